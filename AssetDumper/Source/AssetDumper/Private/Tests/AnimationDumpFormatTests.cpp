@@ -0,0 +1,167 @@
+#include "Toolkit/AssetTypes/AnimationDumpFormat.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Maximum error of a single unpacked component. Quantization step is about 1.4e-6, renormalization adds a bit on top of half of it */
+#define PACKED_ROTATION_MAX_COMPONENT_ERROR 4.0e-6f
+
+/** Returns the largest component difference between the two quaternions, treating Q and -Q as the same rotation */
+static float GetRotationComponentError(const FQuat& Expected, const FQuat& Actual) {
+	const float SameSignError = FMath::Max(FMath::Max(FMath::Abs(Expected.X - Actual.X), FMath::Abs(Expected.Y - Actual.Y)),
+		FMath::Max(FMath::Abs(Expected.Z - Actual.Z), FMath::Abs(Expected.W - Actual.W)));
+	const float FlippedSignError = FMath::Max(FMath::Max(FMath::Abs(Expected.X + Actual.X), FMath::Abs(Expected.Y + Actual.Y)),
+		FMath::Max(FMath::Abs(Expected.Z + Actual.Z), FMath::Abs(Expected.W + Actual.W)));
+	return FMath::Min(SameSignError, FlippedSignError);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPackedRotationPrecisionTest, "AssetDumper.AnimationDumpFormat.PackedRotationPrecision", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPackedRotationPrecisionTest::RunTest(const FString& Parameters) {
+	//Rotations on the boundaries of the encoding: identity, half turns, and quaternions with several equally large components
+	TArray<FQuat> Rotations;
+	Rotations.Add(FQuat::Identity);
+	Rotations.Add(FQuat(1.0f, 0.0f, 0.0f, 0.0f));
+	Rotations.Add(FQuat(0.0f, 0.0f, -1.0f, 0.0f));
+	Rotations.Add(FQuat(0.5f, 0.5f, 0.5f, 0.5f));
+	Rotations.Add(FQuat(-0.5f, 0.5f, -0.5f, 0.5f));
+	Rotations.Add(FQuat(HALF_SQRT_2, 0.0f, 0.0f, HALF_SQRT_2));
+	Rotations.Add(FQuat(0.0f, -HALF_SQRT_2, HALF_SQRT_2, 0.0f));
+	Rotations.Add(FQuat(FVector::UpVector, KINDA_SMALL_NUMBER));
+
+	FRandomStream RandomStream(0x51DE);
+	for (int32 i = 0; i < 100000; i++) {
+		Rotations.Add(FQuat(RandomStream.FRandRange(-1.0f, 1.0f), RandomStream.FRandRange(-1.0f, 1.0f),
+			RandomStream.FRandRange(-1.0f, 1.0f), RandomStream.FRandRange(-1.0f, 1.0f)).GetNormalized());
+	}
+
+	float MaxComponentError = 0.0f;
+	for (const FQuat& Rotation : Rotations) {
+		const uint64 PackedRotation = FDumpedAnimationData::PackRotation(Rotation);
+		const FQuat UnpackedRotation = FDumpedAnimationData::UnpackRotation(PackedRotation);
+		const float ComponentError = GetRotationComponentError(Rotation, UnpackedRotation);
+		MaxComponentError = FMath::Max(MaxComponentError, ComponentError);
+
+		if (ComponentError > PACKED_ROTATION_MAX_COMPONENT_ERROR) {
+			AddError(FString::Printf(TEXT("Rotation %s was unpacked as %s, component error %g is above %g"),
+				*Rotation.ToString(), *UnpackedRotation.ToString(), ComponentError, PACKED_ROTATION_MAX_COMPONENT_ERROR));
+			return false;
+		}
+		if (!UnpackedRotation.IsNormalized()) {
+			AddError(FString::Printf(TEXT("Rotation %s was unpacked as non normalized quaternion %s"), *Rotation.ToString(), *UnpackedRotation.ToString()));
+			return false;
+		}
+
+		//Q and -Q are the same rotation, so both should end up with the same bits
+		const FQuat NegatedRotation(-Rotation.X, -Rotation.Y, -Rotation.Z, -Rotation.W);
+		TestTrue(TEXT("Negated rotation packs to the same value"), FDumpedAnimationData::PackRotation(NegatedRotation) == PackedRotation);
+
+		//Animations are dumped again from the generated assets, so repeated round trips must not accumulate error
+		const FQuat RepackedRotation = FDumpedAnimationData::UnpackRotation(FDumpedAnimationData::PackRotation(UnpackedRotation));
+		TestTrue(TEXT("Repeated round trip does not drift"), GetRotationComponentError(Rotation, RepackedRotation) <= PACKED_ROTATION_MAX_COMPONENT_ERROR);
+	}
+	AddInfo(FString::Printf(TEXT("Maximum component error over %d rotations is %g"), Rotations.Num(), MaxComponentError));
+	return true;
+}
+
+/** Creates curve key with every field set, so any field lost by the format is noticed */
+static FDumpedCurveKey MakeTestCurveKey(const float Time, const float Value, const uint8 InterpMode, const uint8 TangentMode, const uint8 TangentWeightMode) {
+	FDumpedCurveKey Key;
+	Key.Time = Time;
+	Key.Value = Value;
+	Key.ArriveTangent = Value * 0.5f - 1.0f;
+	Key.LeaveTangent = Value * -0.25f + 2.0f;
+	Key.ArriveTangentWeight = Time + 0.125f;
+	Key.LeaveTangentWeight = Time + 0.375f;
+	Key.InterpMode = InterpMode;
+	Key.TangentMode = TangentMode;
+	Key.TangentWeightMode = TangentWeightMode;
+	return Key;
+}
+
+/** Compares floats by their bits, since curves are expected to be stored losslessly, including negative zero and denormals */
+static bool AreFloatsBitwiseEqual(const float A, const float B) {
+	return FMemory::Memcmp(&A, &B, sizeof(float)) == 0;
+}
+
+static bool AreCurveKeysIdentical(const FDumpedCurveKey& A, const FDumpedCurveKey& B) {
+	return AreFloatsBitwiseEqual(A.Time, B.Time) && AreFloatsBitwiseEqual(A.Value, B.Value) &&
+		AreFloatsBitwiseEqual(A.ArriveTangent, B.ArriveTangent) && AreFloatsBitwiseEqual(A.LeaveTangent, B.LeaveTangent) &&
+		AreFloatsBitwiseEqual(A.ArriveTangentWeight, B.ArriveTangentWeight) && AreFloatsBitwiseEqual(A.LeaveTangentWeight, B.LeaveTangentWeight) &&
+		A.InterpMode == B.InterpMode && A.TangentMode == B.TangentMode && A.TangentWeightMode == B.TangentWeightMode;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAnimationCurveRoundTripTest, "AssetDumper.AnimationDumpFormat.CurveRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAnimationCurveRoundTripTest::RunTest(const FString& Parameters) {
+	FDumpedAnimationData AnimationData;
+	AnimationData.NumFrames = 30;
+	AnimationData.SequenceLength = 1.0f;
+
+	FDumpedAnimationTrack& Track = AnimationData.Tracks.AddDefaulted_GetRef();
+	Track.BoneName = TEXT("root");
+	Track.PositionKeys.Add(FVector::ZeroVector);
+	Track.RotationKeys.Add(FQuat::Identity);
+	Track.ScaleKeys.Add(FVector::OneVector);
+
+	//Curve using every interpolation, tangent and tangent weight mode
+	FDumpedAnimationCurve& ModesCurve = AnimationData.Curves.AddDefaulted_GetRef();
+	ModesCurve.CurveName = TEXT("MorphTarget_Blink");
+	ModesCurve.CurveTypeFlags = 0x5;
+	for (uint8 InterpMode = 0; InterpMode < 4; InterpMode++) {
+		for (uint8 TangentMode = 0; TangentMode < 4; TangentMode++) {
+			for (uint8 TangentWeightMode = 0; TangentWeightMode < 4; TangentWeightMode++) {
+				const float Time = ModesCurve.Keys.Num() / 64.0f;
+				ModesCurve.Keys.Add(MakeTestCurveKey(Time, FMath::Sin(Time * 7.0f), InterpMode, TangentMode, TangentWeightMode));
+			}
+		}
+	}
+
+	//Curve with the values floats are easy to lose precision or sign on
+	FDumpedAnimationCurve& ValuesCurve = AnimationData.Curves.AddDefaulted_GetRef();
+	ValuesCurve.CurveName = TEXT("Material_Emissive_\u00C4");
+	ValuesCurve.CurveTypeFlags = 0x2;
+	const TArray<float> EdgeValues = {0.0f, -0.0f, 1.0e-40f, -FLT_MIN, FLT_MAX, -FLT_MAX, 0.1f, 1.0f / 3.0f, 123456.789f};
+	for (int32 i = 0; i < EdgeValues.Num(); i++) {
+		ValuesCurve.Keys.Add(MakeTestCurveKey(i * 0.1f, EdgeValues[i], 0, 0, 0));
+	}
+
+	//Curve without any keys still keeps it's name and flags
+	FDumpedAnimationCurve& EmptyCurve = AnimationData.Curves.AddDefaulted_GetRef();
+	EmptyCurve.CurveName = TEXT("EmptyCurve");
+	EmptyCurve.CurveTypeFlags = 0;
+
+	TArray<uint8> AnimationBytes;
+	AnimationData.SaveToBytes(AnimationBytes);
+
+	FDumpedAnimationData LoadedAnimationData;
+	FString ErrorMessage;
+	if (!TestTrue(FString::Printf(TEXT("Animation data is read back: %s"), *ErrorMessage), LoadedAnimationData.LoadFromBytes(AnimationBytes, ErrorMessage))) {
+		return false;
+	}
+	if (!TestEqual(TEXT("Amount of curves"), LoadedAnimationData.Curves.Num(), AnimationData.Curves.Num())) {
+		return false;
+	}
+
+	for (int32 CurveIndex = 0; CurveIndex < AnimationData.Curves.Num(); CurveIndex++) {
+		const FDumpedAnimationCurve& Curve = AnimationData.Curves[CurveIndex];
+		const FDumpedAnimationCurve& LoadedCurve = LoadedAnimationData.Curves[CurveIndex];
+		TestEqual(TEXT("Curve name"), LoadedCurve.CurveName, Curve.CurveName);
+		TestEqual(TEXT("Curve type flags"), LoadedCurve.CurveTypeFlags, Curve.CurveTypeFlags);
+
+		if (!TestEqual(FString::Printf(TEXT("Amount of keys of %s"), *Curve.CurveName), LoadedCurve.Keys.Num(), Curve.Keys.Num())) {
+			continue;
+		}
+		for (int32 KeyIndex = 0; KeyIndex < Curve.Keys.Num(); KeyIndex++) {
+			TestTrue(FString::Printf(TEXT("Key %d of %s is identical"), KeyIndex, *Curve.CurveName), AreCurveKeysIdentical(Curve.Keys[KeyIndex], LoadedCurve.Keys[KeyIndex]));
+		}
+	}
+
+	//Writing the loaded data again has to produce the same bytes, so the file hash of the regenerated asset does not change
+	TArray<uint8> RewrittenBytes;
+	LoadedAnimationData.SaveToBytes(RewrittenBytes);
+	TestTrue(TEXT("Rewritten animation data is identical"), RewrittenBytes == AnimationBytes);
+	return true;
+}
+
+#endif
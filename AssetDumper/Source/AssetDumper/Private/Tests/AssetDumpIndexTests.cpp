@@ -0,0 +1,121 @@
+#include "Toolkit/AssetDumping/AssetDumpIndex.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Writes minimal asset dump file for the provided package into the dump directory and fills it's index entry */
+static void WriteTestDumpFile(const FString& RootDirectory, const FString& PackageName, FAssetDumpIndexEntry& OutEntry) {
+	const FString FileContents = FString::Printf(TEXT("{\"AssetPackage\": \"%s\", \"AssetClass\": \"Texture2D\", \"ObjectHierarchy\": []}"), *PackageName);
+	const FTCHARToUTF8 FileContentsUTF8(*FileContents);
+	const TArray<uint8> FileBytes((const uint8*) FileContentsUTF8.Get(), FileContentsUTF8.Length());
+	FFileHelper::SaveArrayToFile(FileBytes, *(RootDirectory / PackageName.Mid(1) + TEXT(".json")));
+
+	OutEntry.PackageName = *PackageName;
+	OutEntry.AssetClass = TEXT("Texture2D");
+	OutEntry.FileSize = FileBytes.Num();
+	OutEntry.ContentHash = FAssetDumpIndex::ComputeContentHash(FileBytes);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetDumpIndexCompletionMarkerTest, "AssetDumper.DumpIndex.CompletionMarker", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssetDumpIndexCompletionMarkerTest::RunTest(const FString& Parameters) {
+	const FString RootDirectory = FPaths::AutomationTransientDir() / TEXT("AssetDumpIndexMarker");
+	IFileManager::Get().DeleteDirectory(*RootDirectory, false, true);
+
+	FAssetDumpIndex DumpIndex;
+	FAssetDumpIndexEntry FirstEntry;
+	FAssetDumpIndexEntry SecondEntry;
+	WriteTestDumpFile(RootDirectory, TEXT("/Game/Test/First"), FirstEntry);
+	DumpIndex.AddEntry(FirstEntry);
+
+	//Dump writes the second file after the last periodic index save and then crashes
+	FAssetDumpIndex::MarkDumpInProgress(RootDirectory);
+	DumpIndex.SaveToDumpDirectory(RootDirectory, false);
+	WriteTestDumpFile(RootDirectory, TEXT("/Game/Test/Second"), SecondEntry);
+
+	TestTrue(TEXT("Dump is marked as in progress"), FAssetDumpIndex::IsDumpInProgress(RootDirectory));
+	TestFalse(TEXT("Index of the unfinished dump is rejected"), FAssetDumpIndex::LoadFromDumpDirectory(RootDirectory).IsValid());
+	TestTrue(TEXT("Index of the unfinished dump can be read explicitly"), FAssetDumpIndex::LoadFromDumpDirectory(RootDirectory, true).IsValid());
+
+	//Interrupted dump is indexed from the dump files, which clears the marker
+	const TSharedPtr<FAssetDumpIndex> RebuiltIndex = FAssetDumpIndex::LoadOrRebuildFromDumpDirectory(RootDirectory);
+	TestTrue(TEXT("Index is rebuilt"), RebuiltIndex.IsValid() && RebuiltIndex->GetEntries().Num() == 2);
+	TestTrue(TEXT("Rebuilt index lists the file missed by the crashed dump"), RebuiltIndex.IsValid() && RebuiltIndex->FindEntry(SecondEntry.PackageName) != NULL);
+	TestFalse(TEXT("Marker is removed after rebuilding"), FAssetDumpIndex::IsDumpInProgress(RootDirectory));
+	TestTrue(TEXT("Rebuilt index is accepted"), FAssetDumpIndex::LoadFromDumpDirectory(RootDirectory).IsValid());
+
+	//Dump that finishes writes the complete index and removes the marker
+	FAssetDumpIndex::MarkDumpInProgress(RootDirectory);
+	DumpIndex.AddEntry(SecondEntry);
+	DumpIndex.SaveToDumpDirectory(RootDirectory, true);
+	TestFalse(TEXT("Marker is removed by the finished dump"), FAssetDumpIndex::IsDumpInProgress(RootDirectory));
+
+	const TSharedPtr<FAssetDumpIndex> LoadedIndex = FAssetDumpIndex::LoadFromDumpDirectory(RootDirectory);
+	TestTrue(TEXT("Index of the finished dump is accepted"), LoadedIndex.IsValid() && LoadedIndex->GetEntries().Num() == 2);
+	if (LoadedIndex.IsValid()) {
+		const FAssetDumpIndexEntry* LoadedEntry = LoadedIndex->FindEntry(FirstEntry.PackageName);
+		TestTrue(TEXT("Entry survives the round trip"), LoadedEntry && LoadedEntry->ContentHash == FirstEntry.ContentHash && LoadedEntry->FileSize == FirstEntry.FileSize);
+	}
+
+	IFileManager::Get().DeleteDirectory(*RootDirectory, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetDumpIndexLoadBenchmark, "AssetDumper.DumpIndex.LoadBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FAssetDumpIndexLoadBenchmark::RunTest(const FString& Parameters) {
+	const int32 NumDumpFiles = 5000;
+	const int32 NumDirectories = 50;
+	const int32 NumLoadRuns = 5;
+	const FString RootDirectory = FPaths::AutomationTransientDir() / TEXT("AssetDumpIndexBenchmark");
+	IFileManager::Get().DeleteDirectory(*RootDirectory, false, true);
+
+	FAssetDumpIndex DumpIndex;
+	for (int32 i = 0; i < NumDumpFiles; i++) {
+		FAssetDumpIndexEntry Entry;
+		WriteTestDumpFile(RootDirectory, FString::Printf(TEXT("/Game/Directory%d/Package%d"), i % NumDirectories, i), Entry);
+		DumpIndex.AddEntry(Entry);
+	}
+	DumpIndex.SaveToDumpDirectory(RootDirectory, true);
+
+	//Loading the index only reads the index file and checks for the marker
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumLoadRuns; i++) {
+		const TSharedPtr<FAssetDumpIndex> LoadedIndex = FAssetDumpIndex::LoadFromDumpDirectory(RootDirectory);
+		if (!LoadedIndex.IsValid() || LoadedIndex->GetEntries().Num() != NumDumpFiles) {
+			AddError(TEXT("Failed to load the benchmark dump index"));
+			return false;
+		}
+	}
+	const double IndexLoadSeconds = (FPlatformTime::Seconds() - StartTime) / NumLoadRuns;
+
+	//Directory walk every index load used to perform to verify the index against the dump files
+	StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumLoadRuns; i++) {
+		int32 DumpFileCount = 0;
+		FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStatRecursively(*RootDirectory, [&](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData) {
+			DumpFileCount += !StatData.bIsDirectory && FPaths::GetExtension(FilenameOrDirectory) == TEXT("json") ? 1 : 0;
+			return true;
+		});
+		TestEqual(TEXT("Directory walk finds every dump file"), DumpFileCount, NumDumpFiles);
+	}
+	const double DirectoryWalkSeconds = (FPlatformTime::Seconds() - StartTime) / NumLoadRuns;
+
+	//Rebuilding opens and parses every single dump file, which is what a missing or outdated index costs
+	StartTime = FPlatformTime::Seconds();
+	const TSharedRef<FAssetDumpIndex> RebuiltIndex = FAssetDumpIndex::RebuildFromDumpDirectory(RootDirectory);
+	const double RebuildSeconds = FPlatformTime::Seconds() - StartTime;
+	TestEqual(TEXT("Rebuilt index lists every dump file"), RebuiltIndex->GetEntries().Num(), NumDumpFiles);
+
+	AddInfo(FString::Printf(TEXT("%d dump files: loading index %.2fms, directory walk %.2fms, loading index with the directory walk %.2fms, rebuilding index %.2fms"),
+		NumDumpFiles, IndexLoadSeconds * 1000.0, DirectoryWalkSeconds * 1000.0, (IndexLoadSeconds + DirectoryWalkSeconds) * 1000.0, RebuildSeconds * 1000.0));
+
+	IFileManager::Get().DeleteDirectory(*RootDirectory, false, true);
+	return true;
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "Toolkit/AssetTypes/AssetHelper.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Tolerance of the legacy string form, which only keeps 6 decimal digits and stores rotation as a rotator */
+#define LEGACY_TRANSFORM_TOLERANCE 1.0e-3f
+
+/** Transforms on the edges of the float range along with the random bone-like transforms */
+static void CreateTestTransforms(const int32 NumRandomTransforms, TArray<FTransform>& OutTransforms) {
+	OutTransforms.Add(FTransform::Identity);
+	OutTransforms.Add(FTransform(FQuat(0.5f, -0.5f, 0.5f, -0.5f), FVector(-0.0f, 1.0e-30f, -1.0e-40f), FVector(1.0f, -1.0f, 0.0f)));
+	OutTransforms.Add(FTransform(FQuat(FVector::RightVector, PI / 3.0f), FVector(FLT_MAX, -FLT_MAX, 16777217.0f), FVector(FLT_MIN, 3.0e38f, 0.1f)));
+	OutTransforms.Add(FTransform(FQuat(0.1f, 0.2f, 0.3f, 0.9273618f), FVector(1.0f / 3.0f, 2.0f / 3.0f, 0.7f), FVector(1.0000001f)));
+
+	FRandomStream RandomStream(0x7F0A);
+	for (int32 i = 0; i < NumRandomTransforms; i++) {
+		const FQuat Rotation = FQuat(RandomStream.FRandRange(-1.0f, 1.0f), RandomStream.FRandRange(-1.0f, 1.0f),
+			RandomStream.FRandRange(-1.0f, 1.0f), RandomStream.FRandRange(-1.0f, 1.0f)).GetNormalized();
+		const FVector Translation(RandomStream.FRandRange(-1000.0f, 1000.0f), RandomStream.FRandRange(-1000.0f, 1000.0f), RandomStream.FRandRange(-1000.0f, 1000.0f));
+		const FVector Scale(RandomStream.FRandRange(0.01f, 10.0f), RandomStream.FRandRange(0.01f, 10.0f), RandomStream.FRandRange(0.01f, 10.0f));
+		OutTransforms.Add(FTransform(Rotation, Translation, Scale));
+	}
+}
+
+/** Writes the values into the JSON text and parses them back, the same way they go through the dump files */
+static bool RoundTripThroughJsonText(const TArray<TSharedPtr<FJsonValue>>& Values, TArray<TSharedPtr<FJsonValue>>& OutValues) {
+	const TSharedRef<FJsonObject> RootObject = MakeShareable(new FJsonObject());
+	RootObject->SetArrayField(TEXT("Transforms"), Values);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	FJsonSerializer::Serialize(RootObject, Writer);
+
+	TSharedPtr<FJsonObject> ParsedObject;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), ParsedObject) || !ParsedObject.IsValid()) {
+		return false;
+	}
+	OutValues = ParsedObject->GetArrayField(TEXT("Transforms"));
+	return true;
+}
+
+static bool AreFloatsBitwiseEqual(const float A, const float B) {
+	return FMemory::Memcmp(&A, &B, sizeof(float)) == 0;
+}
+
+static bool AreTransformsBitwiseEqual(const FTransform& A, const FTransform& B) {
+	const FVector TranslationA = A.GetTranslation(), TranslationB = B.GetTranslation();
+	const FQuat RotationA = A.GetRotation(), RotationB = B.GetRotation();
+	const FVector ScaleA = A.GetScale3D(), ScaleB = B.GetScale3D();
+
+	return AreFloatsBitwiseEqual(TranslationA.X, TranslationB.X) && AreFloatsBitwiseEqual(TranslationA.Y, TranslationB.Y) && AreFloatsBitwiseEqual(TranslationA.Z, TranslationB.Z) &&
+		AreFloatsBitwiseEqual(RotationA.X, RotationB.X) && AreFloatsBitwiseEqual(RotationA.Y, RotationB.Y) && AreFloatsBitwiseEqual(RotationA.Z, RotationB.Z) && AreFloatsBitwiseEqual(RotationA.W, RotationB.W) &&
+		AreFloatsBitwiseEqual(ScaleA.X, ScaleB.X) && AreFloatsBitwiseEqual(ScaleA.Y, ScaleB.Y) && AreFloatsBitwiseEqual(ScaleA.Z, ScaleB.Z);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTransformRoundTripTest, "AssetDumper.AssetHelper.TransformRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTransformRoundTripTest::RunTest(const FString& Parameters) {
+	TArray<FTransform> Transforms;
+	CreateTestTransforms(10000, Transforms);
+
+	//Numeric array form has to be lossless, bit for bit
+	TArray<TSharedPtr<FJsonValue>> NumericValues;
+	for (const FTransform& Transform : Transforms) {
+		NumericValues.Add(FAssetHelper::SerializeTransform(Transform));
+	}
+	TArray<TSharedPtr<FJsonValue>> ParsedNumericValues;
+	if (!TestTrue(TEXT("Numeric transforms are parsed"), RoundTripThroughJsonText(NumericValues, ParsedNumericValues) && ParsedNumericValues.Num() == Transforms.Num())) {
+		return false;
+	}
+	for (int32 i = 0; i < Transforms.Num(); i++) {
+		FTransform ParsedTransform;
+		const bool bParsed = FAssetHelper::DeserializeTransform(ParsedNumericValues[i], ParsedTransform);
+
+		if (!bParsed || !AreTransformsBitwiseEqual(Transforms[i], ParsedTransform)) {
+			AddError(FString::Printf(TEXT("Transform %s was read back from the numeric form as %s"), *Transforms[i].ToString(), bParsed ? *ParsedTransform.ToString() : TEXT("malformed")));
+			return false;
+		}
+	}
+
+	//Legacy string form written by the older dumps is still readable, with the precision it has been written with
+	TArray<TSharedPtr<FJsonValue>> LegacyValues;
+	for (int32 i = 4; i < Transforms.Num(); i++) {
+		LegacyValues.Add(MakeShareable(new FJsonValueString(Transforms[i].ToString())));
+	}
+	TArray<TSharedPtr<FJsonValue>> ParsedLegacyValues;
+	if (!TestTrue(TEXT("Legacy transforms are parsed"), RoundTripThroughJsonText(LegacyValues, ParsedLegacyValues) && ParsedLegacyValues.Num() == LegacyValues.Num())) {
+		return false;
+	}
+	for (int32 i = 0; i < ParsedLegacyValues.Num(); i++) {
+		const FTransform& Transform = Transforms[i + 4];
+		FTransform ParsedTransform;
+		const bool bParsed = FAssetHelper::DeserializeTransform(ParsedLegacyValues[i], ParsedTransform);
+
+		if (!bParsed || !Transform.Equals(ParsedTransform, LEGACY_TRANSFORM_TOLERANCE)) {
+			AddError(FString::Printf(TEXT("Transform %s was read back from the legacy form as %s"), *Transform.ToString(), bParsed ? *ParsedTransform.ToString() : TEXT("malformed")));
+			return false;
+		}
+	}
+
+	//Malformed values are reported instead of producing a garbage transform
+	FTransform MalformedTransform;
+	TArray<TSharedPtr<FJsonValue>> TooFewNumbers;
+	for (int32 i = 0; i < 9; i++) {
+		TooFewNumbers.Add(MakeShareable(new FJsonValueNumber(1.0)));
+	}
+	TestFalse(TEXT("Array with the wrong amount of numbers"), FAssetHelper::DeserializeTransform(MakeShareable(new FJsonValueArray(TooFewNumbers)), MalformedTransform));
+	TestFalse(TEXT("Object value"), FAssetHelper::DeserializeTransform(MakeShareable(new FJsonValueObject(MakeShareable(new FJsonObject()))), MalformedTransform));
+	TestFalse(TEXT("Missing value"), FAssetHelper::DeserializeTransform(NULL, MalformedTransform));
+	TestFalse(TEXT("Malformed legacy string"), FAssetHelper::DeserializeTransform(MakeShareable(new FJsonValueString(TEXT("1,2|3"))), MalformedTransform));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTransformParseBenchmarkTest, "AssetDumper.AssetHelper.TransformParseBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FTransformParseBenchmarkTest::RunTest(const FString& Parameters) {
+	TArray<FTransform> Transforms;
+	CreateTestTransforms(100000, Transforms);
+
+	TArray<TSharedPtr<FJsonValue>> NumericValues;
+	TArray<TSharedPtr<FJsonValue>> LegacyValues;
+	for (const FTransform& Transform : Transforms) {
+		NumericValues.Add(FAssetHelper::SerializeTransform(Transform));
+		LegacyValues.Add(MakeShareable(new FJsonValueString(Transform.ToString())));
+	}
+
+	//Both forms are measured from the JSON text, since parsing the text is part of reading the transforms
+	for (const bool bLegacyForm : {false, true}) {
+		const double StartTime = FPlatformTime::Seconds();
+		TArray<TSharedPtr<FJsonValue>> ParsedValues;
+		RoundTripThroughJsonText(bLegacyForm ? LegacyValues : NumericValues, ParsedValues);
+
+		int32 NumParsed = 0;
+		for (const TSharedPtr<FJsonValue>& Value : ParsedValues) {
+			FTransform Transform;
+			NumParsed += FAssetHelper::DeserializeTransform(Value, Transform) ? 1 : 0;
+		}
+		const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+		TestEqual(TEXT("Every transform is parsed"), NumParsed, Transforms.Num());
+		AddInfo(FString::Printf(TEXT("%s form: %d transforms written and parsed in %.2f ms"), bLegacyForm ? TEXT("Legacy string") : TEXT("Numeric array"), Transforms.Num(), ElapsedTime * 1000.0));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,271 @@
+#include "Toolkit/KismetBytecodeCompactFormat.h"
+#include "Dom/JsonValue.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Base64.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Compares two JSON values exactly, including case of the strings and order of the object fields */
+static bool AreJsonValuesIdentical(const TSharedPtr<FJsonValue>& A, const TSharedPtr<FJsonValue>& B) {
+	if (!A.IsValid() || !B.IsValid() || A->Type != B->Type) {
+		return false;
+	}
+	switch (A->Type) {
+	case EJson::Boolean:
+		return A->AsBool() == B->AsBool();
+	case EJson::String:
+		return A->AsString().Equals(B->AsString(), ESearchCase::CaseSensitive);
+	case EJson::Number:
+		return A->AsNumber() == B->AsNumber();
+	case EJson::Array:
+	{
+		const TArray<TSharedPtr<FJsonValue>>& ArrayA = A->AsArray();
+		const TArray<TSharedPtr<FJsonValue>>& ArrayB = B->AsArray();
+		if (ArrayA.Num() != ArrayB.Num()) {
+			return false;
+		}
+		for (int32 i = 0; i < ArrayA.Num(); i++) {
+			if (!AreJsonValuesIdentical(ArrayA[i], ArrayB[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+	case EJson::Object:
+	{
+		const TMap<FString, TSharedPtr<FJsonValue>>& FieldsA = A->AsObject()->Values;
+		const TMap<FString, TSharedPtr<FJsonValue>>& FieldsB = B->AsObject()->Values;
+		if (FieldsA.Num() != FieldsB.Num()) {
+			return false;
+		}
+		auto IteratorB = FieldsB.CreateConstIterator();
+		for (auto IteratorA = FieldsA.CreateConstIterator(); IteratorA; ++IteratorA, ++IteratorB) {
+			if (!IteratorA.Key().Equals(IteratorB.Key(), ESearchCase::CaseSensitive) ||
+				!AreJsonValuesIdentical(IteratorA.Value(), IteratorB.Value())) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return true;
+	}
+}
+
+/** Builds statement list covering every value type of the format and the edge cases of the string table and number encoding */
+static TArray<TSharedPtr<FJsonValue>> MakeTestStatements() {
+	TArray<TSharedPtr<FJsonValue>> Statements;
+
+	const TSharedPtr<FJsonObject> CallStatement = MakeShareable(new FJsonObject());
+	CallStatement->SetStringField(TEXT("Inst"), TEXT("FinalFunction"));
+	CallStatement->SetStringField(TEXT("Function"), TEXT("/Script/Engine.KismetSystemLibrary:PrintString"));
+	CallStatement->SetNumberField(TEXT("StatementIndex"), 0);
+
+	//String values differing only by case must not be merged in the string table
+	TArray<TSharedPtr<FJsonValue>> Parameters;
+	Parameters.Add(MakeShareable(new FJsonValueString(TEXT("Value"))));
+	Parameters.Add(MakeShareable(new FJsonValueString(TEXT("value"))));
+	Parameters.Add(MakeShareable(new FJsonValueString(TEXT("VALUE"))));
+	Parameters.Add(MakeShareable(new FJsonValueString(TEXT(""))));
+	Parameters.Add(MakeShareable(new FJsonValueString(TEXT("\u00DCnicode \u041F\u0440\u0438\u0432\u0435\u0442 \u65E5\u672C"))));
+	Parameters.Add(MakeShareable(new FJsonValueNull()));
+	Parameters.Add(MakeShareable(new FJsonValueBoolean(true)));
+	Parameters.Add(MakeShareable(new FJsonValueBoolean(false)));
+	CallStatement->SetArrayField(TEXT("Parameters"), Parameters);
+	Statements.Add(MakeShareable(new FJsonValueObject(CallStatement)));
+
+	//Numbers on both sides of the packed unsigned integer range
+	const TSharedPtr<FJsonObject> NumberStatement = MakeShareable(new FJsonObject());
+	NumberStatement->SetStringField(TEXT("Inst"), TEXT("Let"));
+	NumberStatement->SetNumberField(TEXT("Zero"), 0.0);
+	NumberStatement->SetNumberField(TEXT("MaxUnsigned"), MAX_uint32);
+	NumberStatement->SetNumberField(TEXT("AboveMaxUnsigned"), 5.0e9);
+	NumberStatement->SetNumberField(TEXT("Negative"), -1.0);
+	NumberStatement->SetNumberField(TEXT("MinInt"), MIN_int32);
+	NumberStatement->SetNumberField(TEXT("Fraction"), 0.1);
+	NumberStatement->SetNumberField(TEXT("statementindex"), 1);
+
+	//Nested empty containers, and an object nested inside of the array
+	const TSharedPtr<FJsonObject> NestedObject = MakeShareable(new FJsonObject());
+	NestedObject->SetArrayField(TEXT("Empty"), TArray<TSharedPtr<FJsonValue>>());
+	NestedObject->SetObjectField(TEXT("EmptyObject"), MakeShareable(new FJsonObject()));
+	TArray<TSharedPtr<FJsonValue>> NestedArray;
+	NestedArray.Add(MakeShareable(new FJsonValueArray(TArray<TSharedPtr<FJsonValue>>())));
+	NestedArray.Add(MakeShareable(new FJsonValueObject(NestedObject)));
+	NumberStatement->SetArrayField(TEXT("Nested"), NestedArray);
+	Statements.Add(MakeShareable(new FJsonValueObject(NumberStatement)));
+
+	Statements.Add(MakeShareable(new FJsonValueNull()));
+	return Statements;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeCompactFormatRoundTripTest, "AssetDumper.KismetBytecodeCompactFormat.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeCompactFormatRoundTripTest::RunTest(const FString& Parameters) {
+	const TArray<TSharedPtr<FJsonValue>> Statements = MakeTestStatements();
+	TArray<uint8> SavedBytes;
+	FKismetBytecodeCompactFormat::SaveStatements(Statements, SavedBytes);
+
+	TArray<TSharedPtr<FJsonValue>> LoadedStatements;
+	FString ErrorMessage;
+	if (!FKismetBytecodeCompactFormat::LoadStatements(SavedBytes, LoadedStatements, ErrorMessage)) {
+		AddError(FString::Printf(TEXT("Failed to load saved statements: %s"), *ErrorMessage));
+		return false;
+	}
+
+	TestEqual(TEXT("Statement count"), LoadedStatements.Num(), Statements.Num());
+	for (int32 i = 0; i < FMath::Min(LoadedStatements.Num(), Statements.Num()); i++) {
+		TestTrue(FString::Printf(TEXT("Statement %d is identical"), i), AreJsonValuesIdentical(LoadedStatements[i], Statements[i]));
+	}
+
+	//Saving the loaded statements again should produce identical bytes, so dumps stay stable
+	TArray<uint8> ResavedBytes;
+	FKismetBytecodeCompactFormat::SaveStatements(LoadedStatements, ResavedBytes);
+	TestTrue(TEXT("Re-saved statements are identical"), ResavedBytes == SavedBytes);
+
+	TArray<uint8> EmptyBytes;
+	TArray<TSharedPtr<FJsonValue>> EmptyStatements;
+	FKismetBytecodeCompactFormat::SaveStatements(TArray<TSharedPtr<FJsonValue>>(), EmptyBytes);
+	TestTrue(TEXT("Empty statement list is loaded"), FKismetBytecodeCompactFormat::LoadStatements(EmptyBytes, EmptyStatements, ErrorMessage));
+	TestEqual(TEXT("Empty statement list count"), EmptyStatements.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeCompactFormatMalformedDataTest, "AssetDumper.KismetBytecodeCompactFormat.MalformedData", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeCompactFormatMalformedDataTest::RunTest(const FString& Parameters) {
+	TArray<uint8> SavedBytes;
+	FKismetBytecodeCompactFormat::SaveStatements(MakeTestStatements(), SavedBytes);
+	FString ErrorMessage;
+
+	//Every truncation of the data should be rejected instead of producing partially loaded statements
+	for (int32 TruncatedSize = 0; TruncatedSize < SavedBytes.Num(); TruncatedSize++) {
+		const TArray<uint8> TruncatedBytes(SavedBytes.GetData(), TruncatedSize);
+		TArray<TSharedPtr<FJsonValue>> LoadedStatements;
+		if (FKismetBytecodeCompactFormat::LoadStatements(TruncatedBytes, LoadedStatements, ErrorMessage)) {
+			AddError(FString::Printf(TEXT("Statements truncated to %d out of %d bytes were loaded successfully"), TruncatedSize, SavedBytes.Num()));
+			return false;
+		}
+	}
+
+	TArray<uint8> TrailingBytes = SavedBytes;
+	TrailingBytes.Add(0);
+	TArray<TSharedPtr<FJsonValue>> TrailingStatements;
+	TestFalse(TEXT("Statements with trailing bytes are rejected"), FKismetBytecodeCompactFormat::LoadStatements(TrailingBytes, TrailingStatements, ErrorMessage));
+
+	TArray<uint8> WrongMagicBytes = SavedBytes;
+	WrongMagicBytes[0] ^= 0xFF;
+	TArray<TSharedPtr<FJsonValue>> WrongMagicStatements;
+	TestFalse(TEXT("Statements with wrong magic are rejected"), FKismetBytecodeCompactFormat::LoadStatements(WrongMagicBytes, WrongMagicStatements, ErrorMessage));
+
+	//Version is stored right after the 4 byte magic
+	TArray<uint8> FutureVersionBytes = SavedBytes;
+	FutureVersionBytes[4] += 1;
+	TArray<TSharedPtr<FJsonValue>> FutureVersionStatements;
+	TestFalse(TEXT("Statements with unsupported version are rejected"), FKismetBytecodeCompactFormat::LoadStatements(FutureVersionBytes, FutureVersionStatements, ErrorMessage));
+
+	//String table count follows the version, and the length of the first string follows the count.
+	//Corrupted values should be rejected before anything is allocated for them
+	for (const int32 CorruptedValue : {MAX_int32, MIN_int32, -(1 << 24), 1 << 24}) {
+		for (const int32 CorruptedOffset : {8, 12}) {
+			TArray<uint8> CorruptedBytes = SavedBytes;
+			FMemory::Memcpy(CorruptedBytes.GetData() + CorruptedOffset, &CorruptedValue, sizeof(int32));
+			TArray<TSharedPtr<FJsonValue>> CorruptedStatements;
+			TestFalse(FString::Printf(TEXT("Corrupted value %d at offset %d is rejected"), CorruptedValue, CorruptedOffset),
+				FKismetBytecodeCompactFormat::LoadStatements(CorruptedBytes, CorruptedStatements, ErrorMessage));
+		}
+	}
+	return true;
+}
+
+/** Builds statement list shaped like the disassembly of a typical Blueprint function: calls with variable and literal parameters, assignments and jumps */
+static TArray<TSharedPtr<FJsonValue>> MakeBenchmarkStatements(const int32 NumStatements) {
+	TArray<TSharedPtr<FJsonValue>> Statements;
+	for (int32 i = 0; i < NumStatements; i++) {
+		const TSharedPtr<FJsonObject> Statement = MakeShareable(new FJsonObject());
+		Statement->SetNumberField(TEXT("StatementIndex"), i * 24);
+
+		if (i % 4 == 3) {
+			Statement->SetStringField(TEXT("Inst"), TEXT("JumpIfNot"));
+			Statement->SetNumberField(TEXT("Offset"), (i + 4) * 24);
+			const TSharedPtr<FJsonObject> Condition = MakeShareable(new FJsonObject());
+			Condition->SetStringField(TEXT("Inst"), TEXT("LocalVariable"));
+			Condition->SetStringField(TEXT("VariableName"), FString::Printf(TEXT("CallFunc_Condition_ReturnValue_%d"), i % 16));
+			Statement->SetObjectField(TEXT("Condition"), Condition);
+		}
+		else {
+			Statement->SetStringField(TEXT("Inst"), TEXT("CallMath"));
+			Statement->SetStringField(TEXT("ContextClass"), TEXT("/Script/Engine.KismetMathLibrary"));
+			Statement->SetStringField(TEXT("Function"), i % 2 ? TEXT("Add_IntInt") : TEXT("Multiply_FloatFloat"));
+
+			TArray<TSharedPtr<FJsonValue>> Parameters;
+			const TSharedPtr<FJsonObject> VariableParameter = MakeShareable(new FJsonObject());
+			VariableParameter->SetStringField(TEXT("Inst"), TEXT("InstanceVariable"));
+			VariableParameter->SetStringField(TEXT("VariableName"), FString::Printf(TEXT("Variable_%d"), i % 32));
+			const TSharedPtr<FJsonObject> VariableType = MakeShareable(new FJsonObject());
+			VariableType->SetStringField(TEXT("ObjectClass"), TEXT("IntProperty"));
+			VariableType->SetNumberField(TEXT("PropertyFlags"), 1 << (i % 20));
+			VariableParameter->SetObjectField(TEXT("VariableType"), VariableType);
+			Parameters.Add(MakeShareable(new FJsonValueObject(VariableParameter)));
+
+			const TSharedPtr<FJsonObject> LiteralParameter = MakeShareable(new FJsonObject());
+			LiteralParameter->SetStringField(TEXT("Inst"), i % 2 ? TEXT("IntConst") : TEXT("FloatConst"));
+			LiteralParameter->SetNumberField(TEXT("Value"), i % 2 ? (double) (i % 100) : i * 0.5);
+			Parameters.Add(MakeShareable(new FJsonValueObject(LiteralParameter)));
+			Statement->SetArrayField(TEXT("Parameters"), Parameters);
+		}
+		Statements.Add(MakeShareable(new FJsonValueObject(Statement)));
+	}
+	return Statements;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeCompactFormatBenchmark, "AssetDumper.KismetBytecodeCompactFormat.SizeAndParseBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FKismetBytecodeCompactFormatBenchmark::RunTest(const FString& Parameters) {
+	const int32 NumStatements = 20000;
+	const int32 NumIterations = 5;
+	const TArray<TSharedPtr<FJsonValue>> Statements = MakeBenchmarkStatements(NumStatements);
+
+	//JSON form is the Script array as written into the dump with the default pretty printing
+	FString JsonScript;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonScript);
+	FJsonSerializer::Serialize(Statements, JsonWriter);
+
+	//Compact form is written into the dump as a base64 string
+	TArray<uint8> CompactBytes;
+	FKismetBytecodeCompactFormat::SaveStatements(Statements, CompactBytes);
+	const FString CompactScript = FBase64::Encode(CompactBytes);
+
+	double JsonParseTime = 0.0;
+	double CompactParseTime = 0.0;
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+		const double JsonStartTime = FPlatformTime::Seconds();
+		TArray<TSharedPtr<FJsonValue>> JsonStatements;
+		const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonScript);
+		const bool bJsonParsed = FJsonSerializer::Deserialize(JsonReader, JsonStatements);
+		JsonParseTime += FPlatformTime::Seconds() - JsonStartTime;
+
+		const double CompactStartTime = FPlatformTime::Seconds();
+		TArray<uint8> DecodedBytes;
+		TArray<TSharedPtr<FJsonValue>> CompactStatements;
+		FString ErrorMessage;
+		const bool bCompactParsed = FBase64::Decode(CompactScript, DecodedBytes) && FKismetBytecodeCompactFormat::LoadStatements(DecodedBytes, CompactStatements, ErrorMessage);
+		CompactParseTime += FPlatformTime::Seconds() - CompactStartTime;
+
+		if (!bJsonParsed || !bCompactParsed || JsonStatements.Num() != NumStatements || CompactStatements.Num() != NumStatements) {
+			AddError(TEXT("Failed to parse benchmark statements"));
+			return false;
+		}
+	}
+
+	const int32 JsonSize = FTCHARToUTF8(*JsonScript).Length();
+	AddInfo(FString::Printf(TEXT("%d statements: JSON %d bytes, compact %d bytes (%d bytes base64, %.1f%% of JSON)"),
+		NumStatements, JsonSize, CompactBytes.Num(), CompactScript.Len(), CompactScript.Len() * 100.0 / JsonSize));
+	AddInfo(FString::Printf(TEXT("Parse time per iteration: JSON %.2fms, compact including base64 decoding %.2fms"),
+		JsonParseTime * 1000.0 / NumIterations, CompactParseTime * 1000.0 / NumIterations));
+	TestTrue(TEXT("Compact form is smaller than JSON"), CompactScript.Len() < JsonSize);
+	return true;
+}
+
+#endif
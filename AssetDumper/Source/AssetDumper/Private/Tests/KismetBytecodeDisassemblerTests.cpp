@@ -0,0 +1,338 @@
+#include "Toolkit/KismetBytecodeDisassemblerJson.h"
+#include "Toolkit/AssetTypes/AssetHelper.h"
+#include "Toolkit/ObjectHierarchySerializer.h"
+#include "Toolkit/PropertySerializer.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Script.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Appends raw bytecode in the same layout the script compiler writes it */
+struct FTestScriptWriter {
+	TArray<uint8> Script;
+
+	template <typename T>
+	void Write(const T& Value) {
+		const int32 Offset = Script.AddUninitialized(sizeof(T));
+		FMemory::Memcpy(Script.GetData() + Offset, &Value, sizeof(T));
+	}
+
+	void WriteOpcode(EExprToken Opcode) {
+		Write<uint8>(Opcode);
+	}
+
+	void WriteString8(const ANSICHAR* String) {
+		Script.Append((const uint8*) String, FCStringAnsi::Strlen(String) + 1);
+	}
+
+	void WriteString16(const TArray<uint16>& Characters) {
+		for (uint16 Character : Characters) {
+			Write<uint16>(Character);
+		}
+		Write<uint16>(0);
+	}
+};
+
+/** Builds script out of the instructions that do not reference any objects, so it can be disassembled without a real function */
+static TArray<uint8> MakeTestScript(const int32 IntConstValue = -12345) {
+	FTestScriptWriter Writer;
+
+	Writer.WriteOpcode(EX_PushExecutionFlow);
+	Writer.Write<CodeSkipSizeType>(42);
+
+	Writer.WriteOpcode(EX_JumpIfNot);
+	Writer.Write<CodeSkipSizeType>(7);
+	Writer.WriteOpcode(EX_True);
+
+	Writer.WriteOpcode(EX_LocalVirtualFunction);
+	Writer.Write<FScriptName>(NameToScriptName(FName(TEXT("TestFunction"))));
+	Writer.WriteOpcode(EX_IntConst);
+	Writer.Write<int32>(IntConstValue);
+	Writer.WriteOpcode(EX_StringConst);
+	Writer.WriteString8("Ansi string");
+	Writer.WriteOpcode(EX_UnicodeStringConst);
+	Writer.WriteString16({ 0x0423, 0x043D, 0x0438 });
+	Writer.WriteOpcode(EX_VectorConst);
+	Writer.Write<float>(1.0f);
+	Writer.Write<float>(2.0f);
+	Writer.Write<float>(3.0f);
+	Writer.WriteOpcode(EX_EndFunctionParms);
+
+	Writer.WriteOpcode(EX_SetArray);
+	Writer.WriteOpcode(EX_Self);
+	Writer.WriteOpcode(EX_ByteConst);
+	Writer.Write<uint8>(200);
+	Writer.WriteOpcode(EX_Int64Const);
+	Writer.Write<int64>(MAX_int32 + 1ll);
+	Writer.WriteOpcode(EX_EndArray);
+
+	Writer.WriteOpcode(EX_Jump);
+	Writer.Write<CodeSkipSizeType>(0);
+	Writer.WriteOpcode(EX_PopExecutionFlow);
+	Writer.WriteOpcode(EX_Nothing);
+
+	Writer.WriteOpcode(EX_Return);
+	Writer.WriteOpcode(EX_NoObject);
+	Writer.WriteOpcode(EX_EndOfScript);
+	return Writer.Script;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeDisassemblerTruncatedScriptTest, "AssetDumper.KismetBytecodeDisassembler.TruncatedScript", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeDisassemblerTruncatedScriptTest::RunTest(const FString& Parameters) {
+	const TArray<uint8> Script = MakeTestScript();
+	FKismetBytecodeDisassemblerJson Disassembler;
+
+	const TArray<TSharedPtr<FJsonValue>> Statements = Disassembler.SerializeScript(Script, NULL);
+	if (Disassembler.HasReadError()) {
+		AddError(FString::Printf(TEXT("Failed to disassemble complete script: %s"), *Disassembler.GetReadErrorMessage()));
+		return false;
+	}
+	TestEqual(TEXT("Statement count"), Statements.Num(), 9);
+
+	//Cutting the script right before a statement leaves a valid shorter script, so only these sizes should be disassembled
+	TMap<int32, int32> StatementCountAtOffset;
+	for (int32 i = 0; i < Statements.Num(); i++) {
+		StatementCountAtOffset.Add((int32) Statements[i]->AsObject()->GetNumberField(TEXT("StatementIndex")), i);
+	}
+
+	for (int32 TruncatedSize = 0; TruncatedSize < Script.Num(); TruncatedSize++) {
+		const TArray<TSharedPtr<FJsonValue>> TruncatedStatements = Disassembler.SerializeScript(TArrayView<const uint8>(Script.GetData(), TruncatedSize), NULL);
+
+		if (const int32* ExpectedStatementCount = StatementCountAtOffset.Find(TruncatedSize)) {
+			TestFalse(FString::Printf(TEXT("Script cut at statement boundary %d is disassembled"), TruncatedSize), Disassembler.HasReadError());
+			TestEqual(FString::Printf(TEXT("Statement count of script cut at %d"), TruncatedSize), TruncatedStatements.Num(), *ExpectedStatementCount);
+		}
+		else if (!Disassembler.HasReadError() || TruncatedStatements.Num() != 0) {
+			AddError(FString::Printf(TEXT("Script truncated to %d out of %d bytes did not report a read error"), TruncatedSize, Script.Num()));
+			return false;
+		}
+	}
+
+	//Read error should not stick around once a valid script is disassembled again
+	Disassembler.SerializeScript(Script, NULL);
+	TestFalse(TEXT("Read error is reset for the next script"), Disassembler.HasReadError());
+	return true;
+}
+
+/** Applies a single random mutation to the script: overwrites, flips, inserts or removes a byte, or plants a random opcode */
+static void MutateScript(TArray<uint8>& Script, FRandomStream& RandomStream) {
+	const int32 MutationType = RandomStream.RandRange(0, 4);
+	const int32 Position = Script.Num() ? RandomStream.RandRange(0, Script.Num() - 1) : 0;
+
+	if (MutationType == 2 || Script.Num() == 0) {
+		Script.Insert((uint8) RandomStream.RandRange(0, 255), Position);
+	}
+	else if (MutationType == 0) {
+		Script[Position] = (uint8) RandomStream.RandRange(0, 255);
+	}
+	else if (MutationType == 1) {
+		Script[Position] ^= (uint8) (1 << RandomStream.RandRange(0, 7));
+	}
+	else if (MutationType == 3) {
+		Script.RemoveAt(Position);
+	}
+	else {
+		//Opcodes are the first bytes of every instruction, so planting them reaches decoding paths random bytes rarely hit
+		Script[Position] = (uint8) RandomStream.RandRange(0, EX_Max - 1);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeDisassemblerMutatedScriptTest, "AssetDumper.KismetBytecodeDisassembler.MutatedScript", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeDisassemblerMutatedScriptTest::RunTest(const FString& Parameters) {
+	FKismetBytecodeDisassemblerJson Disassembler;
+	FRandomStream RandomStream(0x4B425344);
+	const int32 NumIterations = 20000;
+	int32 NumDisassembled = 0;
+
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+		TArray<uint8> Script = MakeTestScript(RandomStream.RandRange(MIN_int32, MAX_int32));
+		const int32 NumMutations = RandomStream.RandRange(1, 4);
+		for (int32 i = 0; i < NumMutations; i++) {
+			MutateScript(Script, RandomStream);
+		}
+
+		//Corrupted script must either be disassembled completely, or report a read error and return no statements
+		const TArray<TSharedPtr<FJsonValue>> Statements = Disassembler.SerializeScript(Script, NULL);
+		if (Disassembler.HasReadError()) {
+			if (Statements.Num() != 0 || Disassembler.GetReadErrorMessage().IsEmpty()) {
+				AddError(FString::Printf(TEXT("Mutated script %d reported a read error, but returned %d statements"), Iteration, Statements.Num()));
+				return false;
+			}
+			continue;
+		}
+
+		//Successfully disassembled statements should cover the script in order, without starting outside of it
+		int32 LastStatementIndex = -1;
+		for (const TSharedPtr<FJsonValue>& Statement : Statements) {
+			const int32 StatementIndex = (int32) Statement->AsObject()->GetNumberField(TEXT("StatementIndex"));
+			if (StatementIndex <= LastStatementIndex || StatementIndex >= Script.Num() || !Statement->AsObject()->HasField(TEXT("Inst"))) {
+				AddError(FString::Printf(TEXT("Mutated script %d was disassembled into a malformed statement at %d"), Iteration, StatementIndex));
+				return false;
+			}
+			LastStatementIndex = StatementIndex;
+		}
+		NumDisassembled++;
+	}
+
+	//Scripts with object references planted by the mutations are rejected instead of dereferencing the random pointer
+	FTestScriptWriter Writer;
+	Writer.WriteOpcode(EX_ObjectConst);
+	Writer.Write<uint64>(0xDEADBEEFDEADBEEF);
+	Disassembler.SerializeScript(Writer.Script, NULL);
+	TestTrue(TEXT("Object reference in a script without a function is rejected"), Disassembler.HasReadError());
+
+	AddInfo(FString::Printf(TEXT("%d out of %d mutated scripts were still disassembled, the rest reported read errors"), NumDisassembled, NumIterations));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeDisassemblerThroughputBenchmark, "AssetDumper.KismetBytecodeDisassembler.ThroughputBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FKismetBytecodeDisassemblerThroughputBenchmark::RunTest(const FString& Parameters) {
+	FKismetBytecodeDisassemblerJson Disassembler;
+	const int32 NumIterations = 5;
+
+	//Synthetic script of about a megabyte, built out of the test script repeated with different constants
+	TArray<uint8> Script;
+	for (int32 i = 0; Script.Num() < 1024 * 1024; i++) {
+		Script.Append(MakeTestScript(i));
+	}
+
+	int32 NumStatements = 0;
+	const double SyntheticStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+		NumStatements = Disassembler.SerializeScript(Script, NULL).Num();
+	}
+	const double SyntheticTime = (FPlatformTime::Seconds() - SyntheticStartTime) / NumIterations;
+	TestFalse(TEXT("Synthetic script is disassembled"), Disassembler.HasReadError());
+	AddInfo(FString::Printf(TEXT("Synthetic script: %d bytes, %d statements in %.2fms, %.1f MB/s"),
+		Script.Num(), NumStatements, SyntheticTime * 1000.0, Script.Num() / (1024.0 * 1024.0) / SyntheticTime));
+
+	//Bytecode of the functions loaded in the editor, which references real objects and properties
+	TArray<UFunction*> Functions;
+	int64 TotalScriptSize = 0;
+	for (TObjectIterator<UFunction> It; It; ++It) {
+		if (It->Script.Num() && !It->HasAnyFlags(RF_Transient)) {
+			Functions.Add(*It);
+			TotalScriptSize += It->Script.Num();
+		}
+	}
+	if (Functions.Num() == 0) {
+		AddInfo(TEXT("No functions with bytecode are loaded, skipping loaded function throughput"));
+		return true;
+	}
+
+	const double LoadedStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+		for (UFunction* Function : Functions) {
+			Disassembler.SerializeFunction(Function);
+		}
+	}
+	const double LoadedTime = (FPlatformTime::Seconds() - LoadedStartTime) / NumIterations;
+	AddInfo(FString::Printf(TEXT("Loaded functions: %d functions, %lld bytes in %.2fms, %.1f MB/s"),
+		Functions.Num(), TotalScriptSize, LoadedTime * 1000.0, TotalScriptSize / (1024.0 * 1024.0) / LoadedTime));
+	return true;
+}
+
+/** Disassembles script of every struct with FAssetHelper::DisassembleScript and returns it written as JSON text, in parallel or sequentially */
+static TArray<FString> DisassembleScriptsAsText(const TArray<UStruct*>& Structs, const bool bParallel) {
+	TArray<FString> ScriptTexts;
+	ScriptTexts.SetNum(Structs.Num());
+
+	ParallelFor(Structs.Num(), [&Structs, &ScriptTexts](const int32 StructIndex) {
+		const TSharedPtr<FJsonObject> ScriptObject = FAssetHelper::DisassembleScript(Structs[StructIndex]);
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ScriptTexts[StructIndex]);
+		FJsonSerializer::Serialize(ScriptObject.ToSharedRef(), Writer);
+	}, !bParallel);
+	return ScriptTexts;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeDisassemblerParallelDeterminismTest, "AssetDumper.KismetBytecodeDisassembler.ParallelDeterminism", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeDisassemblerParallelDeterminismTest::RunTest(const FString& Parameters) {
+	//Synthetic functions make sure there is always something to disassemble, even if no blueprints are loaded
+	TArray<UStruct*> Structs;
+	for (int32 i = 0; i < 64; i++) {
+		UFunction* Function = NewObject<UFunction>(GetTransientPackage(), NAME_None, RF_Transient);
+		Function->Script = MakeTestScript(i);
+		Structs.Add(Function);
+	}
+
+	//Functions of the blueprints loaded in the editor cover the instructions referencing real objects
+	for (TObjectIterator<UFunction> It; It && Structs.Num() < 4096; ++It) {
+		if (It->Script.Num() && !It->HasAnyFlags(RF_Transient)) {
+			Structs.Add(*It);
+		}
+	}
+
+	//Parallel disassembly should produce exactly the same output as the sequential one, no matter how work is scheduled
+	const TArray<FString> SequentialScriptTexts = DisassembleScriptsAsText(Structs, false);
+	for (int32 Iteration = 0; Iteration < 3; Iteration++) {
+		const TArray<FString> ParallelScriptTexts = DisassembleScriptsAsText(Structs, true);
+
+		for (int32 StructIndex = 0; StructIndex < Structs.Num(); StructIndex++) {
+			if (!ParallelScriptTexts[StructIndex].Equals(SequentialScriptTexts[StructIndex], ESearchCase::CaseSensitive)) {
+				AddError(FString::Printf(TEXT("Parallel disassembly of %s differs from the sequential one"), *Structs[StructIndex]->GetPathName()));
+				return false;
+			}
+		}
+	}
+	AddInfo(FString::Printf(TEXT("Disassembled %d functions identically"), Structs.Num()));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeDisassemblerManyFunctionsBenchmark, "AssetDumper.KismetBytecodeDisassembler.ManyFunctionsBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FKismetBytecodeDisassemblerManyFunctionsBenchmark::RunTest(const FString& Parameters) {
+	const int32 NumFunctions = 512;
+	const int32 NumIterations = 5;
+
+	//Struct declaring a lot of functions with a few kilobytes of bytecode each, like a large blueprint class
+	UStruct* Struct = NewObject<UStruct>(GetTransientPackage(), NAME_None, RF_Transient);
+	for (int32 FunctionIndex = 0; FunctionIndex < NumFunctions; FunctionIndex++) {
+		UFunction* Function = NewObject<UFunction>(Struct, NAME_None, RF_Transient);
+		for (int32 i = 0; i < 32; i++) {
+			Function->Script.Append(MakeTestScript(FunctionIndex * 32 + i));
+		}
+		Function->Next = Struct->Children;
+		Struct->Children = Function;
+	}
+
+	UPropertySerializer* PropertySerializer = NewObject<UPropertySerializer>();
+	UObjectHierarchySerializer* ObjectHierarchySerializer = NewObject<UObjectHierarchySerializer>();
+	ObjectHierarchySerializer->SetPropertySerializer(PropertySerializer);
+
+	//Serializes the struct the same way the blueprint serializer does, either disassembling functions in parallel or on this thread
+	FString StructTexts[2];
+	double StructTimes[2];
+	for (const bool bForceSingleThread : {true, false}) {
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+			ObjectHierarchySerializer->InitializeForSerialization(GetTransientPackage());
+			const TSharedRef<FJsonObject> StructObject = MakeShareable(new FJsonObject());
+			FAssetHelper::SerializeStruct(StructObject, Struct, ObjectHierarchySerializer, NULL, bForceSingleThread);
+			ObjectHierarchySerializer->Reset();
+
+			if (Iteration == 0) {
+				const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&StructTexts[bForceSingleThread]);
+				FJsonSerializer::Serialize(StructObject, Writer);
+			}
+		}
+		StructTimes[bForceSingleThread] = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+	}
+
+	TestTrue(TEXT("Parallel disassembly produces the same struct as the single threaded one"), StructTexts[0].Equals(StructTexts[1], ESearchCase::CaseSensitive));
+	AddInfo(FString::Printf(TEXT("Serialized struct with %d functions in %.2fms single threaded and %.2fms in parallel (%.2fx)"),
+		NumFunctions, StructTimes[1] * 1000.0, StructTimes[0] * 1000.0, StructTimes[1] / FMath::Max(StructTimes[0], SMALL_NUMBER)));
+
+	PropertySerializer->MarkPendingKill();
+	ObjectHierarchySerializer->MarkPendingKill();
+	return true;
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include "Toolkit/AssetTypes/MeshDumpFormat.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Builds small skinned mesh with two LODs, vertex colors and two UV channels, covering every optional part of the format */
+static FDumpedMeshData MakeTestMeshData() {
+	FDumpedMeshData MeshData;
+	MeshData.MaterialSlotNames.Add(TEXT("Body"));
+	MeshData.MaterialSlotNames.Add(TEXT("Head"));
+
+	FDumpedMeshBone& RootBone = MeshData.Bones.AddDefaulted_GetRef();
+	RootBone.Name = TEXT("root");
+	RootBone.ParentIndex = INDEX_NONE;
+	RootBone.Pose = FTransform::Identity;
+
+	FDumpedMeshBone& ChildBone = MeshData.Bones.AddDefaulted_GetRef();
+	ChildBone.Name = TEXT("spine_01");
+	ChildBone.ParentIndex = 0;
+	ChildBone.Pose = FTransform(FQuat(FVector::UpVector, 0.5f), FVector(0.0f, 0.0f, 42.0f), FVector(1.0f, 1.0f, 2.0f));
+
+	for (int32 LODIndex = 0; LODIndex < 2; LODIndex++) {
+		FDumpedMeshLOD& LOD = MeshData.LODs.AddDefaulted_GetRef();
+		LOD.ScreenSize = 1.0f / (LODIndex + 1);
+		LOD.NumInfluencesPerVertex = 2;
+		LOD.TexCoords.SetNum(2);
+
+		const int32 NumVertices = 6 - LODIndex * 3;
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++) {
+			LOD.Positions.Add(FVector(VertexIndex, VertexIndex * 2.0f, -VertexIndex));
+			LOD.Normals.Add(FVector::UpVector);
+			LOD.Tangents.Add(FVector4(1.0f, 0.0f, 0.0f, VertexIndex % 2 ? -1.0f : 1.0f));
+			LOD.TexCoords[0].Add(FVector2D(VertexIndex * 0.1f, 0.5f));
+			LOD.TexCoords[1].Add(FVector2D(0.25f, VertexIndex * 0.2f));
+			LOD.Colors.Add(FColor(VertexIndex * 10, 20, 30, 255));
+			LOD.Indices.Add(VertexIndex);
+			LOD.InfluenceBones.Add(0);
+			LOD.InfluenceBones.Add(1);
+			LOD.InfluenceWeights.Add(200);
+			LOD.InfluenceWeights.Add(55);
+		}
+		for (int32 SectionIndex = 0; SectionIndex < NumVertices / 3; SectionIndex++) {
+			FDumpedMeshSection& Section = LOD.Sections.AddDefaulted_GetRef();
+			Section.MaterialIndex = SectionIndex % MeshData.MaterialSlotNames.Num();
+			Section.FirstIndex = SectionIndex * 3;
+			Section.NumTriangles = 1;
+		}
+	}
+	return MeshData;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMeshDumpFormatRoundTripTest, "AssetDumper.MeshDumpFormat.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMeshDumpFormatRoundTripTest::RunTest(const FString& Parameters) {
+	const FDumpedMeshData MeshData = MakeTestMeshData();
+	FString ErrorMessage;
+	if (!MeshData.Validate(ErrorMessage)) {
+		AddError(FString::Printf(TEXT("Test mesh data is not valid: %s"), *ErrorMessage));
+		return false;
+	}
+
+	TArray<uint8> SavedBytes;
+	MeshData.SaveToBytes(SavedBytes);
+
+	FDumpedMeshData LoadedMeshData;
+	if (!LoadedMeshData.LoadFromBytes(SavedBytes, ErrorMessage)) {
+		AddError(FString::Printf(TEXT("Failed to load saved mesh data: %s"), *ErrorMessage));
+		return false;
+	}
+
+	TestEqual(TEXT("Material slot names"), LoadedMeshData.MaterialSlotNames, MeshData.MaterialSlotNames);
+	TestEqual(TEXT("LOD count"), LoadedMeshData.LODs.Num(), MeshData.LODs.Num());
+	TestEqual(TEXT("Bone count"), LoadedMeshData.Bones.Num(), MeshData.Bones.Num());
+	TestEqual(TEXT("Bone name"), LoadedMeshData.Bones[1].Name, MeshData.Bones[1].Name);
+	TestTrue(TEXT("Bone pose"), LoadedMeshData.Bones[1].Pose.Equals(MeshData.Bones[1].Pose, 0.0f));
+
+	for (int32 LODIndex = 0; LODIndex < FMath::Min(LoadedMeshData.LODs.Num(), MeshData.LODs.Num()); LODIndex++) {
+		const FDumpedMeshLOD& LoadedLOD = LoadedMeshData.LODs[LODIndex];
+		const FDumpedMeshLOD& LOD = MeshData.LODs[LODIndex];
+		TestEqual(TEXT("Screen size"), LoadedLOD.ScreenSize, LOD.ScreenSize);
+		TestEqual(TEXT("Positions"), LoadedLOD.Positions, LOD.Positions);
+		TestEqual(TEXT("Texture coordinates"), LoadedLOD.TexCoords[1], LOD.TexCoords[1]);
+		TestEqual(TEXT("Colors"), LoadedLOD.Colors, LOD.Colors);
+		TestEqual(TEXT("Indices"), LoadedLOD.Indices, LOD.Indices);
+		TestEqual(TEXT("Section count"), LoadedLOD.Sections.Num(), LOD.Sections.Num());
+		TestEqual(TEXT("Influence bones"), LoadedLOD.InfluenceBones, LOD.InfluenceBones);
+		TestEqual(TEXT("Influence weights"), LoadedLOD.InfluenceWeights, LOD.InfluenceWeights);
+	}
+
+	//Saving the loaded data again should produce identical bytes, so the file hash stays stable across dumps
+	TArray<uint8> ResavedBytes;
+	LoadedMeshData.SaveToBytes(ResavedBytes);
+	TestTrue(TEXT("Re-saved mesh data is identical"), ResavedBytes == SavedBytes);
+	TestEqual(TEXT("File hash"), FDumpedMeshData::ComputeFileHash(ResavedBytes), FDumpedMeshData::ComputeFileHash(SavedBytes));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMeshDumpFormatMalformedDataTest, "AssetDumper.MeshDumpFormat.MalformedData", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMeshDumpFormatMalformedDataTest::RunTest(const FString& Parameters) {
+	TArray<uint8> SavedBytes;
+	MakeTestMeshData().SaveToBytes(SavedBytes);
+	FString ErrorMessage;
+
+	//Every truncation of the file should be rejected instead of producing partially loaded data
+	for (int32 TruncatedSize = 0; TruncatedSize < SavedBytes.Num(); TruncatedSize++) {
+		const TArray<uint8> TruncatedBytes(SavedBytes.GetData(), TruncatedSize);
+		FDumpedMeshData LoadedMeshData;
+		if (LoadedMeshData.LoadFromBytes(TruncatedBytes, ErrorMessage)) {
+			AddError(FString::Printf(TEXT("Mesh data truncated to %d out of %d bytes was loaded successfully"), TruncatedSize, SavedBytes.Num()));
+			return false;
+		}
+	}
+
+	TArray<uint8> TrailingBytes = SavedBytes;
+	TrailingBytes.Add(0);
+	FDumpedMeshData TrailingMeshData;
+	TestFalse(TEXT("Mesh data with trailing bytes is rejected"), TrailingMeshData.LoadFromBytes(TrailingBytes, ErrorMessage));
+
+	TArray<uint8> WrongMagicBytes = SavedBytes;
+	WrongMagicBytes[0] ^= 0xFF;
+	FDumpedMeshData WrongMagicMeshData;
+	TestFalse(TEXT("Mesh data with wrong magic is rejected"), WrongMagicMeshData.LoadFromBytes(WrongMagicBytes, ErrorMessage));
+
+	FDumpedMeshData InvalidMaterialMeshData = MakeTestMeshData();
+	InvalidMaterialMeshData.LODs[0].Sections[0].MaterialIndex = InvalidMaterialMeshData.MaterialSlotNames.Num();
+	TArray<uint8> InvalidMaterialBytes;
+	InvalidMaterialMeshData.SaveToBytes(InvalidMaterialBytes);
+
+	FDumpedMeshData LoadedInvalidMaterialMeshData;
+	TestFalse(TEXT("Mesh data with out of range material index is rejected"), LoadedInvalidMaterialMeshData.LoadFromBytes(InvalidMaterialBytes, ErrorMessage));
+	return true;
+}
+
+#endif
@@ -0,0 +1,175 @@
+#include "Util/PackageNameMatcher.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPackageNameMatcherExactNamesTest, "AssetDumper.PackageNameMatcher.ExactNames", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPackageNameMatcherExactNamesTest::RunTest(const FString& Parameters) {
+	FPackageNameMatcher Matcher;
+	TestTrue(TEXT("New matcher is empty"), Matcher.IsEmpty());
+	TestFalse(TEXT("Empty matcher matches nothing"), Matcher.Matches(FName(TEXT("/Game/Path/Package"))));
+
+	Matcher.AddRule(TEXT("/Game/Path/Package"));
+	TestEqual(TEXT("Rule without trailing / is an exact name"), Matcher.GetNumPackageNames(), 1);
+	TestEqual(TEXT("Rule without trailing / is not a path"), Matcher.GetNumPackagePaths(), 0);
+
+	TestTrue(TEXT("Exact name"), Matcher.Matches(FName(TEXT("/Game/Path/Package"))));
+	TestTrue(TEXT("Exact name as string"), Matcher.Matches(FString(TEXT("/Game/Path/Package"))));
+	TestTrue(TEXT("Exact name ignores case, same as FName"), Matcher.Matches(FString(TEXT("/game/path/PACKAGE"))));
+	TestFalse(TEXT("Exact name does not match longer names"), Matcher.Matches(FString(TEXT("/Game/Path/Package2"))));
+	TestFalse(TEXT("Exact name does not match packages under it"), Matcher.Matches(FString(TEXT("/Game/Path/Package/Other"))));
+	TestFalse(TEXT("Exact name does not match it's parent"), Matcher.Matches(FString(TEXT("/Game/Path"))));
+	TestFalse(TEXT("Name that has never been an FName"), Matcher.Matches(FString(TEXT("/Game/Path/PackageNameMatcherNeverRegisteredName"))));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPackageNameMatcherPackagePathsTest, "AssetDumper.PackageNameMatcher.PackagePaths", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPackageNameMatcherPackagePathsTest::RunTest(const FString& Parameters) {
+	FPackageNameMatcher Matcher;
+	Matcher.AddRule(TEXT("/Game/Path/"));
+	Matcher.AddRule(TEXT("/Game/Path/Sub/"));
+	Matcher.AddPackagePath(TEXT("/Engine/Deep/Nested/Path"));
+	TestEqual(TEXT("Rules ending with / are paths"), Matcher.GetNumPackagePaths(), 3);
+	TestEqual(TEXT("Rules ending with / are not exact names"), Matcher.GetNumPackageNames(), 0);
+
+	//Wildcard paths match every package under them, at any depth
+	TestTrue(TEXT("Package directly under the path"), Matcher.Matches(FString(TEXT("/Game/Path/Package"))));
+	TestTrue(TEXT("Package in the sub path"), Matcher.Matches(FString(TEXT("/Game/Path/Sub/Package"))));
+	TestTrue(TEXT("Package deep under the path"), Matcher.Matches(FString(TEXT("/Game/Path/A/B/C/Package"))));
+	TestTrue(TEXT("Path without trailing /"), Matcher.Matches(FString(TEXT("/Engine/Deep/Nested/Path/Package"))));
+	TestTrue(TEXT("Path ignores case"), Matcher.Matches(FString(TEXT("/game/PATH/Package"))));
+	TestTrue(TEXT("Path as FName"), Matcher.Matches(FName(TEXT("/Game/Path/Package"))));
+
+	//Paths are matched by whole segments, unlike plain prefix comparison
+	TestFalse(TEXT("Package named like the path"), Matcher.Matches(FString(TEXT("/Game/Path"))));
+	TestFalse(TEXT("Sibling path sharing the prefix"), Matcher.Matches(FString(TEXT("/Game/PathOther/Package"))));
+	TestFalse(TEXT("Parent of the path"), Matcher.Matches(FString(TEXT("/Game/Package"))));
+	TestFalse(TEXT("Partially matching deep path"), Matcher.Matches(FString(TEXT("/Engine/Deep/Package"))));
+	TestFalse(TEXT("Package in unrelated root"), Matcher.Matches(FString(TEXT("/Other/Path/Package"))));
+
+	//Registering the same path twice is not counted twice
+	Matcher.AddPackagePath(TEXT("/Game/Path/"));
+	TestEqual(TEXT("Duplicate path"), Matcher.GetNumPackagePaths(), 3);
+
+	//Root path matches every package
+	FPackageNameMatcher RootMatcher;
+	RootMatcher.AddRule(TEXT("/"));
+	TestTrue(TEXT("Root path matches everything"), RootMatcher.Matches(FString(TEXT("/Game/Any/Package"))));
+	return true;
+}
+
+/** Matches the package the way the linear scan replaced by the trie did, used as a reference */
+static bool MatchesLinearScan(const FString& PackageName, const TSet<FString>& PackageNames, const TArray<FString>& PackagePaths) {
+	if (PackageNames.Contains(PackageName)) {
+		return true;
+	}
+	for (const FString& PackagePath : PackagePaths) {
+		if (PackageName.StartsWith(PackagePath)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Generates rules and package names on a fixed set of directories, so a part of the packages hits the rules */
+static void GenerateMatcherData(FRandomStream& RandomStream, const int32 NumRules, const int32 NumPackages, TSet<FString>& OutPackageNames, TArray<FString>& OutPackagePaths, TArray<FString>& OutPackagesToMatch) {
+	const int32 NumDirectories = FMath::Max(NumRules, 16);
+	auto MakePackagePath = [&]() {
+		return FString::Printf(TEXT("/Game/Directory%d/Sub%d/"), RandomStream.RandRange(0, NumDirectories - 1), RandomStream.RandRange(0, 3));
+	};
+
+	for (int32 i = 0; i < NumRules; i++) {
+		if (RandomStream.FRand() < 0.5f) {
+			OutPackagePaths.Add(MakePackagePath());
+		} else {
+			OutPackageNames.Add(MakePackagePath() + FString::Printf(TEXT("Package%d"), RandomStream.RandRange(0, 7)));
+		}
+	}
+	for (int32 i = 0; i < NumPackages; i++) {
+		FString PackageName = MakePackagePath();
+		if (RandomStream.FRand() < 0.3f) {
+			PackageName.Append(FString::Printf(TEXT("Nested%d/"), RandomStream.RandRange(0, 3)));
+		}
+		PackageName.Append(FString::Printf(TEXT("Package%d"), RandomStream.RandRange(0, 7)));
+		OutPackagesToMatch.Add(PackageName);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPackageNameMatcherLinearScanEquivalenceTest, "AssetDumper.PackageNameMatcher.LinearScanEquivalence", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPackageNameMatcherLinearScanEquivalenceTest::RunTest(const FString& Parameters) {
+	FRandomStream RandomStream(0x3A7C);
+	TSet<FString> PackageNames;
+	TArray<FString> PackagePaths;
+	TArray<FString> PackagesToMatch;
+	GenerateMatcherData(RandomStream, 200, 5000, PackageNames, PackagePaths, PackagesToMatch);
+
+	FPackageNameMatcher Matcher;
+	for (const FString& PackageName : PackageNames) {
+		Matcher.AddRule(PackageName);
+	}
+	for (const FString& PackagePath : PackagePaths) {
+		Matcher.AddRule(PackagePath);
+	}
+
+	int32 NumMatched = 0;
+	for (const FString& PackageName : PackagesToMatch) {
+		const bool bExpected = MatchesLinearScan(PackageName, PackageNames, PackagePaths);
+		if (Matcher.Matches(PackageName) != bExpected || Matcher.Matches(FName(*PackageName)) != bExpected) {
+			AddError(FString::Printf(TEXT("Package %s is %s by the linear scan, but not by the matcher"), *PackageName, bExpected ? TEXT("matched") : TEXT("not matched")));
+			return false;
+		}
+		NumMatched += bExpected ? 1 : 0;
+	}
+	//Make sure the generated data covers both outcomes
+	TestTrue(TEXT("Some packages are matched"), NumMatched > 0);
+	TestTrue(TEXT("Some packages are not matched"), NumMatched < PackagesToMatch.Num());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPackageNameMatcherBenchmark, "AssetDumper.PackageNameMatcher.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FPackageNameMatcherBenchmark::RunTest(const FString& Parameters) {
+	const int32 NumRules = 10000;
+	const int32 NumPackages = 200000;
+	//Linear scan over all of the path rules is too slow to run on every package, so it is sampled and extrapolated
+	const int32 NumLinearScanPackages = 2000;
+
+	FRandomStream RandomStream(0xBE4C);
+	TSet<FString> PackageNames;
+	TArray<FString> PackagePaths;
+	TArray<FString> PackagesToMatch;
+	GenerateMatcherData(RandomStream, NumRules, NumPackages, PackageNames, PackagePaths, PackagesToMatch);
+
+	double StartTime = FPlatformTime::Seconds();
+	FPackageNameMatcher Matcher;
+	for (const FString& PackageName : PackageNames) {
+		Matcher.AddRule(PackageName);
+	}
+	for (const FString& PackagePath : PackagePaths) {
+		Matcher.AddRule(PackagePath);
+	}
+	const double BuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+	int32 NumMatched = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (const FString& PackageName : PackagesToMatch) {
+		NumMatched += Matcher.Matches(PackageName) ? 1 : 0;
+	}
+	const double MatcherSeconds = FPlatformTime::Seconds() - StartTime;
+
+	int32 NumMatchedLinearScan = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumLinearScanPackages; i++) {
+		NumMatchedLinearScan += MatchesLinearScan(PackagesToMatch[i], PackageNames, PackagePaths) ? 1 : 0;
+	}
+	const double LinearScanSeconds = (FPlatformTime::Seconds() - StartTime) * NumPackages / NumLinearScanPackages;
+
+	AddInfo(FString::Printf(TEXT("%d rules (%d paths), %d packages (%d matched): building matcher %.2fms, matching %.2fms, linear scan %.2fms (extrapolated from %d packages, %d matched)"),
+		NumRules, PackagePaths.Num(), NumPackages, NumMatched, BuildSeconds * 1000.0, MatcherSeconds * 1000.0, LinearScanSeconds * 1000.0, NumLinearScanPackages, NumMatchedLinearScan));
+	return true;
+}
+
+#endif
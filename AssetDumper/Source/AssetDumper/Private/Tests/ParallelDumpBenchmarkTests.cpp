@@ -0,0 +1,91 @@
+#include "Toolkit/AssetDumping/AssetDumpProcessor.h"
+#include "AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Toolkit/AssetDumping/AssetDumpIndex.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#define BENCHMARK_ASSETS_PER_CLASS 25
+
+/** Collects fixed set of engine content assets of the classes dumped using snapshots, sorted so every run dumps the same assets */
+static void CollectBenchmarkAssets(TArray<FAssetData>& OutAssets) {
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	for (const TCHAR* AssetClass : {TEXT("StaticMesh"), TEXT("SkeletalMesh"), TEXT("Skeleton"), TEXT("AnimSequence")}) {
+		FARFilter Filter;
+		Filter.PackagePaths.Add(TEXT("/Engine"));
+		Filter.ClassNames.Add(AssetClass);
+		Filter.bRecursivePaths = true;
+
+		TArray<FAssetData> ClassAssets;
+		AssetRegistry.GetAssets(Filter, ClassAssets);
+		ClassAssets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+		
+		for (int32 i = 0; i < FMath::Min(ClassAssets.Num(), BENCHMARK_ASSETS_PER_CLASS); i++) {
+			OutAssets.Add(ClassAssets[i]);
+		}
+	}
+}
+
+/** Dumps provided assets into the directory by ticking the dump processor until it finishes, returning time spent serializing them */
+static double RunBenchmarkDump(const TArray<FAssetData>& Assets, const FString& RootDirectory, const bool bForceSingleThread) {
+	IFileManager::Get().DeleteDirectory(*RootDirectory, false, true);
+	
+	FAssetDumpSettings Settings;
+	Settings.RootDumpDirectory = RootDirectory;
+	Settings.bForceSingleThread = bForceSingleThread;
+	Settings.MaxPackagesToProcessInOneTick = Assets.Num();
+	Settings.GarbageCollectionInterval = MAX_flt;
+
+	const TSharedRef<FAssetDumpProcessor> DumpProcessor = FAssetDumpProcessor::StartAssetDump(Settings, Assets);
+	while (!DumpProcessor->IsFinishedDumping()) {
+		FlushAsyncLoading();
+		DumpProcessor->Tick(0.0f);
+	}
+	return DumpProcessor->GetTimeSpentSerializingParallel();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelDumpBenchmarkTest, "AssetDumper.ParallelDump.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FParallelDumpBenchmarkTest::RunTest(const FString& Parameters) {
+	if (!TestFalse(TEXT("No other asset dump is in progress"), FAssetDumpProcessor::GetActiveDumpProcessor().IsValid())) {
+		return false;
+	}
+	TArray<FAssetData> Assets;
+	CollectBenchmarkAssets(Assets);
+	if (!TestTrue(TEXT("Engine content has assets to dump"), Assets.Num() != 0)) {
+		return false;
+	}
+	
+	//Load assets upfront, so both runs only measure the serialization
+	for (const FAssetData& AssetData : Assets) {
+		AssetData.GetPackage();
+	}
+	
+	const FString SerialRootDirectory = FPaths::AutomationTransientDir() / TEXT("ParallelDumpBenchmark/Serial");
+	const FString ParallelRootDirectory = FPaths::AutomationTransientDir() / TEXT("ParallelDumpBenchmark/Parallel");
+	const double SerialTime = RunBenchmarkDump(Assets, SerialRootDirectory, true);
+	const double ParallelTime = RunBenchmarkDump(Assets, ParallelRootDirectory, false);
+
+	AddInfo(FString::Printf(TEXT("Serialized %d assets in %.2f ms single threaded and %.2f ms in parallel (%.2fx)"),
+		Assets.Num(), SerialTime * 1000.0, ParallelTime * 1000.0, SerialTime / FMath::Max(ParallelTime, SMALL_NUMBER)));
+
+	//Parallel dumping has to produce exactly the same files
+	const TSharedPtr<FAssetDumpIndex> SerialIndex = FAssetDumpIndex::LoadFromDumpDirectory(SerialRootDirectory);
+	const TSharedPtr<FAssetDumpIndex> ParallelIndex = FAssetDumpIndex::LoadFromDumpDirectory(ParallelRootDirectory);
+	if (TestTrue(TEXT("Both dumps have been indexed"), SerialIndex.IsValid() && ParallelIndex.IsValid())) {
+		TestEqual(TEXT("Both dumps contain the same assets"), ParallelIndex->GetEntries().Num(), SerialIndex->GetEntries().Num());
+
+		for (const TPair<FName, FAssetDumpIndexEntry>& Pair : SerialIndex->GetEntries()) {
+			const FAssetDumpIndexEntry* ParallelEntry = ParallelIndex->FindEntry(Pair.Key);
+			TestTrue(FString::Printf(TEXT("Parallel dump of %s matches"), *Pair.Key.ToString()), ParallelEntry != NULL && ParallelEntry->ContentHash == Pair.Value.ContentHash);
+		}
+	}
+	IFileManager::Get().DeleteDirectory(*(FPaths::AutomationTransientDir() / TEXT("ParallelDumpBenchmark")), false, true);
+	return true;
+}
+
+#endif
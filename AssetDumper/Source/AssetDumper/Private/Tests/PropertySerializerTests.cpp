@@ -0,0 +1,121 @@
+#include "Toolkit/PropertySerializer.h"
+#include "Engine/EngineTypes.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#define EXACT_DOUBLE_INTEGER_LIMIT (1ll << 53)
+
+/** Boundary value along with the description used in the test messages */
+template<typename T>
+struct FInt64TestValue {
+	T Value;
+	const TCHAR* Description;
+};
+
+/** Returns the first reflected property of the given type among the candidates, which can be struct members or function parameters */
+template<typename PropertyType>
+static UProperty* FindReflectedProperty(const TArray<TPair<UStruct*, FName>>& Candidates) {
+	for (const TPair<UStruct*, FName>& Candidate : Candidates) {
+		UProperty* Property = Candidate.Key ? Candidate.Key->FindPropertyByName(Candidate.Value) : NULL;
+		if (Property != NULL && Property->IsA<PropertyType>()) {
+			return Property;
+		}
+	}
+	return NULL;
+}
+
+/** Writes the value into the JSON text and parses it back, the same way it goes through the dump file. Returns the written text too */
+static TSharedPtr<FJsonValue> RoundTripThroughJsonText(const TSharedRef<FJsonValue>& Value, FString& OutJsonText) {
+	const TSharedRef<FJsonObject> RootObject = MakeShareable(new FJsonObject());
+	RootObject->SetField(TEXT("Value"), Value);
+	
+	OutJsonText.Reset();
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutJsonText);
+	FJsonSerializer::Serialize(RootObject, Writer);
+
+	TSharedPtr<FJsonObject> ParsedObject;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(OutJsonText), ParsedObject) || !ParsedObject.IsValid()) {
+		return NULL;
+	}
+	return ParsedObject->TryGetField(TEXT("Value"));
+}
+
+/**
+ * Dumps the 64-bit value, reads it back like the generator does and dumps the read value again
+ * Checks that the value survives, that the generator sees it as up to date, and that the second dump does not differ from the first one
+ */
+template<typename T>
+static void TestInt64RoundTrip(FAutomationTestBase& Test, UPropertySerializer* PropertySerializer, UProperty* Property, const T OriginalValue, const FString& ValueDescription) {
+	FString DumpedJsonText;
+	const TSharedRef<FJsonValue> DumpedValue = PropertySerializer->SerializePropertyValue(Property, &OriginalValue);
+	const TSharedPtr<FJsonValue> ParsedValue = RoundTripThroughJsonText(DumpedValue, DumpedJsonText);
+	if (!Test.TestTrue(FString::Printf(TEXT("%s is parsed"), *ValueDescription), ParsedValue.IsValid())) {
+		return;
+	}
+
+	//Values doubles cannot represent exactly are written as strings, others stay plain numbers
+	const bool bExpectString = OriginalValue > (T) EXACT_DOUBLE_INTEGER_LIMIT || (TIsSigned<T>::Value && (int64) OriginalValue < -EXACT_DOUBLE_INTEGER_LIMIT);
+	Test.TestTrue(FString::Printf(TEXT("%s is written as %s"), *ValueDescription, bExpectString ? TEXT("string") : TEXT("number")), ParsedValue->Type == (bExpectString ? EJson::String : EJson::Number));
+
+	T GeneratedValue = 0;
+	PropertySerializer->DeserializePropertyValue(Property, ParsedValue.ToSharedRef(), &GeneratedValue);
+	Test.TestTrue(FString::Printf(TEXT("%s is read back exactly"), *ValueDescription), GeneratedValue == OriginalValue);
+	Test.TestTrue(FString::Printf(TEXT("%s is up to date"), *ValueDescription), PropertySerializer->ComparePropertyValues(Property, ParsedValue.ToSharedRef(), &GeneratedValue));
+
+	//Neighbouring values have to be told apart, otherwise changed values would be treated as up to date
+	const T NeighbourValue = OriginalValue == TNumericLimits<T>::Max() ? OriginalValue - 1 : OriginalValue + 1;
+	Test.TestFalse(FString::Printf(TEXT("%s differs from it's neighbour"), *ValueDescription), PropertySerializer->ComparePropertyValues(Property, ParsedValue.ToSharedRef(), &NeighbourValue));
+
+	FString RedumpedJsonText;
+	RoundTripThroughJsonText(PropertySerializer->SerializePropertyValue(Property, &GeneratedValue), RedumpedJsonText);
+	Test.TestEqual(FString::Printf(TEXT("Re-dumping %s produces no diff"), *ValueDescription), RedumpedJsonText, DumpedJsonText);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPropertySerializerInt64RoundTripTest, "AssetDumper.PropertySerializer.Int64RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPropertySerializerInt64RoundTripTest::RunTest(const FString& Parameters) {
+	//Reflected 64-bit properties of the engine types, values are passed as plain integers so only their types matter
+	UProperty* Int64Property = FindReflectedProperty<UInt64Property>({
+		TPair<UStruct*, FName>(TBaseStructure<FDateTime>::Get(), TEXT("Ticks")),
+		TPair<UStruct*, FName>(UKismetMathLibrary::StaticClass()->FindFunctionByName(TEXT("Conv_IntToInt64")), TEXT("ReturnValue"))});
+	UProperty* UInt64Property = FindReflectedProperty<UUInt64Property>({
+		TPair<UStruct*, FName>(FTimerHandle::StaticStruct(), TEXT("Handle"))});
+	if (!TestTrue(TEXT("64-bit properties are found"), Int64Property != NULL && UInt64Property != NULL)) {
+		return false;
+	}
+	UPropertySerializer* PropertySerializer = NewObject<UPropertySerializer>();
+
+	const int64 ExactLimit = EXACT_DOUBLE_INTEGER_LIMIT;
+	const TArray<FInt64TestValue<int64>> SignedValues = {
+		{0, TEXT("0")}, {-1, TEXT("-1")},
+		{ExactLimit - 1, TEXT("2^53-1")}, {-(ExactLimit - 1), TEXT("-(2^53-1)")},
+		{ExactLimit, TEXT("2^53")}, {-ExactLimit, TEXT("-2^53")},
+		{ExactLimit + 1, TEXT("2^53+1")}, {-(ExactLimit + 1), TEXT("-(2^53+1)")},
+		{MAX_int64, TEXT("INT64_MAX")}, {MIN_int64, TEXT("INT64_MIN")}, {MIN_int64 + 1, TEXT("INT64_MIN+1")}
+	};
+	for (const FInt64TestValue<int64>& Value : SignedValues) {
+		TestInt64RoundTrip<int64>(*this, PropertySerializer, Int64Property, Value.Value, FString::Printf(TEXT("int64 %s"), Value.Description));
+	}
+
+	const TArray<FInt64TestValue<uint64>> UnsignedValues = {
+		{0, TEXT("0")}, {(uint64) ExactLimit, TEXT("2^53")}, {(uint64) ExactLimit + 1, TEXT("2^53+1")},
+		{(uint64) MAX_int64, TEXT("INT64_MAX")}, {(uint64) MAX_int64 + 1, TEXT("2^63")}, {MAX_uint64, TEXT("UINT64_MAX")}
+	};
+	for (const FInt64TestValue<uint64>& Value : UnsignedValues) {
+		TestInt64RoundTrip<uint64>(*this, PropertySerializer, UInt64Property, Value.Value, FString::Printf(TEXT("uint64 %s"), Value.Description));
+	}
+
+	//Older dumps wrote every value as a number, they are still read as numbers
+	int64 LegacyValue = 0;
+	PropertySerializer->DeserializePropertyValue(Int64Property, MakeShareable(new FJsonValueNumber((double) -ExactLimit)), &LegacyValue);
+	TestTrue(TEXT("Legacy number value is read"), LegacyValue == -ExactLimit);
+
+	PropertySerializer->MarkPendingKill();
+	return true;
+}
+
+#endif
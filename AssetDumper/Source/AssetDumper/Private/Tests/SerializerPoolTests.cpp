@@ -0,0 +1,180 @@
+#include "Toolkit/AssetDumping/SerializerPool.h"
+#include "Curves/CurveFloat.h"
+#include "Misc/AutomationTest.h"
+#include "Toolkit/ObjectHierarchySerializer.h"
+#include "Toolkit/PropertySerializer.h"
+#include "Toolkit/AssetTypes/AssetTypeSerializer.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Creates float curve asset with a single key and a subobject, so it's dump has both exported and imported objects in the hierarchy */
+static UCurveFloat* CreateTestCurveAsset(const FString& PackageName, const float KeyValue) {
+	UPackage* Package = CreatePackage(
+#if ENGINE_MINOR_VERSION < 26
+	nullptr,
+#endif
+	*PackageName);
+	Package->SetFlags(RF_Transient);
+	
+	UCurveFloat* Curve = NewObject<UCurveFloat>(Package, FPackageName::GetShortFName(PackageName), RF_Public | RF_Transient);
+	Curve->FloatCurve.AddKey(0.0f, KeyValue);
+	NewObject<UCurveFloat>(Curve, TEXT("InnerCurve"), RF_Transient)->FloatCurve.AddKey(1.0f, KeyValue);
+	return Curve;
+}
+
+/** Dumps the asset the same way serialization context and asset type serializer do it, returning the resulting JSON */
+static FString DumpTestAsset(const FPooledSerializers& Serializers, UObject* Asset) {
+	UObjectHierarchySerializer* ObjectSerializer = Serializers.ObjectHierarchySerializer;
+	ObjectSerializer->InitializeForSerialization(Asset->GetOutermost());
+	ObjectSerializer->SetObjectMark(Asset, TEXT("$AssetObject$"));
+
+	const TSharedRef<FJsonObject> RootObject = MakeShareable(new FJsonObject());
+	const TSharedRef<FJsonObject> AssetObjectData = MakeShareable(new FJsonObject());
+	ObjectSerializer->SerializeObjectPropertiesIntoObject(Asset, AssetObjectData);
+	RootObject->SetObjectField(TEXT("AssetObjectData"), AssetObjectData);
+
+	TArray<TSharedPtr<FJsonValue>> InnerObjects;
+	ForEachObjectWithOuter(Asset, [&](UObject* InnerObject) {
+		InnerObjects.Add(MakeShareable(new FJsonValueNumber(ObjectSerializer->SerializeObject(InnerObject))));
+	}, false);
+	RootObject->SetArrayField(TEXT("InnerObjects"), InnerObjects);
+	RootObject->SetNumberField(TEXT("AssetClass"), ObjectSerializer->SerializeObject(Asset->GetClass()));
+	RootObject->SetArrayField(TEXT("ObjectHierarchy"), ObjectSerializer->FinalizeSerialization());
+
+	FString ResultString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
+	FJsonSerializer::Serialize(RootObject, Writer);
+	return ResultString;
+}
+
+/** Creates serializers the way the dumper used to do it for every single asset, before the pool existed */
+static FPooledSerializers CreateUnpooledSerializers() {
+	FPooledSerializers Serializers;
+	Serializers.PropertySerializer = NewObject<UPropertySerializer>();
+	Serializers.ObjectHierarchySerializer = NewObject<UObjectHierarchySerializer>();
+	Serializers.ObjectHierarchySerializer->SetPropertySerializer(Serializers.PropertySerializer);
+	return Serializers;
+}
+
+static void DestroyUnpooledSerializers(const FPooledSerializers& Serializers) {
+	Serializers.PropertySerializer->MarkPendingKill();
+	Serializers.ObjectHierarchySerializer->MarkPendingKill();
+}
+
+static int32 CountLiveObjectHierarchySerializers() {
+	int32 NumSerializers = 0;
+	for (TObjectIterator<UObjectHierarchySerializer> It; It; ++It) {
+		NumSerializers++;
+	}
+	return NumSerializers;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSerializerPoolIsolationTest, "AssetDumper.SerializerPool.Isolation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSerializerPoolIsolationTest::RunTest(const FString& Parameters) {
+	UAssetTypeSerializer* CurveSerializer = UAssetTypeSerializer::FindSerializerForAssetClass(UCurveFloat::StaticClass()->GetFName());
+	UAssetTypeSerializer* TextureSerializer = UAssetTypeSerializer::FindSerializerForAssetClass(TEXT("Texture2D"));
+	if (!TestTrue(TEXT("Asset type serializers are registered"), CurveSerializer != NULL && TextureSerializer != NULL)) {
+		return false;
+	}
+	UCurveFloat* FirstAsset = CreateTestCurveAsset(TEXT("/Temp/AssetDumperTests/SerializerPool/FirstCurve"), 1.0f);
+	UCurveFloat* SecondAsset = CreateTestCurveAsset(TEXT("/Temp/AssetDumperTests/SerializerPool/SecondCurve"), 2.0f);
+
+	//Reference dump of the second asset made with the fresh serializers
+	const FPooledSerializers UnpooledSerializers = CreateUnpooledSerializers();
+	const FString ExpectedSecondDump = DumpTestAsset(UnpooledSerializers, SecondAsset);
+	DestroyUnpooledSerializers(UnpooledSerializers);
+
+	FSerializerPool SerializerPool;
+	const FPooledSerializers FirstSerializers = SerializerPool.Acquire(CurveSerializer);
+	const FString FirstDump = DumpTestAsset(FirstSerializers, FirstAsset);
+	SerializerPool.Release(CurveSerializer, FirstSerializers);
+
+	//Object hierarchy serializer forgets everything about the previous asset as soon as it is released
+	UObjectHierarchySerializer* ObjectSerializer = FirstSerializers.ObjectHierarchySerializer;
+	TestEqual(TEXT("No objects are left in the released serializer"), ObjectSerializer->FinalizeSerialization().Num(), 0);
+	TestTrue(TEXT("Package name is cleared"), ObjectSerializer->PackageName.IsEmpty());
+
+	const FPooledSerializers SecondSerializers = SerializerPool.Acquire(CurveSerializer);
+	TestTrue(TEXT("Released serializers are reused for the asset of the same type"), SecondSerializers.ObjectHierarchySerializer == FirstSerializers.ObjectHierarchySerializer &&
+		SecondSerializers.PropertySerializer == FirstSerializers.PropertySerializer);
+	
+	const FString SecondDump = DumpTestAsset(SecondSerializers, SecondAsset);
+	TestEqual(TEXT("Pooled serializers produce the same dump as the fresh ones"), SecondDump, ExpectedSecondDump);
+	TestFalse(TEXT("Dump does not reference the previous asset"), SecondDump.Contains(TEXT("FirstCurve")));
+	TestTrue(TEXT("Previous dump references it's own asset"), FirstDump.Contains(TEXT("FirstCurve")));
+	SerializerPool.Release(CurveSerializer, SecondSerializers);
+
+	//Property serializer configuration done by one asset type serializer is never seen by the assets of other types
+	const FPooledSerializers CurveSerializers = SerializerPool.Acquire(CurveSerializer);
+	UProperty* FloatCurveProperty = UCurveFloat::StaticClass()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(UCurveFloat, FloatCurve));
+	CurveSerializers.PropertySerializer->DisablePropertySerialization(UCurveFloat::StaticClass(), FloatCurveProperty->GetFName());
+	SerializerPool.Release(CurveSerializer, CurveSerializers);
+
+	const FPooledSerializers TextureSerializers = SerializerPool.Acquire(TextureSerializer);
+	TestTrue(TEXT("Serializers are not shared between asset types"), TextureSerializers.PropertySerializer != CurveSerializers.PropertySerializer);
+	TestTrue(TEXT("Blacklist of another asset type is not applied"), TextureSerializers.PropertySerializer->ShouldSerializeProperty(FloatCurveProperty));
+	SerializerPool.Release(TextureSerializer, TextureSerializers);
+	
+	TestEqual(TEXT("Serializers created"), SerializerPool.GetNumCreated(), 2);
+	TestEqual(TEXT("Serializers acquired"), SerializerPool.GetNumAcquired(), 4);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSerializerPoolAllocationTest, "AssetDumper.SerializerPool.AllocationReduction", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSerializerPoolAllocationTest::RunTest(const FString& Parameters) {
+	const int32 NumAssets = 200;
+	const int32 NumParallelAssets = 4;
+	UAssetTypeSerializer* CurveSerializer = UAssetTypeSerializer::FindSerializerForAssetClass(UCurveFloat::StaticClass()->GetFName());
+	if (!TestNotNull(TEXT("Curve serializer"), CurveSerializer)) {
+		return false;
+	}
+	TArray<UCurveFloat*> Assets;
+	for (int32 i = 0; i < NumAssets; i++) {
+		Assets.Add(CreateTestCurveAsset(FString::Printf(TEXT("/Temp/AssetDumperTests/SerializerPoolAllocation/Curve%d"), i), (float) i));
+	}
+
+	//Old behavior, new serializer pair for every single asset
+	const int32 SerializersBeforeUnpooled = CountLiveObjectHierarchySerializers();
+	const double UnpooledStartTime = FPlatformTime::Seconds();
+	TArray<FPooledSerializers> UnpooledSerializers;
+	for (UCurveFloat* Asset : Assets) {
+		UnpooledSerializers.Add(CreateUnpooledSerializers());
+		DumpTestAsset(UnpooledSerializers.Last(), Asset);
+	}
+	const double UnpooledTime = FPlatformTime::Seconds() - UnpooledStartTime;
+	const int32 UnpooledAllocations = CountLiveObjectHierarchySerializers() - SerializersBeforeUnpooled;
+	for (const FPooledSerializers& Serializers : UnpooledSerializers) {
+		DestroyUnpooledSerializers(Serializers);
+	}
+
+	//Pooled serializers, with several assets in flight at once like with the parallel dumping
+	const int32 SerializersBeforePooled = CountLiveObjectHierarchySerializers();
+	const double PooledStartTime = FPlatformTime::Seconds();
+	FSerializerPool SerializerPool;
+	for (int32 FirstAssetIndex = 0; FirstAssetIndex < NumAssets; FirstAssetIndex += NumParallelAssets) {
+		TArray<FPooledSerializers> SerializersInFlight;
+		for (int32 i = FirstAssetIndex; i < FMath::Min(FirstAssetIndex + NumParallelAssets, NumAssets); i++) {
+			SerializersInFlight.Add(SerializerPool.Acquire(CurveSerializer));
+			DumpTestAsset(SerializersInFlight.Last(), Assets[i]);
+		}
+		for (const FPooledSerializers& Serializers : SerializersInFlight) {
+			SerializerPool.Release(CurveSerializer, Serializers);
+		}
+	}
+	const double PooledTime = FPlatformTime::Seconds() - PooledStartTime;
+	const int32 PooledAllocations = CountLiveObjectHierarchySerializers() - SerializersBeforePooled;
+
+	AddInfo(FString::Printf(TEXT("%d assets: %d serializer pairs allocated without the pool (%.2f ms), %d with the pool (%.2f ms)"),
+		NumAssets, UnpooledAllocations, UnpooledTime * 1000.0, PooledAllocations, PooledTime * 1000.0));
+
+	TestEqual(TEXT("Unpooled dump allocates serializers for every asset"), UnpooledAllocations, NumAssets);
+	TestEqual(TEXT("Pool only allocates serializers for the assets in flight"), PooledAllocations, NumParallelAssets);
+	TestEqual(TEXT("Pool statistics match the allocations"), SerializerPool.GetNumCreated(), NumParallelAssets);
+	TestEqual(TEXT("Every asset acquired serializers"), SerializerPool.GetNumAcquired(), NumAssets);
+	return true;
+}
+
+#endif
@@ -0,0 +1,313 @@
+#include "Toolkit/AssetDumping/AssetDumpIndex.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "AssetDumperModule.h"
+
+#define ASSET_DUMP_INDEX_FILE_NAME TEXT("AssetDumpIndex.txt")
+#define ASSET_DUMP_INDEX_HEADER TEXT("AssetDumpIndex")
+#define ASSET_DUMP_INDEX_VERSION 3
+#define ASSET_DUMP_IN_PROGRESS_MARKER_FILE_NAME TEXT("AssetDumpIndex.InProgress")
+
+FAssetDumpIndexEntry::FAssetDumpIndexEntry() : FileSize(0) {
+}
+
+FAssetDumpIndex::FAssetDumpIndex() : bDirectoryTreeBuilt(false) {
+}
+
+void FAssetDumpIndex::AddEntry(const FAssetDumpIndexEntry& Entry) {
+	FScopeLock ScopeLock(&EntriesCriticalSection);
+	this->Entries.Add(Entry.PackageName, Entry);
+	this->bDirectoryTreeBuilt = false;
+}
+
+void FAssetDumpIndex::AddMissingEntries(const FAssetDumpIndex& OtherIndex) {
+	FScopeLock ScopeLock(&EntriesCriticalSection);
+	FScopeLock OtherScopeLock(&OtherIndex.EntriesCriticalSection);
+	
+	for (const TPair<FName, FAssetDumpIndexEntry>& Pair : OtherIndex.Entries) {
+		if (!Entries.Contains(Pair.Key)) {
+			this->Entries.Add(Pair.Key, Pair.Value);
+		}
+	}
+	this->bDirectoryTreeBuilt = false;
+}
+
+const FAssetDumpIndexEntry* FAssetDumpIndex::FindEntry(const FName PackageName) const {
+	return Entries.Find(PackageName);
+}
+
+static FString GetParentPackagePath(const FString& PackagePath) {
+	const int32 LastSlashIndex = PackagePath.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	if (LastSlashIndex <= 0) {
+		return TEXT("/");
+	}
+	return PackagePath.Left(LastSlashIndex);
+}
+
+void FAssetDumpIndex::BuildDirectoryTree() const {
+	FScopeLock ScopeLock(&EntriesCriticalSection);
+	if (bDirectoryTreeBuilt) {
+		return;
+	}
+	this->ChildDirectories.Empty();
+	this->DirectoryPackages.Empty();
+	TSet<FString> KnownDirectories;
+
+	for (const TPair<FName, FAssetDumpIndexEntry>& Pair : Entries) {
+		FString DirectoryPath = GetParentPackagePath(Pair.Key.ToString());
+		DirectoryPackages.FindOrAdd(DirectoryPath).Add(Pair.Key);
+
+		//Register every directory up to the root as a child of it's parent, stopping at the first one we have seen already
+		while (DirectoryPath != TEXT("/") && !KnownDirectories.Contains(DirectoryPath)) {
+			KnownDirectories.Add(DirectoryPath);
+			const FString ParentPath = GetParentPackagePath(DirectoryPath);
+			ChildDirectories.FindOrAdd(ParentPath).Add(DirectoryPath);
+			DirectoryPath = ParentPath;
+		}
+	}
+
+	//Keep the listings stable regardless of the order entries were added in
+	for (TPair<FString, TArray<FString>>& Pair : ChildDirectories) {
+		Pair.Value.Sort();
+	}
+	for (TPair<FString, TArray<FName>>& Pair : DirectoryPackages) {
+		Pair.Value.Sort([](const FName& A, const FName& B) { return A.ToString() < B.ToString(); });
+	}
+	this->bDirectoryTreeBuilt = true;
+}
+
+const TArray<FString>& FAssetDumpIndex::GetChildDirectories(const FString& PackagePath) const {
+	static const TArray<FString> EmptyDirectoryList;
+	BuildDirectoryTree();
+	const TArray<FString>* FoundDirectories = ChildDirectories.Find(PackagePath);
+	return FoundDirectories ? *FoundDirectories : EmptyDirectoryList;
+}
+
+const TArray<FName>& FAssetDumpIndex::GetDirectoryPackages(const FString& PackagePath) const {
+	static const TArray<FName> EmptyPackageList;
+	BuildDirectoryTree();
+	const TArray<FName>* FoundPackages = DirectoryPackages.Find(PackagePath);
+	return FoundPackages ? *FoundPackages : EmptyPackageList;
+}
+
+FString FAssetDumpIndex::GetIndexFilePath(const FString& RootDirectory) {
+	return FPaths::Combine(RootDirectory, ASSET_DUMP_INDEX_FILE_NAME);
+}
+
+FString FAssetDumpIndex::GetInProgressMarkerFilePath(const FString& RootDirectory) {
+	return FPaths::Combine(RootDirectory, ASSET_DUMP_IN_PROGRESS_MARKER_FILE_NAME);
+}
+
+bool FAssetDumpIndex::IsDumpInProgress(const FString& RootDirectory) {
+	return FPlatformFileManager::Get().GetPlatformFile().FileExists(*GetInProgressMarkerFilePath(RootDirectory));
+}
+
+void FAssetDumpIndex::MarkDumpInProgress(const FString& RootDirectory) {
+	const FString MarkerFilePath = GetInProgressMarkerFilePath(RootDirectory);
+	if (!FFileHelper::SaveStringToFile(FDateTime::Now().ToString(), *MarkerFilePath)) {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to write asset dump marker file %s"), *MarkerFilePath);
+	}
+}
+
+bool FAssetDumpIndex::SaveToDumpDirectory(const FString& RootDirectory, const bool bDumpComplete) const {
+	FScopeLock ScopeLock(&EntriesCriticalSection);
+
+	//Header holds the format version, then there is one tab-separated line per package:
+	//name, class, file size, content hash and semicolon-separated dependencies
+	FString ResultString = FString::Printf(TEXT("%s\t%d"), ASSET_DUMP_INDEX_HEADER, ASSET_DUMP_INDEX_VERSION);
+	ResultString.Append(LINE_TERMINATOR);
+
+	for (const TPair<FName, FAssetDumpIndexEntry>& Pair : Entries) {
+		const FAssetDumpIndexEntry& Entry = Pair.Value;
+		ResultString.Append(Entry.PackageName.ToString()).AppendChar('\t');
+		ResultString.Append(Entry.AssetClass.ToString()).AppendChar('\t');
+		ResultString.Append(FString::Printf(TEXT("%lld"), Entry.FileSize)).AppendChar('\t');
+		ResultString.Append(Entry.ContentHash).AppendChar('\t');
+
+		for (int32 i = 0; i < Entry.DependencyPackages.Num(); i++) {
+			if (i != 0) {
+				ResultString.AppendChar(';');
+			}
+			ResultString.Append(Entry.DependencyPackages[i].ToString());
+		}
+		ResultString.Append(LINE_TERMINATOR);
+	}
+
+	const FString IndexFilePath = GetIndexFilePath(RootDirectory);
+	if (!FFileHelper::SaveStringToFile(ResultString, *IndexFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)) {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to write asset dump index file %s"), *IndexFilePath);
+		return false;
+	}
+	//Marker is only removed once the complete index is on disk, so a crash in between still leaves the dump marked as incomplete
+	if (bDumpComplete) {
+		IFileManager::Get().Delete(*GetInProgressMarkerFilePath(RootDirectory), false, false, true);
+	}
+	UE_LOG(LogAssetDumper, Display, TEXT("Written asset dump index with %d packages to %s"), Entries.Num(), *IndexFilePath);
+	return true;
+}
+
+TSharedPtr<FAssetDumpIndex> FAssetDumpIndex::LoadFromDumpDirectory(const FString& RootDirectory, const bool bAllowDumpInProgress) {
+	const FString IndexFilePath = GetIndexFilePath(RootDirectory);
+	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*IndexFilePath)) {
+		return NULL;
+	}
+
+	//Dumps that have been interrupted or are still running leave the marker behind, and the index misses the packages dumped since the last save
+	if (!bAllowDumpInProgress && IsDumpInProgress(RootDirectory)) {
+		UE_LOG(LogAssetDumper, Warning, TEXT("Asset dump index file %s belongs to the dump that has not finished, it will be ignored"), *IndexFilePath);
+		return NULL;
+	}
+
+	FString IndexFileContents;
+	if (!FFileHelper::LoadFileToString(IndexFileContents, *IndexFilePath)) {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to load asset dump index file %s"), *IndexFilePath);
+		return NULL;
+	}
+
+	TArray<FString> IndexLines;
+	IndexFileContents.ParseIntoArrayLines(IndexLines);
+
+	TArray<FString> HeaderFields;
+	if (IndexLines.Num()) {
+		IndexLines[0].ParseIntoArray(HeaderFields, TEXT("\t"), false);
+	}
+	if (HeaderFields.Num() != 2 || HeaderFields[0] != ASSET_DUMP_INDEX_HEADER || FCString::Atoi(*HeaderFields[1]) != ASSET_DUMP_INDEX_VERSION) {
+		UE_LOG(LogAssetDumper, Warning, TEXT("Asset dump index file %s has unsupported format, it will be ignored"), *IndexFilePath);
+		return NULL;
+	}
+
+	const TSharedRef<FAssetDumpIndex> ResultIndex = MakeShareable(new FAssetDumpIndex());
+	ResultIndex->Entries.Reserve(IndexLines.Num() - 1);
+
+	TArray<FString> LineFields;
+	TArray<FString> DependencyNames;
+
+	for (int32 i = 1; i < IndexLines.Num(); i++) {
+		LineFields.Reset();
+		IndexLines[i].ParseIntoArray(LineFields, TEXT("\t"), false);
+
+		if (LineFields.Num() != 5) {
+			UE_LOG(LogAssetDumper, Warning, TEXT("Malformed line %d in asset dump index file %s, it will be ignored"), i + 1, *IndexFilePath);
+			return NULL;
+		}
+
+		FAssetDumpIndexEntry Entry;
+		Entry.PackageName = *LineFields[0];
+		Entry.AssetClass = *LineFields[1];
+		Entry.FileSize = FCString::Atoi64(*LineFields[2]);
+		Entry.ContentHash = LineFields[3];
+
+		DependencyNames.Reset();
+		LineFields[4].ParseIntoArray(DependencyNames, TEXT(";"), true);
+		for (const FString& DependencyName : DependencyNames) {
+			Entry.DependencyPackages.Add(*DependencyName);
+		}
+		ResultIndex->Entries.Add(Entry.PackageName, MoveTemp(Entry));
+	}
+	return ResultIndex;
+}
+
+TSharedPtr<FAssetDumpIndex> FAssetDumpIndex::LoadOrRebuildFromDumpDirectory(const FString& RootDirectory) {
+	TSharedPtr<FAssetDumpIndex> LoadedIndex = LoadFromDumpDirectory(RootDirectory);
+
+	//Index file exists but cannot be used, so replace it with the one reflecting the current state of the directory
+	if (!LoadedIndex.IsValid() && FPlatformFileManager::Get().GetPlatformFile().FileExists(*GetIndexFilePath(RootDirectory))) {
+		LoadedIndex = RebuildFromDumpDirectory(RootDirectory);
+		LoadedIndex->SaveToDumpDirectory(RootDirectory);
+	}
+	return LoadedIndex;
+}
+
+FString FAssetDumpIndex::ComputeContentHash(const TArray<uint8>& FileBytes) {
+	uint8 Digest[16];
+
+	FMD5 ContentHash;
+	ContentHash.Update(FileBytes.GetData(), FileBytes.Num());
+	ContentHash.Final(Digest);
+	return BytesToHex(Digest, 16);
+}
+
+void FAssetDumpIndex::CollectDependencyPackages(const TArray<TSharedPtr<FJsonValue>>& ObjectHierarchy, const FName SelfPackageName, TArray<FName>& OutDependencyPackages) {
+	for (const TSharedPtr<FJsonValue>& ObjectValue : ObjectHierarchy) {
+		const TSharedPtr<FJsonObject> Object = ObjectValue->AsObject();
+		if (Object->GetStringField(TEXT("Type")) != TEXT("Import")) {
+			continue;
+		}
+
+		//Imported objects without an outer are the imported packages themselves
+		if (!Object->HasField(TEXT("Outer"))) {
+			const FString PackageName = Object->GetStringField(TEXT("ObjectName"));
+			if (!PackageName.StartsWith(TEXT("/Script/")) && PackageName != SelfPackageName.ToString()) {
+				OutDependencyPackages.AddUnique(*PackageName);
+			}
+		}
+		const FString ClassPackage = Object->GetStringField(TEXT("ClassPackage"));
+		if (!ClassPackage.StartsWith(TEXT("/Script/")) && ClassPackage != SelfPackageName.ToString()) {
+			OutDependencyPackages.AddUnique(*ClassPackage);
+		}
+	}
+}
+
+bool FAssetDumpIndex::CreateEntryFromDumpFile(const TSharedPtr<FJsonObject>& RootObject, const TArray<uint8>& FileBytes, FAssetDumpIndexEntry& OutEntry) {
+	FString PackageName;
+	FString AssetClass;
+	if (!RootObject->TryGetStringField(TEXT("AssetPackage"), PackageName) ||
+		!RootObject->TryGetStringField(TEXT("AssetClass"), AssetClass)) {
+		return false;
+	}
+
+	OutEntry.PackageName = *PackageName;
+	OutEntry.AssetClass = *AssetClass;
+	OutEntry.FileSize = FileBytes.Num();
+	OutEntry.ContentHash = ComputeContentHash(FileBytes);
+
+	const TArray<TSharedPtr<FJsonValue>>* ObjectHierarchy;
+	if (RootObject->TryGetArrayField(TEXT("ObjectHierarchy"), ObjectHierarchy)) {
+		CollectDependencyPackages(*ObjectHierarchy, OutEntry.PackageName, OutEntry.DependencyPackages);
+	}
+	return true;
+}
+
+TSharedRef<FAssetDumpIndex> FAssetDumpIndex::RebuildFromDumpDirectory(const FString& RootDirectory) {
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FString> DumpFilePaths;
+	IFileManager::Get().FindFilesRecursive(DumpFilePaths, *RootDirectory, TEXT("*.json"), true, false);
+
+	const TSharedRef<FAssetDumpIndex> ResultIndex = MakeShareable(new FAssetDumpIndex());
+
+	//Dump files are independent from each other, so read and parse them on the task graph
+	ParallelFor(DumpFilePaths.Num(), [&](const int32 FileIndex) {
+		const FString& DumpFilePath = DumpFilePaths[FileIndex];
+
+		//Content hash is computed over the raw file bytes, so it can be verified against the file on disk
+		TArray<uint8> FileBytes;
+		if (!FFileHelper::LoadFileToArray(FileBytes, *DumpFilePath)) {
+			UE_LOG(LogAssetDumper, Error, TEXT("Failed to load asset dump file %s"), *DumpFilePath);
+			return;
+		}
+		FString FileContents;
+		FFileHelper::BufferToString(FileContents, FileBytes.GetData(), FileBytes.Num());
+
+		TSharedPtr<FJsonObject> RootObject;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FileContents), RootObject) || !RootObject.IsValid()) {
+			UE_LOG(LogAssetDumper, Warning, TEXT("Skipping file %s while rebuilding asset dump index: invalid json"), *DumpFilePath);
+			return;
+		}
+
+		FAssetDumpIndexEntry Entry;
+		if (!CreateEntryFromDumpFile(RootObject, FileBytes, Entry)) {
+			UE_LOG(LogAssetDumper, Warning, TEXT("Skipping file %s while rebuilding asset dump index: not an asset dump file"), *DumpFilePath);
+			return;
+		}
+		ResultIndex->AddEntry(Entry);
+	});
+
+	UE_LOG(LogAssetDumper, Display, TEXT("Rebuilt asset dump index from %d dump files in %.2f seconds"), DumpFilePaths.Num(), FPlatformTime::Seconds() - StartTime);
+	return ResultIndex;
+}
@@ -1,12 +1,15 @@
 #include "Toolkit/AssetDumping/AssetDumpProcessor.h"
+#include "Async/Async.h"
 #include "Async/ParallelFor.h"
 #include "Toolkit/AssetDumping/AssetTypeSerializer.h"
 #include "Toolkit/AssetDumping/SerializationContext.h"
+#include "Toolkit/AssetDumping/AssetDumpIndex.h"
 #include "AssetDumperModule.h"
 
 using FInlinePackageArray = TArray<FPendingPackageData, TInlineAllocator<16>>;
 
 #define DEFAULT_PACKAGES_TO_PROCESS_PER_TICK 16
+#define DUMP_INDEX_SAVE_INTERVAL 60.0f
 
 FAssetDumpSettings::FAssetDumpSettings() :
 	RootDumpDirectory(GetDefaultRootDumpDirectory()),
@@ -42,8 +45,15 @@ FAssetDumpProcessor::~FAssetDumpProcessor() {
 	//which will crash trying to call our method upon finishing after we've been destructed
 	check(PackageLoadRequestsInFlyCounter.GetValue() == 0);
 
+	//Write the index of the packages dumped so far if dumping has been interrupted, leaving the dump marked as in progress
+	if (!bHasFinishedDumping) {
+		MergePreviousDumpIndex(true);
+		SaveDumpIndex(false);
+	}
+
 	for (const FPendingPackageData& PackageData : this->LoadedPackages) {
 		PackageData.AssetObject->RemoveFromRoot();
+		SerializerPool.Release(PackageData.Serializer, PackageData.PooledSerializers);
 	}
 
 	this->LoadedPackages.Empty();
@@ -67,8 +77,34 @@ TSharedRef<FAssetDumpProcessor> FAssetDumpProcessor::StartAssetDump(const FAsset
 	return NewProcessor;
 }
 
+void FAssetDumpProcessor::MergePreviousDumpIndex(const bool bWaitForCompletion) {
+	if (bPreviousDumpIndexMerged || (!bWaitForCompletion && !PreviousDumpIndexFuture.IsReady())) {
+		return;
+	}
+	//Packages dumped during this run take priority over the entries of the previous dump
+	const TSharedPtr<FAssetDumpIndex> PreviousDumpIndex = PreviousDumpIndexFuture.Get();
+	if (PreviousDumpIndex.IsValid()) {
+		this->DumpIndex->AddMissingEntries(*PreviousDumpIndex);
+	}
+	this->bPreviousDumpIndexMerged = true;
+}
+
+void FAssetDumpProcessor::SaveDumpIndex(const bool bDumpComplete) {
+	this->DumpIndex->SaveToDumpDirectory(Settings.RootDumpDirectory, bDumpComplete);
+	this->TimeSinceDumpIndexSave = 0.0f;
+	this->PackagesProcessedAtDumpIndexSave = PackagesProcessed.GetValue();
+}
+
 void FAssetDumpProcessor::Tick(float DeltaTime) {
 	this->TimeSinceGarbageCollection += DeltaTime;
+	this->TimeSinceDumpIndexSave += DeltaTime;
+	MergePreviousDumpIndex(false);
+
+	//Periodically write the index, so a crashed dump still lists most of the packages it has dumped.
+	//Index is only written once it includes the previous dump, otherwise it would drop all of it's entries
+	if (bPreviousDumpIndexMerged && TimeSinceDumpIndexSave >= DUMP_INDEX_SAVE_INTERVAL && PackagesProcessed.GetValue() != PackagesProcessedAtDumpIndexSave) {
+		SaveDumpIndex(false);
+	}
 
 	//Collect garbage if we exceeded GC interval
 	if (TimeSinceGarbageCollection >= Settings.GarbageCollectionInterval) {
@@ -108,6 +144,13 @@ void FAssetDumpProcessor::Tick(float DeltaTime) {
 	FInlinePackageArray PackagesToProcessParallel;
 	FInlinePackageArray PackagesToProcessInMainThread;
 
+	//Capture the data serializers cannot read from the worker threads while we are still on the game thread
+	const double SnapshotStartTime = FPlatformTime::Seconds();
+	for (const FPendingPackageData& PackageData : PackagesToProcessThisTick) {
+		PackageData.Serializer->CaptureAssetSnapshot(PackageData.SerializationContext.ToSharedRef());
+	}
+	this->TimeSpentCapturingSnapshots += FPlatformTime::Seconds() - SnapshotStartTime;
+
 	for (const FPendingPackageData& PackageData : PackagesToProcessThisTick) {
 		if (PackageData.Serializer->SupportsParallelDumping()) {
 			PackagesToProcessParallel.Add(PackageData);
@@ -118,22 +161,34 @@ void FAssetDumpProcessor::Tick(float DeltaTime) {
 	}
 
 	if (PackagesToProcessParallel.Num()) {
+		const double SerializationStartTime = FPlatformTime::Seconds();
 		ParallelFor(PackagesToProcessParallel.Num(), [this, &PackagesToProcessParallel](const int32 PackageIndex) {
 			PerformAssetDumpForPackage(PackagesToProcessParallel[PackageIndex]);
 			}, Settings.bForceSingleThread);
+		this->TimeSpentSerializingParallel += FPlatformTime::Seconds() - SerializationStartTime;
+		this->PackagesSerializedParallel += PackagesToProcessParallel.Num();
 	}
 
 	if (PackagesToProcessInMainThread.Num()) {
+		const double SerializationStartTime = FPlatformTime::Seconds();
 		for (int32 i = 0; i < PackagesToProcessInMainThread.Num(); i++) {
 			PerformAssetDumpForPackage(PackagesToProcessInMainThread[i]);
 		}
+		this->TimeSpentSerializingGameThread += FPlatformTime::Seconds() - SerializationStartTime;
+		this->PackagesSerializedGameThread += PackagesToProcessInMainThread.Num();
 	}
 
 	if (CurrentPackageToLoadIndex >= PackagesToLoad.Num() &&
 		PackageLoadRequestsInFlyCounter.GetValue() == 0 &&
 		PackagesWaitingForProcessing.GetValue() == 0) {
 		UE_LOG(LogAssetDumper, Display, TEXT("Asset dumping finished successfully"));
+		UE_LOG(LogAssetDumper, Display, TEXT("Serialized %d assets using %d pooled serializer pairs"), SerializerPool.GetNumAcquired(), SerializerPool.GetNumCreated());
+		UE_LOG(LogAssetDumper, Display, TEXT("Serialized %d packages in %.2f seconds %s and %d packages in %.2f seconds on the game thread, capturing snapshots took %.2f seconds"),
+			PackagesSerializedParallel, TimeSpentSerializingParallel, Settings.bForceSingleThread ? TEXT("single threaded") : TEXT("in parallel"),
+			PackagesSerializedGameThread, TimeSpentSerializingGameThread, TimeSpentCapturingSnapshots);
 		this->bHasFinishedDumping = true;
+		MergePreviousDumpIndex(true);
+		SaveDumpIndex(true);
 
 		//If we were requested to exit on finish, do it now
 		if (Settings.bExitOnFinish) {
@@ -185,7 +240,12 @@ void FAssetDumpProcessor::PerformAssetDumpForPackage(const FPendingPackageData&
 
 	//Serialize asset, finalize serialization, save data into file
 	PackageData.Serializer->SerializeAsset(PackageData.SerializationContext.ToSharedRef());
-	PackageData.SerializationContext->Finalize();
+	FAssetDumpIndexEntry IndexEntry;
+	PackageData.SerializationContext->Finalize(IndexEntry);
+	this->DumpIndex->AddEntry(IndexEntry);
+
+	//Return serializers to the pool for the next asset of the same type
+	SerializerPool.Release(PackageData.Serializer, PackageData.PooledSerializers);
 
 	//Unroot object now, we have processed it already and do not need to keep it in memory anymore
 	PackageData.AssetObject->RemoveFromRoot();
@@ -217,7 +277,8 @@ bool FAssetDumpProcessor::CreatePackageData(UPackage* Package, FPendingPackageDa
 	UObject* AssetObject = FSerializationContext::GetAssetObjectFromPackage(Package, *AssetData);
 	checkf(AssetObject, TEXT("Failed to find asset object '%s' inside of the package '%s'"), *AssetData->AssetName.ToString(), *Package->GetPathName());
 
-	const TSharedPtr<FSerializationContext> Context = MakeShareable(new FSerializationContext(Settings.RootDumpDirectory, *AssetData, AssetObject));
+	const FPooledSerializers PooledSerializers = SerializerPool.Acquire(Serializer);
+	const TSharedPtr<FSerializationContext> Context = MakeShareable(new FSerializationContext(Settings.RootDumpDirectory, *AssetData, AssetObject, PooledSerializers, Settings.bForceSingleThread));
 
 	//Check for existing asset files
 	if (!Settings.bOverwriteExistingAssets) {
@@ -225,6 +286,7 @@ bool FAssetDumpProcessor::CreatePackageData(UPackage* Package, FPendingPackageDa
 
 		//Skip dumping when we have a dump file already and are not allowed to overwrite assets
 		if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*AssetOutputFile)) {
+			SerializerPool.Release(Serializer, PooledSerializers);
 			UE_LOG(LogAssetDumper, Display, TEXT("Skipping dumping asset %s, dump file is already present and overwriting is not allowed"), *Package->GetName());
 			return false;
 		}
@@ -234,14 +296,43 @@ bool FAssetDumpProcessor::CreatePackageData(UPackage* Package, FPendingPackageDa
 	PendingPackageData.AssetObject = AssetObject;
 	PendingPackageData.SerializationContext = Context;
 	PendingPackageData.Serializer = Serializer;
+	PendingPackageData.PooledSerializers = PooledSerializers;
 	return true;
 }
 
 void FAssetDumpProcessor::InitializeAssetDump() {
 	this->TimeSinceGarbageCollection = 0.0f;
+	this->TimeSpentCapturingSnapshots = 0.0;
+	this->TimeSpentSerializingParallel = 0.0;
+	this->TimeSpentSerializingGameThread = 0.0;
+	this->PackagesSerializedParallel = 0;
+	this->PackagesSerializedGameThread = 0;
 	this->CurrentPackageToLoadIndex = 0;
 	this->bHasFinishedDumping = false;
 	this->PackagesTotal = PackagesToLoad.Num();
+	this->TimeSinceDumpIndexSave = 0.0f;
+	this->PackagesProcessedAtDumpIndexSave = 0;
+
+	//Keep entries of the assets dumped previously, since they can be skipped this time if overwriting is disabled
+	//Indices of interrupted dumps and dumps written before the index existed are indexed from scratch, so the resulting index covers the whole directory
+	//Loading and rebuilding the index is done on the worker thread while dumping already runs
+	this->DumpIndex = MakeShareable(new FAssetDumpIndex());
+	this->bPreviousDumpIndexMerged = false;
+	
+	//Marker has to be checked before this dump places it, and placed before any of the dump files are written
+	const FString RootDumpDirectory = Settings.RootDumpDirectory;
+	const bool bPreviousDumpInterrupted = FAssetDumpIndex::IsDumpInProgress(RootDumpDirectory);
+	FAssetDumpIndex::MarkDumpInProgress(RootDumpDirectory);
+	
+	this->PreviousDumpIndexFuture = Async(EAsyncExecution::ThreadPool, [RootDumpDirectory, bPreviousDumpInterrupted]() -> TSharedPtr<FAssetDumpIndex> {
+		if (!bPreviousDumpInterrupted) {
+			const TSharedPtr<FAssetDumpIndex> LoadedIndex = FAssetDumpIndex::LoadFromDumpDirectory(RootDumpDirectory, true);
+			if (LoadedIndex.IsValid()) {
+				return LoadedIndex;
+			}
+		}
+		return FAssetDumpIndex::RebuildFromDumpDirectory(RootDumpDirectory);
+	});
 
 	this->MaxPackagesToProcessInOneTick = Settings.MaxPackagesToProcessInOneTick;
 	this->MaxLoadRequestsInFly = Settings.MaxPackagesToProcessInOneTick;
@@ -6,12 +6,8 @@
 #define LOCTEXT_NAMESPACE "AssetDumper"
 
 bool FSelectedAssetsStruct::ProcessIncludedPathAsset(const FAssetData& AssetData) {
-	//Skip assets located in excluded package paths
-	if (ExcludedPackagePaths.Contains(AssetData.PackagePath)) {
-		return true;
-	}
-	//Skip assets that have been explicitly excluded by package name
-	if (ExcludedPackageNames.Contains(AssetData.PackageName)) {
+	//Skip assets that have been explicitly excluded by package name or located in excluded package paths
+	if (ExcludedPackagesMatcher.Matches(AssetData.PackageName)) {
 		return true;
 	}
 	//Skip assets that we have already included
@@ -41,21 +37,14 @@ void FSelectedAssetsStruct::AddIncludedPackageName(const FString& PackageName) {
 }
 
 void FSelectedAssetsStruct::AddExcludedPackagePath(const FString& PackagePath) {
+	//Matcher handles sub-paths on it's own, so there is no need to expand them through the asset registry
 	this->ExcludedPackagePaths.Add(*PackagePath);
-
-	//We need to append PackagePath, but also expand it's sub-paths
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	FJsonSerializableArray array;
-	AssetRegistry.GetSubPaths(PackagePath, array, true);
-	for (auto element : array) {
-		this->ExcludedPackagePaths.Add(*element);
-	}
+	this->ExcludedPackagesMatcher.AddPackagePath(PackagePath);
 }
 
 void FSelectedAssetsStruct::AddExcludedPackageName(const FString& PackageName) {
 	this->ExcludedPackageNames.Add(*PackageName);
+	this->ExcludedPackagesMatcher.AddPackageName(PackageName);
 }
 
 void FSelectedAssetsStruct::AddAssetClassWhitelist(FName AssetClass) {
@@ -1,4 +1,6 @@
 #include "Toolkit/AssetDumping/SerializationContext.h"
+#include "Toolkit/AssetDumping/AssetDumpIndex.h"
+#include "Toolkit/AssetDumping/SerializerPool.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
 #include "Toolkit/PropertySerializer.h"
 
@@ -22,14 +24,11 @@ UObject* ResolveGenericAsset(UPackage* Package, const FAssetData& AssetData) {
 	return FindObjectFast<UObject>(Package, *AssetData.AssetName.ToString());
 }
 
-FSerializationContext::FSerializationContext(const FString& RootOutputDirectory, const FAssetData& AssetData, UObject* AssetObject) {
+FSerializationContext::FSerializationContext(const FString& RootOutputDirectory, const FAssetData& AssetData, UObject* AssetObject, const FPooledSerializers& Serializers, const bool bForceSingleThread) {
 	this->AssetSerializedData = MakeShareable(new FJsonObject());
-	this->PropertySerializer = NewObject<UPropertySerializer>();
-	this->ObjectHierarchySerializer = NewObject<UObjectHierarchySerializer>();
-	this->ObjectHierarchySerializer->SetPropertySerializer(PropertySerializer);
-
-	this->PropertySerializer->AddToRoot();
-	this->ObjectHierarchySerializer->AddToRoot();
+	this->bForceSingleThread = bForceSingleThread;
+	this->PropertySerializer = Serializers.PropertySerializer;
+	this->ObjectHierarchySerializer = Serializers.ObjectHierarchySerializer;
 
 	//Object hierarchy serializer will also root package object by referencing it
 	this->AssetObject = AssetObject;
@@ -47,14 +46,6 @@ FSerializationContext::FSerializationContext(const FString& RootOutputDirectory,
 	this->ObjectHierarchySerializer->SetObjectMark(AssetObject, TEXT("$AssetObject$"));
 }
 
-FSerializationContext::~FSerializationContext() {
-	this->PropertySerializer->RemoveFromRoot();
-	this->ObjectHierarchySerializer->RemoveFromRoot();
-
-	this->PropertySerializer->MarkPendingKill();
-	this->ObjectHierarchySerializer->MarkPendingKill();
-}
-
 UObject* FSerializationContext::GetAssetObjectFromPackage(UPackage* Package, const FAssetData& AssetData) {
 	if (AssetData.TagsAndValues.Contains(FBlueprintTags::GeneratedClassPath)) {
 		return ResolveBlueprintClassAsset(Package, AssetData);
@@ -64,19 +55,32 @@ UObject* FSerializationContext::GetAssetObjectFromPackage(UPackage* Package, con
 	return ResolveGenericAsset(Package, AssetData);
 }
 
-void FSerializationContext::Finalize() const {
+void FSerializationContext::Finalize(FAssetDumpIndexEntry& OutIndexEntry) const {
 	TSharedRef<FJsonObject> RootObject = MakeShareable(new FJsonObject());
 	RootObject->SetStringField(TEXT("AssetClass"), AssetData.AssetClass.ToString());
 	RootObject->SetStringField(TEXT("AssetPackage"), Package->GetName());
 	RootObject->SetStringField(TEXT("AssetName"), AssetData.AssetName.ToString());
 	
 	RootObject->SetObjectField(TEXT("AssetSerializedData"), AssetSerializedData);
-	RootObject->SetArrayField(TEXT("ObjectHierarchy"), ObjectHierarchySerializer->FinalizeSerialization());
+	
+	const TArray<TSharedPtr<FJsonValue>> ObjectHierarchy = ObjectHierarchySerializer->FinalizeSerialization();
+	RootObject->SetArrayField(TEXT("ObjectHierarchy"), ObjectHierarchy);
 
 	FString ResultString;
 	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
 	FJsonSerializer::Serialize(RootObject, Writer);
 
+	//Encode the file ourselves, so the content hash in the index is computed over exactly the bytes written on disk
+	const FTCHARToUTF8 ResultStringUTF8(*ResultString);
+	const TArray<uint8> ResultBytes((const uint8*) ResultStringUTF8.Get(), ResultStringUTF8.Length());
+
 	const FString OutputFilename = GetDumpFilePath(TEXT(""), TEXT("json"));
-	check(FFileHelper::SaveStringToFile(ResultString, *OutputFilename));
+	check(FFileHelper::SaveArrayToFile(ResultBytes, *OutputFilename));
+
+	//Describe the written file for the dump index, so tools do not have to open it just to learn it's class and dependencies
+	OutIndexEntry.PackageName = Package->GetFName();
+	OutIndexEntry.AssetClass = AssetData.AssetClass;
+	OutIndexEntry.FileSize = ResultBytes.Num();
+	OutIndexEntry.ContentHash = FAssetDumpIndex::ComputeContentHash(ResultBytes);
+	FAssetDumpIndex::CollectDependencyPackages(ObjectHierarchy, OutIndexEntry.PackageName, OutIndexEntry.DependencyPackages);
 }
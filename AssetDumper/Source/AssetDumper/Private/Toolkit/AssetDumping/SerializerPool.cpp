@@ -0,0 +1,48 @@
+#include "Toolkit/AssetDumping/SerializerPool.h"
+#include "Toolkit/ObjectHierarchySerializer.h"
+#include "Toolkit/PropertySerializer.h"
+
+FSerializerPool::FSerializerPool() : NumAcquired(0) {
+}
+
+FSerializerPool::~FSerializerPool() {
+	for (const FPooledSerializers& Serializers : AllSerializers) {
+		Serializers.PropertySerializer->RemoveFromRoot();
+		Serializers.ObjectHierarchySerializer->RemoveFromRoot();
+
+		Serializers.PropertySerializer->MarkPendingKill();
+		Serializers.ObjectHierarchySerializer->MarkPendingKill();
+	}
+}
+
+FPooledSerializers FSerializerPool::Acquire(UAssetTypeSerializer* AssetSerializer) {
+	check(IsInGameThread());
+	this->NumAcquired++;
+	{
+		FScopeLock ScopeLock(&FreeSerializersCriticalSection);
+		TArray<FPooledSerializers>* FreeList = FreeSerializers.Find(AssetSerializer);
+		
+		if (FreeList != NULL && FreeList->Num() != 0) {
+			return FreeList->Pop(false);
+		}
+	}
+
+	FPooledSerializers NewSerializers;
+	NewSerializers.PropertySerializer = NewObject<UPropertySerializer>();
+	NewSerializers.ObjectHierarchySerializer = NewObject<UObjectHierarchySerializer>();
+	NewSerializers.ObjectHierarchySerializer->SetPropertySerializer(NewSerializers.PropertySerializer);
+
+	NewSerializers.PropertySerializer->AddToRoot();
+	NewSerializers.ObjectHierarchySerializer->AddToRoot();
+	
+	this->AllSerializers.Add(NewSerializers);
+	return NewSerializers;
+}
+
+void FSerializerPool::Release(UAssetTypeSerializer* AssetSerializer, const FPooledSerializers& Serializers) {
+	//Reset right away, so objects of the dumped asset are no longer referenced and can be garbage collected
+	Serializers.ObjectHierarchySerializer->Reset();
+
+	FScopeLock ScopeLock(&FreeSerializersCriticalSection);
+	this->FreeSerializers.FindOrAdd(AssetSerializer).Add(Serializers);
+}
@@ -0,0 +1,218 @@
+#include "Toolkit/AssetTypes/AnimationDumpFormat.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#define ANIMATION_DUMP_FILE_MAGIC 0x4D4E4144
+#define ANIMATION_DUMP_FILE_VERSION 1
+
+#define PACKED_ROTATION_COMPONENT_BITS 20
+#define PACKED_ROTATION_COMPONENT_MASK ((1ull << PACKED_ROTATION_COMPONENT_BITS) - 1)
+//Components other than the largest one are always within [-1/sqrt(2), 1/sqrt(2)] range
+#define PACKED_ROTATION_COMPONENT_RANGE 0.70710678118f
+
+const TCHAR* FDumpedAnimationData::FileExtension = TEXT("anim");
+
+template<typename T>
+static void CompactKeyArray(TArray<T>& Keys) {
+	for (int32 i = 1; i < Keys.Num(); i++) {
+		if (!(Keys[i] == Keys[0])) {
+			return;
+		}
+	}
+	Keys.SetNum(FMath::Min(Keys.Num(), 1));
+}
+
+void FDumpedAnimationTrack::CompactConstantKeys() {
+	CompactKeyArray(PositionKeys);
+	CompactKeyArray(RotationKeys);
+	CompactKeyArray(ScaleKeys);
+}
+
+FArchive& operator<<(FArchive& Ar, FDumpedAnimationTrack& Track) {
+	Ar << Track.BoneName;
+	Track.PositionKeys.BulkSerialize(Ar);
+
+	TArray<uint64> PackedRotationKeys;
+	if (Ar.IsSaving()) {
+		PackedRotationKeys.Reserve(Track.RotationKeys.Num());
+		for (const FQuat& RotationKey : Track.RotationKeys) {
+			PackedRotationKeys.Add(FDumpedAnimationData::PackRotation(RotationKey));
+		}
+	}
+	PackedRotationKeys.BulkSerialize(Ar);
+	if (Ar.IsLoading()) {
+		Track.RotationKeys.Empty(PackedRotationKeys.Num());
+		for (const uint64 PackedRotationKey : PackedRotationKeys) {
+			Track.RotationKeys.Add(FDumpedAnimationData::UnpackRotation(PackedRotationKey));
+		}
+	}
+
+	Track.ScaleKeys.BulkSerialize(Ar);
+	return Ar;
+}
+
+FDumpedCurveKey::FDumpedCurveKey() : Time(0.0f), Value(0.0f), ArriveTangent(0.0f), LeaveTangent(0.0f),
+	ArriveTangentWeight(0.0f), LeaveTangentWeight(0.0f), InterpMode(0), TangentMode(0), TangentWeightMode(0) {
+}
+
+FArchive& operator<<(FArchive& Ar, FDumpedCurveKey& Key) {
+	Ar << Key.Time;
+	Ar << Key.Value;
+	Ar << Key.ArriveTangent;
+	Ar << Key.LeaveTangent;
+	Ar << Key.ArriveTangentWeight;
+	Ar << Key.LeaveTangentWeight;
+	Ar << Key.InterpMode;
+	Ar << Key.TangentMode;
+	Ar << Key.TangentWeightMode;
+	return Ar;
+}
+
+FDumpedAnimationCurve::FDumpedAnimationCurve() : CurveTypeFlags(0) {
+}
+
+FArchive& operator<<(FArchive& Ar, FDumpedAnimationCurve& Curve) {
+	Ar << Curve.CurveName;
+	Ar << Curve.CurveTypeFlags;
+	Ar << Curve.Keys;
+	return Ar;
+}
+
+FDumpedAnimationData::FDumpedAnimationData() : NumFrames(0), SequenceLength(0.0f) {
+}
+
+FArchive& operator<<(FArchive& Ar, FDumpedAnimationData& AnimationData) {
+	Ar << AnimationData.NumFrames;
+	Ar << AnimationData.SequenceLength;
+	Ar << AnimationData.Tracks;
+	Ar << AnimationData.Curves;
+	return Ar;
+}
+
+float FDumpedAnimationData::GetTimeAtFrame(const int32 Frame) const {
+	return NumFrames > 1 ? SequenceLength * Frame / (NumFrames - 1) : 0.0f;
+}
+
+bool FDumpedAnimationData::Validate(FString& OutErrorMessage) const {
+	if (NumFrames < 0 || SequenceLength < 0.0f) {
+		OutErrorMessage = FString::Printf(TEXT("Invalid frame count %d or sequence length %f"), NumFrames, SequenceLength);
+		return false;
+	}
+	for (const FDumpedAnimationTrack& Track : Tracks) {
+		//Scale keys can be omitted completely, in which case the bone is not scaled
+		const bool bValidKeyCount =
+			(Track.PositionKeys.Num() == 1 || Track.PositionKeys.Num() == NumFrames) &&
+			(Track.RotationKeys.Num() == 1 || Track.RotationKeys.Num() == NumFrames) &&
+			(Track.ScaleKeys.Num() <= 1 || Track.ScaleKeys.Num() == NumFrames);
+
+		if (!bValidKeyCount) {
+			OutErrorMessage = FString::Printf(TEXT("Track of bone %s has key count not matching frame count %d"), *Track.BoneName, NumFrames);
+			return false;
+		}
+	}
+	return true;
+}
+
+void FDumpedAnimationData::SaveToBytes(TArray<uint8>& OutBytes) const {
+	FMemoryWriter Writer(OutBytes);
+	uint32 FileMagic = ANIMATION_DUMP_FILE_MAGIC;
+	int32 FileVersion = ANIMATION_DUMP_FILE_VERSION;
+
+	Writer << FileMagic;
+	Writer << FileVersion;
+	//Serialization operator is shared between loading and saving, so it cannot take a const reference
+	Writer << const_cast<FDumpedAnimationData&>(*this);
+}
+
+bool FDumpedAnimationData::LoadFromBytes(const TArray<uint8>& Bytes, FString& OutErrorMessage) {
+	FMemoryReader Reader(Bytes);
+	uint32 FileMagic = 0;
+	int32 FileVersion = 0;
+
+	Reader << FileMagic;
+	if (FileMagic != ANIMATION_DUMP_FILE_MAGIC) {
+		OutErrorMessage = TEXT("Not a dumped animation file");
+		return false;
+	}
+	Reader << FileVersion;
+	if (FileVersion <= 0 || FileVersion > ANIMATION_DUMP_FILE_VERSION) {
+		OutErrorMessage = FString::Printf(TEXT("Unsupported dumped animation file version %d"), FileVersion);
+		return false;
+	}
+
+	Reader << *this;
+	if (Reader.IsError() || !Reader.AtEnd()) {
+		OutErrorMessage = TEXT("Dumped animation file is truncated or corrupted");
+		return false;
+	}
+	return Validate(OutErrorMessage);
+}
+
+bool FDumpedAnimationData::LoadFromFile(const FString& FilePath, FString& OutErrorMessage) {
+	TArray<uint8> FileBytes;
+	if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath)) {
+		OutErrorMessage = FString::Printf(TEXT("Failed to read file %s"), *FilePath);
+		return false;
+	}
+	return LoadFromBytes(FileBytes, OutErrorMessage);
+}
+
+uint64 FDumpedAnimationData::PackRotation(const FQuat& Rotation) {
+	const FQuat NormalizedRotation = Rotation.GetNormalized();
+	const float Components[4] = {NormalizedRotation.X, NormalizedRotation.Y, NormalizedRotation.Z, NormalizedRotation.W};
+
+	int32 LargestComponentIndex = 0;
+	for (int32 i = 1; i < 4; i++) {
+		if (FMath::Abs(Components[i]) > FMath::Abs(Components[LargestComponentIndex])) {
+			LargestComponentIndex = i;
+		}
+	}
+	//Q and -Q represent the same rotation, so flip the quaternion to make the omitted component positive
+	const float Sign = Components[LargestComponentIndex] < 0.0f ? -1.0f : 1.0f;
+
+	uint64 PackedRotation = LargestComponentIndex;
+	int32 CurrentShift = 2;
+
+	for (int32 i = 0; i < 4; i++) {
+		if (i != LargestComponentIndex) {
+			const float NormalizedComponent = FMath::Clamp((Components[i] * Sign / PACKED_ROTATION_COMPONENT_RANGE + 1.0f) * 0.5f, 0.0f, 1.0f);
+			const uint64 QuantizedComponent = (uint64) FMath::RoundToInt(NormalizedComponent * PACKED_ROTATION_COMPONENT_MASK);
+
+			PackedRotation |= QuantizedComponent << CurrentShift;
+			CurrentShift += PACKED_ROTATION_COMPONENT_BITS;
+		}
+	}
+	return PackedRotation;
+}
+
+FQuat FDumpedAnimationData::UnpackRotation(const uint64 PackedRotation) {
+	const int32 LargestComponentIndex = (int32) (PackedRotation & 3);
+	float Components[4];
+	float SumOfSquares = 0.0f;
+	int32 CurrentShift = 2;
+
+	for (int32 i = 0; i < 4; i++) {
+		if (i != LargestComponentIndex) {
+			const uint64 QuantizedComponent = (PackedRotation >> CurrentShift) & PACKED_ROTATION_COMPONENT_MASK;
+			const float NormalizedComponent = (float) QuantizedComponent / PACKED_ROTATION_COMPONENT_MASK;
+
+			Components[i] = (NormalizedComponent * 2.0f - 1.0f) * PACKED_ROTATION_COMPONENT_RANGE;
+			SumOfSquares += Components[i] * Components[i];
+			CurrentShift += PACKED_ROTATION_COMPONENT_BITS;
+		}
+	}
+	Components[LargestComponentIndex] = FMath::Sqrt(FMath::Max(0.0f, 1.0f - SumOfSquares));
+
+	return FQuat(Components[0], Components[1], Components[2], Components[3]).GetNormalized();
+}
+
+FString FDumpedAnimationData::ComputeFileHash(const TArray<uint8>& Bytes) {
+	FMD5 MD5;
+	MD5.Update(Bytes.GetData(), Bytes.Num());
+
+	FMD5Hash FileHash;
+	FileHash.Set(MD5);
+	return LexToString(FileHash);
+}
@@ -2,10 +2,136 @@
 #include "Toolkit/ObjectHierarchySerializer.h"
 #include "Toolkit/AssetDumping/AssetTypeSerializerMacros.h"
 #include "Toolkit/AssetDumping/SerializationContext.h"
-//#include "Toolkit/AssetTypes/FbxMeshExporter.h"
+#include "Toolkit/AssetTypes/AnimationDumpFormat.h"
 #include "Toolkit/PropertySerializer.h"
 #include "Animation/AnimSequenceBase.h"
 #include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "AssetDumperModule.h"
+#include "Misc/FileHelper.h"
+
+/** Animation sequence timing captured on the game thread */
+struct FAnimSequenceDumpSnapshot : public FAssetSerializationSnapshot {
+	int32 FrameRate;
+	int32 NumFrames;
+	float SequenceLength;
+	/** Additive animations keep additive deltas in the compressed data, so their tracks are copied from the raw data instead */
+	bool bIsValidAdditive;
+};
+
+void UAnimationSequenceAssetSerializer::CaptureAssetSnapshot(TSharedRef<FSerializationContext> Context) const {
+	UAnimSequence* Asset = Context->GetAsset<UAnimSequence>();
+	const TSharedRef<FAnimSequenceDumpSnapshot> Snapshot = MakeShared<FAnimSequenceDumpSnapshot>();
+
+	Snapshot->FrameRate = (int32) Asset->GetFrameRate();
+	Snapshot->NumFrames = Asset->GetNumberOfFrames();
+	Snapshot->SequenceLength = Asset->SequenceLength;
+	Snapshot->bIsValidAdditive = Asset->IsValidAdditive();
+	Context->SetSnapshot(Snapshot);
+}
+
+/**
+ * Copies bone tracks of the additive animation from it's raw data, which holds the full pose before the additive base is subtracted from it
+ * Compressed data of the additive animation only contains additive deltas, which would get the additive settings applied to them again once generated
+ */
+static bool CaptureAdditiveAnimationTracks(UAnimSequence* Asset, const FReferenceSkeleton& ReferenceSkeleton, FDumpedAnimationData& OutAnimationData, FString& OutErrorMessage) {
+	const TArray<FRawAnimSequenceTrack>& RawTracks = Asset->GetRawAnimationData();
+	const TArray<FTrackToSkeletonMap>& RawTrackToSkeletonMap = Asset->GetRawTrackToSkeletonMapTable();
+	
+	if (RawTracks.Num() == 0 || RawTracks.Num() != RawTrackToSkeletonMap.Num()) {
+		OutErrorMessage = TEXT("Animation is additive and has no raw animation data, additive base pose cannot be restored from the compressed data");
+		return false;
+	}
+
+	for (int32 TrackIndex = 0; TrackIndex < RawTracks.Num(); TrackIndex++) {
+		const int32 BoneIndex = RawTrackToSkeletonMap[TrackIndex].BoneTreeIndex;
+		if (!ReferenceSkeleton.IsValidIndex(BoneIndex)) {
+			continue;
+		}
+		const FRawAnimSequenceTrack& RawTrack = RawTracks[TrackIndex];
+		FDumpedAnimationTrack& Track = OutAnimationData.Tracks.AddDefaulted_GetRef();
+		Track.BoneName = ReferenceSkeleton.GetBoneName(BoneIndex).ToString();
+		Track.PositionKeys = RawTrack.PosKeys;
+		Track.RotationKeys = RawTrack.RotKeys;
+		Track.ScaleKeys = RawTrack.ScaleKeys;
+
+		//Raw tracks are allowed to omit scale keys entirely
+		if (Track.ScaleKeys.Num() == 0) {
+			Track.ScaleKeys.Add(FVector::OneVector);
+		}
+		Track.CompactConstantKeys();
+	}
+	return true;
+}
+
+/** Samples bone tracks of the non-additive animation at every frame */
+static void SampleAnimationTracks(UAnimSequence* Asset, const FReferenceSkeleton& ReferenceSkeleton, FDumpedAnimationData& OutAnimationData) {
+	const TArray<FTrackToSkeletonMap>& TrackToSkeletonMap = Asset->GetCompressedTrackToSkeletonMapTable();
+	const int32 NumKeys = FMath::Max(OutAnimationData.NumFrames, 1);
+
+	//Sampling works the same way for raw and compressed animation data, and compressed data is meant to be decompressed on the worker threads
+	for (int32 TrackIndex = 0; TrackIndex < TrackToSkeletonMap.Num(); TrackIndex++) {
+		const int32 BoneIndex = TrackToSkeletonMap[TrackIndex].BoneTreeIndex;
+		if (!ReferenceSkeleton.IsValidIndex(BoneIndex)) {
+			continue;
+		}
+		FDumpedAnimationTrack& Track = OutAnimationData.Tracks.AddDefaulted_GetRef();
+		Track.BoneName = ReferenceSkeleton.GetBoneName(BoneIndex).ToString();
+		Track.PositionKeys.Reserve(NumKeys);
+		Track.RotationKeys.Reserve(NumKeys);
+		Track.ScaleKeys.Reserve(NumKeys);
+
+		for (int32 Frame = 0; Frame < NumKeys; Frame++) {
+			FTransform BoneTransform;
+			Asset->GetBoneTransform(BoneTransform, TrackIndex, OutAnimationData.GetTimeAtFrame(Frame), false);
+			
+			Track.PositionKeys.Add(BoneTransform.GetTranslation());
+			Track.RotationKeys.Add(BoneTransform.GetRotation());
+			Track.ScaleKeys.Add(BoneTransform.GetScale3D());
+		}
+		Track.CompactConstantKeys();
+	}
+}
+
+/** Captures bone tracks of the animation and copies it's float curves */
+static bool CaptureAnimationData(UAnimSequence* Asset, const FAnimSequenceDumpSnapshot& Snapshot, FDumpedAnimationData& OutAnimationData, FString& OutErrorMessage) {
+	USkeleton* Skeleton = Asset->GetSkeleton();
+	if (Skeleton == NULL) {
+		OutErrorMessage = TEXT("Animation has no skeleton");
+		return false;
+	}
+	const FReferenceSkeleton& ReferenceSkeleton = Skeleton->GetReferenceSkeleton();
+	OutAnimationData.NumFrames = Snapshot.NumFrames;
+	OutAnimationData.SequenceLength = Snapshot.SequenceLength;
+
+	if (Snapshot.bIsValidAdditive) {
+		if (!CaptureAdditiveAnimationTracks(Asset, ReferenceSkeleton, OutAnimationData, OutErrorMessage)) {
+			return false;
+		}
+	} else {
+		SampleAnimationTracks(Asset, ReferenceSkeleton, OutAnimationData);
+	}
+
+	for (const FFloatCurve& FloatCurve : Asset->RawCurveData.FloatCurves) {
+		FDumpedAnimationCurve& Curve = OutAnimationData.Curves.AddDefaulted_GetRef();
+		Curve.CurveName = FloatCurve.Name.DisplayName.ToString();
+		Curve.CurveTypeFlags = FloatCurve.GetCurveTypeFlags();
+
+		for (const FRichCurveKey& RichCurveKey : FloatCurve.FloatCurve.Keys) {
+			FDumpedCurveKey& Key = Curve.Keys.AddDefaulted_GetRef();
+			Key.Time = RichCurveKey.Time;
+			Key.Value = RichCurveKey.Value;
+			Key.ArriveTangent = RichCurveKey.ArriveTangent;
+			Key.LeaveTangent = RichCurveKey.LeaveTangent;
+			Key.ArriveTangentWeight = RichCurveKey.ArriveTangentWeight;
+			Key.LeaveTangentWeight = RichCurveKey.LeaveTangentWeight;
+			Key.InterpMode = RichCurveKey.InterpMode;
+			Key.TangentMode = RichCurveKey.TangentMode;
+			Key.TangentWeightMode = RichCurveKey.TangentWeightMode;
+		}
+	}
+	return OutAnimationData.Validate(OutErrorMessage);
+}
 
 void UAnimationSequenceAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext> Context) const {
 	BEGIN_ASSET_SERIALIZATION(UAnimSequence)
@@ -17,20 +143,29 @@ void UAnimationSequenceAssetSerializer::SerializeAsset(TSharedRef<FSerialization
 
 	SERIALIZE_ASSET_OBJECT
 
-		//Serialize precomputed framerate because we skip NumFrames serialization
-		Data->SetNumberField(TEXT("FrameRate"), (int32)Asset->GetFrameRate());
-	Data->SetNumberField(TEXT("NumFrames"), Asset->GetNumberOfFrames());
-	Data->SetNumberField(TEXT("SequenceLength"), Asset->SequenceLength);
+	//Serialize precomputed framerate because we skip NumFrames serialization
+	const FAnimSequenceDumpSnapshot& Snapshot = Context->GetSnapshot<FAnimSequenceDumpSnapshot>();
+	Data->SetNumberField(TEXT("FrameRate"), Snapshot.FrameRate);
+	Data->SetNumberField(TEXT("NumFrames"), Snapshot.NumFrames);
+	Data->SetNumberField(TEXT("SequenceLength"), Snapshot.SequenceLength);
 
-	//Serialize animation data
-	const FString OutFbxFileName = Context->GetDumpFilePath(TEXT(""), TEXT("fbx"));
+	//Serialize animation data into separate animation file
+	FDumpedAnimationData AnimationData;
 	FString OutErrorMessage;
-	//const bool bSuccess = FFbxMeshExporter::ExportAnimSequenceIntoFbxFile(Asset, OutFbxFileName, false, &OutErrorMessage);
-	//checkf(bSuccess, TEXT("Failed to export anim sequence %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
+	
+	if (CaptureAnimationData(Asset, Snapshot, AnimationData, OutErrorMessage)) {
+		TArray<uint8> AnimationFileBytes;
+		AnimationData.SaveToBytes(AnimationFileBytes);
+
+		const FString OutAnimationFileName = Context->GetDumpFilePath(TEXT(""), FDumpedAnimationData::FileExtension);
+		const bool bSuccess = FFileHelper::SaveArrayToFile(AnimationFileBytes, *OutAnimationFileName);
+		checkf(bSuccess, TEXT("Failed to write anim sequence file %s"), *OutAnimationFileName);
 
-	//Serialize exported model hash to avoid reading it during generation pass
-	//const FMD5Hash ModelFileHash = FMD5Hash::HashFile(*OutFbxFileName);
-	//Data->SetStringField(TEXT("ModelFileHash"), LexToString(ModelFileHash));
+		//Serialize exported model hash to avoid reading it during generation pass
+		Data->SetStringField(TEXT("ModelFileHash"), FDumpedAnimationData::ComputeFileHash(AnimationFileBytes));
+	} else {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to export anim sequence %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
+	}
 
 	END_ASSET_SERIALIZATION
 }
@@ -40,5 +175,5 @@ FName UAnimationSequenceAssetSerializer::GetAssetClass() const {
 }
 
 bool UAnimationSequenceAssetSerializer::SupportsParallelDumping() const {
-	return false;
+	return true;
 }
@@ -1,16 +1,20 @@
 #include "Toolkit/AssetTypes/AssetHelper.h"
+#include "Async/ParallelFor.h"
 #include "UObject/Class.h"
+#include "Dom/JsonValue.h"
 #include "Toolkit/KismetBytecodeDisassemblerJson.h"
+#include "Toolkit/KismetBytecodeCompactFormat.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
+#include "AssetDumperModule.h"
 
 bool FAssetHelper::HasCustomSerializeOnStruct(UScriptStruct* Struct) {
 	return (Struct->StructFlags & STRUCT_SerializeNative) != 0;
 }
 
-void FAssetHelper::SerializeClass(TSharedPtr<FJsonObject> OutObject, UClass* Class, UObjectHierarchySerializer* ObjectHierarchySerializer) {
+void FAssetHelper::SerializeClass(TSharedPtr<FJsonObject> OutObject, UClass* Class, UObjectHierarchySerializer* ObjectHierarchySerializer, const bool bForceSingleThread) {
 
 	//Serialize native Struct class data first
-	SerializeStruct(OutObject, Class, ObjectHierarchySerializer);
+	SerializeStruct(OutObject, Class, ObjectHierarchySerializer, NULL, bForceSingleThread);
 
 	//Skip serializing FuncMap as there is no point really
 	//It can be regenerated on deserialization quickly
@@ -48,7 +52,7 @@ void FAssetHelper::SerializeClass(TSharedPtr<FJsonObject> OutObject, UClass* Cla
 }
 
 
-void FAssetHelper::SerializeStruct(TSharedPtr<FJsonObject> OutObject, UStruct* Struct, UObjectHierarchySerializer* ObjectHierarchySerializer) {
+void FAssetHelper::SerializeStruct(TSharedPtr<FJsonObject> OutObject, UStruct* Struct, UObjectHierarchySerializer* ObjectHierarchySerializer, TSharedPtr<FJsonObject> DisassembledScript, const bool bForceSingleThread) {
 	//Do not serialize UField parent object
 	//It doesn't have anything special in it's Serialize anyway,
 	//just support for legacy field serialization, which we don't need
@@ -57,22 +61,41 @@ void FAssetHelper::SerializeStruct(TSharedPtr<FJsonObject> OutObject, UStruct* S
 	const int32 SuperStructIndex = ObjectHierarchySerializer->SerializeObject(Struct->GetSuperStruct());
 	OutObject->SetNumberField(TEXT("SuperStruct"), SuperStructIndex);
 
-	//Serialize Children now (these can only be UFunctions, properties are no longer UObjects)
+	//Collect Children first (these can only be UFunctions, properties are no longer UObjects)
+	TArray<UField*> ChildFields;
+	for (UField* Child = Struct->Children; Child; Child = Child->Next) {
+		ChildFields.Add(Child);
+	}
+
+	//Disassembling function bytecode is independent for every function, so do it in parallel, with every function writing into its own slot
+	//Object hierarchy serializer assigns object indices in the order objects are encountered, so functions themselves are serialized in order afterwards
+	//Disassembly only reads the loaded functions and the objects they reference: resolving pin types and member references reads property flags,
+	//owner classes and names, and GetPathName only walks the outer chain. None of them load, create or modify objects (ClassGeneratedBy is NULL
+	//in cooked data, so member references never look up the blueprint), and the game thread is blocked in ParallelFor, so garbage collection cannot run
+	TArray<TSharedPtr<FJsonObject>> DisassembledChildScripts;
+	DisassembledChildScripts.SetNum(ChildFields.Num());
+
+	ParallelFor(ChildFields.Num(), [&ChildFields, &DisassembledChildScripts](const int32 ChildIndex) {
+		if (UFunction* Function = Cast<UFunction>(ChildFields[ChildIndex])) {
+			DisassembledChildScripts[ChildIndex] = DisassembleScript(Function);
+		}
+	}, bForceSingleThread);
+
+	//Serialize Children now
 	TArray<TSharedPtr<FJsonValue>> Children;
-	UField* Child = Struct->Children;
-	while (Child) {
+	for (int32 ChildIndex = 0; ChildIndex < ChildFields.Num(); ChildIndex++) {
+		UField* Child = ChildFields[ChildIndex];
 		const TSharedPtr<FJsonObject> FieldObject = MakeShareable(new FJsonObject());
 
 		if (Child->IsA<UFunction>()) {
 			FieldObject->SetStringField(TEXT("FieldKind"), TEXT("Function"));
-			SerializeFunction(FieldObject, Cast<UFunction>(Child), ObjectHierarchySerializer);
+			SerializeFunction(FieldObject, Cast<UFunction>(Child), ObjectHierarchySerializer, DisassembledChildScripts[ChildIndex]);
 		}
 		else {
 			checkf(0, TEXT("Unsupported Children object type: %s"), *Child->GetClass()->GetPathName());
 		}
 
 		Children.Add(MakeShareable(new FJsonValueObject(FieldObject)));
-		Child = Child->Next;
 	}
 	OutObject->SetArrayField(TEXT("Children"), Children);
 
@@ -96,19 +119,36 @@ void FAssetHelper::SerializeStruct(TSharedPtr<FJsonObject> OutObject, UStruct* S
 	}
 	OutObject->SetArrayField(TEXT("ChildProperties"), ChildProperties);*/
 
-	//Serialize script bytecode now
-	//but only if we actually have some, since normal classes and script structs never have any
+	//Serialize script bytecode now, disassembling it unless it has been disassembled already
+	if (!DisassembledScript.IsValid()) {
+		DisassembledScript = DisassembleScript(Struct);
+	}
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : DisassembledScript->Values) {
+		OutObject->SetField(Pair.Key, Pair.Value);
+	}
+}
+
+TSharedPtr<FJsonObject> FAssetHelper::DisassembleScript(UStruct* Struct) {
+	TSharedPtr<FJsonObject> ScriptObject = MakeShareable(new FJsonObject());
+
+	//Only disassemble bytecode if we actually have some, since normal classes and script structs never have any
+	//It is written in the compact form, with plain JSON statement list written only for debugging
 	if (Struct->Script.Num()) {
 		FKismetBytecodeDisassemblerJson BytecodeDisassembler;
 		const TArray<TSharedPtr<FJsonValue>> Statements = BytecodeDisassembler.SerializeFunction(Struct);
-		OutObject->SetArrayField(TEXT("Script"), Statements);
+		if (BytecodeDisassembler.HasReadError()) {
+			UE_LOG(LogAssetDumper, Error, TEXT("Failed to disassemble script of %s, writing it without bytecode: %s"),
+				*Struct->GetPathName(), *BytecodeDisassembler.GetReadErrorMessage());
+		}
+		FKismetBytecodeCompactFormat::WriteFunctionScript(ScriptObject, Statements);
 	}
+	return ScriptObject;
 }
 
-void FAssetHelper::SerializeScriptStruct(TSharedPtr<FJsonObject> OutObject, UScriptStruct* Struct, UObjectHierarchySerializer* ObjectHierarchySerializer) {
+void FAssetHelper::SerializeScriptStruct(TSharedPtr<FJsonObject> OutObject, UScriptStruct* Struct, UObjectHierarchySerializer* ObjectHierarchySerializer, const bool bForceSingleThread) {
 
 	//Serialize normal Struct data first
-	SerializeStruct(OutObject, Struct, ObjectHierarchySerializer);
+	SerializeStruct(OutObject, Struct, ObjectHierarchySerializer, NULL, bForceSingleThread);
 
 	//Serialize struct flags
 	OutObject->SetNumberField(TEXT("StructFlags"), Struct->StructFlags);
@@ -239,13 +279,13 @@ void FAssetHelper::SerializeEnum(TSharedPtr<FJsonObject> OutObject, UEnum* Enum)
 	OutObject->SetNumberField(TEXT("CppForm"), (uint8)Enum->GetCppForm());
 }
 
-void FAssetHelper::SerializeFunction(TSharedPtr<FJsonObject> OutObject, UFunction* Function, UObjectHierarchySerializer* ObjectHierarchySerializer) {
+void FAssetHelper::SerializeFunction(TSharedPtr<FJsonObject> OutObject, UFunction* Function, UObjectHierarchySerializer* ObjectHierarchySerializer, TSharedPtr<FJsonObject> DisassembledScript) {
 	OutObject->SetStringField(TEXT("ObjectClass"), UFunction::StaticClass()->GetName());
 	OutObject->SetStringField(TEXT("ObjectName"), Function->GetName());
 
 	//Serialize super Struct data
 	//It will also serialize script bytecode for function
-	SerializeStruct(OutObject, Function, ObjectHierarchySerializer);
+	SerializeStruct(OutObject, Function, ObjectHierarchySerializer, DisassembledScript);
 
 	//Save function flags
 	const EFunctionFlags FunctionFlags = Function->FunctionFlags;
@@ -270,6 +310,54 @@ FString FAssetHelper::ComputePayloadHash(const TArray<uint8>& Payload) {
 	return Hash;
 }
 
+#define TRANSFORM_NUMBER_COUNT 10
+
+TSharedRef<FJsonValue> FAssetHelper::SerializeTransform(const FTransform& Transform) {
+	const FVector Translation = Transform.GetTranslation();
+	const FQuat Rotation = Transform.GetRotation();
+	const FVector Scale = Transform.GetScale3D();
+	const float Numbers[TRANSFORM_NUMBER_COUNT] = {
+		Translation.X, Translation.Y, Translation.Z,
+		Rotation.X, Rotation.Y, Rotation.Z, Rotation.W,
+		Scale.X, Scale.Y, Scale.Z
+	};
+
+	//Floats are converted to doubles exactly, and written with enough digits to be read back without any loss
+	TArray<TSharedPtr<FJsonValue>> NumberValues;
+	NumberValues.Reserve(TRANSFORM_NUMBER_COUNT);
+	for (const float Number : Numbers) {
+		NumberValues.Add(MakeShareable(new FJsonValueNumber(Number)));
+	}
+	return MakeShareable(new FJsonValueArray(NumberValues));
+}
+
+bool FAssetHelper::DeserializeTransform(const TSharedPtr<FJsonValue>& Value, FTransform& OutTransform) {
+	if (!Value.IsValid()) {
+		return false;
+	}
+	//Dumps made before the numeric encoding contain the transform formatted by FTransform::ToString
+	if (Value->Type == EJson::String) {
+		return OutTransform.InitFromString(Value->AsString());
+	}
+	if (Value->Type != EJson::Array) {
+		return false;
+	}
+	const TArray<TSharedPtr<FJsonValue>>& NumberValues = Value->AsArray();
+	if (NumberValues.Num() != TRANSFORM_NUMBER_COUNT) {
+		return false;
+	}
+
+	float Numbers[TRANSFORM_NUMBER_COUNT];
+	for (int32 i = 0; i < TRANSFORM_NUMBER_COUNT; i++) {
+		Numbers[i] = (float) NumberValues[i]->AsNumber();
+	}
+	OutTransform.SetComponents(
+		FQuat(Numbers[3], Numbers[4], Numbers[5], Numbers[6]),
+		FVector(Numbers[0], Numbers[1], Numbers[2]),
+		FVector(Numbers[7], Numbers[8], Numbers[9]));
+	return true;
+}
+
 
 
 
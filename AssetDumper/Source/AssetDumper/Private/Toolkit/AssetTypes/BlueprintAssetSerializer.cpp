@@ -54,7 +54,7 @@ void UBlueprintAssetSerializer::SerializeBlueprintClass(UBlueprintGeneratedClass
     UObjectHierarchySerializer* ObjectSerializer = Context->GetObjectSerializer();
     
     //Serialize normal UClass object with all the properties
-    FAssetHelper::SerializeClass(Data, Asset, ObjectSerializer);
+    FAssetHelper::SerializeClass(Data, Asset, ObjectSerializer, Context->ShouldForceSingleThread());
     
     //Disable cooked data serialization and also direct uber graph function ref
     DISABLE_SERIALIZATION(USCS_Node, CookedComponentInstancingData);
@@ -0,0 +1,188 @@
+#include "Toolkit/AssetTypes/MeshDumpFormat.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#define MESH_DUMP_FILE_MAGIC 0x48534D44
+#define MESH_DUMP_FILE_VERSION 1
+
+const TCHAR* FDumpedMeshData::FileExtension = TEXT("mesh");
+
+FDumpedMeshSection::FDumpedMeshSection() : MaterialIndex(0), FirstIndex(0), NumTriangles(0) {
+}
+
+FArchive& operator<<(FArchive& Ar, FDumpedMeshSection& Section) {
+	Ar << Section.MaterialIndex;
+	Ar << Section.FirstIndex;
+	Ar << Section.NumTriangles;
+	return Ar;
+}
+
+FDumpedMeshLOD::FDumpedMeshLOD() : ScreenSize(0.0f), NumInfluencesPerVertex(0) {
+}
+
+FArchive& operator<<(FArchive& Ar, FDumpedMeshLOD& LOD) {
+	Ar << LOD.ScreenSize;
+	LOD.Positions.BulkSerialize(Ar);
+	LOD.Normals.BulkSerialize(Ar);
+	LOD.Tangents.BulkSerialize(Ar);
+
+	int32 NumTexCoords = LOD.TexCoords.Num();
+	Ar << NumTexCoords;
+	if (Ar.IsLoading()) {
+		if (NumTexCoords < 0) {
+			Ar.SetError();
+			return Ar;
+		}
+		LOD.TexCoords.SetNum(NumTexCoords);
+	}
+	for (TArray<FVector2D>& ChannelTexCoords : LOD.TexCoords) {
+		ChannelTexCoords.BulkSerialize(Ar);
+	}
+
+	LOD.Colors.BulkSerialize(Ar);
+	LOD.Indices.BulkSerialize(Ar);
+	Ar << LOD.Sections;
+
+	Ar << LOD.NumInfluencesPerVertex;
+	LOD.InfluenceBones.BulkSerialize(Ar);
+	LOD.InfluenceWeights.BulkSerialize(Ar);
+	return Ar;
+}
+
+FDumpedMeshBone::FDumpedMeshBone() : ParentIndex(INDEX_NONE) {
+}
+
+FArchive& operator<<(FArchive& Ar, FDumpedMeshBone& Bone) {
+	Ar << Bone.Name;
+	Ar << Bone.ParentIndex;
+	Ar << Bone.Pose;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FDumpedMeshData& MeshData) {
+	Ar << MeshData.MaterialSlotNames;
+	Ar << MeshData.LODs;
+	Ar << MeshData.Bones;
+	return Ar;
+}
+
+bool FDumpedMeshData::Validate(FString& OutErrorMessage) const {
+	for (int32 BoneIndex = 0; BoneIndex < Bones.Num(); BoneIndex++) {
+		//Parent bones always precede their children in the reference skeleton
+		const int32 ParentIndex = Bones[BoneIndex].ParentIndex;
+		if (ParentIndex >= BoneIndex || (ParentIndex == INDEX_NONE) != (BoneIndex == 0)) {
+			OutErrorMessage = FString::Printf(TEXT("Bone %d (%s) has invalid parent index %d"), BoneIndex, *Bones[BoneIndex].Name, ParentIndex);
+			return false;
+		}
+	}
+
+	for (int32 LODIndex = 0; LODIndex < LODs.Num(); LODIndex++) {
+		const FDumpedMeshLOD& LOD = LODs[LODIndex];
+		const int32 NumVertices = LOD.GetNumVertices();
+
+		bool bAttributesValid = LOD.Normals.Num() == NumVertices && LOD.Tangents.Num() == NumVertices;
+		bAttributesValid &= LOD.Colors.Num() == 0 || LOD.Colors.Num() == NumVertices;
+		for (const TArray<FVector2D>& ChannelTexCoords : LOD.TexCoords) {
+			bAttributesValid &= ChannelTexCoords.Num() == NumVertices;
+		}
+		if (!bAttributesValid) {
+			OutErrorMessage = FString::Printf(TEXT("LOD %d has vertex attributes not matching vertex count %d"), LODIndex, NumVertices);
+			return false;
+		}
+
+		if (LOD.Indices.Num() % 3 != 0) {
+			OutErrorMessage = FString::Printf(TEXT("LOD %d has %d indices, which is not a triangle list"), LODIndex, LOD.Indices.Num());
+			return false;
+		}
+		for (const uint32 VertexIndex : LOD.Indices) {
+			if (VertexIndex >= (uint32) NumVertices) {
+				OutErrorMessage = FString::Printf(TEXT("LOD %d references vertex %u out of %d"), LODIndex, VertexIndex, NumVertices);
+				return false;
+			}
+		}
+
+		for (const FDumpedMeshSection& Section : LOD.Sections) {
+			const int64 LastIndex = (int64) Section.FirstIndex + (int64) Section.NumTriangles * 3;
+			if (Section.FirstIndex < 0 || Section.NumTriangles < 0 || LastIndex > LOD.Indices.Num()) {
+				OutErrorMessage = FString::Printf(TEXT("LOD %d has section outside of the index buffer"), LODIndex);
+				return false;
+			}
+			if (!MaterialSlotNames.IsValidIndex(Section.MaterialIndex)) {
+				OutErrorMessage = FString::Printf(TEXT("LOD %d has section with invalid material index %d"), LODIndex, Section.MaterialIndex);
+				return false;
+			}
+		}
+
+		if (LOD.NumInfluencesPerVertex < 0 || (LOD.NumInfluencesPerVertex > 0 && !IsSkeletalMesh())) {
+			OutErrorMessage = FString::Printf(TEXT("LOD %d has skin weights but mesh has no reference skeleton"), LODIndex);
+			return false;
+		}
+		const int64 NumInfluences = (int64) NumVertices * LOD.NumInfluencesPerVertex;
+		if (LOD.InfluenceBones.Num() != NumInfluences || LOD.InfluenceWeights.Num() != NumInfluences) {
+			OutErrorMessage = FString::Printf(TEXT("LOD %d has influence count not matching vertex count %d"), LODIndex, NumVertices);
+			return false;
+		}
+		for (const uint16 BoneIndex : LOD.InfluenceBones) {
+			if (BoneIndex >= Bones.Num()) {
+				OutErrorMessage = FString::Printf(TEXT("LOD %d references bone %d out of %d"), LODIndex, BoneIndex, Bones.Num());
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void FDumpedMeshData::SaveToBytes(TArray<uint8>& OutBytes) const {
+	FMemoryWriter Writer(OutBytes);
+	uint32 FileMagic = MESH_DUMP_FILE_MAGIC;
+	int32 FileVersion = MESH_DUMP_FILE_VERSION;
+
+	Writer << FileMagic;
+	Writer << FileVersion;
+	//Serialization operator is shared between loading and saving, so it cannot take a const reference
+	Writer << const_cast<FDumpedMeshData&>(*this);
+}
+
+bool FDumpedMeshData::LoadFromBytes(const TArray<uint8>& Bytes, FString& OutErrorMessage) {
+	FMemoryReader Reader(Bytes);
+	uint32 FileMagic = 0;
+	int32 FileVersion = 0;
+
+	Reader << FileMagic;
+	if (FileMagic != MESH_DUMP_FILE_MAGIC) {
+		OutErrorMessage = TEXT("Not a dumped mesh file");
+		return false;
+	}
+	Reader << FileVersion;
+	if (FileVersion <= 0 || FileVersion > MESH_DUMP_FILE_VERSION) {
+		OutErrorMessage = FString::Printf(TEXT("Unsupported dumped mesh file version %d"), FileVersion);
+		return false;
+	}
+
+	Reader << *this;
+	if (Reader.IsError() || !Reader.AtEnd()) {
+		OutErrorMessage = TEXT("Dumped mesh file is truncated or corrupted");
+		return false;
+	}
+	return Validate(OutErrorMessage);
+}
+
+bool FDumpedMeshData::LoadFromFile(const FString& FilePath, FString& OutErrorMessage) {
+	TArray<uint8> FileBytes;
+	if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath)) {
+		OutErrorMessage = FString::Printf(TEXT("Failed to read file %s"), *FilePath);
+		return false;
+	}
+	return LoadFromBytes(FileBytes, OutErrorMessage);
+}
+
+FString FDumpedMeshData::ComputeFileHash(const TArray<uint8>& Bytes) {
+	FMD5 MD5;
+	MD5.Update(Bytes.GetData(), Bytes.Num());
+
+	FMD5Hash FileHash;
+	FileHash.Set(MD5);
+	return LexToString(FileHash);
+}
@@ -1,5 +1,10 @@
 #include "Toolkit/AssetTypes/SkeletalMeshAssetSerializer.h"
-//#include "Toolkit/AssetTypes/FbxMeshExporter.h"
+#include "Toolkit/AssetTypes/MeshDumpFormat.h"
+#include "Toolkit/AssetTypes/AssetHelper.h"
+#include "Toolkit/AssetTypes/StaticMeshAssetSerializer.h"
+#include "AssetDumperModule.h"
+#include "Misc/FileHelper.h"
+#include "Rendering/SkeletalMeshRenderData.h"
 #include "Toolkit/PropertySerializer.h"
 #include "Engine/SkeletalMesh.h"
 #include "Materials/MaterialInterface.h"
@@ -8,6 +13,78 @@
 #include "Toolkit/AssetDumping/AssetTypeSerializerMacros.h"
 #include "Toolkit/AssetDumping/SerializationContext.h"
 
+/** Skeletal mesh render data captured on the game thread */
+struct FSkeletalMeshDumpSnapshot : public FAssetSerializationSnapshot {
+	/** Mesh data copied from the render data, empty if CPU copy of the render data is not available */
+	FDumpedMeshData MeshData;
+	FString MeshDataErrorMessage;
+};
+
+void USkeletalMeshAssetSerializer::CaptureAssetSnapshot(TSharedRef<FSerializationContext> Context) const {
+	USkeletalMesh* Asset = Context->GetAsset<USkeletalMesh>();
+	const TSharedRef<FSkeletalMeshDumpSnapshot> Snapshot = MakeShared<FSkeletalMeshDumpSnapshot>();
+	FDumpedMeshData& MeshData = Snapshot->MeshData;
+
+	for (const FSkeletalMaterial& SkeletalMaterial : Asset->Materials) {
+		MeshData.MaterialSlotNames.Add(SkeletalMaterial.MaterialSlotName.ToString());
+	}
+
+	const FReferenceSkeleton& ReferenceSkeleton = Asset->RefSkeleton;
+	for (int32 BoneIndex = 0; BoneIndex < ReferenceSkeleton.GetRawBoneNum(); BoneIndex++) {
+		FDumpedMeshBone& Bone = MeshData.Bones.AddDefaulted_GetRef();
+		Bone.Name = ReferenceSkeleton.GetRawRefBoneInfo()[BoneIndex].Name.ToString();
+		Bone.ParentIndex = ReferenceSkeleton.GetRawRefBoneInfo()[BoneIndex].ParentIndex;
+		Bone.Pose = ReferenceSkeleton.GetRawRefBonePose()[BoneIndex];
+	}
+
+	FSkeletalMeshRenderData* RenderData = Asset->GetResourceForRendering();
+	const int32 NumLODs = RenderData != NULL ? RenderData->LODRenderData.Num() : 0;
+	
+	for (int32 LODIndex = 0; LODIndex < NumLODs; LODIndex++) {
+		FSkeletalMeshLODRenderData& LODRenderData = RenderData->LODRenderData[LODIndex];
+		const FSkinWeightVertexBuffer& SkinWeightBuffer = LODRenderData.SkinWeightVertexBuffer;
+		FDumpedMeshLOD& LOD = MeshData.LODs.AddDefaulted_GetRef();
+
+		const FSkeletalMeshLODInfo* LODInfo = Asset->GetLODInfo(LODIndex);
+		LOD.ScreenSize = LODInfo ? LODInfo->ScreenSize.Default : 0.0f;
+
+		if (!UStaticMeshAssetSerializer::CaptureVertexBuffers(LODRenderData.StaticVertexBuffers, LOD)) {
+			Snapshot->MeshDataErrorMessage = FString::Printf(TEXT("CPU copy of the LOD %d vertex data is not available"), LODIndex);
+			MeshData.LODs.Empty();
+			break;
+		}
+		LODRenderData.MultiSizeIndexContainer.GetIndexBuffer(LOD.Indices);
+
+		const int32 NumInfluences = SkinWeightBuffer.GetMaxBoneInfluences();
+		LOD.NumInfluencesPerVertex = NumInfluences;
+		LOD.InfluenceBones.SetNumZeroed(LOD.GetNumVertices() * NumInfluences);
+		LOD.InfluenceWeights.SetNumZeroed(LOD.GetNumVertices() * NumInfluences);
+
+		for (const FSkelMeshRenderSection& RenderSection : LODRenderData.RenderSections) {
+			FDumpedMeshSection& Section = LOD.Sections.AddDefaulted_GetRef();
+			Section.MaterialIndex = RenderSection.MaterialIndex;
+			Section.FirstIndex = RenderSection.BaseIndex;
+			Section.NumTriangles = RenderSection.NumTriangles;
+
+			//Skin weights reference bones through the section bone map, remap them to the reference skeleton bones
+			const uint32 LastVertexIndex = FMath::Min(RenderSection.BaseVertexIndex + RenderSection.NumVertices, (uint32) LOD.GetNumVertices());
+			for (uint32 VertexIndex = RenderSection.BaseVertexIndex; VertexIndex < LastVertexIndex; VertexIndex++) {
+				for (int32 InfluenceIndex = 0; InfluenceIndex < NumInfluences; InfluenceIndex++) {
+					const uint8 BoneWeight = SkinWeightBuffer.GetBoneWeight(VertexIndex, InfluenceIndex);
+					const uint32 SectionBoneIndex = SkinWeightBuffer.GetBoneIndex(VertexIndex, InfluenceIndex);
+					
+					if (BoneWeight != 0 && RenderSection.BoneMap.IsValidIndex(SectionBoneIndex)) {
+						const int32 InfluenceOffset = VertexIndex * NumInfluences + InfluenceIndex;
+						LOD.InfluenceBones[InfluenceOffset] = RenderSection.BoneMap[SectionBoneIndex];
+						LOD.InfluenceWeights[InfluenceOffset] = BoneWeight;
+					}
+				}
+			}
+		}
+	}
+	Context->SetSnapshot(Snapshot);
+}
+
 void USkeletalMeshAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext> Context) const {
 	BEGIN_ASSET_SERIALIZATION(USkeletalMesh)
 
@@ -41,16 +118,23 @@ void USkeletalMeshAssetSerializer::SerializeAsset(TSharedRef<FSerializationConte
 		Data->SetNumberField(TEXT("BodySetup"), ObjectSerializer->SerializeObject(Asset->BodySetup));
 	}
 
-	//Export raw mesh data into separate FBX file that can be imported back into UE
-	const FString OutFbxMeshFileName = Context->GetDumpFilePath(TEXT(""), TEXT("fbx"));
-
-	FString OutErrorMessage;
-	//const bool bSuccess = FFbxMeshExporter::ExportSkeletalMeshIntoFbxFile(Asset, OutFbxMeshFileName, false, &OutErrorMessage);
-	//checkf(bSuccess, TEXT("Failed to export skeletal mesh %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
-
-	//Serialize exported model hash to avoid reading it during generation pass
-	//const FMD5Hash ModelFileHash = FMD5Hash::HashFile(*OutFbxMeshFileName);
-	//Data->SetStringField(TEXT("ModelFileHash"), LexToString(ModelFileHash));
+	//Export raw mesh data into separate mesh file that can be imported back into UE
+	const FSkeletalMeshDumpSnapshot& Snapshot = Context->GetSnapshot<FSkeletalMeshDumpSnapshot>();
+	
+	FString OutErrorMessage = Snapshot.MeshDataErrorMessage;
+	if (OutErrorMessage.IsEmpty() && Snapshot.MeshData.Validate(OutErrorMessage)) {
+		TArray<uint8> MeshFileBytes;
+		Snapshot.MeshData.SaveToBytes(MeshFileBytes);
+
+		const FString OutMeshFileName = Context->GetDumpFilePath(TEXT(""), FDumpedMeshData::FileExtension);
+		const bool bSuccess = FFileHelper::SaveArrayToFile(MeshFileBytes, *OutMeshFileName);
+		checkf(bSuccess, TEXT("Failed to write skeletal mesh file %s"), *OutMeshFileName);
+
+		//Serialize exported model hash to avoid reading it during generation pass
+		Data->SetStringField(TEXT("ModelFileHash"), FDumpedMeshData::ComputeFileHash(MeshFileBytes));
+	} else {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to export skeletal mesh %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
+	}
 
 	END_ASSET_SERIALIZATION
 }
@@ -66,7 +150,7 @@ void USkeletalMeshAssetSerializer::SerializeReferenceSkeleton(const FReferenceSk
 		BoneObject->SetStringField(TEXT("Name"), BoneInfo.Name.ToString());
 		BoneObject->SetNumberField(TEXT("ParentIndex"), BoneInfo.ParentIndex);
 		BoneObject->SetNumberField(TEXT("Index"), i);
-		BoneObject->SetStringField(TEXT("Pose"), PoseTransform.ToString());
+		BoneObject->SetField(TEXT("Pose"), FAssetHelper::SerializeTransform(PoseTransform));
 
 		SkeletonBones.Add(MakeShareable(new FJsonValueObject(BoneObject)));
 	}
@@ -81,5 +165,6 @@ FName USkeletalMeshAssetSerializer::GetAssetClass() const {
 }
 
 bool USkeletalMeshAssetSerializer::SupportsParallelDumping() const {
-	return false;
+	//Render data is copied in CaptureAssetSnapshot, everything else is safe to serialize from the worker threads
+	return true;
 }
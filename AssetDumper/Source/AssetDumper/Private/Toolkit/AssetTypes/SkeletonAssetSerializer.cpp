@@ -8,6 +8,30 @@
 #include "Toolkit/AssetDumping/AssetTypeSerializerMacros.h"
 #include "Toolkit/AssetDumping/SerializationContext.h"
 
+/** Skeleton bone data captured on the game thread, skeletons are shared with the meshes and animations being loaded meanwhile */
+struct FSkeletonDumpSnapshot : public FAssetSerializationSnapshot {
+	FReferenceSkeleton ReferenceSkeleton;
+	TArray<FVirtualBone> VirtualBones;
+	TArray<EBoneTranslationRetargetingMode::Type> BoneRetargetingModes;
+	TArray<FReferencePose> AnimRetargetSources;
+};
+
+void USkeletonAssetSerializer::CaptureAssetSnapshot(TSharedRef<FSerializationContext> Context) const {
+	USkeleton* Asset = Context->GetAsset<USkeleton>();
+	const TSharedRef<FSkeletonDumpSnapshot> Snapshot = MakeShared<FSkeletonDumpSnapshot>();
+
+	Snapshot->ReferenceSkeleton = Asset->GetReferenceSkeleton();
+	Snapshot->VirtualBones = Asset->GetVirtualBones();
+	
+	for (int32 i = 0; i < Snapshot->ReferenceSkeleton.GetRawBoneNum(); i++) {
+		Snapshot->BoneRetargetingModes.Add(Asset->GetBoneTranslationRetargetingMode(i));
+	}
+	for (const TPair<FName, FReferencePose>& Pair : Asset->AnimRetargetSources) {
+		Snapshot->AnimRetargetSources.Add(Pair.Value);
+	}
+	Context->SetSnapshot(Snapshot);
+}
+
 void USkeletonAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext> Context) const {
 	BEGIN_ASSET_SERIALIZATION(USkeleton)
 
@@ -16,14 +40,15 @@ void USkeletonAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext>
 	DISABLE_SERIALIZATION_RAW(USkeleton, "VirtualBones");
 
 	//Serialize reference skeleton object
+	const FSkeletonDumpSnapshot& Snapshot = Context->GetSnapshot<FSkeletonDumpSnapshot>();
 	const TSharedPtr<FJsonObject> ReferenceSkeleton = MakeShareable(new FJsonObject());
-	USkeletalMeshAssetSerializer::SerializeReferenceSkeleton(Asset->GetReferenceSkeleton(), ReferenceSkeleton);
+	USkeletalMeshAssetSerializer::SerializeReferenceSkeleton(Snapshot.ReferenceSkeleton, ReferenceSkeleton);
 	Data->SetObjectField(TEXT("ReferenceSkeleton"), ReferenceSkeleton);
 
 	//Serialize virtual bones
 	TArray<TSharedPtr<FJsonValue>> VirtualBones;
 
-	for (const FVirtualBone& VirtualBone : Asset->GetVirtualBones()) {
+	for (const FVirtualBone& VirtualBone : Snapshot.VirtualBones) {
 		const TSharedPtr<FJsonObject> VirtualBoneNode = MakeShareable(new FJsonObject());
 
 		VirtualBoneNode->SetStringField(TEXT("SourceBoneName"), VirtualBone.SourceBoneName.ToString());
@@ -36,8 +61,7 @@ void USkeletonAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext>
 	//Serialize bone tree translation retargeting modes
 	TArray<TSharedPtr<FJsonValue>> BoneTree;
 
-	for (int32 i = 0; i < Asset->GetReferenceSkeleton().GetRawBoneNum(); i++) {
-		const EBoneTranslationRetargetingMode::Type RetargetingType = Asset->GetBoneTranslationRetargetingMode(i);
+	for (const EBoneTranslationRetargetingMode::Type RetargetingType : Snapshot.BoneRetargetingModes) {
 		BoneTree.Add(MakeShareable(new FJsonValueNumber((int32)RetargetingType)));
 	}
 	Data->SetArrayField(TEXT("BoneTree"), BoneTree);
@@ -45,13 +69,13 @@ void USkeletonAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext>
 	//Serialize animation retarget sources
 	TArray<TSharedPtr<FJsonValue>> AnimRetargetSources;
 
-	for (const TPair<FName, FReferencePose>& Pair : Asset->AnimRetargetSources) {
+	for (const FReferencePose& RetargetSource : Snapshot.AnimRetargetSources) {
 		TSharedRef<FJsonObject> Value = MakeShareable(new FJsonObject());
-		Value->SetStringField(TEXT("PoseName"), Pair.Value.PoseName.ToString());
+		Value->SetStringField(TEXT("PoseName"), RetargetSource.PoseName.ToString());
 
 		TArray<TSharedPtr<FJsonValue>> ReferencePose;
-		for (const FTransform& Transform : Pair.Value.ReferencePose) {
-			ReferencePose.Add(MakeShareable(new FJsonValueString(Transform.ToString())));
+		for (const FTransform& Transform : RetargetSource.ReferencePose) {
+			ReferencePose.Add(FAssetHelper::SerializeTransform(Transform));
 		}
 		Value->SetArrayField(TEXT("ReferencePose"), ReferencePose);
 		AnimRetargetSources.Add(MakeShareable(new FJsonValueObject(Value)));
@@ -119,5 +143,5 @@ FName USkeletonAssetSerializer::GetAssetClass() const {
 }
 
 bool USkeletonAssetSerializer::SupportsParallelDumping() const {
-	return false;
+	return true;
 }
@@ -1,7 +1,10 @@
 ﻿#include "Toolkit/AssetTypes/StaticMeshAssetSerializer.h"
 #include "AI/Navigation/NavCollisionBase.h"
-//#include "Toolkit/AssetTypes/FbxMeshExporter.h"
+#include "Toolkit/AssetTypes/MeshDumpFormat.h"
+#include "AssetDumperModule.h"
 #include "Engine/StaticMesh.h"
+#include "Misc/FileHelper.h"
+#include "Rendering/StaticMeshVertexBuffers.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "Dom/JsonObject.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
@@ -9,6 +12,94 @@
 #include "Toolkit/AssetDumping/AssetTypeSerializerMacros.h"
 #include "Toolkit/AssetDumping/SerializationContext.h"
 
+/** Static mesh render data captured on the game thread */
+struct FStaticMeshDumpSnapshot : public FAssetSerializationSnapshot {
+	int32 MinimumLodNumber;
+	int32 LodNumber;
+	TArray<float> ScreenSize;
+	/** Mesh data copied from the render data, empty if CPU copy of the render data is not available */
+	FDumpedMeshData MeshData;
+	FString MeshDataErrorMessage;
+};
+
+bool UStaticMeshAssetSerializer::CaptureVertexBuffers(FStaticMeshVertexBuffers& VertexBuffers, FDumpedMeshLOD& OutLOD) {
+	FPositionVertexBuffer& PositionBuffer = VertexBuffers.PositionVertexBuffer;
+	FStaticMeshVertexBuffer& VertexBuffer = VertexBuffers.StaticMeshVertexBuffer;
+	const FColorVertexBuffer& ColorBuffer = VertexBuffers.ColorVertexBuffer;
+	const uint32 NumVertices = PositionBuffer.GetNumVertices();
+
+	//CPU copy of the vertex data is discarded after it has been uploaded to the GPU, unless mesh requested CPU access
+	if (NumVertices == 0 || PositionBuffer.GetVertexData() == NULL || VertexBuffer.GetTangentData() == NULL) {
+		return false;
+	}
+	const uint32 NumTexCoords = VertexBuffer.GetNumTexCoords();
+	const bool bHasVertexColors = ColorBuffer.GetNumVertices() == NumVertices;
+	
+	OutLOD.Positions.SetNumUninitialized(NumVertices);
+	OutLOD.Normals.SetNumUninitialized(NumVertices);
+	OutLOD.Tangents.SetNumUninitialized(NumVertices);
+	OutLOD.TexCoords.SetNum(NumTexCoords);
+	for (TArray<FVector2D>& ChannelTexCoords : OutLOD.TexCoords) {
+		ChannelTexCoords.SetNumUninitialized(NumVertices);
+	}
+	if (bHasVertexColors) {
+		OutLOD.Colors.SetNumUninitialized(NumVertices);
+	}
+
+	for (uint32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++) {
+		const FVector4 TangentX = VertexBuffer.VertexTangentX(VertexIndex);
+		const FVector4 TangentZ = VertexBuffer.VertexTangentZ(VertexIndex);
+
+		OutLOD.Positions[VertexIndex] = PositionBuffer.VertexPosition(VertexIndex);
+		OutLOD.Normals[VertexIndex] = FVector(TangentZ);
+		OutLOD.Tangents[VertexIndex] = FVector4(FVector(TangentX), TangentZ.W);
+		
+		for (uint32 TexCoordIndex = 0; TexCoordIndex < NumTexCoords; TexCoordIndex++) {
+			OutLOD.TexCoords[TexCoordIndex][VertexIndex] = VertexBuffer.GetVertexUV(VertexIndex, TexCoordIndex);
+		}
+		if (bHasVertexColors) {
+			OutLOD.Colors[VertexIndex] = ColorBuffer.VertexColor(VertexIndex);
+		}
+	}
+	return true;
+}
+
+void UStaticMeshAssetSerializer::CaptureAssetSnapshot(TSharedRef<FSerializationContext> Context) const {
+	UStaticMesh* Asset = Context->GetAsset<UStaticMesh>();
+	const TSharedRef<FStaticMeshDumpSnapshot> Snapshot = MakeShared<FStaticMeshDumpSnapshot>();
+	
+	Snapshot->MinimumLodNumber = Asset->MinLOD.Default;
+	Snapshot->LodNumber = Asset->GetNumLODs();
+	for (int32 i = 0; i < MAX_STATIC_MESH_LODS; i++) {
+		Snapshot->ScreenSize.Add(Asset->RenderData->ScreenSize[i].Default);
+	}
+
+	for (const FStaticMaterial& StaticMaterial : Asset->StaticMaterials) {
+		Snapshot->MeshData.MaterialSlotNames.Add(StaticMaterial.MaterialSlotName.ToString());
+	}
+	
+	for (int32 LODIndex = 0; LODIndex < Asset->RenderData->LODResources.Num(); LODIndex++) {
+		FStaticMeshLODResources& LODResources = Asset->RenderData->LODResources[LODIndex];
+		FDumpedMeshLOD& LOD = Snapshot->MeshData.LODs.AddDefaulted_GetRef();
+		LOD.ScreenSize = Asset->RenderData->ScreenSize[LODIndex].Default;
+
+		if (!CaptureVertexBuffers(LODResources.VertexBuffers, LOD)) {
+			Snapshot->MeshDataErrorMessage = FString::Printf(TEXT("CPU copy of the LOD %d vertex data is not available"), LODIndex);
+			Snapshot->MeshData.LODs.Empty();
+			break;
+		}
+		LODResources.IndexBuffer.GetCopy(LOD.Indices);
+		
+		for (const FStaticMeshSection& RenderSection : LODResources.Sections) {
+			FDumpedMeshSection& Section = LOD.Sections.AddDefaulted_GetRef();
+			Section.MaterialIndex = RenderSection.MaterialIndex;
+			Section.FirstIndex = RenderSection.FirstIndex;
+			Section.NumTriangles = RenderSection.NumTriangles;
+		}
+	}
+	Context->SetSnapshot(Snapshot);
+}
+
 void UStaticMeshAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext> Context) const {
 	BEGIN_ASSET_SERIALIZATION(UStaticMesh)
 
@@ -38,24 +129,31 @@ void UStaticMeshAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext
 	Data->SetNumberField(TEXT("BodySetup"), ObjectSerializer->SerializeObject(Asset->BodySetup));
 
 	//Serialize screen LOD sizes to carry them to the editor
-	Data->SetNumberField(TEXT("MinimumLodNumber"), Asset->MinLOD.Default);
-	Data->SetNumberField(TEXT("LodNumber"), Asset->GetNumLODs());
+	const FStaticMeshDumpSnapshot& Snapshot = Context->GetSnapshot<FStaticMeshDumpSnapshot>();
+	Data->SetNumberField(TEXT("MinimumLodNumber"), Snapshot.MinimumLodNumber);
+	Data->SetNumberField(TEXT("LodNumber"), Snapshot.LodNumber);
 
 	TArray<TSharedPtr<FJsonValue>> ScreenSize;
-	for (int32 i = 0; i < MAX_STATIC_MESH_LODS; i++) {
-		ScreenSize.Add(MakeShareable(new FJsonValueNumber(Asset->RenderData->ScreenSize[i].Default)));
+	for (const float LodScreenSize : Snapshot.ScreenSize) {
+		ScreenSize.Add(MakeShareable(new FJsonValueNumber(LodScreenSize)));
 	}
 	Data->SetArrayField(TEXT("ScreenSize"), ScreenSize);
 
-	//Export raw mesh data into separate FBX file that can be imported back into UE
-	const FString OutFbxMeshFileName = Context->GetDumpFilePath(TEXT(""), TEXT("fbx"));
-	FString OutErrorMessage;
-	//const bool bSuccess = FFbxMeshExporter::ExportStaticMeshIntoFbxFile(Asset, OutFbxMeshFileName, false, &OutErrorMessage);
-	//checkf(bSuccess, TEXT("Failed to export static mesh %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
+	//Export raw mesh data into separate mesh file that can be imported back into UE
+	FString OutErrorMessage = Snapshot.MeshDataErrorMessage;
+	if (OutErrorMessage.IsEmpty() && Snapshot.MeshData.Validate(OutErrorMessage)) {
+		TArray<uint8> MeshFileBytes;
+		Snapshot.MeshData.SaveToBytes(MeshFileBytes);
+		
+		const FString OutMeshFileName = Context->GetDumpFilePath(TEXT(""), FDumpedMeshData::FileExtension);
+		const bool bSuccess = FFileHelper::SaveArrayToFile(MeshFileBytes, *OutMeshFileName);
+		checkf(bSuccess, TEXT("Failed to write static mesh file %s"), *OutMeshFileName);
 
-	//Serialize exported model hash to avoid reading it during generation pass
-	//const FMD5Hash ModelFileHash = FMD5Hash::HashFile(*OutFbxMeshFileName);
-	//Data->SetStringField(TEXT("ModelFileHash"), LexToString(ModelFileHash));
+		//Serialize exported model hash to avoid reading it during generation pass
+		Data->SetStringField(TEXT("ModelFileHash"), FDumpedMeshData::ComputeFileHash(MeshFileBytes));
+	} else {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to export static mesh %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
+	}
 
 	END_ASSET_SERIALIZATION
 }
@@ -65,5 +163,6 @@ FName UStaticMeshAssetSerializer::GetAssetClass() const {
 }
 
 bool UStaticMeshAssetSerializer::SupportsParallelDumping() const {
-	return false;
+	//Render data is copied in CaptureAssetSnapshot, everything else is safe to serialize from the worker threads
+	return true;
 }
@@ -8,7 +8,7 @@
 
 void UUserDefinedStructAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext> Context) const {
     BEGIN_ASSET_SERIALIZATION(UUserDefinedStruct)
-    FAssetHelper::SerializeScriptStruct(Data, Asset, ObjectSerializer);
+    FAssetHelper::SerializeScriptStruct(Data, Asset, ObjectSerializer, Context->ShouldForceSingleThread());
 
     //Serialize Struct GUID
     Data->SetStringField(TEXT("Guid"), Asset->Guid.ToString());
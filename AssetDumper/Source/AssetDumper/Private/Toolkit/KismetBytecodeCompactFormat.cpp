@@ -0,0 +1,382 @@
+#include "Toolkit/KismetBytecodeCompactFormat.h"
+#include "Dom/JsonValue.h"
+#include "Misc/Base64.h"
+#include "Misc/CommandLine.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogKismetBytecodeCompactFormat, Error, Log);
+
+#define COMPACT_BYTECODE_MAGIC 0x5343424B
+#define COMPACT_BYTECODE_VERSION 1
+//Statement trees are never nested that deep, it only guards the reader against corrupted data
+#define COMPACT_BYTECODE_MAX_DEPTH 512
+
+/** Type tags preceding every encoded value */
+enum class ECompactValueType : uint8 {
+	Null,
+	False,
+	True,
+	String,
+	/** Integral numbers fitting into uint32, which are most numbers in the disassembled bytecode (offsets, indices) */
+	UnsignedInteger,
+	Number,
+	Array,
+	Object
+};
+
+/** String table keys should be case sensitive, unlike default FString map keys, since string values are literals */
+struct FCaseSensitiveStringKeyFuncs : BaseKeyFuncs<TPair<FString, uint32>, FString, false> {
+	static FORCEINLINE const FString& GetSetKey(const TPair<FString, uint32>& Element) {
+		return Element.Key;
+	}
+	static FORCEINLINE bool Matches(const FString& A, const FString& B) {
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+	static FORCEINLINE uint32 GetKeyHash(const FString& Key) {
+		return FCrc::StrCrc32(*Key);
+	}
+};
+
+struct FCompactStatementWriter {
+	FMemoryWriter& Writer;
+	TMap<FString, uint32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs> StringIndices;
+	TArray<FString> StringTable;
+
+	explicit FCompactStatementWriter(FMemoryWriter& Writer) : Writer(Writer) {}
+
+	void WriteString(const FString& String) {
+		uint32 StringIndex;
+		if (const uint32* ExistingIndex = StringIndices.Find(String)) {
+			StringIndex = *ExistingIndex;
+		}
+		else {
+			StringIndex = StringTable.Add(String);
+			StringIndices.Add(String, StringIndex);
+		}
+		Writer.SerializeIntPacked(StringIndex);
+	}
+
+	void WriteType(ECompactValueType Type) {
+		uint8 TypeTag = (uint8) Type;
+		Writer << TypeTag;
+	}
+
+	void WriteValue(const TSharedPtr<FJsonValue>& Value) {
+		switch (Value.IsValid() ? Value->Type : EJson::Null) {
+		case EJson::Boolean:
+		{
+			WriteType(Value->AsBool() ? ECompactValueType::True : ECompactValueType::False);
+			break;
+		}
+		case EJson::String:
+		{
+			WriteType(ECompactValueType::String);
+			WriteString(Value->AsString());
+			break;
+		}
+		case EJson::Number:
+		{
+			double NumberValue = Value->AsNumber();
+			if (NumberValue >= 0.0 && NumberValue <= MAX_uint32 && FMath::FloorToDouble(NumberValue) == NumberValue) {
+				uint32 IntegerValue = (uint32) NumberValue;
+				WriteType(ECompactValueType::UnsignedInteger);
+				Writer.SerializeIntPacked(IntegerValue);
+			}
+			else {
+				WriteType(ECompactValueType::Number);
+				Writer << NumberValue;
+			}
+			break;
+		}
+		case EJson::Array:
+		{
+			const TArray<TSharedPtr<FJsonValue>>& ArrayValue = Value->AsArray();
+			uint32 NumElements = ArrayValue.Num();
+			WriteType(ECompactValueType::Array);
+			Writer.SerializeIntPacked(NumElements);
+
+			for (const TSharedPtr<FJsonValue>& Element : ArrayValue) {
+				WriteValue(Element);
+			}
+			break;
+		}
+		case EJson::Object:
+		{
+			WriteType(ECompactValueType::Object);
+			WriteObject(Value->AsObject());
+			break;
+		}
+		default:
+		{
+			WriteType(ECompactValueType::Null);
+			break;
+		}
+		}
+	}
+
+	void WriteObject(const TSharedPtr<FJsonObject>& Object) {
+		uint32 NumFields = Object->Values.Num();
+		Writer.SerializeIntPacked(NumFields);
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values) {
+			WriteString(Pair.Key);
+			WriteValue(Pair.Value);
+		}
+	}
+};
+
+/** Reads string table written in the TArray<FString> layout, bounding string count and lengths by the remaining data size */
+static bool ReadStringTable(FMemoryReader& Reader, TArray<FString>& OutStringTable) {
+	int32 NumStrings = 0;
+	Reader << NumStrings;
+	//Every string is prefixed with its length, so it takes at least 4 bytes
+	if (Reader.IsError() || NumStrings < 0 || NumStrings > (Reader.TotalSize() - Reader.Tell()) / 4) {
+		return false;
+	}
+	OutStringTable.Reserve(NumStrings);
+
+	for (int32 i = 0; i < NumStrings; i++) {
+		const int64 StringOffset = Reader.Tell();
+		int32 StringLength = 0;
+		Reader << StringLength;
+
+		//Negative length means the string is stored as UTF-16, length includes the null terminator in both cases
+		const int64 StringSize = StringLength < 0 ? -(int64) StringLength * sizeof(UCS2CHAR) : (int64) StringLength;
+		if (Reader.IsError() || StringSize > Reader.TotalSize() - Reader.Tell()) {
+			return false;
+		}
+		Reader.Seek(StringOffset);
+		Reader << OutStringTable.AddDefaulted_GetRef();
+	}
+	return !Reader.IsError();
+}
+
+struct FCompactStatementReader {
+	FMemoryReader& Reader;
+	const TArray<FString>& StringTable;
+
+	//JSON values are never modified by the consumers, so string values and constants are created once and shared by all nodes
+	TArray<TSharedPtr<FJsonValue>> StringValues;
+	const TSharedPtr<FJsonValue> NullValue;
+	const TSharedPtr<FJsonValue> FalseValue;
+	const TSharedPtr<FJsonValue> TrueValue;
+
+	FCompactStatementReader(FMemoryReader& Reader, const TArray<FString>& StringTable) : Reader(Reader), StringTable(StringTable),
+		NullValue(MakeShareable(new FJsonValueNull())),
+		FalseValue(MakeShareable(new FJsonValueBoolean(false))),
+		TrueValue(MakeShareable(new FJsonValueBoolean(true))) {
+		StringValues.SetNum(StringTable.Num());
+	}
+
+	bool ReadStringIndex(uint32& OutStringIndex) {
+		Reader.SerializeIntPacked(OutStringIndex);
+		return !Reader.IsError() && OutStringIndex < (uint32) StringTable.Num();
+	}
+
+	TSharedPtr<FJsonValue> ReadStringValue() {
+		uint32 StringIndex = 0;
+		if (!ReadStringIndex(StringIndex)) {
+			return NULL;
+		}
+		TSharedPtr<FJsonValue>& StringValue = StringValues[StringIndex];
+		if (!StringValue.IsValid()) {
+			StringValue = MakeShareable(new FJsonValueString(StringTable[StringIndex]));
+		}
+		return StringValue;
+	}
+
+	TSharedPtr<FJsonValue> ReadValue(int32 Depth) {
+		uint8 TypeTag = 0;
+		Reader << TypeTag;
+		if (Reader.IsError() || Depth > COMPACT_BYTECODE_MAX_DEPTH) {
+			return NULL;
+		}
+
+		switch ((ECompactValueType) TypeTag) {
+		case ECompactValueType::Null:
+			return NullValue;
+		case ECompactValueType::False:
+			return FalseValue;
+		case ECompactValueType::True:
+			return TrueValue;
+		case ECompactValueType::String:
+			return ReadStringValue();
+		case ECompactValueType::UnsignedInteger:
+		{
+			uint32 IntegerValue = 0;
+			Reader.SerializeIntPacked(IntegerValue);
+			return MakeShareable(new FJsonValueNumber(IntegerValue));
+		}
+		case ECompactValueType::Number:
+		{
+			double NumberValue = 0.0;
+			Reader << NumberValue;
+			return MakeShareable(new FJsonValueNumber(NumberValue));
+		}
+		case ECompactValueType::Array:
+		{
+			uint32 NumElements = 0;
+			Reader.SerializeIntPacked(NumElements);
+			//Every element takes at least one byte, so larger counts can only come from corrupted data
+			if (Reader.IsError() || NumElements > (uint32) (Reader.TotalSize() - Reader.Tell())) {
+				return NULL;
+			}
+
+			TArray<TSharedPtr<FJsonValue>> ArrayValue;
+			ArrayValue.Reserve(NumElements);
+			for (uint32 i = 0; i < NumElements; i++) {
+				TSharedPtr<FJsonValue> Element = ReadValue(Depth + 1);
+				if (!Element.IsValid()) {
+					return NULL;
+				}
+				ArrayValue.Add(Element);
+			}
+			return MakeShareable(new FJsonValueArray(ArrayValue));
+		}
+		case ECompactValueType::Object:
+		{
+			const TSharedPtr<FJsonObject> Object = ReadObject(Depth + 1);
+			if (!Object.IsValid()) {
+				return NULL;
+			}
+			return MakeShareable(new FJsonValueObject(Object));
+		}
+		default:
+			return NULL;
+		}
+	}
+
+	TSharedPtr<FJsonObject> ReadObject(int32 Depth) {
+		uint32 NumFields = 0;
+		Reader.SerializeIntPacked(NumFields);
+		if (Reader.IsError() || NumFields > (uint32) (Reader.TotalSize() - Reader.Tell())) {
+			return NULL;
+		}
+
+		TSharedPtr<FJsonObject> Object = MakeShareable(new FJsonObject());
+		Object->Values.Reserve(NumFields);
+
+		for (uint32 i = 0; i < NumFields; i++) {
+			uint32 FieldNameIndex = 0;
+			if (!ReadStringIndex(FieldNameIndex)) {
+				return NULL;
+			}
+			TSharedPtr<FJsonValue> FieldValue = ReadValue(Depth);
+			if (!FieldValue.IsValid()) {
+				return NULL;
+			}
+			Object->Values.Add(StringTable[FieldNameIndex], MoveTemp(FieldValue));
+		}
+		return Object;
+	}
+};
+
+void FKismetBytecodeCompactFormat::SaveStatements(const TArray<TSharedPtr<FJsonValue>>& Statements, TArray<uint8>& OutBytes) {
+	//Encode statements first to collect the string table, and then write it in front of them
+	TArray<uint8> StatementBytes;
+	FMemoryWriter StatementWriter(StatementBytes);
+	FCompactStatementWriter CompactWriter(StatementWriter);
+
+	uint32 NumStatements = Statements.Num();
+	StatementWriter.SerializeIntPacked(NumStatements);
+	for (const TSharedPtr<FJsonValue>& Statement : Statements) {
+		CompactWriter.WriteValue(Statement);
+	}
+
+	FMemoryWriter Writer(OutBytes);
+	uint32 Magic = COMPACT_BYTECODE_MAGIC;
+	int32 Version = COMPACT_BYTECODE_VERSION;
+
+	Writer << Magic;
+	Writer << Version;
+	Writer << CompactWriter.StringTable;
+	Writer.Serialize(StatementBytes.GetData(), StatementBytes.Num());
+}
+
+bool FKismetBytecodeCompactFormat::LoadStatements(const TArray<uint8>& Bytes, TArray<TSharedPtr<FJsonValue>>& OutStatements, FString& OutErrorMessage) {
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	int32 Version = 0;
+
+	Reader << Magic;
+	if (Magic != COMPACT_BYTECODE_MAGIC) {
+		OutErrorMessage = TEXT("Not a compact bytecode data");
+		return false;
+	}
+	Reader << Version;
+	if (Version <= 0 || Version > COMPACT_BYTECODE_VERSION) {
+		OutErrorMessage = FString::Printf(TEXT("Unsupported compact bytecode version %d"), Version);
+		return false;
+	}
+
+	TArray<FString> StringTable;
+	if (!ReadStringTable(Reader, StringTable)) {
+		OutErrorMessage = TEXT("Compact bytecode string table is truncated or corrupted");
+		return false;
+	}
+
+	uint32 NumStatements = 0;
+	Reader.SerializeIntPacked(NumStatements);
+	if (Reader.IsError() || NumStatements > (uint32) (Reader.TotalSize() - Reader.Tell())) {
+		OutErrorMessage = TEXT("Compact bytecode data is truncated or corrupted");
+		return false;
+	}
+
+	FCompactStatementReader CompactReader(Reader, StringTable);
+	OutStatements.Empty(NumStatements);
+
+	for (uint32 i = 0; i < NumStatements; i++) {
+		TSharedPtr<FJsonValue> Statement = CompactReader.ReadValue(0);
+		if (!Statement.IsValid()) {
+			OutErrorMessage = FString::Printf(TEXT("Compact bytecode statement %d is corrupted"), i);
+			return false;
+		}
+		OutStatements.Add(Statement);
+	}
+
+	if (Reader.IsError() || !Reader.AtEnd()) {
+		OutErrorMessage = TEXT("Compact bytecode data is truncated or corrupted");
+		return false;
+	}
+	return true;
+}
+
+void FKismetBytecodeCompactFormat::WriteFunctionScript(const TSharedPtr<FJsonObject>& OutObject, const TArray<TSharedPtr<FJsonValue>>& Statements) {
+	TArray<uint8> CompactScript;
+	SaveStatements(Statements, CompactScript);
+	OutObject->SetStringField(TEXT("CompactScript"), FBase64::Encode(CompactScript));
+
+	if (ShouldDumpBytecodeAsJson()) {
+		OutObject->SetArrayField(TEXT("Script"), Statements);
+	}
+}
+
+TArray<TSharedPtr<FJsonValue>> FKismetBytecodeCompactFormat::ReadFunctionScript(const TSharedPtr<FJsonObject>& Object) {
+	TArray<TSharedPtr<FJsonValue>> Statements;
+	FString CompactScriptString;
+
+	if (Object->TryGetStringField(TEXT("CompactScript"), CompactScriptString)) {
+		TArray<uint8> CompactScript;
+		FString ErrorMessage;
+
+		if (FBase64::Decode(CompactScriptString, CompactScript) && LoadStatements(CompactScript, Statements, ErrorMessage)) {
+			return Statements;
+		}
+		UE_LOG(LogKismetBytecodeCompactFormat, Error, TEXT("Failed to read compact function script of %s: %s"),
+			*Object->GetStringField(TEXT("ObjectName")), *ErrorMessage);
+		Statements.Empty();
+	}
+
+	//Dumps made before compact script was introduced, or with it failing to load, can still have plain JSON statement list
+	const TArray<TSharedPtr<FJsonValue>>* ScriptStatements;
+	if (Object->TryGetArrayField(TEXT("Script"), ScriptStatements)) {
+		Statements = *ScriptStatements;
+	}
+	return Statements;
+}
+
+bool FKismetBytecodeCompactFormat::ShouldDumpBytecodeAsJson() {
+	static const bool bDumpBytecodeAsJson = FParse::Param(FCommandLine::Get(), TEXT("DumpBytecodeAsJson"));
+	return bDumpBytecodeAsJson;
+}
@@ -1,4 +1,5 @@
 #include "Toolkit/KismetBytecodeDisassemblerJson.h"
+#include "Misc/ByteSwap.h"
 #include "Serialization/JsonSerializer.h"
 #include "Toolkit/PropertyTypeHelper.h"
 
@@ -6,6 +7,12 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	EExprToken Opcode = (EExprToken)ReadByte(ScriptIndex);
 	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
 
+	//Nothing can be read past the end of the truncated script, so stop here and let the caller report the error
+	if (HasReadError()) {
+		Result->SetStringField(TEXT("Inst"), TEXT("EndOfScript"));
+		return Result;
+	}
+
 	switch (Opcode) {
 	case EX_PrimitiveCast:
 	{
@@ -26,10 +33,14 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 
 			Result->SetStringField(TEXT("CastType"), TEXT("ObjectToInterface"));
 			UClass* InterfaceClass = ReadPointer<UClass>(ScriptIndex);
+			if (HasReadError()) {
+				break;
+			}
 			Result->SetStringField(TEXT("InterfaceClass"), InterfaceClass->GetPathName());
 		}
-		else {
-			checkf(0, TEXT("Unsupported primitive cast type %d"), ConversionType);
+		else if (!HasReadError()) {
+			SetReadError(ScriptIndex, FString::Printf(TEXT("Unsupported primitive cast type %d"), ConversionType));
+			break;
 		}
 
 		Result->SetObjectField(TEXT("Expression"), SerializeExpression(ScriptIndex));
@@ -43,7 +54,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		TArray<TSharedPtr<FJsonValue>> Values;
 		ReadInt(ScriptIndex); //Skip element amount
 
-		while (Script[ScriptIndex] != EX_EndSet) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndSet)) {
 			TSharedPtr<FJsonObject> Expression = SerializeExpression(ScriptIndex);
 			Values.Add(MakeShareable(new FJsonValueObject(Expression)));
 		}
@@ -54,6 +65,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	case EX_SetConst:
 	{
 		UProperty* InnerProp = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		FEdGraphPinType PropertyPinType;
 		UPropertyTypeHelper::ConvertPropertyToPinType(InnerProp, PropertyPinType);
 
@@ -63,7 +77,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		TArray<TSharedPtr<FJsonValue>> Values;
 		ReadInt(ScriptIndex); //Skip element amount
 
-		while (Script[ScriptIndex] != EX_EndSetConst) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndSetConst)) {
 			TSharedPtr<FJsonObject> Expression = SerializeExpression(ScriptIndex);
 			Values.Add(MakeShareable(new FJsonValueObject(Expression)));
 		}
@@ -79,7 +93,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		TArray<TSharedPtr<FJsonValue>> Values;
 		ReadInt(ScriptIndex); //Skip element amount
 
-		while (Script[ScriptIndex] != EX_EndMap) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndMap)) {
 			TSharedPtr<FJsonObject> KeyExpression = SerializeExpression(ScriptIndex);
 			TSharedPtr<FJsonObject> ValueExpression = SerializeExpression(ScriptIndex);
 
@@ -97,11 +111,17 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("Inst"), TEXT("MapConst"));
 
 		UProperty* KeyProp = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		FEdGraphPinType KeyPropPinType;
 		UPropertyTypeHelper::ConvertPropertyToPinType(KeyProp, KeyPropPinType);
 		Result->SetObjectField(TEXT("KeyProperty"), UPropertyTypeHelper::SerializeGraphPinType(KeyPropPinType, SelfScope.Get()));
 
 		UProperty* ValProp = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		FEdGraphPinType ValuePropPinType;
 		UPropertyTypeHelper::ConvertPropertyToPinType(ValProp, ValuePropPinType);
 		Result->SetObjectField(TEXT("ValueProperty"), UPropertyTypeHelper::SerializeGraphPinType(ValuePropPinType, SelfScope.Get()));
@@ -109,7 +129,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		TArray<TSharedPtr<FJsonValue>> Values;
 		ReadInt(ScriptIndex); //Skip element amount
 
-		while (Script[ScriptIndex] != EX_EndMapConst) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndMapConst)) {
 			TSharedPtr<FJsonObject> KeyExpression = SerializeExpression(ScriptIndex);
 			TSharedPtr<FJsonObject> ValueExpression = SerializeExpression(ScriptIndex);
 
@@ -126,6 +146,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	{
 		Result->SetStringField(TEXT("Inst"), TEXT("ObjToInterfaceCast"));
 		UClass* InterfaceClass = ReadPointer<UClass>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 
 		Result->SetStringField(TEXT("InterfaceClass"), InterfaceClass->GetPathName());
 		Result->SetObjectField(TEXT("Expression"), SerializeExpression(ScriptIndex));
@@ -135,6 +158,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	{
 		Result->SetStringField(TEXT("Inst"), TEXT("CrossInterfaceCast"));
 		UClass* InterfaceClass = ReadPointer<UClass>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 
 		Result->SetStringField(TEXT("InterfaceClass"), InterfaceClass->GetPathName());
 		Result->SetObjectField(TEXT("Expression"), SerializeExpression(ScriptIndex));
@@ -144,6 +170,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	{
 		Result->SetStringField(TEXT("Inst"), TEXT("InterfaceToObjCast"));
 		UClass* ObjectClass = ReadPointer<UClass>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 
 		Result->SetStringField(TEXT("ObjectClass"), ObjectClass->GetPathName());
 		Result->SetObjectField(TEXT("Expression"), SerializeExpression(ScriptIndex));
@@ -189,6 +218,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("Inst"), TEXT("LetValueOnPersistentFrame"));
 
 		UProperty* Property = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		Result->SetStringField(TEXT("PropertyName"), Property->GetName());
 
 		FEdGraphPinType PropertyType;
@@ -203,6 +235,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("Inst"), TEXT("StructMemberContext"));
 
 		UProperty* Property = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		FEdGraphPinType PropertyPinType;
 		UPropertyTypeHelper::ConvertPropertyToPinType(Property, PropertyPinType);
 		Result->SetObjectField(TEXT("PropertyType"), UPropertyTypeHelper::SerializeGraphPinType(PropertyPinType, SelfScope.Get()));
@@ -226,7 +261,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("FunctionName"), FunctionName);
 
 		TArray<TSharedPtr<FJsonValue>> Parameters;
-		while (Script[ScriptIndex] != EX_EndFunctionParms) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndFunctionParms)) {
 			TSharedPtr<FJsonObject> Parameter = SerializeExpression(ScriptIndex);
 			Parameters.Add(MakeShareable(new FJsonValueObject(Parameter)));
 		}
@@ -238,10 +273,13 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	{
 		Result->SetStringField(TEXT("Inst"), TEXT("LocalFinalFunction"));
 		UFunction* StackNode = ReadPointer<UFunction>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		Result->SetStringField(TEXT("Function"), StackNode->GetName());
 
 		TArray<TSharedPtr<FJsonValue>> Parameters;
-		while (Script[ScriptIndex] != EX_EndFunctionParms) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndFunctionParms)) {
 			TSharedPtr<FJsonObject> Parameter = SerializeExpression(ScriptIndex);
 			Parameters.Add(MakeShareable(new FJsonValueObject(Parameter)));
 		}
@@ -277,6 +315,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("Inst"), TEXT("LocalVariable"));
 
 		UProperty* Property = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		FEdGraphPinType PropertyPinType;
 		UPropertyTypeHelper::ConvertPropertyToPinType(Property, PropertyPinType);
 
@@ -289,6 +330,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("Inst"), TEXT("DefaultVariable"));
 
 		UProperty* Property = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		FEdGraphPinType PropertyPinType;
 		UPropertyTypeHelper::ConvertPropertyToPinType(Property, PropertyPinType);
 
@@ -301,6 +345,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("Inst"), TEXT("InstanceVariable"));
 
 		UProperty* Property = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		FEdGraphPinType PropertyPinType;
 		UPropertyTypeHelper::ConvertPropertyToPinType(Property, PropertyPinType);
 
@@ -313,6 +360,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("Inst"), TEXT("LocalOutVariable"));
 
 		UProperty* Property = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		FEdGraphPinType PropertyPinType;
 		UPropertyTypeHelper::ConvertPropertyToPinType(Property, PropertyPinType);
 
@@ -387,6 +437,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("Inst"), TEXT("CallMath"));
 
 		UFunction* StackNode = ReadPointer<UFunction>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		Result->SetStringField(TEXT("Function"), StackNode->GetName());
 
 		//EX_CallMath will never have EX_Context instructions because they don't need any context,
@@ -397,7 +450,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("ContextClass"), MemberParentClass->GetPathName());
 
 		TArray<TSharedPtr<FJsonValue>> Parameters;
-		while (Script[ScriptIndex] != EX_EndFunctionParms) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndFunctionParms)) {
 			TSharedPtr<FJsonObject> Parameter = SerializeExpression(ScriptIndex);
 			Parameters.Add(MakeShareable(new FJsonValueObject(Parameter)));
 		}
@@ -409,10 +462,13 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	{
 		Result->SetStringField(TEXT("Inst"), TEXT("FinalFunction"));
 		UFunction* StackNode = ReadPointer<UFunction>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		Result->SetStringField(TEXT("Function"), StackNode->GetName());
 
 		TArray<TSharedPtr<FJsonValue>> Parameters;
-		while (Script[ScriptIndex] != EX_EndFunctionParms) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndFunctionParms)) {
 			TSharedPtr<FJsonObject> Parameter = SerializeExpression(ScriptIndex);
 			Parameters.Add(MakeShareable(new FJsonValueObject(Parameter)));
 		}
@@ -424,6 +480,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	{
 		Result->SetStringField(TEXT("Inst"), TEXT("CallMulticastDelegate"));
 		UFunction* StackNode = ReadPointer<UFunction>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		UClass* DelegateSignatureParent = StackNode->GetOuterUClass();
 		const bool bIsSelfContext = DelegateSignatureParent == SelfScope;
 
@@ -438,7 +497,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetObjectField(TEXT("Delegate"), SerializeExpression(ScriptIndex));
 
 		TArray<TSharedPtr<FJsonValue>> Parameters;
-		while (Script[ScriptIndex] != EX_EndFunctionParms) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndFunctionParms)) {
 			TSharedPtr<FJsonObject> Parameter = SerializeExpression(ScriptIndex);
 			Parameters.Add(MakeShareable(new FJsonValueObject(Parameter)));
 		}
@@ -453,7 +512,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetStringField(TEXT("Function"), FunctionName);
 
 		TArray<TSharedPtr<FJsonValue>> Parameters;
-		while (Script[ScriptIndex] != EX_EndFunctionParms) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndFunctionParms)) {
 			TSharedPtr<FJsonObject> Parameter = SerializeExpression(ScriptIndex);
 			Parameters.Add(MakeShareable(new FJsonValueObject(Parameter)));
 		}
@@ -532,7 +591,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	{
 		Result->SetStringField(TEXT("Inst"), TEXT("TextConst"));
 		// What kind of text are we dealing with?
-		const EBlueprintTextLiteralType TextLiteralType = (EBlueprintTextLiteralType)Script[ScriptIndex++];
+		const EBlueprintTextLiteralType TextLiteralType = (EBlueprintTextLiteralType)ReadByte(ScriptIndex);
 
 		switch (TextLiteralType) {
 		case EBlueprintTextLiteralType::Empty:
@@ -579,7 +638,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 			break;
 		}
 		default:
-			checkf(false, TEXT("Unknown EBlueprintTextLiteralType! Please update FKismetBytecodeDisassembler::ProcessCommon to handle this type of text."));
+			SetReadError(ScriptIndex, FString::Printf(TEXT("Unknown text literal type %d"), (int32) TextLiteralType));
 			break;
 		}
 		break;
@@ -588,6 +647,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	{
 		Result->SetStringField(TEXT("Inst"), TEXT("ObjectConst"));
 		UObject* Pointer = ReadPointer<UObject>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		Result->SetStringField(TEXT("Object"), Pointer->GetPathName());
 		break;
 	}
@@ -670,6 +732,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	{
 		Result->SetStringField(TEXT("Inst"), TEXT("StructConst"));
 		UScriptStruct* Struct = ReadPointer<UScriptStruct>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		Result->SetStringField(TEXT("Struct"), Struct->GetPathName());
 
 		ReadInt(ScriptIndex); //Skip serialized structure size (not particularly useful really)
@@ -704,7 +769,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		Result->SetObjectField(TEXT("LeftSideExpression"), SerializeExpression(ScriptIndex));
 
 		TArray<TSharedPtr<FJsonValue>> Values;
-		while (Script[ScriptIndex] != EX_EndArray) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndArray)) {
 			TSharedPtr<FJsonObject> Value = SerializeExpression(ScriptIndex);
 			Values.Add(MakeShareable(new FJsonValueObject(Value)));
 		}
@@ -715,6 +780,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	case EX_ArrayConst:
 	{
 		UProperty* InnerProp = ReadPointer<UProperty>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		FEdGraphPinType PropertyPinType;
 		UPropertyTypeHelper::ConvertPropertyToPinType(InnerProp, PropertyPinType);
 
@@ -724,7 +792,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		TArray<TSharedPtr<FJsonValue>> Values;
 		ReadInt(ScriptIndex); //Skip element amount
 
-		while (Script[ScriptIndex] != EX_EndArrayConst) {
+		while (!IsAtEndToken(ScriptIndex, EX_EndArrayConst)) {
 			TSharedPtr<FJsonObject> Expression = SerializeExpression(ScriptIndex);
 			Values.Add(MakeShareable(new FJsonValueObject(Expression)));
 		}
@@ -765,6 +833,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		//Cast of class object to another class object
 		Result->SetStringField(TEXT("Inst"), TEXT("MetaCast"));
 		UClass* Class = ReadPointer<UClass>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 
 		Result->SetStringField(TEXT("Class"), Class->GetPathName());
 		Result->SetObjectField(TEXT("Expression"), SerializeExpression(ScriptIndex));
@@ -775,6 +846,9 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 		//Cast of external object to provided class
 		Result->SetStringField(TEXT("Inst"), TEXT("DynamicCast"));
 		UClass* Class = ReadPointer<UClass>(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 
 		Result->SetStringField(TEXT("Class"), Class->GetPathName());
 		Result->SetObjectField(TEXT("Expression"), SerializeExpression(ScriptIndex));
@@ -913,7 +987,7 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 			Result->SetStringField(TEXT("EventType"), TEXT("TunnelEndOfThread"));
 			break;
 		default:
-			checkf(0, TEXT("Unhandled instrumentation event type: %d"), EventType);
+			SetReadError(ScriptIndex, FString::Printf(TEXT("Unhandled instrumentation event type: %d"), EventType));
 			break;
 		}
 		break;
@@ -956,19 +1030,29 @@ TSharedPtr<FJsonObject> FKismetBytecodeDisassemblerJson::SerializeExpression(int
 	}
 	default:
 	{
-		// This should never occur.
-		checkf(0, TEXT("Unknown bytecode 0x%02X"), (uint8)Opcode);
+		//Compiler never emits unknown opcodes, so the script is corrupted and nothing after this point can be decoded
+		SetReadError(ScriptIndex, FString::Printf(TEXT("Unknown bytecode 0x%02X at %d"), (uint8)Opcode, ScriptIndex - 1));
 		break;
 	}
 	}
-	//Make sure no instruction identifier is ever missing from returned json object
-	check(Result->HasField(TEXT("Inst")));
+	//Make sure no instruction identifier is ever missing from returned json object, statements are discarded on read error anyway
+	check(Result->HasField(TEXT("Inst")) || HasReadError());
 	return Result;
 }
 
 TArray<TSharedPtr<FJsonValue>> FKismetBytecodeDisassemblerJson::SerializeFunction(UStruct* Function) {
-	this->Script = Function->Script;
-	this->SelfScope = Function->GetTypedOuter<UClass>();
+	return SerializeStatements(Function->Script, Function->GetTypedOuter<UClass>(), true);
+}
+
+TArray<TSharedPtr<FJsonValue>> FKismetBytecodeDisassemblerJson::SerializeScript(const TArrayView<const uint8> InScript, UClass* InSelfScope) {
+	return SerializeStatements(InScript, InSelfScope, false);
+}
+
+TArray<TSharedPtr<FJsonValue>> FKismetBytecodeDisassemblerJson::SerializeStatements(const TArrayView<const uint8> InScript, UClass* InSelfScope, const bool bInCanResolveObjectReferences) {
+	this->Script = InScript;
+	this->SelfScope = InSelfScope;
+	this->bCanResolveObjectReferences = bInCanResolveObjectReferences;
+	this->bHasReadError = false;
 
 	TArray<TSharedPtr<FJsonValue>> Statements;
 	int32 ScriptIndex = 0;
@@ -982,19 +1066,29 @@ TArray<TSharedPtr<FJsonValue>> FKismetBytecodeDisassemblerJson::SerializeFunctio
 		Statements.Add(MakeShareable(new FJsonValueObject(StatementObject)));
 	}
 
+	//Statements of the truncated script are incomplete, so none of them are returned
+	if (HasReadError()) {
+		Statements.Empty();
+	}
 	return Statements;
 }
 
 bool FKismetBytecodeDisassemblerJson::FindFirstStatementOfType(UStruct* Function, int32 StartScriptIndex, uint8 ExpectedStatementOpcode, int32& OutStatementIndex) {
 	this->Script = Function->Script;
 	this->SelfScope = Function->GetTypedOuter<UClass>();
+	this->bHasReadError = false;
+
+	this->bCanResolveObjectReferences = true;
 
 	int32 ScriptIndex = StartScriptIndex;
 	while (ScriptIndex < Script.Num()) {
 		const int32 StatementIndex = ScriptIndex;
-		const uint8 StatementOpcode = Script[ScriptIndex];
+		const uint8 StatementOpcode = PeekByte(ScriptIndex);
 		FString ResultString;
 		SerializeExpression(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		if (StatementOpcode == ExpectedStatementOpcode) {
 			OutStatementIndex = StatementIndex;
 			return true;
@@ -1008,11 +1102,16 @@ bool FKismetBytecodeDisassemblerJson::FindFirstStatementOfType(UStruct* Function
 bool FKismetBytecodeDisassemblerJson::GetStatementLength(UStruct* Function, int32 ExpectedStatementIndex, int32& OutStatementLength) {
 	this->Script = Function->Script;
 	this->SelfScope = Function->GetTypedOuter<UClass>();
+	this->bHasReadError = false;
+	this->bCanResolveObjectReferences = true;
 
 	int32 ScriptIndex = 0;
 	while (ScriptIndex < Script.Num()) {
 		const int32 StatementIndex = ScriptIndex;
 		SerializeExpression(ScriptIndex);
+		if (HasReadError()) {
+			break;
+		}
 		if (StatementIndex == ExpectedStatementIndex) {
 			//This is the statement we are looking for, compute difference and return it as length
 			OutStatementLength = ScriptIndex - StatementIndex;
@@ -1025,45 +1124,60 @@ bool FKismetBytecodeDisassemblerJson::GetStatementLength(UStruct* Function, int3
 }
 
 
-int32 FKismetBytecodeDisassemblerJson::ReadInt(int32& ScriptIndex) {
-	int32 Value = Script[ScriptIndex]; ++ScriptIndex;
-	Value = Value | ((int32)Script[ScriptIndex] << 8); ++ScriptIndex;
-	Value = Value | ((int32)Script[ScriptIndex] << 16); ++ScriptIndex;
-	Value = Value | ((int32)Script[ScriptIndex] << 24); ++ScriptIndex;
+bool FKismetBytecodeDisassemblerJson::CheckScriptBounds(const int32 ScriptIndex, const int32 NumBytes) {
+	if (ScriptIndex >= 0 && NumBytes <= Script.Num() - ScriptIndex) {
+		return true;
+	}
+	if (!bHasReadError) {
+		this->bHasReadError = true;
+		this->ReadErrorMessage = FString::Printf(TEXT("Bytecode read of %d bytes at %d is out of bounds of the script of %d bytes"), NumBytes, ScriptIndex, Script.Num());
+	}
+	return false;
+}
+
+void FKismetBytecodeDisassemblerJson::SetReadError(int32& ScriptIndex, const FString& ErrorMessage) {
+	if (!bHasReadError) {
+		this->bHasReadError = true;
+		this->ReadErrorMessage = ErrorMessage;
+	}
+	ScriptIndex = Script.Num();
+}
+
+uint8 FKismetBytecodeDisassemblerJson::PeekByte(const int32 ScriptIndex) {
+	return CheckScriptBounds(ScriptIndex, 1) ? Script[ScriptIndex] : 0;
+}
 
-	return Value;
+bool FKismetBytecodeDisassemblerJson::IsAtEndToken(const int32 ScriptIndex, const uint8 EndToken) {
+	//Loops reading until the end token would never finish on truncated script, so a read error ends them too
+	return PeekByte(ScriptIndex) == EndToken || HasReadError();
+}
+
+int32 FKismetBytecodeDisassemblerJson::ReadInt(int32& ScriptIndex) {
+	return INTEL_ORDER32(ReadUnaligned<int32>(ScriptIndex));
 }
 
 uint64 FKismetBytecodeDisassemblerJson::ReadQword(int32& ScriptIndex) {
-	uint64 Value = Script[ScriptIndex]; ++ScriptIndex;
-	Value = Value | ((uint64)Script[ScriptIndex] << 8); ++ScriptIndex;
-	Value = Value | ((uint64)Script[ScriptIndex] << 16); ++ScriptIndex;
-	Value = Value | ((uint64)Script[ScriptIndex] << 24); ++ScriptIndex;
-	Value = Value | ((uint64)Script[ScriptIndex] << 32); ++ScriptIndex;
-	Value = Value | ((uint64)Script[ScriptIndex] << 40); ++ScriptIndex;
-	Value = Value | ((uint64)Script[ScriptIndex] << 48); ++ScriptIndex;
-	Value = Value | ((uint64)Script[ScriptIndex] << 56); ++ScriptIndex;
-
-	return Value;
+	return INTEL_ORDER64(ReadUnaligned<uint64>(ScriptIndex));
 }
 
 uint8 FKismetBytecodeDisassemblerJson::ReadByte(int32& ScriptIndex) {
-	uint8 Value = Script[ScriptIndex]; ++ScriptIndex;
-
-	return Value;
+	return ReadUnaligned<uint8>(ScriptIndex);
 }
 
 FString FKismetBytecodeDisassemblerJson::ReadName(int32& ScriptIndex) {
-	const FScriptName ConstValue = *(FScriptName*)(Script.GetData() + ScriptIndex);
-	ScriptIndex += sizeof(FScriptName);
+	const int32 NameIndex = ScriptIndex;
+	const FScriptName ConstValue = ReadUnaligned<FScriptName>(ScriptIndex);
 
+	//Name entries are looked up directly by the recorded indices, so corrupted ones would read outside of the name table
+	if (!FName::IsWithinBounds(ConstValue.ComparisonIndex) || !FName::IsWithinBounds(ConstValue.DisplayIndex)) {
+		SetReadError(ScriptIndex, FString::Printf(TEXT("Name at %d does not reference a valid name entry"), NameIndex));
+		return FString();
+	}
 	return ScriptNameToName(ConstValue).ToString();
 }
 
 uint16 FKismetBytecodeDisassemblerJson::ReadWord(int32& ScriptIndex) {
-	uint16 Value = Script[ScriptIndex]; ++ScriptIndex;
-	Value = Value | ((uint16)Script[ScriptIndex] << 8); ++ScriptIndex;
-	return Value;
+	return INTEL_ORDER16(ReadUnaligned<uint16>(ScriptIndex));
 }
 
 float FKismetBytecodeDisassemblerJson::ReadFloat(int32& ScriptIndex) {
@@ -1082,27 +1196,62 @@ CodeSkipSizeType FKismetBytecodeDisassemblerJson::ReadSkipCount(int32& ScriptInd
 }
 
 FString FKismetBytecodeDisassemblerJson::ReadString8(int32& ScriptIndex) {
-	FString Result;
+	//Find the terminator first, so the string can be constructed with a single allocation
+	if (!CheckScriptBounds(ScriptIndex, 1)) {
+		ScriptIndex = Script.Num();
+		return FString();
+	}
+	const ANSICHAR* StringStart = (const ANSICHAR*) (Script.GetData() + ScriptIndex);
+	const int32 MaxLength = Script.Num() - ScriptIndex;
 
-	do {
-		Result += (ANSICHAR)ReadByte(ScriptIndex);
-	} while (Script[ScriptIndex - 1] != 0);
+	int32 Length = 0;
+	while (Length < MaxLength && StringStart[Length] != 0) {
+		Length++;
+	}
+	if (Length == MaxLength) {
+		SetReadError(ScriptIndex, FString::Printf(TEXT("Unterminated string constant at %d"), ScriptIndex));
+		return FString();
+	}
 
-	return Result;
+	ScriptIndex += Length + 1;
+	return FString(Length, StringStart);
 }
 
 FString FKismetBytecodeDisassemblerJson::ReadString16(int32& ScriptIndex) {
-	FString Result;
+	//Find the terminator first, so the string can be constructed with a single allocation
+	if (!CheckScriptBounds(ScriptIndex, sizeof(uint16))) {
+		ScriptIndex = Script.Num();
+		return FString();
+	}
+	const uint8* StringStart = Script.GetData() + ScriptIndex;
+	const int32 MaxLength = (Script.Num() - ScriptIndex) / sizeof(uint16);
 
-	do {
-		Result += (TCHAR)ReadWord(ScriptIndex);
-	} while ((Script[ScriptIndex - 1] != 0) || (Script[ScriptIndex - 2] != 0));
+	int32 Length = 0;
+	while (Length < MaxLength && (StringStart[Length * 2] != 0 || StringStart[Length * 2 + 1] != 0)) {
+		Length++;
+	}
+	if (Length == MaxLength) {
+		SetReadError(ScriptIndex, FString::Printf(TEXT("Unterminated unicode string constant at %d"), ScriptIndex));
+		return FString();
+	}
+
+	FString Result;
+	if (Length > 0) {
+		TArray<TCHAR>& CharArray = Result.GetCharArray();
+		CharArray.SetNumUninitialized(Length + 1);
 
+		//Characters are UTF-16 code units, which are not necessarily aligned and can be narrower than TCHAR
+		for (int32 i = 0; i < Length; i++) {
+			CharArray[i] = (TCHAR) (StringStart[i * 2] | (StringStart[i * 2 + 1] << 8));
+		}
+		CharArray[Length] = 0;
+	}
+	ScriptIndex += (Length + 1) * sizeof(uint16);
 	return Result;
 }
 
 FString FKismetBytecodeDisassemblerJson::ReadString(int32& ScriptIndex) {
-	const EExprToken Opcode = (EExprToken)Script[ScriptIndex++];
+	const EExprToken Opcode = (EExprToken)ReadByte(ScriptIndex);
 
 	switch (Opcode) {
 	case EX_StringConst:
@@ -1110,7 +1259,7 @@ FString FKismetBytecodeDisassemblerJson::ReadString(int32& ScriptIndex) {
 	case EX_UnicodeStringConst:
 		return ReadString16(ScriptIndex);
 	default:
-		checkf(false, TEXT("FKismetBytecodeDisassembler::ReadString - Unexpected opcode. Expected %d or %d, got %d"), (int)EX_StringConst, (int)EX_UnicodeStringConst, (int)Opcode);
+		SetReadError(ScriptIndex, FString::Printf(TEXT("Unexpected string opcode. Expected %d or %d, got %d"), (int)EX_StringConst, (int)EX_UnicodeStringConst, (int)Opcode));
 		break;
 	}
 
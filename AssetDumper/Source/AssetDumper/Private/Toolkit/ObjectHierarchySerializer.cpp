@@ -63,6 +63,18 @@ void UObjectHierarchySerializer::InitializeForSerialization(UPackage* NewSourceP
 	this->SourcePackage = NewSourcePackage;
 }
 
+void UObjectHierarchySerializer::Reset() {
+	this->SourcePackage = NULL;
+	this->PackageName.Empty();
+	this->LastObjectIndex = 0;
+	
+	//Keep allocated memory around, next asset is likely to have similar amount of objects
+	this->ObjectIndices.Reset();
+	this->LoadedObjects.Reset();
+	this->SerializedObjects.Reset();
+	this->ObjectMarks.Reset();
+}
+
 void UObjectHierarchySerializer::SetPackageForDeserialization(UPackage* SelfPackage) {
 	check(SelfPackage);
 	this->SourcePackage = SelfPackage;
@@ -4,6 +4,9 @@
 
 DECLARE_LOG_CATEGORY_CLASS(LogPropertySerializer, Error, Log);
 
+//Doubles represent every integer up to 2^53 exactly, integers with larger magnitude are written as strings to avoid losing precision
+#define MAX_EXACT_DOUBLE_INTEGER (1ll << 53)
+
 PRAGMA_DISABLE_OPTIMIZATION
 
 void FDateTimeSerializer::Serialize(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, TArray<int32>* OutReferencedSubobjects) {
@@ -270,10 +273,19 @@ bool UPropertySerializer::DeserializePropertyValueInner(UProperty* Property, con
 		//Primitives below, they are serialized as plain json values
 	}
 	else if (const UNumericProperty* NumberProperty = Cast<const UNumericProperty>(Property)) {
-		const double NumberValue = JsonValue->AsNumber();
-		if (NumberProperty->IsFloatingPoint())
-			NumberProperty->SetFloatingPointPropertyValue(Value, NumberValue);
-		else NumberProperty->SetIntPropertyValue(Value, static_cast<int64>(NumberValue));
+		if (JsonValue->Type == EJson::String) {
+			//64-bit integers which cannot be represented as doubles exactly are serialized as strings
+			const FString NumberString = JsonValue->AsString();
+			if (NumberProperty->IsA<UUInt64Property>())
+				NumberProperty->SetIntPropertyValue(Value, FCString::Strtoui64(*NumberString, NULL, 10));
+			else NumberProperty->SetIntPropertyValue(Value, FCString::Atoi64(*NumberString));
+		}
+		else {
+			const double NumberValue = JsonValue->AsNumber();
+			if (NumberProperty->IsFloatingPoint())
+				NumberProperty->SetFloatingPointPropertyValue(Value, NumberValue);
+			else NumberProperty->SetIntPropertyValue(Value, static_cast<int64>(NumberValue));
+		}
 
 	}
 	else if (const UBoolProperty* BoolProperty = Cast<const UBoolProperty>(Property)) {
@@ -319,12 +331,13 @@ void UPropertySerializer::DisablePropertySerialization(UStruct* Struct, FName Pr
 	UProperty* Property = Struct->FindPropertyByName(PropertyName);
 	if (!Property) return;
 	//checkf(Property, TEXT("Cannot find Property %s in Struct %s"), *PropertyName.ToString(), *Struct->GetPathName());
-	this->PinnedStructs.Add(Struct);
+	//Serializers are reused for the assets of the same type, which will disable the same properties again
+	this->PinnedStructs.AddUnique(Struct);
 	this->BlacklistedProperties.Add(Property);
 }
 
 void UPropertySerializer::AddStructSerializer(UScriptStruct* Struct, const TSharedPtr<FStructSerializer>& Serializer) {
-	this->PinnedStructs.Add(Struct);
+	this->PinnedStructs.AddUnique(Struct);
 	this->StructSerializers.Add(Struct, Serializer);
 }
 
@@ -501,11 +514,22 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(UPropert
 	}
 
 	if (const UNumericProperty* NumberProperty = Cast<const UNumericProperty>(Property)) {
-		double ResultValue;
-		if (NumberProperty->IsFloatingPoint())
-			ResultValue = NumberProperty->GetFloatingPointPropertyValue(Value);
-		else ResultValue = NumberProperty->GetSignedIntPropertyValue(Value);
-		return MakeShareable(new FJsonValueNumber(ResultValue));
+		if (NumberProperty->IsFloatingPoint()) {
+			return MakeShareable(new FJsonValueNumber(NumberProperty->GetFloatingPointPropertyValue(Value)));
+		}
+		//Unsigned 64-bit values above the signed range would turn negative if read as signed integers
+		if (NumberProperty->IsA<UUInt64Property>()) {
+			const uint64 UnsignedValue = NumberProperty->GetUnsignedIntPropertyValue(Value);
+			if (UnsignedValue > (uint64) MAX_EXACT_DOUBLE_INTEGER) {
+				return MakeShareable(new FJsonValueString(FString::Printf(TEXT("%llu"), UnsignedValue)));
+			}
+			return MakeShareable(new FJsonValueNumber((double) UnsignedValue));
+		}
+		const int64 SignedValue = NumberProperty->GetSignedIntPropertyValue(Value);
+		if (SignedValue > MAX_EXACT_DOUBLE_INTEGER || SignedValue < -MAX_EXACT_DOUBLE_INTEGER) {
+			return MakeShareable(new FJsonValueString(FString::Printf(TEXT("%lld"), SignedValue)));
+		}
+		return MakeShareable(new FJsonValueNumber((double) SignedValue));
 	}
 
 	if (const UBoolProperty* BoolProperty = Cast<const UBoolProperty>(Property)) {
@@ -0,0 +1,104 @@
+#include "Util/PackageNameMatcher.h"
+
+FPackageNameMatcher::FPackageNameMatcher() : NumPackagePaths(0) {
+	this->PathNodes.AddDefaulted();
+}
+
+void FPackageNameMatcher::AddPackageName(const FString& PackageName) {
+	this->PackageNames.Add(*PackageName);
+}
+
+void FPackageNameMatcher::AddPackagePath(const FString& PackagePath) {
+	TArray<FString> PathSegments;
+	PackagePath.ParseIntoArray(PathSegments, TEXT("/"), true);
+
+	int32 CurrentNodeIndex = 0;
+	for (const FString& PathSegment : PathSegments) {
+		const FName SegmentName = *PathSegment;
+		const int32* ChildNodeIndex = PathNodes[CurrentNodeIndex].Children.Find(SegmentName);
+
+		if (ChildNodeIndex != NULL) {
+			CurrentNodeIndex = *ChildNodeIndex;
+		} else {
+			//Add node first, since adding it can reallocate the array and invalidate references into it
+			const int32 NewNodeIndex = PathNodes.AddDefaulted();
+			this->PathNodes[CurrentNodeIndex].Children.Add(SegmentName, NewNodeIndex);
+			CurrentNodeIndex = NewNodeIndex;
+		}
+	}
+
+	if (!PathNodes[CurrentNodeIndex].bMatchesSubtree) {
+		this->PathNodes[CurrentNodeIndex].bMatchesSubtree = true;
+		this->NumPackagePaths++;
+	}
+}
+
+void FPackageNameMatcher::AddRule(const FString& Rule) {
+	if (Rule.EndsWith(TEXT("/"))) {
+		AddPackagePath(Rule);
+	} else {
+		AddPackageName(Rule);
+	}
+}
+
+bool FPackageNameMatcher::Matches(const FName PackageName) const {
+	if (PackageNames.Contains(PackageName)) {
+		return true;
+	}
+	if (NumPackagePaths == 0) {
+		return false;
+	}
+	const FString PackageNameString = PackageName.ToString();
+	return MatchesPackagePath(*PackageNameString, PackageNameString.Len());
+}
+
+bool FPackageNameMatcher::Matches(const FString& PackageName) const {
+	//Names that have never been registered as FName cannot be in the exact names set, so avoid adding them
+	if (PackageNames.Num() != 0) {
+		const FName ExistingPackageName = FName(*PackageName, FNAME_Find);
+		if (ExistingPackageName != NAME_None && PackageNames.Contains(ExistingPackageName)) {
+			return true;
+		}
+	}
+	if (NumPackagePaths == 0) {
+		return false;
+	}
+	return MatchesPackagePath(*PackageName, PackageName.Len());
+}
+
+bool FPackageNameMatcher::MatchesPackagePath(const TCHAR* PackageName, const int32 PackageNameLen) const {
+	int32 CurrentNodeIndex = 0;
+	int32 SegmentStart = 0;
+
+	while (true) {
+		if (PathNodes[CurrentNodeIndex].bMatchesSubtree) {
+			return true;
+		}
+		//Skip separators, including the leading one
+		while (SegmentStart < PackageNameLen && PackageName[SegmentStart] == TEXT('/')) {
+			SegmentStart++;
+		}
+
+		int32 SegmentEnd = SegmentStart;
+		while (SegmentEnd < PackageNameLen && PackageName[SegmentEnd] != TEXT('/')) {
+			SegmentEnd++;
+		}
+
+		//Last segment is the short package name and not a path, so it never matches the path rules
+		if (SegmentEnd >= PackageNameLen) {
+			return false;
+		}
+
+		//Segment that has never been registered as FName cannot be a part of any rule
+		const FName SegmentName = FName(SegmentEnd - SegmentStart, PackageName + SegmentStart, FNAME_Find);
+		if (SegmentName == NAME_None) {
+			return false;
+		}
+		const int32* ChildNodeIndex = PathNodes[CurrentNodeIndex].Children.Find(SegmentName);
+		if (ChildNodeIndex == NULL) {
+			return false;
+		}
+		CurrentNodeIndex = *ChildNodeIndex;
+		SegmentStart = SegmentEnd;
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/** Describes a single asset dump file listed in the dump index */
+struct ASSETDUMPER_API FAssetDumpIndexEntry {
+public:
+	/** Long name of the dumped package, like /Game/Path/Package */
+	FName PackageName;
+	/** Class of the asset contained in the package */
+	FName AssetClass;
+	/** Size of the dump file on disk, in bytes */
+	int64 FileSize;
+	/** MD5 hash of the dump file bytes, exactly as they are stored on disk */
+	FString ContentHash;
+	/** Non-native packages referenced by the dumped asset */
+	TArray<FName> DependencyPackages;
+
+	FAssetDumpIndexEntry();
+};
+
+/**
+ * Compact index of the asset dump directory, written by the asset dumper next to the dump files
+ * Lists every dumped package along with it's asset class and dependencies, so tools reading the dump
+ * can enumerate packages without walking the directory tree and opening every single dump file
+ */
+class ASSETDUMPER_API FAssetDumpIndex {
+private:
+	/** Index entries mapped by the package name */
+	TMap<FName, FAssetDumpIndexEntry> Entries;
+	/** Maps package path to the package paths directly under it. Built lazily when the tree is first queried */
+	mutable TMap<FString, TArray<FString>> ChildDirectories;
+	/** Maps package path to the packages located directly under it */
+	mutable TMap<FString, TArray<FName>> DirectoryPackages;
+	/** True when directory maps have been built for the current set of entries */
+	mutable bool bDirectoryTreeBuilt;
+	/** Guards entries against concurrent modification by the dumper worker threads */
+	mutable FCriticalSection EntriesCriticalSection;
+
+	/** Builds directory maps from the current set of entries */
+	void BuildDirectoryTree() const;
+public:
+	FAssetDumpIndex();
+
+	/** Adds or replaces index entry for the package. Thread safe */
+	void AddEntry(const FAssetDumpIndexEntry& Entry);
+
+	/** Adds entries of the provided index for the packages that are not listed in this one yet. Thread safe */
+	void AddMissingEntries(const FAssetDumpIndex& OtherIndex);
+
+	/** Returns entry for the provided package, or NULL if it's not listed in the index */
+	const FAssetDumpIndexEntry* FindEntry(FName PackageName) const;
+
+	/** Returns all of the entries listed in the index */
+	FORCEINLINE const TMap<FName, FAssetDumpIndexEntry>& GetEntries() const { return Entries; }
+
+	/** Returns package paths located directly under the provided one. Root path is / */
+	const TArray<FString>& GetChildDirectories(const FString& PackagePath) const;
+
+	/** Returns packages located directly under the provided package path */
+	const TArray<FName>& GetDirectoryPackages(const FString& PackagePath) const;
+
+	/** Writes index into the dump root directory. When the dump is complete, the in progress marker is removed after the index is written */
+	bool SaveToDumpDirectory(const FString& RootDirectory, bool bDumpComplete = true) const;
+
+	/** Returns path to the index file in the provided dump root directory */
+	static FString GetIndexFilePath(const FString& RootDirectory);
+
+	/** Returns path to the marker file present in the dump root directory while the dump is in progress */
+	static FString GetInProgressMarkerFilePath(const FString& RootDirectory);
+
+	/** Returns true if the dump has been started in the provided directory and has not finished writing the complete index yet */
+	static bool IsDumpInProgress(const FString& RootDirectory);
+
+	/** Marks the dump in the provided directory as in progress. Must be called before any dump file is written */
+	static void MarkDumpInProgress(const FString& RootDirectory);
+
+	/**
+	 * Loads index from the dump root directory. Returns NULL if there is no index, it cannot be read, or it is outdated
+	 * Index is outdated when the dump that wrote it has not finished, which is detected by the in progress marker instead of walking the directory
+	 * Dump files modified by hand are not detected, RebuildFromDumpDirectory should be used for them
+	 */
+	static TSharedPtr<FAssetDumpIndex> LoadFromDumpDirectory(const FString& RootDirectory, bool bAllowDumpInProgress = false);
+
+	/** Loads index from the dump root directory, rebuilding and saving it when it is outdated or corrupted. Returns NULL only if there is no index at all */
+	static TSharedPtr<FAssetDumpIndex> LoadOrRebuildFromDumpDirectory(const FString& RootDirectory);
+
+	/** Rebuilds index by scanning and parsing all of the dump files in the dump root directory. Slow, only used when the index is missing or outdated */
+	static TSharedRef<FAssetDumpIndex> RebuildFromDumpDirectory(const FString& RootDirectory);
+
+	/** Computes content hash stored in the index for the provided dump file bytes, as they are written on disk */
+	static FString ComputeContentHash(const TArray<uint8>& FileBytes);
+
+	/** Collects non-native packages referenced by the imports of the serialized object hierarchy */
+	static void CollectDependencyPackages(const TArray<TSharedPtr<class FJsonValue>>& ObjectHierarchy, FName SelfPackageName, TArray<FName>& OutDependencyPackages);
+
+	/** Creates index entry from the parsed dump file. Returns false if the file is not a valid asset dump */
+	static bool CreateEntryFromDumpFile(const TSharedPtr<FJsonObject>& RootObject, const TArray<uint8>& FileBytes, FAssetDumpIndexEntry& OutEntry);
+};
@@ -2,7 +2,9 @@
 #include "CoreMinimal.h"
 #include "Tickable.h"
 #include "AssetData.h"
+#include "Async/Future.h"
 #include "AssetDumperModule.h"
+#include "Toolkit/AssetDumping/SerializerPool.h"
 
 /** Holds asset dumping related settings */
 struct ASSETDUMPER_API FAssetDumpSettings {
@@ -26,6 +28,8 @@ public:
 	UPackage* Package;
 	TSharedPtr<class FSerializationContext> SerializationContext;
 	class UAssetTypeSerializer* Serializer;
+	/** Serializers used by the serialization context, returned to the pool once the package is dumped */
+	FPooledSerializers PooledSerializers;
 };
 
 /**
@@ -57,6 +61,28 @@ private:
 	int32 MaxLoadRequestsInFly;
 	int32 MaxPackagesInProcessQueue;
 	int32 MaxPackagesToProcessInOneTick;
+
+	/** Index of the dump directory, updated with every asset dumped and written periodically and once dumping is finished */
+	TSharedPtr<class FAssetDumpIndex> DumpIndex;
+	/** Index of the assets dumped previously, loaded or rebuilt on the worker thread while dumping is already in progress */
+	TFuture<TSharedPtr<class FAssetDumpIndex>> PreviousDumpIndexFuture;
+	/** True once entries of the previous dump index have been merged into the current one */
+	bool bPreviousDumpIndexMerged;
+	/** Time since the dump index has been written last time, in seconds */
+	float TimeSinceDumpIndexSave;
+	/** Amount of packages processed when the dump index has been written last time */
+	int32 PackagesProcessedAtDumpIndexSave;
+	/** Serializers reused between the dumped assets */
+	FSerializerPool SerializerPool;
+
+	/** Time spent capturing asset snapshots on the game thread, in seconds */
+	double TimeSpentCapturingSnapshots;
+	/** Time spent serializing assets in parallel and on the game thread, in seconds */
+	double TimeSpentSerializingParallel;
+	double TimeSpentSerializingGameThread;
+	/** Amount of packages serialized in parallel and on the game thread */
+	int32 PackagesSerializedParallel;
+	int32 PackagesSerializedGameThread;
 	
 	explicit FAssetDumpProcessor(const FAssetDumpSettings& Settings, const TArray<FAssetData>& InAssets);
 	explicit FAssetDumpProcessor(const FAssetDumpSettings& Settings, const TMap<FName, FAssetData>& InAssets);
@@ -77,6 +103,10 @@ public:
 	FORCEINLINE int32 GetPackagesSkipped() const { return PackagesSkipped.GetValue(); }
 	FORCEINLINE int32 GetPackagesProcessed() const { return PackagesProcessed.GetValue(); }
 	FORCEINLINE bool IsFinishedDumping() const { return bHasFinishedDumping; }
+
+	/** Time spent serializing packages supporting parallel dumping, and amount of such packages */
+	FORCEINLINE double GetTimeSpentSerializingParallel() const { return TimeSpentSerializingParallel; }
+	FORCEINLINE int32 GetPackagesSerializedParallel() const { return PackagesSerializedParallel; }
 	
 	//Begin FTickableGameObject
 	virtual void Tick(float DeltaTime) override;
@@ -89,4 +119,8 @@ protected:
 	void InitializeAssetDump();
 	void OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
 	void PerformAssetDumpForPackage(const FPendingPackageData& PackageData);
+	/** Merges previous dump index into the current one once it is available, optionally waiting for it */
+	void MergePreviousDumpIndex(bool bWaitForCompletion);
+	/** Writes dump index into the dump directory, so packages dumped so far are listed even if dumping is interrupted */
+	void SaveDumpIndex(bool bDumpComplete);
 };
\ No newline at end of file
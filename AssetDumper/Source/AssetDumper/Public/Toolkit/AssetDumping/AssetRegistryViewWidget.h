@@ -1,5 +1,6 @@
 #pragma once
 #include "Slate.h"
+#include "Util/PackageNameMatcher.h"
 
 /** Struct holding information about unknown asset class */
 struct ASSETDUMPER_API FUnknownAssetClass {
@@ -17,8 +18,10 @@ private:
 
 	/** Packages with these names will be excluded from the results */
 	TSet<FName> ExcludedPackageNames;
-	/** Package paths to exclude. Does not provide recursive lookup, you should expand paths beforehand manually */
+	/** Package paths to exclude, sub-paths are excluded recursively */
 	TArray<FName> ExcludedPackagePaths;
+	/** Matches both excluded package names and paths, used for the actual lookups */
+	FPackageNameMatcher ExcludedPackagesMatcher;
 
 	/** When not empty, only assets of the specified classes are included into the search result */
 	TArray<FName> AssetClassesWhitelist;
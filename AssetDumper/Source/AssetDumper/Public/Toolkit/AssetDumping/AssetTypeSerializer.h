@@ -37,6 +37,13 @@ public:
 	/** Determines whenever this serializer supports being run in parallel in worker threads. Override and return false if you depend on main thread state */
 	virtual bool SupportsParallelDumping() const { return true; }
 
+	/**
+	 * Called on the game thread right before SerializeAsset, regardless of the thread SerializeAsset will run on
+	 * Override to copy the asset data that is only safe to access from the game thread, like render or source data,
+	 * into the snapshot stored in the context, so SerializeAsset itself can run in parallel
+	 */
+	virtual void CaptureAssetSnapshot(TSharedRef<FSerializationContext> Context) const {}
+
     /**
      * Returns serializer capable of serializing asset of specified class
      * or NULL if such serializer cannot be resolved.
@@ -4,6 +4,16 @@
 class UPropertySerializer;
 class UObjectHierarchySerializer;
 class FJsonObject;
+struct FAssetDumpIndexEntry;
+struct FPooledSerializers;
+
+/**
+ * Base for the asset data copied on the game thread by UAssetTypeSerializer::CaptureAssetSnapshot
+ * Asset type serializers derive from it to carry the data they cannot safely read from the worker threads
+ */
+struct ASSETDUMPER_API FAssetSerializationSnapshot {
+	virtual ~FAssetSerializationSnapshot() = default;
+};
 
 /**
  * Describes context used for the serialization of a single asset object
@@ -26,21 +36,23 @@ private:
 	UPackage* Package;
 	UObject* AssetObject;
 
-	/** Property serializer handling serialization of object properties */
+	/** Property serializer handling serialization of object properties. Owned by the serializer pool */
 	UPropertySerializer* PropertySerializer;
-	/** Object hierarchy serializer for the serialization of uobject hierarchies */
+	/** Object hierarchy serializer for the serialization of uobject hierarchies. Owned by the serializer pool */
 	UObjectHierarchySerializer* ObjectHierarchySerializer;
 	/** Additional data serialized by the asset type serializer */
 	TSharedPtr<FJsonObject> AssetSerializedData;
+	/** Asset data captured on the game thread before the serialization, can be NULL */
+	TSharedPtr<FAssetSerializationSnapshot> AssetSnapshot;
+	/** Whenever the dump has been requested to run on a single thread, including the work serializers split up themselves */
+	bool bForceSingleThread;
 
-	/** Internal constructor */
-	FSerializationContext(const FString& RootOutputDirectory, const FAssetData& AssetData, UObject* AssetObject);
+	/** Internal constructor, serializers are expected to be freshly acquired from the pool */
+	FSerializationContext(const FString& RootOutputDirectory, const FAssetData& AssetData, UObject* AssetObject, const FPooledSerializers& Serializers, bool bForceSingleThread);
 
-	/** Finalizes serialization by writing resulting JSON file containing object hierarchy and additional information */
-	void Finalize() const;
+	/** Finalizes serialization by writing resulting JSON file containing object hierarchy and additional information, and describes it in the index entry */
+	void Finalize(FAssetDumpIndexEntry& OutIndexEntry) const;
 public:
-	~FSerializationContext();
-
 	static UObject* GetAssetObjectFromPackage(UPackage* Package, const FAssetData& AssetData);
 	
 	/** The path to the package this asset is located in, with final package name stripped, like /Game/Path */
@@ -73,6 +85,23 @@ public:
 		return ObjectHierarchySerializer;
 	}
 
+	/** Returns true if serializers should not parallelize their work, as requested by FAssetDumpSettings::bForceSingleThread */
+	FORCEINLINE bool ShouldForceSingleThread() const {
+		return bForceSingleThread;
+	}
+
+	/** Stores the data captured on the game thread for the serialization step */
+	FORCEINLINE void SetSnapshot(const TSharedRef<FAssetSerializationSnapshot>& NewSnapshot) {
+		this->AssetSnapshot = NewSnapshot;
+	}
+
+	/** Returns snapshot captured by the asset type serializer, which must be of the provided type */
+	template<typename T>
+	FORCEINLINE const T& GetSnapshot() const {
+		checkf(AssetSnapshot.IsValid(), TEXT("Asset snapshot has not been captured for %s"), *GetPackageName());
+		return *StaticCastSharedPtr<T>(AssetSnapshot);
+	}
+
 	/** Returns json object used for writing additional asset-related information for the asset type serializer */
 	FORCEINLINE TSharedRef<FJsonObject> GetData() const {
 		return AssetSerializedData.ToSharedRef();
@@ -0,0 +1,44 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class UPropertySerializer;
+class UObjectHierarchySerializer;
+class UAssetTypeSerializer;
+
+/** Pair of serializers handed out to a single asset being dumped */
+struct ASSETDUMPER_API FPooledSerializers {
+	UPropertySerializer* PropertySerializer;
+	UObjectHierarchySerializer* ObjectHierarchySerializer;
+
+	FPooledSerializers() : PropertySerializer(NULL), ObjectHierarchySerializer(NULL) {}
+};
+
+/**
+ * Keeps property and object hierarchy serializers around between the assets instead of creating new ones for every asset
+ * Serializers are pooled per asset type serializer, because asset type serializers configure them with the
+ * property blacklists specific to their asset type, which should not leak into the assets of other types
+ * Serializers are only created on the game thread, but can be released from any thread
+ */
+class ASSETDUMPER_API FSerializerPool {
+private:
+	/** Serializers available for reuse, grouped by the asset type serializer they have been configured by */
+	TMap<UAssetTypeSerializer*, TArray<FPooledSerializers>> FreeSerializers;
+	/** All of the serializers created by this pool, kept rooted until the pool is destroyed */
+	TArray<FPooledSerializers> AllSerializers;
+	/** Guards free lists against concurrent releases from the dumper worker threads */
+	FCriticalSection FreeSerializersCriticalSection;
+	/** Total amount of times serializers have been acquired */
+	int32 NumAcquired;
+public:
+	FSerializerPool();
+	~FSerializerPool();
+
+	/** Returns serializers ready to be used for the asset of the given type, creating new ones if there are none free. Game thread only */
+	FPooledSerializers Acquire(UAssetTypeSerializer* AssetSerializer);
+
+	/** Resets serializers and makes them available for the next asset of the same type. Thread safe */
+	void Release(UAssetTypeSerializer* AssetSerializer, const FPooledSerializers& Serializers);
+
+	FORCEINLINE int32 GetNumCreated() const { return AllSerializers.Num(); }
+	FORCEINLINE int32 GetNumAcquired() const { return NumAcquired; }
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Keys of a single bone track, laid out the same way as the raw animation track
+ * Every key array contains either a single key for the whole animation or one key per frame
+ */
+struct ASSETDUMPER_API FDumpedAnimationTrack {
+	/** Name of the skeleton bone animated by this track */
+	FString BoneName;
+	TArray<FVector> PositionKeys;
+	/** Rotation keys, stored in the file using smallest three quaternion packing */
+	TArray<FQuat> RotationKeys;
+	TArray<FVector> ScaleKeys;
+
+	/** Collapses key arrays consisting of identical keys into a single key */
+	void CompactConstantKeys();
+
+	friend FArchive& operator<<(FArchive& Ar, FDumpedAnimationTrack& Track);
+};
+
+/** Single key of the float curve, mirrors FRichCurveKey without depending on the Engine module */
+struct ASSETDUMPER_API FDumpedCurveKey {
+	float Time;
+	float Value;
+	float ArriveTangent;
+	float LeaveTangent;
+	float ArriveTangentWeight;
+	float LeaveTangentWeight;
+	uint8 InterpMode;
+	uint8 TangentMode;
+	uint8 TangentWeightMode;
+
+	FDumpedCurveKey();
+
+	friend FArchive& operator<<(FArchive& Ar, FDumpedCurveKey& Key);
+};
+
+/** Float curve of the animation sequence */
+struct ASSETDUMPER_API FDumpedAnimationCurve {
+	FString CurveName;
+	/** Animation curve flags, like morph target or material curve */
+	int32 CurveTypeFlags;
+	TArray<FDumpedCurveKey> Keys;
+
+	FDumpedAnimationCurve();
+
+	friend FArchive& operator<<(FArchive& Ar, FDumpedAnimationCurve& Curve);
+};
+
+/**
+ * Compact binary format for the animation sequence bone tracks and float curves
+ * Written by the asset dumper by sampling the animation at every frame and read back by the asset generator,
+ * which builds raw animation tracks out of it without going through FBX
+ * Positions and scales are stored losslessly, rotations are packed into 64 bits per key
+ */
+struct ASSETDUMPER_API FDumpedAnimationData {
+	/** Amount of frames, tracks having more than one key have exactly this amount of keys */
+	int32 NumFrames;
+	/** Length of the animation in seconds */
+	float SequenceLength;
+	TArray<FDumpedAnimationTrack> Tracks;
+	TArray<FDumpedAnimationCurve> Curves;
+
+	/** Extension of the animation files written into the dump directory */
+	static const TCHAR* FileExtension;
+
+	FDumpedAnimationData();
+
+	/** Returns time of the provided frame, in seconds */
+	float GetTimeAtFrame(int32 Frame) const;
+
+	/** Checks that every track has the valid amount of keys */
+	bool Validate(FString& OutErrorMessage) const;
+
+	/** Serializes animation data into the binary representation */
+	void SaveToBytes(TArray<uint8>& OutBytes) const;
+
+	/** Reads animation data from the binary representation. Returns false if data is malformed or has an unsupported version */
+	bool LoadFromBytes(const TArray<uint8>& Bytes, FString& OutErrorMessage);
+
+	/** Reads animation data from the file on disk */
+	bool LoadFromFile(const FString& FilePath, FString& OutErrorMessage);
+
+	/**
+	 * Packs normalized quaternion into 64 bits using smallest three encoding: index of the largest component
+	 * is stored in 2 bits, and remaining three components are quantized to 20 bits each, with a step of about 1.4e-6
+	 */
+	static uint64 PackRotation(const FQuat& Rotation);
+
+	/** Unpacks quaternion packed by PackRotation. Result is always normalized */
+	static FQuat UnpackRotation(uint64 PackedRotation);
+
+	/** Computes hash of the serialized animation data, matching the one computed by the FMD5Hash::HashFile for the written file */
+	static FString ComputeFileHash(const TArray<uint8>& Bytes);
+
+	friend FArchive& operator<<(FArchive& Ar, FDumpedAnimationData& AnimationData);
+};
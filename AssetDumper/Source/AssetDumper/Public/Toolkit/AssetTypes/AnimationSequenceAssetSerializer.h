@@ -6,6 +6,7 @@ UCLASS(MinimalAPI)
 class UAnimationSequenceAssetSerializer : public UAssetTypeSerializer {
     GENERATED_BODY()
 public:
+    virtual void CaptureAssetSnapshot(TSharedRef<FSerializationContext> Context) const override;
     virtual void SerializeAsset(TSharedRef<FSerializationContext> Context) const override;
     
     virtual FName GetAssetClass() const override;
@@ -3,6 +3,7 @@
 
 class UObjectHierarchySerializer;
 class FJsonObject;
+class FJsonValue;
 
 class ASSETDUMPER_API FAssetHelper {
 public:
@@ -15,20 +16,34 @@ public:
      */
     static bool HasCustomSerializeOnStruct(UScriptStruct* Struct);
 
-    /** Serializes Class object in a way mirroring native UClass::Serialize implementation */
-    static void SerializeClass(TSharedPtr<FJsonObject> OutObject, UClass* Class, UObjectHierarchySerializer* ObjectHierarchySerializer);
+    /**
+     * Serializes Class object in a way mirroring native UClass::Serialize implementation
+     * When bForceSingleThread is set, function bytecode is disassembled on the calling thread
+     */
+    static void SerializeClass(TSharedPtr<FJsonObject> OutObject, UClass* Class, UObjectHierarchySerializer* ObjectHierarchySerializer, bool bForceSingleThread = false);
 
-    /** Serializes Struct object in a way mirroring native UStruct::Serialize implementation */
-    static void SerializeStruct(TSharedPtr<FJsonObject> OutObject, UStruct* Struct, UObjectHierarchySerializer* ObjectHierarchySerializer);
+    /**
+     * Serializes Struct object in a way mirroring native UStruct::Serialize implementation
+     * Functions declared in the struct have their bytecode disassembled in parallel before being serialized in order
+     * DisassembledScript is the result of DisassembleScript for this struct, if NULL bytecode is disassembled in place
+     * When bForceSingleThread is set, functions are disassembled on the calling thread instead
+     */
+    static void SerializeStruct(TSharedPtr<FJsonObject> OutObject, UStruct* Struct, UObjectHierarchySerializer* ObjectHierarchySerializer, TSharedPtr<FJsonObject> DisassembledScript = NULL, bool bForceSingleThread = false);
+
+    /**
+     * Disassembles script bytecode of the struct and returns object holding script fields to be merged into the serialized struct
+     * Does not touch the object hierarchy serializer, so it is safe to call for different structs in parallel
+     */
+    static TSharedPtr<FJsonObject> DisassembleScript(UStruct* Struct);
 
     /** Serializes ScriptStruct object in a way mirroring native UStruct::Serialize implementation */
-    static void SerializeScriptStruct(TSharedPtr<FJsonObject> OutObject, UScriptStruct* Struct, UObjectHierarchySerializer* ObjectHierarchySerializer);
+    static void SerializeScriptStruct(TSharedPtr<FJsonObject> OutObject, UScriptStruct* Struct, UObjectHierarchySerializer* ObjectHierarchySerializer, bool bForceSingleThread = false);
 
     /** Serializes UProperty object in a way mirroring native UProperty::Serialize implementation */
     static void SerializeProperty(TSharedPtr<FJsonObject> OutObject, UProperty* Property, UObjectHierarchySerializer* ObjectHierarchySerializer);
 
     /** Serializes UFunction object in a way mirroring native UFunction::Serialize implementation */
-    static void SerializeFunction(TSharedPtr<FJsonObject> OutObject, UFunction* Function, UObjectHierarchySerializer* ObjectHierarchySerializer);
+    static void SerializeFunction(TSharedPtr<FJsonObject> OutObject, UFunction* Function, UObjectHierarchySerializer* ObjectHierarchySerializer, TSharedPtr<FJsonObject> DisassembledScript = NULL);
 
     /** Serializes UEnum object in a way mirroring native UEnum::Serialize implementation */
     static void SerializeEnum(TSharedPtr<FJsonObject> OutObject, UEnum* Enum);
@@ -38,4 +53,13 @@ public:
 
 	/* Computes hash for the provided payload */
 	static FString ComputePayloadHash(const TArray<uint8>& Payload);
+
+	/**
+	 * Serializes transform as an array of 10 numbers: translation, rotation quaternion and scale
+	 * Unlike FTransform::ToString, the encoding is lossless and does not require string parsing to read back
+	 */
+	static TSharedRef<FJsonValue> SerializeTransform(const FTransform& Transform);
+
+	/** Deserializes transform written by SerializeTransform, or a legacy string written by FTransform::ToString */
+	static bool DeserializeTransform(const TSharedPtr<FJsonValue>& Value, FTransform& OutTransform);
 };
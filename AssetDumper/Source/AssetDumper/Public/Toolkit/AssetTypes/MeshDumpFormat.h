@@ -0,0 +1,101 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/** Single section of the mesh LOD, covering a range of triangles rendered with the same material */
+struct ASSETDUMPER_API FDumpedMeshSection {
+	/** Index of the material slot used by this section */
+	int32 MaterialIndex;
+	/** Index of the first index of the section inside of the LOD index buffer */
+	int32 FirstIndex;
+	/** Amount of triangles in the section */
+	int32 NumTriangles;
+
+	FDumpedMeshSection();
+
+	friend FArchive& operator<<(FArchive& Ar, FDumpedMeshSection& Section);
+};
+
+/**
+ * Vertex and index data of a single mesh LOD, laid out the same way as the render data it was captured from
+ * Every attribute array is either empty or has exactly one element per vertex
+ */
+struct ASSETDUMPER_API FDumpedMeshLOD {
+	/** Screen size at which this LOD becomes active */
+	float ScreenSize;
+	TArray<FVector> Positions;
+	/** Normals (TangentZ) of the vertices */
+	TArray<FVector> Normals;
+	/** Tangents (TangentX) of the vertices, W contains binormal sign */
+	TArray<FVector4> Tangents;
+	/** Texture coordinates, one array per UV channel */
+	TArray<TArray<FVector2D>> TexCoords;
+	/** Vertex colors, empty when mesh has no vertex colors */
+	TArray<FColor> Colors;
+	/** Triangle list indices */
+	TArray<uint32> Indices;
+	TArray<FDumpedMeshSection> Sections;
+	/** Amount of bone influences stored for each vertex, zero for static meshes */
+	int32 NumInfluencesPerVertex;
+	/** Reference skeleton bone indices of the influences, NumInfluencesPerVertex entries per vertex */
+	TArray<uint16> InfluenceBones;
+	/** Weights of the influences, normalized to sum up to 255 for every vertex */
+	TArray<uint8> InfluenceWeights;
+
+	FDumpedMeshLOD();
+
+	FORCEINLINE int32 GetNumVertices() const { return Positions.Num(); }
+	FORCEINLINE int32 GetNumTexCoords() const { return TexCoords.Num(); }
+	FORCEINLINE bool HasVertexColors() const { return Colors.Num() > 0; }
+	FORCEINLINE bool HasSkinWeights() const { return NumInfluencesPerVertex > 0; }
+
+	friend FArchive& operator<<(FArchive& Ar, FDumpedMeshLOD& LOD);
+};
+
+/** Bone of the reference skeleton along with it's reference pose */
+struct ASSETDUMPER_API FDumpedMeshBone {
+	FString Name;
+	/** Index of the parent bone, INDEX_NONE for the root bone */
+	int32 ParentIndex;
+	/** Reference pose of the bone, relative to the parent bone */
+	FTransform Pose;
+
+	FDumpedMeshBone();
+
+	friend FArchive& operator<<(FArchive& Ar, FDumpedMeshBone& Bone);
+};
+
+/**
+ * Self-contained binary interchange format for static and skeletal meshes
+ * Written by the asset dumper directly from the mesh render data and read back by the asset generator,
+ * which builds mesh source data out of it without going through FBX
+ * Only depends on Core, so it can be read and written without the editor or rendering being available
+ */
+struct ASSETDUMPER_API FDumpedMeshData {
+	/** Names of the material slots referenced by the sections */
+	TArray<FString> MaterialSlotNames;
+	TArray<FDumpedMeshLOD> LODs;
+	/** Reference skeleton of the mesh, empty for static meshes */
+	TArray<FDumpedMeshBone> Bones;
+
+	/** Extension of the mesh files written into the dump directory */
+	static const TCHAR* FileExtension;
+
+	FORCEINLINE bool IsSkeletalMesh() const { return Bones.Num() > 0; }
+
+	/** Checks that attribute arrays, indices, sections and influences are consistent with each other */
+	bool Validate(FString& OutErrorMessage) const;
+
+	/** Serializes mesh data into the binary representation */
+	void SaveToBytes(TArray<uint8>& OutBytes) const;
+
+	/** Reads mesh data from the binary representation. Returns false if data is malformed or has an unsupported version */
+	bool LoadFromBytes(const TArray<uint8>& Bytes, FString& OutErrorMessage);
+
+	/** Reads mesh data from the file on disk */
+	bool LoadFromFile(const FString& FilePath, FString& OutErrorMessage);
+
+	/** Computes hash of the serialized mesh data, matching the one computed by the FMD5Hash::HashFile for the written file */
+	static FString ComputeFileHash(const TArray<uint8>& Bytes);
+
+	friend FArchive& operator<<(FArchive& Ar, FDumpedMeshData& MeshData);
+};
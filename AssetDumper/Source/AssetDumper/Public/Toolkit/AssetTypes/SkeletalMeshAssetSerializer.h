@@ -6,6 +6,7 @@ UCLASS(MinimalAPI)
 class USkeletalMeshAssetSerializer : public UAssetTypeSerializer {
     GENERATED_BODY()
 public:
+    virtual void CaptureAssetSnapshot(TSharedRef<FSerializationContext> Context) const override;
     virtual void SerializeAsset(TSharedRef<FSerializationContext> Context) const override;
 
     static void SerializeReferenceSkeleton(const struct FReferenceSkeleton& ReferenceSkeleton, TSharedPtr<class FJsonObject> OutObject);
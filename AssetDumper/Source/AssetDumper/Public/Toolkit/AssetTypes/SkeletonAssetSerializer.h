@@ -6,6 +6,7 @@ UCLASS(MinimalAPI)
 class USkeletonAssetSerializer : public UAssetTypeSerializer {
     GENERATED_BODY()
 public:
+    virtual void CaptureAssetSnapshot(TSharedRef<FSerializationContext> Context) const override;
     virtual void SerializeAsset(TSharedRef<FSerializationContext> Context) const override;
     static void SerializeSmartNameContainer(const struct FSmartNameContainer& Container, TSharedPtr<class FJsonObject> OutObject);
     
@@ -6,8 +6,12 @@ UCLASS(MinimalAPI)
 class UStaticMeshAssetSerializer : public UAssetTypeSerializer {
     GENERATED_BODY()
 public:
+    virtual void CaptureAssetSnapshot(TSharedRef<FSerializationContext> Context) const override;
     virtual void SerializeAsset(TSharedRef<FSerializationContext> Context) const override;
 
     virtual FName GetAssetClass() const override;
     virtual bool SupportsParallelDumping() const override;
+
+    /** Copies vertex attributes out of the render data vertex buffers. Returns false if CPU copy of the vertex data has been discarded */
+    static bool CaptureVertexBuffers(struct FStaticMeshVertexBuffers& VertexBuffers, struct FDumpedMeshLOD& OutLOD);
 };
@@ -0,0 +1,30 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Compact binary representation of the disassembled function bytecode
+ * Encodes the statement tree produced by FKismetBytecodeDisassemblerJson with all field names and string values
+ * interned into a single string table, so repeated instruction and field names are stored only once per function
+ * Written into the dump instead of the plain JSON statement list, which is only written as a debug output now
+ */
+class ASSETDUMPER_API FKismetBytecodeCompactFormat {
+public:
+	/** Encodes disassembled statements into the compact binary representation */
+	static void SaveStatements(const TArray<TSharedPtr<FJsonValue>>& Statements, TArray<uint8>& OutBytes);
+
+	/** Rebuilds disassembled statements from the compact binary representation. Returns false if data is malformed or has an unsupported version */
+	static bool LoadStatements(const TArray<uint8>& Bytes, TArray<TSharedPtr<FJsonValue>>& OutStatements, FString& OutErrorMessage);
+
+	/**
+	 * Writes function script into the provided struct object. Script is always written in the compact form,
+	 * and is additionally written as a plain JSON statement list when -DumpBytecodeAsJson is passed on the command line
+	 */
+	static void WriteFunctionScript(const TSharedPtr<FJsonObject>& OutObject, const TArray<TSharedPtr<FJsonValue>>& Statements);
+
+	/** Reads function script from the struct object, preferring compact form and falling back to the plain JSON statement list */
+	static TArray<TSharedPtr<FJsonValue>> ReadFunctionScript(const TSharedPtr<FJsonObject>& Object);
+
+	/** Returns true if script bytecode should also be written as the plain JSON statement list for debugging */
+	static bool ShouldDumpBytecodeAsJson();
+};
@@ -7,19 +7,59 @@ public:
 	/** Converts a single expression into json object */
 	TSharedPtr<FJsonObject> SerializeExpression(int32& ScriptIndex);
 
-	/** Parses a block of statements until it hits return */
+	/** Parses a block of statements until it hits return. Returns no statements if the script is truncated, see HasReadError */
 	TArray<TSharedPtr<FJsonValue>> SerializeFunction(UStruct* Function);
 
+	/**
+	 * Same as SerializeFunction, but reads the provided script instead of the bytecode of the function
+	 * Such script is not owned by a loaded function, so instructions referencing objects or properties are reported as read errors
+	 */
+	TArray<TSharedPtr<FJsonValue>> SerializeScript(TArrayView<const uint8> InScript, UClass* InSelfScope);
+
 	/** Computes length of the statement in bytes and returns it. Returns false if given index does not correspond to any statement (e.g if it is inside of some statement) */
 	bool GetStatementLength(UStruct* Function, int32 StatementIndex, int32& OutStatementLength);
 
 	/** Returns index of the first statement using given opcode */
 	bool FindFirstStatementOfType(UStruct* Function, int32 StartIndex, uint8 StatementOpcode, int32& OutStatementIndex);
+
+	/** Returns true if the last disassembled script was truncated or malformed, and the message describing the first error */
+	FORCEINLINE bool HasReadError() const { return bHasReadError; }
+	FORCEINLINE FString GetReadErrorMessage() const { return ReadErrorMessage; }
 private:
 	TWeakObjectPtr<UClass> SelfScope;
-	TArray<uint8> Script;
+	/** View into the bytecode of the function being disassembled, it is not copied since function outlives disassembly */
+	TArrayView<const uint8> Script;
+	/** Set once a read goes out of bounds of the script, every read after it returns zero and leaves the index at the end of the script */
+	bool bHasReadError = false;
+	FString ReadErrorMessage;
+	/** False when the script does not belong to a loaded function, pointers recorded in it cannot be dereferenced then */
+	bool bCanResolveObjectReferences = true;
+
+	TArray<TSharedPtr<FJsonValue>> SerializeStatements(TArrayView<const uint8> InScript, UClass* InSelfScope, bool bInCanResolveObjectReferences);
 
 	//Begin script bytecode parsing methods
+	/** Checks that the provided amount of bytes can be read at the script index, recording the read error otherwise */
+	bool CheckScriptBounds(int32 ScriptIndex, int32 NumBytes);
+	/** Records the read error and moves the script index to the end of the script */
+	void SetReadError(int32& ScriptIndex, const FString& ErrorMessage);
+	/** Returns byte at the script index without advancing it, or zero if it is out of bounds */
+	uint8 PeekByte(int32 ScriptIndex);
+	/** Returns true if the script index points at the provided end token, or if the script has been read past it's end */
+	bool IsAtEndToken(int32 ScriptIndex, uint8 EndToken);
+
+	/** Reads little-endian value of the provided type with a single unaligned load */
+	template <typename T>
+	T ReadUnaligned(int32& ScriptIndex) {
+		if (!CheckScriptBounds(ScriptIndex, sizeof(T))) {
+			ScriptIndex = Script.Num();
+			return T();
+		}
+		T Value;
+		FMemory::Memcpy(&Value, Script.GetData() + ScriptIndex, sizeof(T));
+		ScriptIndex += sizeof(T);
+		return Value;
+	}
+
 	int32 ReadInt(int32& ScriptIndex);
 	uint64 ReadQword(int32& ScriptIndex);
 	uint8 ReadByte(int32& ScriptIndex);
@@ -33,7 +73,13 @@ private:
 	
 	template <typename T>
     T* ReadPointer(int32& ScriptIndex) {
-		return (T*)ReadQword(ScriptIndex);
+		const int32 PointerIndex = ScriptIndex;
+		T* Pointer = (T*)ReadQword(ScriptIndex);
+		if (!bCanResolveObjectReferences && !bHasReadError) {
+			SetReadError(ScriptIndex, FString::Printf(TEXT("Object reference at %d cannot be resolved outside of a loaded function"), PointerIndex));
+			return NULL;
+		}
+		return Pointer;
 	}
 	//End script bytecode parsing methods
 };
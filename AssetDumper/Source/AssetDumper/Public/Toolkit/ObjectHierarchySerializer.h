@@ -70,6 +70,12 @@ public:
 	
     void InitializeForSerialization(UPackage* NewSourcePackage);
 
+    /**
+     * Clears all of the per-asset state, like object indices, serialized objects and object marks,
+     * so the serializer can be reused for the next asset. Property serializer and it's configuration are kept
+     */
+    void Reset();
+
     /**
      * Sets object mark for provided object instance
      * Instances of this object will be serialized as a simple object mark string
@@ -51,7 +51,7 @@ private:
 
 	UPROPERTY()
 		TArray<UStruct*> PinnedStructs;
-	TArray<UProperty*> BlacklistedProperties;
+	TSet<UProperty*> BlacklistedProperties;
 
 	TSharedPtr<FStructSerializer> FallbackStructSerializer;
 	TMap<UScriptStruct*, TSharedPtr<FStructSerializer>> StructSerializers;
@@ -0,0 +1,50 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Matches package names against a set of exact package names and recursive package paths
+ * Package paths are stored in a trie keyed by the path segments, so matching a package name
+ * costs one lookup per path segment regardless of the amount of rules registered
+ * Comparison is case insensitive, just like FName comparison
+ */
+class ASSETDUMPER_API FPackageNameMatcher {
+private:
+	/** Single segment of the package path inside of the trie */
+	struct FPathNode {
+		/** Child nodes mapped by the name of the next path segment */
+		TMap<FName, int32> Children;
+		/** True if packages anywhere under this path match */
+		bool bMatchesSubtree;
+
+		FPathNode() : bMatchesSubtree(false) {}
+	};
+
+	/** Nodes of the path trie, root node representing / is always at index 0 */
+	TArray<FPathNode> PathNodes;
+	/** Package names matched exactly */
+	TSet<FName> PackageNames;
+	/** Amount of package paths registered */
+	int32 NumPackagePaths;
+public:
+	FPackageNameMatcher();
+
+	/** Adds package name to be matched exactly, e.g /Game/Path/Package */
+	void AddPackageName(const FString& PackageName);
+
+	/** Adds package path to be matched recursively, e.g /Game/Path will match /Game/Path/Package and /Game/Path/Sub/Package */
+	void AddPackagePath(const FString& PackagePath);
+
+	/** Adds package path if rule ends with /, or exact package name otherwise */
+	void AddRule(const FString& Rule);
+
+	/** Determines whenever provided package name matches any of the rules */
+	bool Matches(FName PackageName) const;
+	bool Matches(const FString& PackageName) const;
+
+	FORCEINLINE bool IsEmpty() const { return PackageNames.Num() == 0 && NumPackagePaths == 0; }
+	FORCEINLINE int32 GetNumPackageNames() const { return PackageNames.Num(); }
+	FORCEINLINE int32 GetNumPackagePaths() const { return NumPackagePaths; }
+private:
+	/** Returns true if any parent path of the package is matched recursively */
+	bool MatchesPackagePath(const TCHAR* PackageName, int32 PackageNameLen) const;
+};
@@ -43,7 +43,10 @@ public class AssetGenerator : ModuleRules
             "PhysicsCore",
             "MediaAssets",
             "AudioEditor",
-            "GraphEditor"
+            "GraphEditor",
+            "MeshDescription",
+            "StaticMeshDescription",
+            "MeshBuilder"
         });
 
 #if UE_4_26_OR_LATER
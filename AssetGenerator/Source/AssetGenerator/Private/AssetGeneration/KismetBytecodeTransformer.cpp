@@ -1,4 +1,5 @@
 ﻿#include "AssetGeneration/KismetBytecodeTransformer.h"
+#include "Algo/BinarySearch.h"
 #include "BPTerminal.h"
 #include "EdGraphSchema_K2.h"
 #include "Engine/Blueprint.h"
@@ -6,8 +7,11 @@
 #include "CoreUObject.h"
 #include "Toolkit/PropertyTypeHelper.h"
 
+DECLARE_LOG_CATEGORY_CLASS(LogKismetBytecodeTransformer, Log, All);
+
 FKismetBytecodeTransformer::FKismetBytecodeTransformer(UBlueprint* Blueprint) {
 	this->OwnerBlueprint = Blueprint;
+	this->bInternLiteralTerminals = true;
 	this->ExecuteUbergraphFunctionName = UEdGraphSchema_K2::FN_ExecuteUbergraphBase.ToString() + TEXT("_") + Blueprint->GetName();
 }
 
@@ -18,22 +22,42 @@ void FKismetBytecodeTransformer::SetUberGraphTransformer(TSharedPtr<FKismetBytec
 
 void FKismetBytecodeTransformer::SetSourceStatements(const FString& FunctionName, const TArray<TSharedPtr<FJsonObject>>& Statements) {
 	this->CurrentFunctionName = FunctionName;
+	this->StatementOffsets.Reserve(Statements.Num());
 	this->ResultStatements.Reserve(Statements.Num());
 
 	for (const TSharedPtr<FJsonObject> StatementObject : Statements) {
 		const uint32 StatementIndex = StatementObject->GetIntegerField(TEXT("StatementIndex"));
 		TSharedPtr<FKismetCompiledStatement> Statement = ProcessStatement(StatementObject);
 
-		this->StatementsByOffset.Add(StatementIndex, Statement);
-		this->ResultStatements.Add(Statement);
+		AddResultStatement(StatementIndex, Statement);
 	}
 }
 
+void FKismetBytecodeTransformer::AddResultStatement(const int32 StatementOffset, TSharedPtr<FKismetCompiledStatement> Statement) {
+	checkf(StatementOffsets.Num() == 0 || StatementOffsets.Last() < StatementOffset,
+		TEXT("Statements of function %s are not in the bytecode order, statement at offset %d follows offset %d"), *CurrentFunctionName, StatementOffset, StatementOffsets.Last());
+	this->StatementOffsets.Add(StatementOffset);
+	this->ResultStatements.Add(Statement);
+}
+
+TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::FindStatementByOffset(const int32 StatementOffset) const {
+	const int32 StatementIndex = Algo::BinarySearch(StatementOffsets, StatementOffset);
+	return StatementIndex != INDEX_NONE ? ResultStatements[StatementIndex] : NULL;
+}
+
 TArray<TSharedPtr<FKismetCompiledStatement>> FKismetBytecodeTransformer::FinishGeneration() {
-	//Apply patch-ups to jump statements
+	//Apply patch-ups to jump statements in a single pass, reporting all dangling jump offsets before failing
+	int32 NumDanglingJumpOffsets = 0;
+
 	for (const TPair<TSharedPtr<FKismetCompiledStatement>, int32>& Pair : JumpPatchUpTable) {
 		const TSharedPtr<FKismetCompiledStatement> JumpStatement = Pair.Key;
-		const TSharedPtr<FKismetCompiledStatement> JumpTarget = StatementsByOffset.FindChecked(Pair.Value);
+		const TSharedPtr<FKismetCompiledStatement> JumpTarget = FindStatementByOffset(Pair.Value);
+
+		if (!JumpTarget.IsValid()) {
+			UE_LOG(LogKismetBytecodeTransformer, Error, TEXT("Jump in function %s targets offset %d, which is not a start of any statement"), *CurrentFunctionName, Pair.Value);
+			NumDanglingJumpOffsets++;
+			continue;
+		}
 		JumpStatement->TargetLabel = JumpTarget;
 
 		//Replace jump statement type if we are jumping to the return statement
@@ -48,41 +72,248 @@ TArray<TSharedPtr<FKismetCompiledStatement>> FKismetBytecodeTransformer::FinishG
 			}
 		}
 	}
+	checkf(NumDanglingJumpOffsets == 0, TEXT("Function %s has %d jumps to dangling bytecode offsets"), *CurrentFunctionName, NumDanglingJumpOffsets);
+
+	//Patch-ups have been applied already, so finishing generation again should not apply them twice
+	this->JumpPatchUpTable.Empty();
 
+	//Result statements keep interned literals alive, the pool itself is only needed while transforming
+	this->LiteralTerminalPool.Reset();
+	this->LiteralTerminalsBySource.Empty();
 	return ResultStatements;
 }
 
-bool FKismetBytecodeTransformer::IsContextInstruction(const FString& InstructionName) {
-	return InstructionName == TEXT("Context") ||
-		InstructionName == TEXT("Context_FailSilent") ||
-		InstructionName == TEXT("ClassContext");
+bool FKismetBytecodeTransformer::CanFallThroughStatement(const TSharedPtr<FKismetCompiledStatement>& Statement) {
+	switch (Statement->Type) {
+	case ECompiledStatementType::KCST_UnconditionalGoto:
+	case ECompiledStatementType::KCST_GotoReturn:
+	case ECompiledStatementType::KCST_Return:
+	case ECompiledStatementType::KCST_EndOfThread:
+	case ECompiledStatementType::KCST_ComputedGoto:
+		return false;
+	default:
+		return true;
+	}
+}
+
+/** Union-find over the region indices, used to merge regions which turn out to share statements */
+static int32 FindRootRegion(TArray<int32>& ParentRegions, int32 RegionIndex) {
+	while (ParentRegions[RegionIndex] != RegionIndex) {
+		ParentRegions[RegionIndex] = ParentRegions[ParentRegions[RegionIndex]];
+		RegionIndex = ParentRegions[RegionIndex];
+	}
+	return RegionIndex;
+}
+
+TArray<FKismetUbergraphRegion> FKismetBytecodeTransformer::PartitionUberGraph(const TArray<int32>& EntryOffsets) const {
+	checkf(IsUberGraphFunction(), TEXT("Only ubergraph function can be partitioned, got %s"), *CurrentFunctionName);
+
+	TMap<TSharedPtr<FKismetCompiledStatement>, int32> StatementIndices;
+	StatementIndices.Reserve(ResultStatements.Num());
+	for (int32 i = 0; i < ResultStatements.Num(); i++) {
+		StatementIndices.Add(ResultStatements[i], i);
+	}
+
+	//Sort entry points so region order does not depend on the order functions calling into the ubergraph were processed in
+	TArray<int32> SortedEntryOffsets = EntryOffsets;
+	SortedEntryOffsets.Sort();
+
+	TArray<int32> EntryStatementIndices;
+	TArray<int32> EntryRegionOffsets;
+	for (int32 i = 0; i < SortedEntryOffsets.Num(); i++) {
+		const int32 EntryStatementIndex = Algo::BinarySearch(StatementOffsets, SortedEntryOffsets[i]);
+		checkf(EntryStatementIndex != INDEX_NONE, TEXT("Ubergraph entry offset %d is not a start of any statement"), SortedEntryOffsets[i]);
+
+		if (!EntryStatementIndices.Contains(EntryStatementIndex)) {
+			EntryStatementIndices.Add(EntryStatementIndex);
+			EntryRegionOffsets.Add(SortedEntryOffsets[i]);
+		}
+	}
+
+	//Walk the control flow from every entry point, marking statements with the region that reached them first
+	//When walk reaches statement already owned by another region, both regions are merged, since they share code
+	TArray<int32> StatementRegions;
+	StatementRegions.Init(INDEX_NONE, ResultStatements.Num());
+	TArray<int32> ParentRegions;
+	TArray<int32> PendingStatements;
+
+	for (int32 RegionIndex = 0; RegionIndex < EntryStatementIndices.Num(); RegionIndex++) {
+		ParentRegions.Add(RegionIndex);
+		PendingStatements.Add(EntryStatementIndices[RegionIndex]);
+
+		while (PendingStatements.Num()) {
+			const int32 StatementIndex = PendingStatements.Pop(false);
+			const int32 OwnerRegion = StatementRegions[StatementIndex];
+
+			if (OwnerRegion != INDEX_NONE) {
+				ParentRegions[FindRootRegion(ParentRegions, OwnerRegion)] = FindRootRegion(ParentRegions, RegionIndex);
+				continue;
+			}
+			StatementRegions[StatementIndex] = RegionIndex;
+
+			const TSharedPtr<FKismetCompiledStatement>& Statement = ResultStatements[StatementIndex];
+			if (CanFallThroughStatement(Statement) && StatementIndex + 1 < ResultStatements.Num()) {
+				PendingStatements.Add(StatementIndex + 1);
+			}
+			//Jumps, pushed execution flow and latent action resume points all reference statements in the ubergraph through the target label
+			if (Statement->TargetLabel.IsValid()) {
+				if (const int32* TargetStatementIndex = StatementIndices.Find(Statement->TargetLabel)) {
+					PendingStatements.Add(*TargetStatementIndex);
+				}
+			}
+		}
+	}
+
+	//Build regions in the order of their first entry point, with statements in the bytecode order
+	TArray<FKismetUbergraphRegion> Regions;
+	TMap<int32, int32> RegionsByRootIndex;
+
+	for (int32 RegionIndex = 0; RegionIndex < EntryStatementIndices.Num(); RegionIndex++) {
+		const int32 RootRegion = FindRootRegion(ParentRegions, RegionIndex);
+		const int32* ExistingRegion = RegionsByRootIndex.Find(RootRegion);
+		const int32 ResultRegionIndex = ExistingRegion ? *ExistingRegion : RegionsByRootIndex.Add(RootRegion, Regions.AddDefaulted());
+
+		Regions[ResultRegionIndex].EntryOffsets.Add(EntryRegionOffsets[RegionIndex]);
+		Regions[ResultRegionIndex].EntryStatements.Add(ResultStatements[EntryStatementIndices[RegionIndex]]);
+	}
+
+	//Statements no known entry point reaches still have to be decompiled, since they can be reached through an entry offset we could not resolve
+	FKismetUbergraphRegion UnreachableRegion;
+	for (int32 StatementIndex = 0; StatementIndex < ResultStatements.Num(); StatementIndex++) {
+		if (StatementRegions[StatementIndex] != INDEX_NONE) {
+			const int32 RootRegion = FindRootRegion(ParentRegions, StatementRegions[StatementIndex]);
+			Regions[RegionsByRootIndex.FindChecked(RootRegion)].Statements.Add(ResultStatements[StatementIndex]);
+		}
+		else {
+			UnreachableRegion.Statements.Add(ResultStatements[StatementIndex]);
+		}
+	}
+	if (UnreachableRegion.Statements.Num()) {
+		UE_LOG(LogKismetBytecodeTransformer, Log, TEXT("%d statements of %s are not reachable from any of the %d known entry points, putting them into a separate region"),
+			UnreachableRegion.Statements.Num(), *CurrentFunctionName, EntryRegionOffsets.Num());
+		Regions.Add(MoveTemp(UnreachableRegion));
+	}
+	return Regions;
+}
+
+//Instruction names match enum entry names, and are the values of the "Inst" field written by the bytecode disassembler
+#define ADD_KISMET_INSTRUCTION(Name) InstructionTable.Add(TEXT(#Name), EKismetInstruction::Name)
+
+static TMap<FString, EKismetInstruction> CreateInstructionLookupTable() {
+	TMap<FString, EKismetInstruction> InstructionTable;
+	ADD_KISMET_INSTRUCTION(Nothing);
+	ADD_KISMET_INSTRUCTION(SetSet);
+	ADD_KISMET_INSTRUCTION(SetArray);
+	ADD_KISMET_INSTRUCTION(SetMap);
+	ADD_KISMET_INSTRUCTION(Let);
+	ADD_KISMET_INSTRUCTION(LetObj);
+	ADD_KISMET_INSTRUCTION(LetWeakObjPtr);
+	ADD_KISMET_INSTRUCTION(LetBool);
+	ADD_KISMET_INSTRUCTION(LetMulticastDelegate);
+	ADD_KISMET_INSTRUCTION(LetDelegate);
+	ADD_KISMET_INSTRUCTION(LetValueOnPersistentFrame);
+	ADD_KISMET_INSTRUCTION(CallMulticastDelegate);
+	ADD_KISMET_INSTRUCTION(ComputedJump);
+	ADD_KISMET_INSTRUCTION(Jump);
+	ADD_KISMET_INSTRUCTION(JumpIfNot);
+	ADD_KISMET_INSTRUCTION(PushExecutionFlow);
+	ADD_KISMET_INSTRUCTION(PopExecutionFlowIfNot);
+	ADD_KISMET_INSTRUCTION(PopExecutionFlow);
+	ADD_KISMET_INSTRUCTION(AddMulticastDelegate);
+	ADD_KISMET_INSTRUCTION(RemoveMulticastDelegate);
+	ADD_KISMET_INSTRUCTION(ClearMulticastDelegate);
+	ADD_KISMET_INSTRUCTION(BindDelegate);
+	ADD_KISMET_INSTRUCTION(Return);
+	ADD_KISMET_INSTRUCTION(CallMath);
+	ADD_KISMET_INSTRUCTION(LocalFinalFunction);
+	ADD_KISMET_INSTRUCTION(FinalFunction);
+	ADD_KISMET_INSTRUCTION(LocalVirtualFunction);
+	ADD_KISMET_INSTRUCTION(VirtualFunction);
+	ADD_KISMET_INSTRUCTION(ObjToInterfaceCast);
+	ADD_KISMET_INSTRUCTION(CrossInterfaceCast);
+	ADD_KISMET_INSTRUCTION(InterfaceToObjCast);
+	ADD_KISMET_INSTRUCTION(DynamicCast);
+	ADD_KISMET_INSTRUCTION(MetaCast);
+	ADD_KISMET_INSTRUCTION(PrimitiveCast);
+	ADD_KISMET_INSTRUCTION(Context);
+	ADD_KISMET_INSTRUCTION(Context_FailSilent);
+	ADD_KISMET_INSTRUCTION(ClassContext);
+	ADD_KISMET_INSTRUCTION(InterfaceContext);
+	ADD_KISMET_INSTRUCTION(StructMemberContext);
+	ADD_KISMET_INSTRUCTION(DefaultVariable);
+	ADD_KISMET_INSTRUCTION(InstanceVariable);
+	ADD_KISMET_INSTRUCTION(LocalVariable);
+	ADD_KISMET_INSTRUCTION(LocalOutVariable);
+	ADD_KISMET_INSTRUCTION(ArrayGetByRef);
+	ADD_KISMET_INSTRUCTION(SwitchValue);
+	ADD_KISMET_INSTRUCTION(Self);
+	ADD_KISMET_INSTRUCTION(TextConst);
+	ADD_KISMET_INSTRUCTION(StringConst);
+	ADD_KISMET_INSTRUCTION(UnicodeStringConst);
+	ADD_KISMET_INSTRUCTION(FloatConst);
+	ADD_KISMET_INSTRUCTION(IntConst);
+	ADD_KISMET_INSTRUCTION(Int64Const);
+	ADD_KISMET_INSTRUCTION(UInt64Const);
+	ADD_KISMET_INSTRUCTION(ByteConst);
+	ADD_KISMET_INSTRUCTION(False);
+	ADD_KISMET_INSTRUCTION(True);
+	ADD_KISMET_INSTRUCTION(NameConst);
+	ADD_KISMET_INSTRUCTION(VectorConst);
+	ADD_KISMET_INSTRUCTION(RotationConst);
+	ADD_KISMET_INSTRUCTION(TransformConst);
+	ADD_KISMET_INSTRUCTION(StructConst);
+	ADD_KISMET_INSTRUCTION(InstanceDelegate);
+	ADD_KISMET_INSTRUCTION(SoftObjectConst);
+	ADD_KISMET_INSTRUCTION(NoObject);
+	ADD_KISMET_INSTRUCTION(ObjectConst);
+	ADD_KISMET_INSTRUCTION(NoInterface);
+	ADD_KISMET_INSTRUCTION(ArrayConst);
+	ADD_KISMET_INSTRUCTION(SetConst);
+	ADD_KISMET_INSTRUCTION(MapConst);
+	return InstructionTable;
 }
 
-bool FKismetBytecodeTransformer::IsCallFunctionInstruction(const FString& InstructionName) {
-	return InstructionName == TEXT("CallMath") ||
-		InstructionName == TEXT("LocalFinalFunction") ||
-		InstructionName == TEXT("FinalFunction") ||
-		InstructionName == TEXT("LocalVirtualFunction") ||
-		InstructionName == TEXT("VirtualFunction");
+#undef ADD_KISMET_INSTRUCTION
+
+EKismetInstruction FKismetBytecodeTransformer::FindInstructionByName(const FString& InstructionName) {
+	//Table is populated once on the first lookup and is never modified afterwards
+	static const TMap<FString, EKismetInstruction> InstructionLookupTable = CreateInstructionLookupTable();
+
+	const EKismetInstruction* Instruction = InstructionLookupTable.Find(InstructionName);
+	return Instruction ? *Instruction : EKismetInstruction::Unknown;
 }
 
-bool FKismetBytecodeTransformer::IsVariableInstruction(const FString& InstructionName) {
-	return InstructionName == TEXT("DefaultVariable") ||
-		InstructionName == TEXT("InstanceVariable") ||
-		InstructionName == TEXT("LocalVariable") ||
-		InstructionName == TEXT("LocalOutVariable");
+EKismetInstruction FKismetBytecodeTransformer::GetInstruction(const TSharedPtr<FJsonObject>& Node) {
+	return FindInstructionByName(Node->GetStringField(TEXT("Inst")));
+}
+
+bool FKismetBytecodeTransformer::IsContextInstruction(const EKismetInstruction Instruction) {
+	return Instruction == EKismetInstruction::Context ||
+		Instruction == EKismetInstruction::Context_FailSilent ||
+		Instruction == EKismetInstruction::ClassContext;
+}
+
+bool FKismetBytecodeTransformer::IsCallFunctionInstruction(const EKismetInstruction Instruction) {
+	return Instruction == EKismetInstruction::CallMath ||
+		Instruction == EKismetInstruction::LocalFinalFunction ||
+		Instruction == EKismetInstruction::FinalFunction ||
+		Instruction == EKismetInstruction::LocalVirtualFunction ||
+		Instruction == EKismetInstruction::VirtualFunction;
 }
 
 TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatement(TSharedPtr<FJsonObject> Statement) {
-	const FString InstructionName = Statement->GetStringField(TEXT("Inst"));
+	const EKismetInstruction Instruction = GetInstruction(Statement);
 
-	if (InstructionName == TEXT("Nothing")) {
+	switch (Instruction) {
+	case EKismetInstruction::Nothing:
+	{
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
 		Result->Type = ECompiledStatementType::KCST_Nop;
 		return Result;
 	}
 
-	if (InstructionName == TEXT("SetSet")) {
+	case EKismetInstruction::SetSet:
+	{
 		TArray<TSharedPtr<FJsonValue>> Values = Statement->GetArrayField(TEXT("Values"));
 		const TSharedPtr<FJsonObject> LeftSideExpression = Statement->GetObjectField(TEXT("LeftSideExpression"));
 
@@ -96,7 +327,8 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 		return Result;
 	}
 
-	if (InstructionName == TEXT("SetArray")) {
+	case EKismetInstruction::SetArray:
+	{
 		TArray<TSharedPtr<FJsonValue>> Values = Statement->GetArrayField(TEXT("Values"));
 		const TSharedPtr<FJsonObject> LeftSideExpression = Statement->GetObjectField(TEXT("LeftSideExpression"));
 
@@ -110,7 +342,8 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 		return Result;
 	}
 
-	if (InstructionName == TEXT("SetMap")) {
+	case EKismetInstruction::SetMap:
+	{
 		TArray<TSharedPtr<FJsonValue>> Values = Statement->GetArrayField(TEXT("Values"));
 		const TSharedPtr<FJsonObject> LeftSideExpression = Statement->GetObjectField(TEXT("LeftSideExpression"));
 
@@ -128,20 +361,23 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 	}
 
 	//All of the assignment instructions are similar, it's just that they are type-specific for runtime to have easier time handling them
-	if (InstructionName == TEXT("Let") || InstructionName == TEXT("LetObj") ||
-		InstructionName == TEXT("LetWeakObjPtr") || InstructionName == TEXT("LetBool") ||
-		InstructionName == TEXT("LetMulticastDelegate") || InstructionName == TEXT("LetDelegate")) {
-
+	case EKismetInstruction::Let:
+	case EKismetInstruction::LetObj:
+	case EKismetInstruction::LetWeakObjPtr:
+	case EKismetInstruction::LetBool:
+	case EKismetInstruction::LetMulticastDelegate:
+	case EKismetInstruction::LetDelegate:
+	{
 		const TSharedPtr<FJsonObject> Variable = Statement->GetObjectField(TEXT("Variable"));
 		const TSharedPtr<FJsonObject> Expression = Statement->GetObjectField(TEXT("Expression"));
-		const FString ExpressionInstName = Expression->GetStringField(TEXT("Inst"));
+		const EKismetInstruction ExpressionInstruction = GetInstruction(Expression);
 
 		//Function calls cannot be expressions in compiled statement representation, so we need to handle case of RHS being CallFunction here
 		//They often happen to be prefixed with a context expression (except math call, which doesn't need context)
 		//So we need to check for both context expression and call function instruction
 		//ProcessFunctionCallStatement will handle context expression itself just fine too, so just call it regardless
-		if (IsCallFunctionInstruction(ExpressionInstName) || IsContextInstruction(ExpressionInstName)) {
-			TSharedPtr<FKismetCompiledStatement> FunctionCall = ProcessFunctionCallStatement(Expression);
+		if (IsCallFunctionInstruction(ExpressionInstruction) || IsContextInstruction(ExpressionInstruction)) {
+			TSharedPtr<FKismetCompiledStatement> FunctionCall = ProcessFunctionCallStatement(Expression, ExpressionInstruction);
 
 			//Set LHS so that function call result will be saved into the variable
 			FunctionCall->LHS = ProcessExpression(Variable);
@@ -151,19 +387,19 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 		//Casts are compiled down to variable assignments, so we need to handle them there
 
 		//These two cases below handle FScriptInterface <-> UObject pointer conversions primarily
-		if (ExpressionInstName == TEXT("ObjToInterfaceCast") || ExpressionInstName == TEXT("CrossInterfaceCast")) {
+		if (ExpressionInstruction == EKismetInstruction::ObjToInterfaceCast || ExpressionInstruction == EKismetInstruction::CrossInterfaceCast) {
 			TSharedPtr<FKismetCompiledStatement> InterfaceCast = MakeShareable(new FKismetCompiledStatement());
 
 			//Wraps UObject pointer into the FScriptInterface with provided interface class
-			if (ExpressionInstName == TEXT("ObjToInterfaceCast")) {
+			if (ExpressionInstruction == EKismetInstruction::ObjToInterfaceCast) {
 				InterfaceCast->Type = ECompiledStatementType::KCST_CastObjToInterface;
 				//Converts FScriptInterface pointer to one interface into another at the same object
 			}
-			else if (ExpressionInstName == TEXT("CrossInterfaceCast")) {
+			else if (ExpressionInstruction == EKismetInstruction::CrossInterfaceCast) {
 				InterfaceCast->Type = ECompiledStatementType::KCST_CrossInterfaceCast;
 			}
 			else {
-				checkf(0, TEXT("Unknown interface cast instruction %s"), *ExpressionInstName);
+				checkf(0, TEXT("Unknown interface cast instruction %s"), *Expression->GetStringField(TEXT("Inst")));
 			}
 
 			const FString InterfaceClassPath = Expression->GetStringField(TEXT("InterfaceClass"));
@@ -186,7 +422,7 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 		}
 
 		//Converts FScriptInterface object to raw UObject pointer
-		if (ExpressionInstName == TEXT("InterfaceToObjCast")) {
+		if (ExpressionInstruction == EKismetInstruction::InterfaceToObjCast) {
 			TSharedPtr<FKismetCompiledStatement> InterfaceToObjCast = MakeShareable(new FKismetCompiledStatement());
 			InterfaceToObjCast->Type = ECompiledStatementType::KCST_CastInterfaceToObj;
 
@@ -209,19 +445,19 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 		}
 
 		//These casts handle conversion between UObject pointer types and do not invole interfaces
-		if (ExpressionInstName == TEXT("DynamicCast") || ExpressionInstName == TEXT("MetaCast")) {
+		if (ExpressionInstruction == EKismetInstruction::DynamicCast || ExpressionInstruction == EKismetInstruction::MetaCast) {
 			TSharedPtr<FKismetCompiledStatement> CastStatement = MakeShareable(new FKismetCompiledStatement());
 
 			//DynamicCast handles conversions between UObject types (except UClasses)
-			if (ExpressionInstName == TEXT("DynamicCast")) {
+			if (ExpressionInstruction == EKismetInstruction::DynamicCast) {
 				CastStatement->Type = ECompiledStatementType::KCST_DynamicCast;
 				//MetaCast handles conversion between UClass types (actually it only does class type checking)
 			}
-			else if (ExpressionInstName == TEXT("MetaCast")) {
+			else if (ExpressionInstruction == EKismetInstruction::MetaCast) {
 				CastStatement->Type = ECompiledStatementType::KCST_MetaCast;
 			}
 			else {
-				checkf(0, TEXT("Unsupported cast instruction: %s"), *ExpressionInstName);
+				checkf(0, TEXT("Unsupported cast instruction: %s"), *Expression->GetStringField(TEXT("Inst")));
 			}
 
 			const FString DestinationClassPath = Expression->GetStringField(TEXT("Class"));
@@ -243,7 +479,7 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 		}
 
 		//PrimitiveCast basically convert UObject pointers and FScriptInterface objects into boolean
-		if (ExpressionInstName == TEXT("PrimitiveCast")) {
+		if (ExpressionInstruction == EKismetInstruction::PrimitiveCast) {
 			TSharedPtr<FKismetCompiledStatement> PrimitiveCast = MakeShareable(new FKismetCompiledStatement());
 			PrimitiveCast->Type = ECompiledStatementType::KCST_ObjectToBool;
 
@@ -261,11 +497,12 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
 		Result->Type = ECompiledStatementType::KCST_Assignment;
 		Result->LHS = ProcessExpression(Variable);
-		Result->RHS.Add(ProcessExpression(Expression));
+		Result->RHS.Add(ProcessExpression(Expression, ExpressionInstruction));
 		return Result;
 	}
 
-	if (InstructionName == TEXT("LetValueOnPersistentFrame")) {
+	case EKismetInstruction::LetValueOnPersistentFrame:
+	{
 		//It is variable assignment on a persistent frame, just like a normal assignment, but dest property is a bit special
 		const TSharedPtr<FJsonObject> Expression = Statement->GetObjectField(TEXT("Expression"));
 		const TSharedPtr<FJsonObject> PropertyType = Statement->GetObjectField(TEXT("PropertyType"));
@@ -287,13 +524,22 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 	//This is a function call statement, possibly prefixed with context expressions
 	//Just call process function call, it will handle the case when actual statement passed
 	//is a context and not the function call node itself gracefully
-	if (IsCallFunctionInstruction(InstructionName) || IsContextInstruction(InstructionName)) {
-		return ProcessFunctionCallStatement(Statement);
+	case EKismetInstruction::CallMath:
+	case EKismetInstruction::LocalFinalFunction:
+	case EKismetInstruction::FinalFunction:
+	case EKismetInstruction::LocalVirtualFunction:
+	case EKismetInstruction::VirtualFunction:
+	case EKismetInstruction::Context:
+	case EKismetInstruction::Context_FailSilent:
+	case EKismetInstruction::ClassContext:
+	{
+		return ProcessFunctionCallStatement(Statement, Instruction);
 	}
 
 	//EX_CallMulticastDelegate will never be prefixed with context,
 	//because it always accepts context as an separate argument and does not need it passed implicitly
-	if (InstructionName == TEXT("CallMulticastDelegate")) {
+	case EKismetInstruction::CallMulticastDelegate:
+	{
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
 		Result->Type = ECompiledStatementType::KCST_CallDelegate;
 		Result->FunctionContext = ProcessExpression(Statement->GetObjectField(TEXT("Delegate")));
@@ -342,7 +588,8 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 	}
 
 	//This is a computed jump statement, offset expression should be stored in the LHS
-	if (InstructionName == TEXT("ComputedJump")) {
+	case EKismetInstruction::ComputedJump:
+	{
 		const TSharedPtr<FJsonObject> Expression = Statement->GetObjectField(TEXT("Expression"));
 
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
@@ -353,38 +600,42 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 
 	//This is an unconditional jump, offset is stored in the TargetLabel
 	//But we cannot really resolve it until we finished processing all statements, so store it in the patch-up map
-	if (InstructionName == TEXT("Jump")) {
+	case EKismetInstruction::Jump:
+	{
 		const int32 JumpOffset = Statement->GetIntegerField(TEXT("Offset"));
 
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
 		Result->Type = ECompiledStatementType::KCST_UnconditionalGoto;
-		JumpPatchUpTable.Add(Result, JumpOffset);
+		JumpPatchUpTable.Emplace(Result, JumpOffset);
 		return Result;
 	}
 
-	if (InstructionName == TEXT("JumpIfNot")) {
+	case EKismetInstruction::JumpIfNot:
+	{
 		const TSharedPtr<FJsonObject> Condition = Statement->GetObjectField(TEXT("Condition"));
 		const int32 JumpOffset = Statement->GetIntegerField(TEXT("Offset"));
 
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
 		Result->Type = ECompiledStatementType::KCST_GotoIfNot;
 		Result->LHS = ProcessExpression(Condition);
-		JumpPatchUpTable.Add(Result, JumpOffset);
+		JumpPatchUpTable.Emplace(Result, JumpOffset);
 		return Result;
 	}
 
 	//Adds the location at which code will jump once PopExecutionFlow is encountered
-	if (InstructionName == TEXT("PushExecutionFlow")) {
+	case EKismetInstruction::PushExecutionFlow:
+	{
 		const int32 JumpOffset = Statement->GetIntegerField(TEXT("Offset"));
 
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
 		Result->Type = ECompiledStatementType::KCST_PushState;
-		JumpPatchUpTable.Add(Result, JumpOffset);
+		JumpPatchUpTable.Emplace(Result, JumpOffset);
 		return Result;
 	}
 
 	//Pops execution flow to the last stored location (or to return statement) if condition is zero
-	if (InstructionName == TEXT("PopExecutionFlowIfNot")) {
+	case EKismetInstruction::PopExecutionFlowIfNot:
+	{
 		const TSharedPtr<FJsonObject> Condition = Statement->GetObjectField(TEXT("Condition"));
 
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
@@ -394,14 +645,16 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 	}
 
 	//Pops execution flow to the last stored location (or to return statement) unconditionally
-	if (InstructionName == TEXT("PopExecutionFlow")) {
+	case EKismetInstruction::PopExecutionFlow:
+	{
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
 		Result->Type = ECompiledStatementType::KCST_EndOfThread;
 		return Result;
 	}
 
 	//Registers a delegate object into the multicast delegate subscription list
-	if (InstructionName == TEXT("AddMulticastDelegate")) {
+	case EKismetInstruction::AddMulticastDelegate:
+	{
 		const TSharedPtr<FJsonObject> MulticastDelegate = Statement->GetObjectField(TEXT("MulticastDelegate"));
 		const TSharedPtr<FJsonObject> Delegate = Statement->GetObjectField(TEXT("Delegate"));
 
@@ -413,7 +666,8 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 	}
 
 	//Removes a single delegate object out of multicast delegate subscription list
-	if (InstructionName == TEXT("RemoveMulticastDelegate")) {
+	case EKismetInstruction::RemoveMulticastDelegate:
+	{
 		const TSharedPtr<FJsonObject> MulticastDelegate = Statement->GetObjectField(TEXT("MulticastDelegate"));
 		const TSharedPtr<FJsonObject> Delegate = Statement->GetObjectField(TEXT("Delegate"));
 
@@ -425,7 +679,8 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 	}
 
 	//Clears a multicast delegate subscription list
-	if (InstructionName == TEXT("ClearMulticastDelegate")) {
+	case EKismetInstruction::ClearMulticastDelegate:
+	{
 		const TSharedPtr<FJsonObject> MulticastDelegate = Statement->GetObjectField(TEXT("MulticastDelegate"));
 
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
@@ -435,7 +690,8 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 	}
 
 	//Populates delegate object expression with a reference to the function of the object passed
-	if (InstructionName == TEXT("BindDelegate")) {
+	case EKismetInstruction::BindDelegate:
+	{
 		const TSharedPtr<FJsonObject> Delegate = Statement->GetObjectField(TEXT("Delegate"));
 		const TSharedPtr<FJsonObject> Object = Statement->GetObjectField(TEXT("Object"));
 		const FString FunctionName = Statement->GetStringField(TEXT("FunctionName"));
@@ -456,30 +712,39 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessStatemen
 	}
 
 	//Returns from the currently running function, optionally passing back returned value (or nothing)
-	if (InstructionName == TEXT("Return")) {
+	case EKismetInstruction::Return:
+	{
 		TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
 		Result->Type = ECompiledStatementType::KCST_Return;
 		return Result;
 	}
 
-	checkf(0, TEXT("Cannot transform instruction into compiled statement: %s"), *InstructionName);
+	default:
+		break;
+	}
+
+	checkf(0, TEXT("Cannot transform instruction into compiled statement: %s"), *Statement->GetStringField(TEXT("Inst")));
 	return NULL;
 }
 
 TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessExpression(TSharedPtr<FJsonObject> Expression) {
-	const FString InstructionName = Expression->GetStringField(TEXT("Inst"));
+	return ProcessExpression(Expression, GetInstruction(Expression));
+}
 
+TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessExpression(TSharedPtr<FJsonObject> Expression, const EKismetInstruction Instruction) {
 	//InlineGeneratedParameter will always be NULL for terminals returned by ProcessExpression,
 	//since we just don't have enough context to process statements here, and
 	//it can only be encountered inside of the CallFunction statements - so we handle it there
 
+	switch (Instruction) {
 	//EX_StructMemberContext retrieves value of struct property from struct value passed as context
-	if (InstructionName == TEXT("StructMemberContext")) {
+	case EKismetInstruction::StructMemberContext:
+	{
 		const FString PropertyName = Expression->GetStringField(TEXT("PropertyName"));
 		const TSharedPtr<FJsonObject> PropertyType = Expression->GetObjectField(TEXT("PropertyType"));
 		const TSharedPtr<FJsonObject> ContextExpression = Expression->GetObjectField(TEXT("StructExpression"));
 
-		const TSharedPtr<FKismetTerminal> ContextTerminal = ProcessExpression(ContextExpression);
+		const TSharedPtr<FKismetTerminal> ContextTerminal = MakeMutableTerminal(ProcessExpression(ContextExpression));
 		ContextTerminal->ContextType = FKismetTerminal::EContextType_Struct;
 
 		TSharedPtr<FKismetTerminal> StructMemberTerminal = MakeShareable(new FKismetTerminal());
@@ -492,21 +757,28 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessExpression(TShare
 	}
 
 	//EX_Context, EX_Context_FailSilent and EX_ClassContext are all indicate nested expression run inside of the context
-	if (IsContextInstruction(InstructionName)) {
-		const bool bIsClassContext = InstructionName == TEXT("ClassContext");
+	case EKismetInstruction::Context:
+	case EKismetInstruction::Context_FailSilent:
+	case EKismetInstruction::ClassContext:
+	{
+		const bool bIsClassContext = Instruction == EKismetInstruction::ClassContext;
 		const TSharedPtr<FJsonObject> Context = Expression->GetObjectField(TEXT("Context"));
 		const TSharedPtr<FJsonObject> InnerExpression = Expression->GetObjectField(TEXT("Expression"));
 
-		TSharedPtr<FKismetTerminal> ContextTerminal = ProcessExpression(Context);
+		TSharedPtr<FKismetTerminal> ContextTerminal = MakeMutableTerminal(ProcessExpression(Context));
 		ContextTerminal->ContextType = bIsClassContext ? FKismetTerminal::EContextType_Class : FKismetTerminal::EContextType_Object;
 
-		TSharedPtr<FKismetTerminal> InnerExpressionTerminal = ProcessExpression(InnerExpression);
+		TSharedPtr<FKismetTerminal> InnerExpressionTerminal = MakeMutableTerminal(ProcessExpression(InnerExpression));
 		InnerExpressionTerminal->Context = ContextTerminal;
 		return InnerExpressionTerminal;
 	}
 
 	//EX_LocalVariable, EX_LocalOutVariable, EX_InstanceVariable and EX_DefaultVariable are all simple terminals with different VarType values
-	if (IsVariableInstruction(InstructionName)) {
+	case EKismetInstruction::DefaultVariable:
+	case EKismetInstruction::InstanceVariable:
+	case EKismetInstruction::LocalVariable:
+	case EKismetInstruction::LocalOutVariable:
+	{
 		const FString VariableName = Expression->GetStringField(TEXT("VariableName"));
 		const TSharedPtr<FJsonObject> VariableType = Expression->GetObjectField(TEXT("VariableType"));
 
@@ -515,42 +787,124 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessExpression(TShare
 		VariableTerminal->Type = UPropertyTypeHelper::DeserializeGraphPinType(VariableType.ToSharedRef(), OwnerBlueprint->SkeletonGeneratedClass);
 		VariableTerminal->AssociatedVarProperty = VariableName;
 
-		if (InstructionName == TEXT("DefaultVariable")) {
+		if (Instruction == EKismetInstruction::DefaultVariable) {
 			VariableTerminal->VarType = FKismetTerminal::EVarType_Default;
 		}
-		else if (InstructionName == TEXT("InstanceVariable")) {
+		else if (Instruction == EKismetInstruction::InstanceVariable) {
 			VariableTerminal->VarType = FKismetTerminal::EVarType_Instanced;
 		}
-		else if (InstructionName == TEXT("LocalVariable") || InstructionName == TEXT("LocalOutVariable")) {
+		else {
 			//LocalOutVariable will be generated if Property in question has CPF_Out flag and is an out property
 			VariableTerminal->VarType = FKismetTerminal::EVarType_Local;
 		}
-		else {
-			checkf(0, TEXT("Unhandled variable instruction: %s"), *InstructionName);
-		}
 		return VariableTerminal;
 	}
 
+	default:
+		break;
+	}
+
 	//Should be a literal now
-	return ProcessLiteralExpression(Expression, false);
+	return ProcessLiteralExpression(Expression, Instruction, false);
 }
 
-TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression(TSharedPtr<FJsonObject> Expression, bool bIsDelimited) {
-	const FString InstructionName = Expression->GetStringField(TEXT("Inst"));
+TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression(TSharedPtr<FJsonObject> Expression, const EKismetInstruction Instruction, bool bIsDelimited) {
+	if (!bInternLiteralTerminals) {
+		return CreateLiteralTerminal(Expression, Instruction, bIsDelimited);
+	}
 
+	//Simple literals repeating the same source value are resolved before building the terminal, skipping the construction and object loading entirely
+	FString LiteralSourceKey;
+	const bool bHasSourceKey = GetLiteralSourceKey(Expression, Instruction, bIsDelimited, LiteralSourceKey);
+	if (bHasSourceKey) {
+		const TSharedPtr<FKismetTerminal>* ExistingTerminal = LiteralTerminalsBySource.Find(LiteralSourceKey);
+		if (ExistingTerminal != NULL) {
+			return *ExistingTerminal;
+		}
+	}
+
+	//Structurally equal literals share a single terminal, so constants repeated across the function are only stored once
+	const TSharedPtr<FKismetTerminal> InternedTerminal = LiteralTerminalPool.Intern(CreateLiteralTerminal(Expression, Instruction, bIsDelimited));
+	if (bHasSourceKey) {
+		this->LiteralTerminalsBySource.Add(LiteralSourceKey, InternedTerminal);
+	}
+	return InternedTerminal;
+}
+
+bool FKismetBytecodeTransformer::GetLiteralSourceKey(const TSharedPtr<FJsonObject>& Expression, const EKismetInstruction Instruction, bool bIsDelimited, FString& OutSourceKey) {
+	const TCHAR* SourceFieldName;
+	switch (Instruction) {
+	//Literals without any operands, every one of them always produces the same terminal
+	case EKismetInstruction::Self:
+	case EKismetInstruction::True:
+	case EKismetInstruction::False:
+	case EKismetInstruction::NoObject:
+	case EKismetInstruction::NoInterface:
+		SourceFieldName = NULL;
+		break;
+
+	//Literals fully determined by a single string or number field
+	case EKismetInstruction::StringConst:
+	case EKismetInstruction::UnicodeStringConst:
+	case EKismetInstruction::NameConst:
+	case EKismetInstruction::IntConst:
+	case EKismetInstruction::ByteConst:
+	case EKismetInstruction::FloatConst:
+	case EKismetInstruction::Int64Const:
+	case EKismetInstruction::UInt64Const:
+		SourceFieldName = TEXT("Value");
+		break;
+
+	case EKismetInstruction::InstanceDelegate:
+		SourceFieldName = TEXT("FunctionName");
+		break;
+
+	case EKismetInstruction::ObjectConst:
+		SourceFieldName = TEXT("Object");
+		break;
+
+	//Text, struct and container literals are built from nested objects, so they are only interned after being built
+	default:
+		return false;
+	}
+
+	FString SourceValue;
+	if (SourceFieldName != NULL) {
+		//Numbers are converted to string with the same 6 digit precision float literals are formatted with, so equal keys always produce equal terminals
+		const TSharedPtr<FJsonValue> SourceField = Expression->TryGetField(SourceFieldName);
+		if (!SourceField.IsValid() || !SourceField->TryGetString(SourceValue)) {
+			return false;
+		}
+	}
+	OutSourceKey = FString::Printf(TEXT("%d|%d|%s"), (int32) Instruction, bIsDelimited ? 1 : 0, *SourceValue);
+	return true;
+}
+
+TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::MakeMutableTerminal(const TSharedPtr<FKismetTerminal>& Terminal) {
+	//Literals can be interned and referenced from multiple statements, so they are copied before being modified
+	if (Terminal->bIsLiteral) {
+		return MakeShareable(new FKismetTerminal(*Terminal));
+	}
+	return Terminal;
+}
+
+TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::CreateLiteralTerminal(TSharedPtr<FJsonObject> Expression, const EKismetInstruction Instruction, bool bIsDelimited) {
 	TSharedPtr<FKismetTerminal> LiteralTerminal = MakeShareable(new FKismetTerminal());
 	LiteralTerminal->bIsLiteral = true;
 
+	switch (Instruction) {
 	//Basically represents the current Context UObject and allows retrieval of it
 	//We record just as the type meta information, actual string and object literals will be empty
-	if (InstructionName == TEXT("Self")) {
+	case EKismetInstruction::Self:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Object;
 		LiteralTerminal->Type.PinSubCategory = UEdGraphSchema_K2::PSC_Self;
 		return LiteralTerminal;
 	}
 
 	//Text literals, pretty complicated in serialization because of existence of multiple types
-	if (InstructionName == TEXT("TextConst")) {
+	case EKismetInstruction::TextConst:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Text;
 		const FString LiteralType = Expression->GetStringField(TEXT("TextLiteralType"));
 
@@ -591,7 +945,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	}
 
 	//String Literal encoded as ASCII, containing only characters of ASCII range
-	if (InstructionName == TEXT("StringConst")) {
+	case EKismetInstruction::StringConst:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_String;
 		LiteralTerminal->StringLiteral = Expression->GetStringField(TEXT("Value"));
 
@@ -602,7 +957,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	}
 
 	//String Literal containing unicode characters
-	if (InstructionName == TEXT("UnicodeStringConst")) {
+	case EKismetInstruction::UnicodeStringConst:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_String;
 		LiteralTerminal->StringLiteral = Expression->GetStringField(TEXT("Value"));
 
@@ -613,21 +969,24 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	}
 
 	//Floating point number constant (in terminal form, it is stored in string literal field)
-	if (InstructionName == TEXT("FloatConst")) {
+	case EKismetInstruction::FloatConst:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Float;
 		LiteralTerminal->StringLiteral = FString::Printf(TEXT("%f"), Expression->GetNumberField(TEXT("Value")));
 		return LiteralTerminal;
 	}
 
 	//Integer number constant (in terminal form, it is stored in string literal field)
-	if (InstructionName == TEXT("IntConst")) {
+	case EKismetInstruction::IntConst:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
 		LiteralTerminal->StringLiteral = FString::FromInt(Expression->GetIntegerField(TEXT("Value")));
 		return LiteralTerminal;
 	}
 
 	//64-bit integer number constant, recorded as string in JSON because double cannot represent entire value range on 64-bit integer
-	if (InstructionName == TEXT("Int64Const")) {
+	case EKismetInstruction::Int64Const:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Int64;
 		LiteralTerminal->StringLiteral = Expression->GetStringField(TEXT("Value"));
 		return LiteralTerminal;
@@ -635,7 +994,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 
 	//Unsigned 64-bit integer number constant, never emitted because there is no Kismet graph type for it
 	//No way to represent UInt64 in Kismet pin type hierarchy, so record it as int64 which will be converted back if needed
-	if (InstructionName == TEXT("UInt64Const")) {
+	case EKismetInstruction::UInt64Const:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Int64;
 		LiteralTerminal->StringLiteral = Expression->GetStringField(TEXT("Value"));
 		return LiteralTerminal;
@@ -643,26 +1003,31 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 
 	//TODO Enums in Kismet are represented as byte constants, since Kismet only supports byte enums
 	//TODO we just don't have information to reconstruct original kismet type there, so we record it as byte
-	if (InstructionName == TEXT("ByteConst")) {
+	case EKismetInstruction::ByteConst:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Byte;
 		LiteralTerminal->StringLiteral = FString::FromInt(Expression->GetIntegerField(TEXT("Value")));
 		return LiteralTerminal;
 	}
 
 	//Convert boolean constant instructions EX_False and EX_True
-	if (InstructionName == TEXT("False")) {
+	case EKismetInstruction::False:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
 		LiteralTerminal->StringLiteral = TEXT("0");
 		return LiteralTerminal;
 	}
-	if (InstructionName == TEXT("True")) {
+
+	case EKismetInstruction::True:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
 		LiteralTerminal->StringLiteral = TEXT("1");
 		return LiteralTerminal;
 	}
 
 	//Name constant, mostly similar to string literal but represents an FName object instead
-	if (InstructionName == TEXT("NameConst")) {
+	case EKismetInstruction::NameConst:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Name;
 		LiteralTerminal->StringLiteral = Expression->GetStringField(TEXT("Value"));
 
@@ -673,7 +1038,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	}
 
 	//Vector constant, basically a specialized version of StructConst with the same format
-	if (InstructionName == TEXT("VectorConst")) {
+	case EKismetInstruction::VectorConst:
+	{
 		FVector VectorConst(Expression->GetNumberField(TEXT("X")), Expression->GetNumberField(TEXT("Y")), Expression->GetNumberField(TEXT("Z")));
 		UScriptStruct* VectorStruct = TBaseStructure<FVector>::Get();
 
@@ -685,7 +1051,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	}
 
 	//Rotation constant, basically a specialized version of StructConst with the same format
-	if (InstructionName == TEXT("RotationConst")) {
+	case EKismetInstruction::RotationConst:
+	{
 		FRotator RotatorConst(Expression->GetNumberField(TEXT("Pitch")), Expression->GetNumberField(TEXT("Yaw")), Expression->GetNumberField(TEXT("Roll")));
 		UScriptStruct* RotatorStruct = TBaseStructure<FRotator>::Get();
 
@@ -697,7 +1064,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	}
 
 	//Transform constant, a combination of rotation, translation and scale components
-	if (InstructionName == TEXT("TransformConst")) {
+	case EKismetInstruction::TransformConst:
+	{
 		const TSharedPtr<FJsonObject> RotationObj = Expression->GetObjectField(TEXT("Rotation"));
 		FQuat Rotation = FQuat(RotationObj->GetNumberField(TEXT("X")), RotationObj->GetNumberField(TEXT("Y")), RotationObj->GetNumberField(TEXT("Z")), RotationObj->GetNumberField(TEXT("W")));
 
@@ -718,7 +1086,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	}
 
 	//Struct constant, needs to be serialized as string
-	if (InstructionName == TEXT("StructConst")) {
+	case EKismetInstruction::StructConst:
+	{
 		const FString StructPathName = Expression->GetStringField(TEXT("Struct"));
 		TSharedPtr<FJsonObject> Properties = Expression->GetObjectField(TEXT("Properties"));
 
@@ -739,7 +1108,7 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 
 			for (int32 ArrayIter = 0; ArrayIter < Property->ArrayDim; ++ArrayIter) {
 				const TSharedPtr<FJsonObject> PropertyValueExpression = PropertyValueArray[ArrayIter]->AsObject();
-				const TSharedPtr<FKismetTerminal> PropertyValue = ProcessLiteralExpression(PropertyValueExpression, false);
+				const TSharedPtr<FKismetTerminal> PropertyValue = CreateLiteralTerminal(PropertyValueExpression, GetInstruction(PropertyValueExpression), false);
 
 				//Thing is, all of the constant values are serialized in the way compatible in ImportText/ExportText
 				//methods implementation on common property types. So we can just call ImportText with StringLiteral
@@ -779,7 +1148,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	//TODO we don't have enough information to determine type of delegate here, primarily because context is not available by the time we are called
 	//TODO but even with context, best thing we could do is obtain function object for bound function, which does not automatically let us obtain reference to
 	//TODO delegate signature function. Best thing we could do is correct the type when assigning delegate to variables/using it during function calls
-	if (InstructionName == TEXT("InstanceDelegate")) {
+	case EKismetInstruction::InstanceDelegate:
+	{
 		const FString FunctionName = Expression->GetStringField(TEXT("FunctionName"));
 
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Delegate;
@@ -788,9 +1158,10 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	}
 
 	//Soft object constant. Expression will always be a string literal path to the object in question
-	if (InstructionName == TEXT("SoftObjectConst")) {
+	case EKismetInstruction::SoftObjectConst:
+	{
 		TSharedPtr<FJsonObject> ObjectPathExpression = Expression->GetObjectField(TEXT("Value"));
-		TSharedPtr<FKismetTerminal> ObjectPathLiteral = ProcessLiteralExpression(ObjectPathExpression, false);
+		TSharedPtr<FKismetTerminal> ObjectPathLiteral = CreateLiteralTerminal(ObjectPathExpression, GetInstruction(ObjectPathExpression), false);
 		check(ObjectPathLiteral->Type.PinCategory == UEdGraphSchema_K2::PC_String);
 		const FString SoftObjectPath = ObjectPathLiteral->StringLiteral;
 
@@ -811,7 +1182,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 
 	//EX_NoObject basically indicates NULL UObject pointer constant. We fill PinSubCategoryObject with UObject::StaticClass()
 	//because we cannot really deduce type of generic NULL value without a context
-	if (InstructionName == TEXT("NoObject")) {
+	case EKismetInstruction::NoObject:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Object;
 		LiteralTerminal->Type.PinSubCategoryObject = UObject::StaticClass();
 		LiteralTerminal->ObjectLiteral = NULL;
@@ -820,7 +1192,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 	}
 
 	//Object literal, points to the existing UObject either inside or outside of this asset
-	if (InstructionName == TEXT("ObjectConst")) {
+	case EKismetInstruction::ObjectConst:
+	{
 		const FString ObjectPath = Expression->GetStringField(TEXT("Object"));
 
 		//Resolve referenced asset object
@@ -846,21 +1219,25 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 
 	//FScriptInterface literal, currently only NULL and Self objects can be represented as interface literals
 	//TODO interface pin type is incomplete, because we cannot infer interface class type from NULL value
-	if (InstructionName == TEXT("NoInterface")) {
+	case EKismetInstruction::NoInterface:
+	{
 		LiteralTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Interface;
 		LiteralTerminal->ObjectLiteral = NULL;
 		LiteralTerminal->StringLiteral = TEXT("None");
+		return LiteralTerminal;
 	}
 
 	//Set and array constants are serialized in exactly the same way, by  using (X, Y, Z) format where X/Y/Z are delimited literals
-	if (InstructionName == TEXT("ArrayConst") || InstructionName == TEXT("SetConst")) {
+	case EKismetInstruction::ArrayConst:
+	case EKismetInstruction::SetConst:
+	{
 		//We know exact element type because it is recorded in the bytecode
 		const TSharedPtr<FJsonObject> InnerPropertyObject = Expression->GetObjectField(TEXT("InnerProperty"));
 		const TArray<TSharedPtr<FJsonValue>> Values = Expression->GetArrayField(TEXT("Values"));
 
 		//Set array type from recorded instruction, container type is either a set or an array (depending on the opcode)
 		FEdGraphPinType ArrayPropertyType = UPropertyTypeHelper::DeserializeGraphPinType(InnerPropertyObject.ToSharedRef(), OwnerBlueprint->SkeletonGeneratedClass);
-		if (InstructionName == TEXT("ArrayConst")) {
+		if (Instruction == EKismetInstruction::ArrayConst) {
 			ArrayPropertyType.ContainerType = EPinContainerType::Array;
 		}
 		else {
@@ -874,7 +1251,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 
 		for (const TSharedPtr<FJsonValue>& ValueExpression : Values) {
 			//We need value constant delimited, because we are building the array literal string
-			const TSharedPtr<FKismetTerminal> ValueConstant = ProcessLiteralExpression(ValueExpression->AsObject(), true);
+			const TSharedPtr<FJsonObject> ValueExpressionObject = ValueExpression->AsObject();
+			const TSharedPtr<FKismetTerminal> ValueConstant = CreateLiteralTerminal(ValueExpressionObject, GetInstruction(ValueExpressionObject), true);
 			check(ValueConstant->bIsLiteral);
 
 			if (CurrentIndex++ != 0) {
@@ -890,7 +1268,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 
 	//Map constants are very similar to set and array constants, we have specific types for them too,
 	//and generally they have the same format, with entries recorded as pairs of (key, value)
-	if (InstructionName == TEXT("MapConst")) {
+	case EKismetInstruction::MapConst:
+	{
 		const TSharedPtr<FJsonObject> KeyPropertyObject = Expression->GetObjectField(TEXT("KeyProperty"));
 		const TSharedPtr<FJsonObject> ValuePropertyObject = Expression->GetObjectField(TEXT("ValueProperty"));
 		const TArray<TSharedPtr<FJsonValue>> Values = Expression->GetArrayField(TEXT("Values"));
@@ -914,8 +1293,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 			const TSharedPtr<FJsonObject> KeyExpressionObject = PairObject->AsObject()->GetObjectField(TEXT("Key"));
 			const TSharedPtr<FJsonObject> ValueExpressionObject = PairObject->AsObject()->GetObjectField(TEXT("Value"));
 
-			const TSharedPtr<FKismetTerminal> KeyTerminal = ProcessLiteralExpression(KeyExpressionObject, true);
-			const TSharedPtr<FKismetTerminal> ValueTerminal = ProcessLiteralExpression(ValueExpressionObject, true);
+			const TSharedPtr<FKismetTerminal> KeyTerminal = CreateLiteralTerminal(KeyExpressionObject, GetInstruction(KeyExpressionObject), true);
+			const TSharedPtr<FKismetTerminal> ValueTerminal = CreateLiteralTerminal(ValueExpressionObject, GetInstruction(ValueExpressionObject), true);
 			check(KeyTerminal->bIsLiteral);
 			check(ValueTerminal->bIsLiteral);
 
@@ -937,38 +1316,42 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessLiteralExpression
 		return LiteralTerminal;
 	}
 
+	default:
+		break;
+	}
+
 	//Unknown literal type, report it and abort
-	checkf(0, TEXT("Found unsupported literal instruction while parsing expression: %s"), *InstructionName);
+	checkf(0, TEXT("Found unsupported literal instruction while parsing expression: %s"), *Expression->GetStringField(TEXT("Inst")));
 	return NULL;
 }
 
-TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessFunctionCallStatement(TSharedPtr<FJsonObject> Statement)
+TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessFunctionCallStatement(TSharedPtr<FJsonObject> Statement, EKismetInstruction Instruction)
 {
 	TSharedPtr<FKismetTerminal> Context;
 	bool bIsInterfaceContext = false;
 
 	//If expression we got is actually a context expression and not a direct function call, unwrap it and record context expression
-	const FString InitialInstName = Statement->GetStringField(TEXT("Inst"));
-	if (IsContextInstruction(InitialInstName)) {
-		const bool bIsClassContext = InitialInstName == TEXT("ClassContext");
+	if (IsContextInstruction(Instruction)) {
+		const bool bIsClassContext = Instruction == EKismetInstruction::ClassContext;
 		TSharedPtr<FJsonObject> ContextObject = Statement->GetObjectField(TEXT("Context"));
 
 		//Context expression will be prefixed with EX_InterfaceContext if bIsInterfaceContext
 		//is set on function call statement. We need to handle it here, otherwise information will be lost
-		if (ContextObject->GetStringField(TEXT("Inst")) == TEXT("InterfaceContext")) {
+		EKismetInstruction ContextInstruction = GetInstruction(ContextObject);
+		if (ContextInstruction == EKismetInstruction::InterfaceContext) {
 			bIsInterfaceContext = true;
 			ContextObject = ContextObject->GetObjectField(TEXT("Expression"));
+			ContextInstruction = GetInstruction(ContextObject);
 		}
 
-		Context = ProcessExpression(ContextObject);
+		Context = MakeMutableTerminal(ProcessExpression(ContextObject, ContextInstruction));
 		Context->ContextType = bIsClassContext ? FKismetTerminal::EContextType_Class : FKismetTerminal::EContextType_Object;
 		Statement = Statement->GetObjectField(TEXT("Expression"));
+		Instruction = GetInstruction(Statement);
 	}
 
-	const FString InstructionName = Statement->GetStringField(TEXT("Inst"));
-
 	//At this point we should always end up with one of function call instructions
-	check(IsCallFunctionInstruction(InstructionName));
+	check(IsCallFunctionInstruction(Instruction));
 
 	TSharedPtr<FKismetCompiledStatement> Result = MakeShareable(new FKismetCompiledStatement());
 	Result->Type = ECompiledStatementType::KCST_CallFunction;
@@ -981,7 +1364,7 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessFunction
 	//Resolve context class for querying function by name
 	UClass* ContextObjectClass;
 
-	if (InstructionName != TEXT("CallMath")) {
+	if (Instruction != EKismetInstruction::CallMath) {
 		//All function calls will have proper context object set, and it will be either an object or class
 		//Either way, PSC_Self handling is equal for both of these cases, and resulting class will be
 		//class of the object on which function will be called (for static functions, it will be class CDO)
@@ -1006,26 +1389,26 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessFunction
 	UFunction* ResolvedFunction = ContextObjectClass->FindFunctionByName(*FunctionName);
 	checkf(ResolvedFunction, TEXT("Couldn't resolve function %s in context of class %s"), *FunctionName, *ContextObjectClass->GetPathName());
 
-	if (InstructionName == TEXT("LocalVirtualFunction") || InstructionName == TEXT("VirtualFunction")) {
+	if (Instruction == EKismetInstruction::LocalVirtualFunction || Instruction == EKismetInstruction::VirtualFunction) {
 		//Obviously it is not a parent context for a virtual function
 		Result->FunctionToCall = ResolvedFunction;
 		Result->bIsParentContext = false;
 
 	}
-	else if (InstructionName == TEXT("LocalFinalFunction") || InstructionName == TEXT("FinalFunction")) {
+	else if (Instruction == EKismetInstruction::LocalFinalFunction || Instruction == EKismetInstruction::FinalFunction) {
 		//Final function call, possibly in the parent context
 		//We set parent context flag if function in question is not final, but is called with FinalFunction opcode
 		Result->FunctionToCall = ResolvedFunction;
 		Result->bIsParentContext = !ResolvedFunction->HasAnyFunctionFlags(EFunctionFlags::FUNC_Final);
 
 	}
-	else if (InstructionName == TEXT("CallMath")) {
+	else if (Instruction == EKismetInstruction::CallMath) {
 		Result->FunctionToCall = ResolvedFunction;
 		Result->bIsParentContext = false;
 
 	}
 	else {
-		checkf(0, TEXT("Unhandled function call opcode: %s"), *InstructionName);
+		checkf(0, TEXT("Unhandled function call opcode: %s"), *Statement->GetStringField(TEXT("Inst")));
 	}
 
 	//Do argument processing that is common for all function call instructions
@@ -1064,7 +1447,8 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessFunction
 		check(UberGraphTransformer.IsValid());
 
 		const int32 OffsetIntoUbergraph = FCString::Atoi(*Result->RHS[0]->StringLiteral);
-		const TSharedPtr<FKismetCompiledStatement> UberGraphStatement = UberGraphTransformer->StatementsByOffset.FindChecked(OffsetIntoUbergraph);
+		const TSharedPtr<FKismetCompiledStatement> UberGraphStatement = UberGraphTransformer->FindStatementByOffset(OffsetIntoUbergraph);
+		checkf(UberGraphStatement.IsValid(), TEXT("Call into ubergraph from function %s targets offset %d, which is not a start of any ubergraph statement"), *CurrentFunctionName, OffsetIntoUbergraph);
 
 		Result->TargetLabel = UberGraphStatement;
 		Result->bIsCallIntoUbergraph = true;
@@ -1089,7 +1473,7 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessFunction
 		//We cannot really resolve pointed compiled statement right now since we haven't finished transforming of the current function yet
 		//Kind of patch up we need is essentially the same as for normal goto, so we just schedule a patch up in jump patch up map
 		const int32 ResumeOffsetInUberGraph = LatentActionInfo.Linkage;
-		this->JumpPatchUpTable.Add(Result, ResumeOffsetInUberGraph);
+		this->JumpPatchUpTable.Emplace(Result, ResumeOffsetInUberGraph);
 		Result->bIsCallIntoUbergraph = false;
 	}
 
@@ -1097,7 +1481,7 @@ TSharedPtr<FKismetCompiledStatement> FKismetBytecodeTransformer::ProcessFunction
 }
 
 TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessFunctionParameter(TSharedPtr<FJsonObject> ParameterExpression) {
-	const FString ParameterInstructionName = ParameterExpression->GetStringField(TEXT("Inst"));
+	const EKismetInstruction ParameterInstruction = GetInstruction(ParameterExpression);
 
 	TSharedPtr<FKismetTerminal> ParameterTerminal;
 
@@ -1106,7 +1490,7 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessFunctionParameter
 
 	//GetArrayItem is one of the only 3 statements that can appear as function arguments. Noticeably, ArrayGetByRef
 	//will actually never appear as a dedicated statement outside of inlined generated parameter context
-	if (ParameterInstructionName == TEXT("ArrayGetByRef")) {
+	if (ParameterInstruction == EKismetInstruction::ArrayGetByRef) {
 		TSharedPtr<FKismetCompiledStatement> ArrayItemStatement = MakeShareable(new FKismetCompiledStatement());
 		ArrayItemStatement->Type = ECompiledStatementType::KCST_ArrayGetByRef;
 		TSharedPtr<FKismetTerminal> ArrayExpression = ProcessExpression(ParameterExpression->GetObjectField(TEXT("ArrayExpression")));
@@ -1127,7 +1511,7 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessFunctionParameter
 
 	//Select is also the other node that will never appear on it's own as a dedicated statement,
 	//because actually it is a perfectly pure node just returning value depending on the inputs
-	else if (ParameterInstructionName == TEXT("SwitchValue")) {
+	else if (ParameterInstruction == EKismetInstruction::SwitchValue) {
 		TSharedPtr<FKismetCompiledStatement> SwitchValue = MakeShareable(new FKismetCompiledStatement());
 		SwitchValue->Type = ECompiledStatementType::KCST_SwitchValue;
 		//First RHS terminal is an index
@@ -1177,8 +1561,8 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessFunctionParameter
 	//These functions, obviously, cannot have any context though.
 	//They, in fact, will be called with a context object that is logically wrong,
 	//but it still works, because native static functions don't use context object at all.
-	else if (IsCallFunctionInstruction(ParameterInstructionName)) {
-		TSharedPtr<FKismetCompiledStatement> InlineFunctionCall = ProcessFunctionCallStatement(ParameterExpression);
+	else if (IsCallFunctionInstruction(ParameterInstruction)) {
+		TSharedPtr<FKismetCompiledStatement> InlineFunctionCall = ProcessFunctionCallStatement(ParameterExpression, ParameterInstruction);
 		check(InlineFunctionCall->FunctionContext.IsValid() == false);
 		check(InlineFunctionCall->FunctionToCall->HasAllFunctionFlags(FUNC_Final | FUNC_Static | FUNC_Native));
 
@@ -1195,7 +1579,7 @@ TSharedPtr<FKismetTerminal> FKismetBytecodeTransformer::ProcessFunctionParameter
 	}
 	else {
 		//Otherwise it is a simple expression that we need to parse
-		ParameterTerminal = ProcessExpression(ParameterExpression);
+		ParameterTerminal = ProcessExpression(ParameterExpression, ParameterInstruction);
 	}
 
 	check(ParameterTerminal.IsValid());
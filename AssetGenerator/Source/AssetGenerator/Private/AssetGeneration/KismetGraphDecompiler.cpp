@@ -18,21 +18,171 @@
 #include "K2Node_StructMemberGet.h"
 #include "K2Node_VariableSetRef.h"
 
+DECLARE_LOG_CATEGORY_CLASS(LogKismetGraphDecompiler, Log, All);
+
+//Vertical distance between the generated nodes, matches the one used by UEdGraph::GetGoodPlaceForNewNode
+#define GENERATED_NODE_VERTICAL_SPACING 256.0f
+//Horizontal distance between the columns of nodes generated for different ubergraph events
+#define GENERATED_EVENT_HORIZONTAL_SPACING 1024.0f
+
 FKismetGraphDecompiler::FKismetGraphDecompiler(UFunction* Function, UEdGraph* Graph) {
 	this->Function = Function;
 	this->EditorGraph = Graph;
+	this->CurrentStatementIndex = 0;
+	this->bBatchNodeGeneration = true;
+	this->bHasUnlinkedNodes = false;
+}
+
+FKismetGraphDecompiler::~FKismetGraphDecompiler() {
+	//Without FinishNodeGeneration generated nodes are left without any links and the graph is never notified about them
+	checkf(!bHasUnlinkedNodes, TEXT("Nodes generated for function %s have not been linked, FinishNodeGeneration has not been called"), *Function->GetName());
 }
 
 void FKismetGraphDecompiler::Initialize(const TArray<TSharedPtr<FKismetCompiledStatement>>& Statements) {
 	this->CompiledStatements = Statements;
+	this->CurrentStatementIndex = 0;
+
+	//Graph is modified once for the whole batch of generated nodes instead of once per node
+	EditorGraph->Modify();
+
+	//Scan the graph for the free space only once, every generated node is then placed below the previous one, without walking all of the graph nodes every time
+	//GetGoodPlaceForNewNode returns the lowest node position moved down by the same spacing, so normal functions end up with the same layout
+	this->NextNodePosition = EditorGraph->GetGoodPlaceForNewNode();
+	this->EventColumnPosition = NextNodePosition;
+}
+
+void FKismetGraphDecompiler::InitializeFromUbergraphRegion(const FKismetUbergraphRegion& Region) {
+	check(Region.EntryOffsets.Num() == Region.EntryStatements.Num());
+	Initialize(Region.Statements);
+
+	this->UbergraphEntryOffsets.Empty(Region.EntryStatements.Num());
+	for (int32 i = 0; i < Region.EntryStatements.Num(); i++) {
+		checkf(Region.Statements.Contains(Region.EntryStatements[i]), TEXT("Ubergraph entry point at offset %d does not belong to the region"), Region.EntryOffsets[i]);
+		this->UbergraphEntryOffsets.Add(Region.EntryStatements[i], Region.EntryOffsets[i]);
+	}
+}
+
+UEdGraphNode* FKismetGraphDecompiler::SpawnGraphNode(UClass* NodeClass, TFunctionRef<void(UEdGraphNode*)> InitializerFn) {
+	UEdGraphNode* NewNode = NewObject<UEdGraphNode>(EditorGraph, NodeClass);
+	NewNode->SetFlags(RF_Transactional);
+	NewNode->CreateNewGuid();
+	NewNode->NodePosX = (int32) NextNodePosition.X;
+	NewNode->NodePosY = (int32) NextNodePosition.Y;
+	this->NextNodePosition.Y += GENERATED_NODE_VERTICAL_SPACING;
+	this->bHasUnlinkedNodes = true;
+
+	//Initializer should run before pins are allocated, since it usually configures pins node is going to have
+	InitializerFn(NewNode);
+
+	//Node is added to the graph directly instead of going through UEdGraph::AddNode,
+	//so graph change notification is only broadcast once for the whole batch in FinishNodeGeneration
+	EditorGraph->Nodes.Add(NewNode);
+	NewNode->PostPlacedNewNode();
+	NewNode->AllocateDefaultPins();
+	return NewNode;
+}
+
+TSharedPtr<FKismetTerminal> FKismetGraphDecompiler::ResolvePassThroughTerminal(const TMap<FKismetTerminalAsKeyType, TSharedPtr<FKismetTerminal>>& PassThroughTerminals, TSharedPtr<FKismetTerminal> Terminal) {
+	//Chain can visit every pass-through terminal at most once, so a longer walk means it loops back onto itself
+	int32 NumPassThroughSteps = 0;
+	while (const TSharedPtr<FKismetTerminal>* PassThroughTerminal = PassThroughTerminals.Find(Terminal)) {
+		if (++NumPassThroughSteps > PassThroughTerminals.Num()) {
+			return NULL;
+		}
+		Terminal = *PassThroughTerminal;
+	}
+	return Terminal;
+}
+
+void FKismetGraphDecompiler::GenerateNodes() {
+	while (CurrentStatementIndex < CompiledStatements.Num()) {
+		const int32 StatementIndex = CurrentStatementIndex;
+		GenerateNodeForStatement();
+
+		//Statement has not been consumed, which means there is no node generator for it yet
+		if (CurrentStatementIndex == StatementIndex) {
+			UE_LOG(LogKismetGraphDecompiler, Verbose, TEXT("Skipping statement %d of type %d in function %s, it is not supported by the decompiler"),
+				StatementIndex, (int32) CompiledStatements[StatementIndex]->Type, *Function->GetName());
+			PopStatement();
+		}
+	}
+	FinishNodeGeneration();
+}
+
+void FKismetGraphDecompiler::FinishNodeGeneration() {
+	const UEdGraphSchema* Schema = EditorGraph->GetSchema();
+	this->bHasUnlinkedNodes = false;
+
+	//Reference path links every pin through the schema, which notifies the nodes and modifies the blueprint on every connection
+	if (!bBatchNodeGeneration) {
+		for (const TPair<UEdGraphPin*, TSharedPtr<FKismetCompiledStatement>>& Pair : ExecPinPatchUpMap) {
+			if (UEdGraphPin* const* TargetExecPin = NodeExecPinInputMap.Find(Pair.Value)) {
+				Schema->TryCreateConnection(Pair.Key, *TargetExecPin);
+			}
+		}
+		for (const TPair<UEdGraphPin*, TSharedPtr<FKismetTerminal>>& Pair : TerminalPatchUpMap) {
+			const TSharedPtr<FKismetTerminal> Terminal = ResolvePassThroughTerminal(PassThroughTerminals, Pair.Value);
+			UEdGraphPin* const* OutputPin = Terminal.IsValid() ? IntermediateVariableHandles.Find(Terminal) : NULL;
+			if (OutputPin != NULL) {
+				Schema->TryCreateConnection(Pair.Key, *OutputPin);
+			}
+		}
+		return;
+	}
+
+	//Link execution pins of the generated nodes in a single pass. Exec pins have no type to propagate, so nodes do not react to their
+	//connection changes, and every output exec pin is patched up exactly once, so there are no existing links the schema would have to break
+	for (const TPair<UEdGraphPin*, TSharedPtr<FKismetCompiledStatement>>& Pair : ExecPinPatchUpMap) {
+		UEdGraphPin* const* TargetExecPin = NodeExecPinInputMap.Find(Pair.Value);
+		if (TargetExecPin != NULL) {
+			Pair.Key->MakeLinkTo(*TargetExecPin);
+		}
+	}
+
+	//Link data pins to the outputs of the nodes which generated values of the intermediate variables
+	for (const TPair<UEdGraphPin*, TSharedPtr<FKismetTerminal>>& Pair : TerminalPatchUpMap) {
+		const TSharedPtr<FKismetTerminal> Terminal = ResolvePassThroughTerminal(PassThroughTerminals, Pair.Value);
+		if (!Terminal.IsValid()) {
+			UE_LOG(LogKismetGraphDecompiler, Error, TEXT("Pass-through terminals of pin %s in function %s form a cycle, leaving it unconnected"),
+				*Pair.Key->GetName(), *Function->GetName());
+			continue;
+		}
+		UEdGraphPin* const* OutputPin = IntermediateVariableHandles.Find(Terminal);
+		if (OutputPin == NULL) {
+			continue;
+		}
+		UEdGraphPin* InputPin = Pair.Key;
+
+		//Connection is checked against the schema, so the resulting graph is the same as the one TryCreateConnection would produce
+		const FPinConnectionResponse Response = Schema->CanCreateConnection(InputPin, *OutputPin);
+		if (Response.Response == CONNECT_RESPONSE_DISALLOW) {
+			UE_LOG(LogKismetGraphDecompiler, Warning, TEXT("Cannot connect pin %s to pin %s in function %s: %s"),
+				*InputPin->GetName(), *(*OutputPin)->GetName(), *Function->GetName(), *Response.Message.ToString());
+			continue;
+		}
+		if (Response.Response == CONNECT_RESPONSE_MAKE_WITH_CONVERSION_NODE) {
+			//Conversion nodes are rare, so let the schema spawn them instead of duplicating it's logic
+			Schema->TryCreateConnection(InputPin, *OutputPin);
+			continue;
+		}
+
+		//Data pins can be wildcards resolved by the connection, like the inputs of the container nodes,
+		//so both nodes are notified the same way the schema notifies them, just without marking blueprint as modified every time
+		InputPin->MakeLinkTo(*OutputPin);
+		InputPin->GetOwningNode()->PinConnectionListChanged(InputPin);
+		(*OutputPin)->GetOwningNode()->PinConnectionListChanged(*OutputPin);
+	}
+
+	//Broadcast notifications suppressed during node generation once for the whole graph
+	EditorGraph->NotifyGraphChanged();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(FBlueprintEditorUtils::FindBlueprintForGraphChecked(EditorGraph));
 }
 
 UEdGraphNode* FKismetGraphDecompiler::CreateMakeMapNode() {
 	TSharedPtr<FKismetCompiledStatement> Statement = PopStatement();
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 
 	//Spawn node in question and links it's terms with children nodes
-	UK2Node_MakeMap* MakeMapNode = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_MakeMap>(EditorGraph, NodePosition, EK2NewNodeFlags::None,
+	UK2Node_MakeMap* MakeMapNode = SpawnGraphNode<UK2Node_MakeMap>(
 		[&Statement](UK2Node_MakeMap* MakeMapNode) {
 			//Setup number of outputs so AllocateDefaultPins will create correct amount of pins
 			//We divide number of right hand inputs by two because NumInputs is actually a number of (key, value) pairs
@@ -57,10 +207,9 @@ UEdGraphNode* FKismetGraphDecompiler::CreateMakeMapNode() {
 
 UEdGraphNode* FKismetGraphDecompiler::CreateMakeSetNode() {
 	TSharedPtr<FKismetCompiledStatement> Statement = PopStatement();
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 
 	//Spawn node in question and links it's terms with children nodes
-	UK2Node_MakeSet* MakeSetNode = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_MakeSet>(EditorGraph, NodePosition, EK2NewNodeFlags::None,
+	UK2Node_MakeSet* MakeSetNode = SpawnGraphNode<UK2Node_MakeSet>(
 		[&Statement](UK2Node_MakeSet* MakeSetNode) {
 			//Setup number of outputs so AllocateDefaultPins will create correct amount of pins
 			MakeSetNode->NumInputs = Statement->RHS.Num();
@@ -84,10 +233,9 @@ UEdGraphNode* FKismetGraphDecompiler::CreateMakeSetNode() {
 
 UEdGraphNode* FKismetGraphDecompiler::CreateMakeArrayNode() {
 	TSharedPtr<FKismetCompiledStatement> Statement = PopStatement();
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 
 	//Spawn node in question and links it's terms with children nodes
-	UK2Node_MakeArray* MakeArrayNode = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_MakeArray>(EditorGraph, NodePosition, EK2NewNodeFlags::None,
+	UK2Node_MakeArray* MakeArrayNode = SpawnGraphNode<UK2Node_MakeArray>(
 		[&Statement](UK2Node_MakeArray* MakeArrayNode) {
 			//Setup number of outputs so AllocateDefaultPins will create correct amount of pins
 			MakeArrayNode->NumInputs = Statement->RHS.Num();
@@ -119,7 +267,6 @@ UEdGraphNode* FKismetGraphDecompiler::CreateCastNode(bool bIsMetaCast) {
 
 	const TSharedPtr<FKismetTerminal> InputObjectTerminal = Statement->RHS[1];
 	const TSharedPtr<FKismetTerminal> CastedObjectOutVariableName = Statement->LHS;
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 
 	//K2Node_DynamicCast will always emit KCST_ObjectToBool as the next statement
 	//Variable name generated by it should be wired up with DynamicCast bSuccess pin output instead
@@ -172,11 +319,11 @@ UEdGraphNode* FKismetGraphDecompiler::CreateCastNode(bool bIsMetaCast) {
 
 	if (bIsMetaCast) {
 		//For MetaCast, spawn ClassDynamicCast node
-		DynamicCastNode = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_ClassDynamicCast>(EditorGraph, NodePosition, EK2NewNodeFlags::None, NodeInitializerLambda);
+		DynamicCastNode = SpawnGraphNode<UK2Node_ClassDynamicCast>(NodeInitializerLambda);
 	}
 	else {
 		//Otherwise spawn normal K2Node_DynamicCast
-		DynamicCastNode = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_DynamicCast>(EditorGraph, NodePosition, EK2NewNodeFlags::None, NodeInitializerLambda);
+		DynamicCastNode = SpawnGraphNode<UK2Node_DynamicCast>(NodeInitializerLambda);
 	}
 
 	//Connect input object pin with the terminal type passed at RHS
@@ -353,8 +500,6 @@ void FKismetGraphDecompiler::ConnectMakeStructNodePinsWithTerminals(UK2Node* Mak
 }
 
 UEdGraphNode* FKismetGraphDecompiler::CreateMakeStructNode(TSharedPtr<FKismetTerminal> StructTerminal) {
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
-
 	//Struct terminal should always have a struct context and a well-defined struct type
 	check(StructTerminal->ContextType == FKismetTerminal::EContextType_Struct);
 	check(StructTerminal->Type.PinCategory == UEdGraphSchema_K2::PC_Struct);
@@ -364,7 +509,7 @@ UEdGraphNode* FKismetGraphDecompiler::CreateMakeStructNode(TSharedPtr<FKismetTer
 	check(ScriptStruct);
 
 	//Allocate node and connect pins that have statements associated with them
-	UK2Node_MakeStruct* MakeStructNode = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_MakeStruct>(EditorGraph, NodePosition, EK2NewNodeFlags::None,
+	UK2Node_MakeStruct* MakeStructNode = SpawnGraphNode<UK2Node_MakeStruct>(
 		[ScriptStruct](UK2Node_MakeStruct* MakeStructNode) {
 			MakeStructNode->StructType = ScriptStruct;
 		});
@@ -384,14 +529,12 @@ UEdGraphNode* FKismetGraphDecompiler::CreateMakeStructNode(TSharedPtr<FKismetTer
 }
 
 UEdGraphNode* FKismetGraphDecompiler::CreateSetFieldsInStructNode(TSharedPtr<FKismetTerminal> StructTerminal) {
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
-
 	check(StructTerminal->ContextType == FKismetTerminal::EContextType_Struct);
 	check(StructTerminal->Type.PinCategory == UEdGraphSchema_K2::PC_Struct);
 	UScriptStruct* StructType = CastChecked<UScriptStruct>(StructTerminal->Type.PinSubCategoryObject);
 
 	//Allocate node and connect pins that have statements associated with them
-	UK2Node_SetFieldsInStruct* SetFieldsInStruct = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_SetFieldsInStruct>(EditorGraph, NodePosition, EK2NewNodeFlags::None,
+	UK2Node_SetFieldsInStruct* SetFieldsInStruct = SpawnGraphNode<UK2Node_SetFieldsInStruct>(
 		[StructType](UK2Node_SetFieldsInStruct* MemberSetNode) {
 			MemberSetNode->StructType = StructType;
 		});
@@ -445,7 +588,6 @@ UEdGraphNode* FKismetGraphDecompiler::CreateSetFieldsInStructNode(TSharedPtr<FKi
 }
 
 UEdGraphNode* FKismetGraphDecompiler::CreateStructMemberSetNode(TSharedPtr<FKismetTerminal> StructTerminal) {
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 	check(IsUserCreatedLocalVariable(StructTerminal));
 	check(StructTerminal->ContextType == FKismetTerminal::EContextType_Struct);
 	check(StructTerminal->Type.PinCategory == UEdGraphSchema_K2::PC_Struct);
@@ -463,7 +605,7 @@ UEdGraphNode* FKismetGraphDecompiler::CreateStructMemberSetNode(TSharedPtr<FKism
 	check(StructTypeByTerminal == StructTypeByLocalVariable);
 
 	//Allocate node and connect pins that have statements associated with them
-	UK2Node_StructMemberSet* MemberSetK2Node = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_StructMemberSet>(EditorGraph, NodePosition, EK2NewNodeFlags::None,
+	UK2Node_StructMemberSet* MemberSetK2Node = SpawnGraphNode<UK2Node_StructMemberSet>(
 		[&](UK2Node_StructMemberSet* MemberSetNode) {
 			MemberSetNode->StructType = StructTypeByLocalVariable;
 	MemberSetNode->VariableReference.SetLocalMember(LocalVariable->VarName, Function, LocalVariable->VarGuid);
@@ -489,14 +631,13 @@ UEdGraphNode* FKismetGraphDecompiler::CreateStructMemberSetNode(TSharedPtr<FKism
 }
 
 UEdGraphNode* FKismetGraphDecompiler::CreateCopyNode() {
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 	const TSharedPtr<FKismetCompiledStatement> AssignmentStatement = PopStatement();
 	const TSharedPtr<FKismetTerminal> InputValue = AssignmentStatement->RHS[0];
 	const TSharedPtr<FKismetTerminal> LeftHandOperand = AssignmentStatement->LHS;
 	check(LeftHandOperand.IsValid());
 
 	//Allocate node and schedule it's pins to be connected later
-	UK2Node_Copy* CopyNode = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_Copy>(EditorGraph, NodePosition, EK2NewNodeFlags::None);
+	UK2Node_Copy* CopyNode = SpawnGraphNode<UK2Node_Copy>();
 
 	UEdGraphPin* CopyNodeOutputPin = CopyNode->GetCopyResultPin();
 	this->IntermediateVariableHandles.Add(LeftHandOperand, CopyNodeOutputPin);
@@ -531,7 +672,6 @@ UEdGraphNode* FKismetGraphDecompiler::CreateDelegateSetNode() {
 
 UEdGraphNode* FKismetGraphDecompiler::CreateVariableSetNode() {
 
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 	const TSharedPtr<FKismetCompiledStatement> AssignmentStatement = PopStatement();
 	const TSharedPtr<FKismetTerminal> AssignedTerminal = AssignmentStatement->RHS[0];
 	const TSharedPtr<FKismetTerminal> LeftHandOperand = AssignmentStatement->LHS;
@@ -549,7 +689,7 @@ UEdGraphNode* FKismetGraphDecompiler::CreateVariableSetNode() {
 	check(ContextTypeStruct->FindPropertyByName(*AccessedPropertyName));
 
 	//Allocate node and try to resolve referenced member at the start
-	UK2Node_VariableSet* MemberSetK2Node = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_VariableSet>(EditorGraph, NodePosition, EK2NewNodeFlags::None,
+	UK2Node_VariableSet* MemberSetK2Node = SpawnGraphNode<UK2Node_VariableSet>(
 		[&](UK2Node_VariableSet* VariableSet) {
 			GraphSchema_K2->ConfigureVarNode(VariableSet, *AccessedPropertyName, ContextTypeStruct, OwnerBlueprint);
 		});
@@ -601,14 +741,13 @@ UEdGraphNode* FKismetGraphDecompiler::CreateVariableSetNode() {
 }
 
 UEdGraphNode* FKismetGraphDecompiler::CreateVariableSetByRefNode() {
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 	const TSharedPtr<FKismetCompiledStatement> AssignmentStatement = PopStatement();
 	const TSharedPtr<FKismetTerminal> AssignedTerminal = AssignmentStatement->RHS[0];
 	const TSharedPtr<FKismetTerminal> LeftHandOperand = AssignmentStatement->LHS;
 	check(LeftHandOperand.IsValid());
 
 	//Allocate node without any predefined settings since it doesn't need any
-	UK2Node_VariableSetRef* SetVariableByRef = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_VariableSetRef>(EditorGraph, NodePosition, EK2NewNodeFlags::None);
+	UK2Node_VariableSetRef* SetVariableByRef = SpawnGraphNode<UK2Node_VariableSetRef>();
 
 	//Connect input value pins first
 	UEdGraphPin* TargetPin = SetVariableByRef->GetTargetPin();
@@ -630,7 +769,6 @@ UEdGraphNode* FKismetGraphDecompiler::CreateVariableSetByRefNode() {
 }
 
 UEdGraphNode* FKismetGraphDecompiler::CreateMakeDelegateNode() {
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 	const TSharedPtr<FKismetCompiledStatement> AssignmentStatement = PopStatement();
 	const TSharedPtr<FKismetTerminal> AssignedDelegate = AssignmentStatement->LHS;
 
@@ -638,7 +776,7 @@ UEdGraphNode* FKismetGraphDecompiler::CreateMakeDelegateNode() {
 	check(IsLocalVariable(AssignedDelegate));
 	check(AssignedDelegate->AssociatedVarProperty.StartsWith(TEXT("K2Node_CreateDelegate_OutputDelegate")));
 
-	UK2Node_CreateDelegate* CreateDelegateNode = FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_CreateDelegate>(EditorGraph, NodePosition, EK2NewNodeFlags::None);
+	UK2Node_CreateDelegate* CreateDelegateNode = SpawnGraphNode<UK2Node_CreateDelegate>();
 
 	//We cannot set delegate function now because scope of the delegate is unknown since
 	//connections from terminals are not handled yet
@@ -662,7 +800,6 @@ UEdGraphNode* FKismetGraphDecompiler::CreateMakeDelegateNode() {
 }
 
 UEdGraphNode* FKismetGraphDecompiler::CreateMulticastDelegateNode(TSubclassOf<UK2Node_BaseMCDelegate> NodeClass) {
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 	const UEdGraphSchema_K2* GraphSchema_K2 = CastChecked<UEdGraphSchema_K2>(EditorGraph->GetSchema());
 	const TSharedPtr<FKismetCompiledStatement> DelegateStatement = PopStatement();
 
@@ -680,16 +817,11 @@ UEdGraphNode* FKismetGraphDecompiler::CreateMulticastDelegateNode(TSubclassOf<UK
 	UMulticastDelegateProperty* DelegateProperty = Cast<UMulticastDelegateProperty>(ContextTerminalClassType->FindPropertyByName(*PropertyName));
 
 	//Allocate node of the class passed as the argument
-	UK2Node_BaseMCDelegate* DelegateNode = Cast<UK2Node_BaseMCDelegate>(
-		FEdGraphSchemaAction_K2NewNode::CreateNode(EditorGraph, TArrayView<UEdGraphPin*>(), NodePosition,
-			[NodeClass](UEdGraph* InParentGraph) {
-				return NewObject<UK2Node>(InParentGraph, NodeClass);
-			},
-			[DelegateProperty, bIsSelfContext, ContextTerminalClassType](UK2Node* NewNode) {
-				UK2Node_BaseMCDelegate* DelegateNode = CastChecked<UK2Node_BaseMCDelegate>(NewNode);
+	UK2Node_BaseMCDelegate* DelegateNode = CastChecked<UK2Node_BaseMCDelegate>(SpawnGraphNode(NodeClass,
+		[DelegateProperty, bIsSelfContext](UEdGraphNode* NewNode) {
+			UK2Node_BaseMCDelegate* DelegateNode = CastChecked<UK2Node_BaseMCDelegate>(NewNode);
 			DelegateNode->SetFromProperty(DelegateProperty, bIsSelfContext);
-			},
-				EK2NewNodeFlags::None));
+		}));
 
 	//Interesting thing: K2Node_BaseMCDelegate can accept MULTIPLE Self inputs and perform operation on each of them
 	//We don't really need to have special handling, because what it does is basically generating
@@ -725,7 +857,6 @@ UEdGraphNode* FKismetGraphDecompiler::CreateMulticastDelegateNode(TSubclassOf<UK
 
 UEdGraphNode* FKismetGraphDecompiler::CreateFunctionCallNode() {
 	const UEdGraphSchema_K2* GraphSchema_K2 = CastChecked<UEdGraphSchema_K2>(EditorGraph->GetSchema());
-	const FVector2D NodePosition = EditorGraph->GetGoodPlaceForNewNode();
 	const TSharedPtr<FKismetCompiledStatement> CallFunctionStatement = PopStatement();
 	check(CallFunctionStatement->Type == ECompiledStatementType::KCST_CallFunction);
 
@@ -735,6 +866,15 @@ UEdGraphNode* FKismetGraphDecompiler::CreateFunctionCallNode() {
 UEdGraphNode* FKismetGraphDecompiler::GenerateNodeForStatement() {
 	const TSharedPtr<FKismetCompiledStatement> Statement = PeekStatement();
 
+	//Every event after the first one starts a new column, so code of different events does not end up in a single long chain
+	if (const int32* EntryOffset = FindUbergraphEntryOffset(Statement)) {
+		if (CurrentStatementIndex != 0) {
+			this->EventColumnPosition.X += GENERATED_EVENT_HORIZONTAL_SPACING;
+			this->NextNodePosition = EventColumnPosition;
+		}
+		UE_LOG(LogKismetGraphDecompiler, Verbose, TEXT("Generating ubergraph event code at offset %d in function %s"), *EntryOffset, *Function->GetName());
+	}
+
 	//Just skip Nop instructions altogether and skip to processing next one
 	if (Statement->Type == ECompiledStatementType::KCST_Nop) {
 		PopStatement();
@@ -0,0 +1,75 @@
+#include "AssetGeneration/KismetIntermediateFormat.h"
+
+static bool AreContextTerminalsEqual(const TSharedPtr<FKismetTerminal>& First, const TSharedPtr<FKismetTerminal>& Second) {
+	if (First == Second) {
+		return true;
+	}
+	return First.IsValid() && Second.IsValid() && *First == *Second;
+}
+
+static uint32 GetPinTypeHash(const FEdGraphPinType& PinType) {
+	uint32 Hash = GetTypeHash(PinType.PinCategory);
+	Hash = HashCombine(Hash, GetTypeHash(PinType.PinSubCategory));
+	Hash = HashCombine(Hash, GetTypeHash(PinType.PinSubCategoryObject.Get()));
+	Hash = HashCombine(Hash, GetTypeHash((uint8) PinType.ContainerType));
+	return Hash;
+}
+
+bool FKismetTerminal::operator==(const FKismetTerminal& Terminal) const {
+	if (this == &Terminal) {
+		return true;
+	}
+	//Compare cheap fields first, string comparisons and context chain walk are done only when they match
+	if (bIsLiteral != Terminal.bIsLiteral ||
+		VarType != Terminal.VarType ||
+		ContextType != Terminal.ContextType ||
+		ObjectLiteral != Terminal.ObjectLiteral ||
+		InlineGeneratedParameter != Terminal.InlineGeneratedParameter) {
+		return false;
+	}
+	if (!(Type == Terminal.Type)) {
+		return false;
+	}
+	//Literal values and property names are case sensitive, even though FString comparison operator is not
+	if (!StringLiteral.Equals(Terminal.StringLiteral, ESearchCase::CaseSensitive) ||
+		!AssociatedVarProperty.Equals(Terminal.AssociatedVarProperty, ESearchCase::CaseSensitive)) {
+		return false;
+	}
+	if (!TextLiteral.IdenticalTo(Terminal.TextLiteral) &&
+		!TextLiteral.ToString().Equals(Terminal.TextLiteral.ToString(), ESearchCase::CaseSensitive)) {
+		return false;
+	}
+	return AreContextTerminalsEqual(Context, Terminal.Context);
+}
+
+uint32 GetTypeHash(const FKismetTerminal& Terminal) {
+	uint32 Hash = GetPinTypeHash(Terminal.Type);
+	Hash = HashCombine(Hash, GetTypeHash(Terminal.bIsLiteral));
+	Hash = HashCombine(Hash, GetTypeHash((uint8) Terminal.VarType));
+	Hash = HashCombine(Hash, GetTypeHash((uint8) Terminal.ContextType));
+	//FString hash ignores case, while the comparison does not, so literals differing only in case would always collide
+	Hash = HashCombine(Hash, FCrc::StrCrc32(*Terminal.StringLiteral));
+	Hash = HashCombine(Hash, FCrc::StrCrc32(*Terminal.AssociatedVarProperty));
+	Hash = HashCombine(Hash, GetTypeHash(Terminal.ObjectLiteral));
+	Hash = HashCombine(Hash, GetTypeHash(Terminal.InlineGeneratedParameter.Get()));
+
+	//Text literal is not hashed, text terminals already carry its exported form in the string literal
+	if (Terminal.Context.IsValid()) {
+		Hash = HashCombine(Hash, GetTypeHash(*Terminal.Context));
+	}
+	return Hash;
+}
+
+TSharedPtr<FKismetTerminal> FKismetLiteralTerminalPool::Intern(const TSharedPtr<FKismetTerminal>& Terminal) {
+	check(Terminal.IsValid() && Terminal->bIsLiteral);
+
+	if (const TSharedPtr<FKismetTerminal>* InternedTerminal = InternedTerminals.Find(Terminal)) {
+		return *InternedTerminal;
+	}
+	InternedTerminals.Add(Terminal);
+	return Terminal;
+}
+
+void FKismetLiteralTerminalPool::Reset() {
+	InternedTerminals.Empty();
+}
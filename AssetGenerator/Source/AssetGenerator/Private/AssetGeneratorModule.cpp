@@ -3,12 +3,18 @@
 #include "WorkspaceMenuStructure.h"
 #include "Toolkit/AssetGeneration/AssetGeneratorWidget.h"
 #include "WorkspaceMenuStructureModule.h"
+#include "Toolkit/AssetGeneration/DirtyPackageTracker.h"
 
 #define LOCTEXT_NAMESPACE "AssetGenerator"
 
 const FName FAssetGeneratorModule::AssetGeneratorTabName = TEXT("AssetGenerator");
 
 void FAssetGeneratorModule::StartupModule() {
+	//Module is started before the engine loads any content, so no package dirtied during the commandlet run is missed
+	if (IsRunningCommandlet()) {
+		this->DirtyPackageTracker = MakeShareable(new FDirtyPackageTracker());
+	}
+
 	const TSharedPtr<FWorkspaceItem> WorkspaceGroup = WorkspaceMenu::GetMenuStructure().GetDeveloperToolsMiscCategory();
 	const TSharedRef<FGlobalTabmanager> TabManager = FGlobalTabmanager::Get();
 	
@@ -30,6 +36,7 @@ void FAssetGeneratorModule::ShutdownModule() {
 	const TSharedRef<FGlobalTabmanager> TabManager = FGlobalTabmanager::Get();
 	
 	TabManager->UnregisterNomadTabSpawner(AssetGeneratorTabName);
+	this->DirtyPackageTracker.Reset();
 }
 
 IMPLEMENT_GAME_MODULE(FAssetGeneratorModule, AssetGenerator);
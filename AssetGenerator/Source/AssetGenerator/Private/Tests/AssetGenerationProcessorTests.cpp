@@ -0,0 +1,314 @@
+#include "Toolkit/AssetGeneration/AssetGenerationProcessor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Ready queue never dereferences generators, so tests use distinct fake pointers instead of spawning real ones */
+static UAssetTypeGenerator* MakeFakeGenerator(const int32 Index) {
+	return reinterpret_cast<UAssetTypeGenerator*>(static_cast<UPTRINT>(Index + 1) * 16);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGeneratorReadyQueueOrderTest, "AssetGenerator.Processor.ReadyQueueOrder", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGeneratorReadyQueueOrderTest::RunTest(const FString& Parameters) {
+	FGeneratorReadyQueue ReadyQueue;
+	TArray<UAssetTypeGenerator*> ExpectedOrder;
+	int32 NextGeneratorIndex = 0;
+	int32 NextExpectedIndex = 0;
+
+	//Interleave enqueues with partial pops, so the queue goes through both the reset and the compaction paths
+	for (int32 Round = 0; Round < 64; Round++) {
+		const int32 NumToEnqueue = 1 + Round % 7;
+		for (int32 i = 0; i < NumToEnqueue; i++) {
+			UAssetTypeGenerator* Generator = MakeFakeGenerator(NextGeneratorIndex++);
+			ReadyQueue.Enqueue(Generator);
+			ExpectedOrder.Add(Generator);
+		}
+
+		const int32 NumToPop = Round % 3 == 0 ? ReadyQueue.Num() : FMath::Min(ReadyQueue.Num(), 1 + Round % 5);
+		for (int32 i = 0; i < NumToPop; i++) {
+			if (ReadyQueue[i] != ExpectedOrder[NextExpectedIndex + i]) {
+				AddError(FString::Printf(TEXT("Generator %d was dequeued out of order in round %d"), NextExpectedIndex + i, Round));
+				return false;
+			}
+		}
+		ReadyQueue.PopFront(NumToPop);
+		NextExpectedIndex += NumToPop;
+		TestEqual(TEXT("Queue length after pop"), ReadyQueue.Num(), ExpectedOrder.Num() - NextExpectedIndex);
+	}
+
+	//Remaining generators should still come out in the order they were enqueued
+	for (int32 i = 0; i < ReadyQueue.Num(); i++) {
+		TestTrue(TEXT("Remaining generator order"), ReadyQueue[i] == ExpectedOrder[NextExpectedIndex + i]);
+	}
+	ReadyQueue.PopFront(ReadyQueue.Num());
+	TestEqual(TEXT("Queue length after draining"), ReadyQueue.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGeneratorDependencyWakeupTest, "AssetGenerator.Processor.DependencyWakeup", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGeneratorDependencyWakeupTest::RunTest(const FString& Parameters) {
+	FGeneratorDependencyIndex DependencyIndex;
+	FGeneratorReadyQueue ReadyQueue;
+	UAssetTypeGenerator* First = MakeFakeGenerator(0);
+	UAssetTypeGenerator* Second = MakeFakeGenerator(1);
+	UAssetTypeGenerator* Third = MakeFakeGenerator(2);
+	const FName PackageA = TEXT("/Game/Test/PackageA");
+	const FName PackageB = TEXT("/Game/Test/PackageB");
+
+	//First waits for two packages, second and third wait for the same stage of the same package
+	DependencyIndex.AddDependency(First, PackageA, EAssetGenerationStage::CONSTRUCTION);
+	DependencyIndex.AddDependency(First, PackageB, EAssetGenerationStage::DATA_POPULATION);
+	DependencyIndex.AddDependency(Second, PackageA, EAssetGenerationStage::CONSTRUCTION);
+	DependencyIndex.AddDependency(Third, PackageA, EAssetGenerationStage::CONSTRUCTION);
+	TestEqual(TEXT("Outstanding dependencies of the first generator"), DependencyIndex.GetOutstandingDependencyCount(First), 2);
+	TestTrue(TEXT("Package with dependents is reported"), DependencyIndex.HasPendingDependents(PackageA));
+
+	//Finishing a stage nobody is waiting for does not wake anyone up
+	TestEqual(TEXT("Dependents of a stage nobody waits for"), DependencyIndex.FinishPackageStage(PackageB, EAssetGenerationStage::CONSTRUCTION, ReadyQueue), 0);
+	TestEqual(TEXT("Nothing is ready after unrelated stage"), ReadyQueue.Num(), 0);
+
+	//Generators waiting only for the finished stage wake up in the order they started waiting, the first one still waits for the other package
+	TestEqual(TEXT("Dependents of the shared stage"), DependencyIndex.FinishPackageStage(PackageA, EAssetGenerationStage::CONSTRUCTION, ReadyQueue), 3);
+	if (ReadyQueue.Num() != 2) {
+		AddError(FString::Printf(TEXT("%d generators are ready instead of 2"), ReadyQueue.Num()));
+		return false;
+	}
+	TestTrue(TEXT("Wakeup order"), ReadyQueue[0] == Second && ReadyQueue[1] == Third);
+	TestEqual(TEXT("Counter of the generator still waiting"), DependencyIndex.GetOutstandingDependencyCount(First), 1);
+	TestFalse(TEXT("Satisfied package has no dependents left"), DependencyIndex.HasPendingDependents(PackageA));
+
+	//Finishing the same stage again is a no-op, since the dependents have been removed from the index
+	TestEqual(TEXT("Dependents of the stage finished twice"), DependencyIndex.FinishPackageStage(PackageA, EAssetGenerationStage::CONSTRUCTION, ReadyQueue), 0);
+	ReadyQueue.PopFront(ReadyQueue.Num());
+
+	DependencyIndex.FinishPackageStage(PackageB, EAssetGenerationStage::DATA_POPULATION, ReadyQueue);
+	TestTrue(TEXT("Generator is ready once the last dependency is satisfied"), ReadyQueue.Num() == 1 && ReadyQueue[0] == First);
+	TestEqual(TEXT("Counter reaches zero"), DependencyIndex.GetOutstandingDependencyCount(First), 0);
+	TestEqual(TEXT("Index is empty"), DependencyIndex.GetPendingDependents().Num(), 0);
+
+	//Generator can wait again for the next stage once it has been woken up
+	DependencyIndex.AddDependency(First, PackageA, EAssetGenerationStage::FINISHED);
+	TestEqual(TEXT("Counter for the next stage"), DependencyIndex.GetOutstandingDependencyCount(First), 1);
+	DependencyIndex.RemovePendingDependents(PackageA);
+	TestFalse(TEXT("Removed dependents are not reported"), DependencyIndex.HasPendingDependents(PackageA));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGeneratorDependencyCountersTest, "AssetGenerator.Processor.DependencyCounters", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGeneratorDependencyCountersTest::RunTest(const FString& Parameters) {
+	const int32 NumGenerators = 500;
+	const int32 NumPackages = 64;
+	const int32 NumStages = (int32) EAssetGenerationStage::FINISHED;
+	FRandomStream RandomStream(0xDE9);
+
+	//Every generator waits for a random set of package stages, which are then finished in a random order
+	FGeneratorDependencyIndex DependencyIndex;
+	FGeneratorReadyQueue ReadyQueue;
+	TArray<TSet<FPackageStageKey>> GeneratorDependencies;
+	TArray<FName> PackageNames;
+
+	for (int32 i = 0; i < NumPackages; i++) {
+		PackageNames.Add(*FString::Printf(TEXT("/Game/Test/Package%d"), i));
+	}
+	for (int32 i = 0; i < NumGenerators; i++) {
+		TSet<FPackageStageKey>& Dependencies = GeneratorDependencies.AddDefaulted_GetRef();
+		const int32 NumDependencies = RandomStream.RandRange(1, 6);
+
+		for (int32 j = 0; j < NumDependencies; j++) {
+			const FPackageStageKey Dependency(PackageNames[RandomStream.RandRange(0, NumPackages - 1)], (EAssetGenerationStage) RandomStream.RandRange(0, NumStages - 1));
+			//Processor compacts dependencies before registering them, so every stage is registered only once per generator
+			if (!Dependencies.Contains(Dependency)) {
+				Dependencies.Add(Dependency);
+				DependencyIndex.AddDependency(MakeFakeGenerator(i), Dependency.PackageName, Dependency.Stage);
+			}
+		}
+	}
+
+	TArray<FPackageStageKey> StagesToFinish;
+	for (const FName& PackageName : PackageNames) {
+		for (int32 StageIndex = 0; StageIndex < NumStages; StageIndex++) {
+			StagesToFinish.Add(FPackageStageKey(PackageName, (EAssetGenerationStage) StageIndex));
+		}
+	}
+	for (int32 i = StagesToFinish.Num() - 1; i > 0; i--) {
+		StagesToFinish.Swap(i, RandomStream.RandRange(0, i));
+	}
+
+	//Reference implementation rescans the dependency lists of all generators after every finished stage
+	TSet<FPackageStageKey> FinishedStages;
+	TArray<bool> GeneratorsWokenUp;
+	GeneratorsWokenUp.Init(false, NumGenerators);
+
+	for (const FPackageStageKey& FinishedStage : StagesToFinish) {
+		FinishedStages.Add(FinishedStage);
+		DependencyIndex.FinishPackageStage(FinishedStage.PackageName, FinishedStage.Stage, ReadyQueue);
+
+		TSet<UAssetTypeGenerator*> ExpectedReadyGenerators;
+		for (int32 i = 0; i < NumGenerators; i++) {
+			if (GeneratorsWokenUp[i]) {
+				continue;
+			}
+			int32 RemainingDependencies = 0;
+			for (const FPackageStageKey& Dependency : GeneratorDependencies[i]) {
+				RemainingDependencies += FinishedStages.Contains(Dependency) ? 0 : 1;
+			}
+			if (DependencyIndex.GetOutstandingDependencyCount(MakeFakeGenerator(i)) != RemainingDependencies) {
+				AddError(FString::Printf(TEXT("Generator %d has %d outstanding dependencies instead of %d"), i, DependencyIndex.GetOutstandingDependencyCount(MakeFakeGenerator(i)), RemainingDependencies));
+				return false;
+			}
+			if (RemainingDependencies == 0) {
+				ExpectedReadyGenerators.Add(MakeFakeGenerator(i));
+				GeneratorsWokenUp[i] = true;
+			}
+		}
+
+		//Every generator with all of the dependencies satisfied is woken up exactly once, and nobody else is
+		TSet<UAssetTypeGenerator*> ReadyGenerators;
+		for (int32 i = 0; i < ReadyQueue.Num(); i++) {
+			ReadyGenerators.Add(ReadyQueue[i]);
+		}
+		if (ReadyGenerators.Num() != ReadyQueue.Num() || !ReadyGenerators.Includes(ExpectedReadyGenerators) || !ExpectedReadyGenerators.Includes(ReadyGenerators)) {
+			AddError(FString::Printf(TEXT("Woke up %d generators instead of %d after finishing stage %d of %s"),
+				ReadyQueue.Num(), ExpectedReadyGenerators.Num(), (int32) FinishedStage.Stage, *FinishedStage.PackageName.ToString()));
+			return false;
+		}
+		ReadyQueue.PopFront(ReadyQueue.Num());
+	}
+
+	TestFalse(TEXT("All generators have been woken up"), GeneratorsWokenUp.Contains(false));
+	TestEqual(TEXT("Index is empty"), DependencyIndex.GetPendingDependents().Num(), 0);
+	return true;
+}
+
+/** Runs generators through all of the stages, every stage waiting for the same stage of up to 4 random packages generated earlier. Returns seconds spent */
+static double SimulateDependencyResolution(const int32 NumGenerators, const TArray<FName>& PackageNames, int32& OutGeneratorsFinished) {
+	const int32 NumStages = (int32) EAssetGenerationStage::FINISHED;
+	FRandomStream RandomStream(NumGenerators);
+	FGeneratorDependencyIndex DependencyIndex;
+	FGeneratorReadyQueue ReadyQueue;
+	TArray<int32> CurrentStages;
+	CurrentStages.Init(0, NumGenerators);
+	OutGeneratorsFinished = 0;
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumGenerators; i++) {
+		ReadyQueue.Enqueue(MakeFakeGenerator(i));
+	}
+	while (ReadyQueue.Num()) {
+		//Fake generators encode their index, so it is recovered without dereferencing them
+		const int32 GeneratorIndex = (int32) (reinterpret_cast<UPTRINT>(ReadyQueue[0]) / 16) - 1;
+		ReadyQueue.PopFront(1);
+
+		const int32 FinishedStage = CurrentStages[GeneratorIndex]++;
+		DependencyIndex.FinishPackageStage(PackageNames[GeneratorIndex], (EAssetGenerationStage) FinishedStage, ReadyQueue);
+
+		if (CurrentStages[GeneratorIndex] == NumStages) {
+			OutGeneratorsFinished++;
+			continue;
+		}
+		//Same as the processor, only wait for the dependencies that have not reached the required stage yet
+		const int32 NumDependencies = GeneratorIndex == 0 ? 0 : RandomStream.RandRange(0, 4);
+		const int32 RequiredStage = CurrentStages[GeneratorIndex];
+		for (int32 j = 0; j < NumDependencies; j++) {
+			const int32 DependencyGeneratorIndex = RandomStream.RandRange(0, GeneratorIndex - 1);
+			if (CurrentStages[DependencyGeneratorIndex] <= RequiredStage) {
+				DependencyIndex.AddDependency(MakeFakeGenerator(GeneratorIndex), PackageNames[DependencyGeneratorIndex], (EAssetGenerationStage) RequiredStage);
+			}
+		}
+		if (DependencyIndex.GetOutstandingDependencyCount(MakeFakeGenerator(GeneratorIndex)) == 0) {
+			ReadyQueue.Enqueue(MakeFakeGenerator(GeneratorIndex));
+		}
+	}
+	return FPlatformTime::Seconds() - StartTime;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGeneratorDependencyScalingBenchmark, "AssetGenerator.Processor.DependencyScalingBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FGeneratorDependencyScalingBenchmark::RunTest(const FString& Parameters) {
+	const TArray<int32> GeneratorCounts = {1000, 10000, 100000};
+	TArray<FName> PackageNames;
+	for (int32 i = 0; i < GeneratorCounts.Last(); i++) {
+		PackageNames.Add(*FString::Printf(TEXT("/Game/Benchmark/Package%d"), i));
+	}
+
+	double SmallestMicrosecondsPerGenerator = 0.0;
+	for (const int32 NumGenerators : GeneratorCounts) {
+		int32 GeneratorsFinished = 0;
+		const double Seconds = SimulateDependencyResolution(NumGenerators, PackageNames, GeneratorsFinished);
+		const double MicrosecondsPerGenerator = Seconds * 1000000.0 / NumGenerators;
+
+		//Dependencies always point to earlier generators, so every one of them should run to completion
+		if (GeneratorsFinished != NumGenerators) {
+			AddError(FString::Printf(TEXT("Only %d out of %d generators have finished"), GeneratorsFinished, NumGenerators));
+			return false;
+		}
+		AddInfo(FString::Printf(TEXT("%d generators: %.2fms total, %.3fus per generator"), NumGenerators, Seconds * 1000.0, MicrosecondsPerGenerator));
+
+		if (SmallestMicrosecondsPerGenerator == 0.0) {
+			SmallestMicrosecondsPerGenerator = MicrosecondsPerGenerator;
+		} else if (MicrosecondsPerGenerator > SmallestMicrosecondsPerGenerator * 10.0) {
+			//Cost per generator should stay flat, rescanning structures would make it grow with the amount of generators
+			AddWarning(FString::Printf(TEXT("Cost per generator grew from %.3fus to %.3fus at %d generators"), SmallestMicrosecondsPerGenerator, MicrosecondsPerGenerator, NumGenerators));
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetGenerationTickBudgetSimulationTest, "AssetGenerator.Processor.TickBudgetSimulation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssetGenerationTickBudgetSimulationTest::RunTest(const FString& Parameters) {
+	const float BudgetMs = 16.0f;
+	const double OverheadPerGeneratorMs = 0.5;
+	const int32 NumTicks = 500;
+
+	FAssetGenerationTickBudget TickBudget(BudgetMs);
+	FRandomStream RandomStream(1337);
+	TestTrue(TEXT("Budget is enabled"), TickBudget.IsEnabled());
+	TestFalse(TEXT("Zero budget is disabled"), FAssetGenerationTickBudget(0.0f).IsEnabled());
+
+	//Simulate ticks over the endless stream of generators, with estimates off from the real stage costs by up to a half
+	//Every tenth generator is more expensive than the whole budget
+	double TotalElapsedMs = 0.0;
+	double MaxStageCostMs = 0.0;
+	int32 GeneratorsAdvancedTotal = 0;
+	double NextStageCostMs = RandomStream.FRandRange(1.0, 12.0);
+	
+	for (int32 TickIndex = 0; TickIndex < NumTicks; TickIndex++) {
+		double TickElapsedMs = 0.0;
+		int32 GeneratorsAdvanced = 0;
+
+		while (true) {
+			const double EstimatedCostMs = NextStageCostMs * RandomStream.FRandRange(0.5, 1.5) + OverheadPerGeneratorMs;
+			if (!TickBudget.CanFit(TickElapsedMs, EstimatedCostMs, GeneratorsAdvanced)) {
+				break;
+			}
+			TickElapsedMs += NextStageCostMs;
+			MaxStageCostMs = FMath::Max(MaxStageCostMs, NextStageCostMs);
+			GeneratorsAdvanced++;
+			GeneratorsAdvancedTotal++;
+			NextStageCostMs = GeneratorsAdvancedTotal % 10 == 0 ? 40.0 : RandomStream.FRandRange(1.0, 12.0);
+		}
+		//Preparation of the next stages and dependency gathering happen after the stages and are charged against the same budget
+		TickElapsedMs += GeneratorsAdvanced * OverheadPerGeneratorMs;
+		TickBudget.FinishTick(TickElapsedMs);
+		TotalElapsedMs += TickElapsedMs;
+
+		if (GeneratorsAdvanced == 0) {
+			AddError(FString::Printf(TEXT("Tick %d has not advanced any generators"), TickIndex));
+			return false;
+		}
+	}
+
+	//Overruns are paid back by the next ticks, so overall time can exceed the budget only by the overrun still outstanding,
+	//which in turn is bounded by a single tick worth of the most expensive stage along with the budget itself
+	const double MaxOverrunMs = 2.0 * (MaxStageCostMs + OverheadPerGeneratorMs) + BudgetMs;
+	TestTrue(FString::Printf(TEXT("Outstanding overrun %.2fms is bounded by %.2fms"), TickBudget.GetOverrunMs(), MaxOverrunMs), TickBudget.GetOverrunMs() <= MaxOverrunMs);
+	TestTrue(FString::Printf(TEXT("Total time %.2fms fits into the budget of %d ticks"), TotalElapsedMs, NumTicks),
+		TotalElapsedMs <= NumTicks * BudgetMs + TickBudget.GetOverrunMs() + KINDA_SMALL_NUMBER);
+	return true;
+}
+
+#endif
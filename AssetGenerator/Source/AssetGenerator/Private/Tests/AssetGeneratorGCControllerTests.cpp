@@ -0,0 +1,139 @@
+#include "Toolkit/AssetGeneration/AssetGeneratorGCController.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Synthetic process model, memory and objects grow with every generated package and are released by the collection down to the baseline */
+struct FSyntheticGCTrace {
+	uint64 BaselineMB;
+	uint64 MemoryPerPackageMB;
+	int32 BaselineObjects;
+	int32 ObjectsPerPackage;
+	/** Fraction of the objects allocated since the last collection that are actually garbage */
+	float GarbageFraction;
+
+	FAssetGeneratorGCSample Current;
+	double CurrentTime;
+	uint64 PeakMemoryMB;
+	TArray<int32> CollectionTicks;
+	TArray<FString> CollectionReasons;
+
+	FSyntheticGCTrace(uint64 BaselineMB, uint64 MemoryPerPackageMB, int32 ObjectsPerPackage, float GarbageFraction) :
+		BaselineMB(BaselineMB), MemoryPerPackageMB(MemoryPerPackageMB), BaselineObjects(10000), ObjectsPerPackage(ObjectsPerPackage), GarbageFraction(GarbageFraction),
+		Current(BaselineMB, 10000), CurrentTime(0.0), PeakMemoryMB(BaselineMB) {}
+
+	/** Runs the controller the same way the commandlet loop does, generating the provided amount of packages every tick */
+	void Run(FAssetGeneratorGCController& Controller, const int32 NumTicks, const int32 PackagesPerTick, const double SecondsPerTick) {
+		for (int32 Tick = 0; Tick < NumTicks; Tick++) {
+			CurrentTime += SecondsPerTick;
+			Current.UsedPhysicalMB += MemoryPerPackageMB * PackagesPerTick;
+			Current.NumObjects += ObjectsPerPackage * PackagesPerTick;
+			PeakMemoryMB = FMath::Max(PeakMemoryMB, Current.UsedPhysicalMB);
+			Controller.Update(PackagesPerTick);
+
+			FString CollectionReason;
+			if (Controller.ShouldCollectGarbage(Current, CurrentTime, CollectionReason)) {
+				const FAssetGeneratorGCSample SampleBefore = Current;
+				const int32 FreedObjects = (int32) ((Current.NumObjects - BaselineObjects) * GarbageFraction);
+				Current.NumObjects -= FreedObjects;
+				this->BaselineObjects = Current.NumObjects;
+				Current.UsedPhysicalMB = BaselineMB + (uint64) ((Current.UsedPhysicalMB - BaselineMB) * (1.0f - GarbageFraction));
+				
+				Controller.RecordCollection(SampleBefore, Current, CurrentTime);
+				CollectionTicks.Add(Tick);
+				CollectionReasons.Add(CollectionReason);
+			}
+		}
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetGeneratorGCFixedIntervalTest, "AssetGenerator.GCController.FixedInterval", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssetGeneratorGCFixedIntervalTest::RunTest(const FString& Parameters) {
+	//Collects every 32 packages, memory usage is ignored without the ceiling
+	FAssetGeneratorGCController PackageController(20.0f, 32, 0);
+	FSyntheticGCTrace PackageTrace(100, 1000, 100, 1.0f);
+	PackageTrace.Run(PackageController, 320, 1, 0.1);
+
+	TestFalse(TEXT("Controller without the ceiling is not adaptive"), PackageController.IsAdaptive());
+	TestEqual(TEXT("Collections by the amount of packages"), PackageTrace.CollectionTicks.Num(), 10);
+	for (int32 i = 0; i < PackageTrace.CollectionTicks.Num(); i++) {
+		TestEqual(TEXT("Collection tick"), PackageTrace.CollectionTicks[i], (i + 1) * 32 - 1);
+	}
+	TestEqual(TEXT("Interval is never stretched without the ceiling"), PackageController.GetIntervalMultiplier(), 1);
+
+	//Collects every 20 seconds when no packages are generated
+	FAssetGeneratorGCController TimeController(20.0f, 32, 0);
+	FSyntheticGCTrace TimeTrace(100, 0, 0, 1.0f);
+	TimeTrace.Run(TimeController, 100, 0, 1.0);
+	TestEqual(TEXT("Collections by time"), TimeTrace.CollectionTicks.Num(), 5);
+	TestTrue(TEXT("First collection after 20 seconds"), TimeTrace.CollectionTicks.Num() != 0 && TimeTrace.CollectionTicks[0] == 19);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetGeneratorGCMemoryPressureTest, "AssetGenerator.GCController.MemoryPressure", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssetGeneratorGCMemoryPressureTest::RunTest(const FString& Parameters) {
+	//Every package takes 30MB, so memory reaches 85% of the ceiling after 22 packages, well before the regular interval of 32 packages
+	FAssetGeneratorGCController Controller(20.0f, 32, 1000);
+	FSyntheticGCTrace Trace(200, 30, 5000, 1.0f);
+	Trace.Run(Controller, 200, 1, 0.1);
+
+	TestTrue(TEXT("Controller with the ceiling is adaptive"), Controller.IsAdaptive());
+	TestTrue(TEXT("Garbage is collected"), Trace.CollectionTicks.Num() != 0);
+	TestTrue(TEXT("Memory usage never reaches the ceiling"), Trace.PeakMemoryMB < 1000);
+	for (const FString& CollectionReason : Trace.CollectionReasons) {
+		TestTrue(TEXT("Collections are triggered by memory pressure"), CollectionReason.StartsWith(TEXT("memory usage")));
+	}
+	TestEqual(TEXT("First collection is triggered once the threshold is reached"), Trace.CollectionTicks.Num() ? Trace.CollectionTicks[0] : -1, 21);
+	TestEqual(TEXT("High yield collections keep the regular interval"), Controller.GetIntervalMultiplier(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetGeneratorGCLowYieldBackoffTest, "AssetGenerator.GCController.LowYieldBackoff", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssetGeneratorGCLowYieldBackoffTest::RunTest(const FString& Parameters) {
+	//Memory stays far below the ceiling and collections free almost nothing, so the interval is stretched up to 8 times
+	FAssetGeneratorGCController Controller(1000.0f, 32, 8192);
+	FSyntheticGCTrace LowYieldTrace(100, 0, 1, 1.0f);
+	LowYieldTrace.Run(Controller, 32 + 64 + 128 + 256 + 256, 1, 0.1);
+
+	const TArray<int32> ExpectedTicks = {31, 95, 223, 479, 735};
+	TestEqual(TEXT("Amount of low yield collections"), LowYieldTrace.CollectionTicks.Num(), ExpectedTicks.Num());
+	for (int32 i = 0; i < FMath::Min(ExpectedTicks.Num(), LowYieldTrace.CollectionTicks.Num()); i++) {
+		TestEqual(FString::Printf(TEXT("Low yield collection %d"), i), LowYieldTrace.CollectionTicks[i], ExpectedTicks[i]);
+	}
+	TestEqual(TEXT("Interval multiplier is capped"), Controller.GetIntervalMultiplier(), 8);
+
+	//Collections become useful again, so the interval shrinks back with every one of them
+	FSyntheticGCTrace HighYieldTrace(100, 0, 1000, 1.0f);
+	HighYieldTrace.Run(Controller, 256 + 128 + 64, 1, 0.1);
+	TestEqual(TEXT("Amount of high yield collections"), HighYieldTrace.CollectionTicks.Num(), 3);
+	TestEqual(TEXT("Interval multiplier shrinks back"), Controller.GetIntervalMultiplier(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetGeneratorGCRepeatedPressureTest, "AssetGenerator.GCController.RepeatedPressure", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssetGeneratorGCRepeatedPressureTest::RunTest(const FString& Parameters) {
+	FAssetGeneratorGCController Controller(20.0f, 32, 1000);
+	const FAssetGeneratorGCSample HighMemorySample(900, 100000);
+	FString CollectionReason;
+
+	//Memory stays above the threshold after a collection that freed little, there is nothing new to free until more packages are generated
+	TestTrue(TEXT("First collection under pressure"), Controller.ShouldCollectGarbage(HighMemorySample, 1.0, CollectionReason));
+	Controller.RecordCollection(HighMemorySample, FAssetGeneratorGCSample(900, 99900), 1.0);
+	TestEqual(TEXT("Objects freed by the low yield collection"), Controller.GetLastGCObjectsFreed(), 100);
+	TestFalse(TEXT("No collection right after the low yield one"), Controller.ShouldCollectGarbage(HighMemorySample, 1.1, CollectionReason));
+
+	Controller.Update(1);
+	TestTrue(TEXT("Collection once a package has been generated"), Controller.ShouldCollectGarbage(HighMemorySample, 1.2, CollectionReason));
+
+	//High yield collections do not hold back the next one
+	Controller.RecordCollection(HighMemorySample, FAssetGeneratorGCSample(900, 50000), 1.2);
+	TestTrue(TEXT("Collection after the high yield one"), Controller.ShouldCollectGarbage(HighMemorySample, 1.3, CollectionReason));
+	TestEqual(TEXT("Amount of collections"), Controller.GetNumCollections(), 2);
+	return true;
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "Toolkit/AssetGeneration/AssetRegistryStateCache.h"
+#include "AssetRegistryModule.h"
+#include "Curves/CurveFloat.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetRegistryStateCacheContentDirectoriesTest, "AssetGenerator.AssetRegistryStateCache.ContentDirectories", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssetRegistryStateCacheContentDirectoriesTest::RunTest(const FString& Parameters) {
+	const TArray<FString> ContentDirectories = FAssetRegistryStateCache::GetContentDirectories();
+	const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir() / TEXT("Generated/Package.uasset"));
+	const FString EngineFile = FPaths::ConvertRelativePathToFull(FPaths::EngineContentDir() / TEXT("Generated/Package.uasset"));
+	const FString OutsideFile = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("Generated/Package.uasset"));
+
+	TestFalse(TEXT("Project content is covered by the cache"), FAssetRegistryStateCache::HasFilesOutsideOfContentDirectories({ProjectFile}, ContentDirectories));
+	TestFalse(TEXT("Engine content is covered by the cache"), FAssetRegistryStateCache::HasFilesOutsideOfContentDirectories({EngineFile}, ContentDirectories));
+	TestTrue(TEXT("Files outside of the content directories require the full rescan"), FAssetRegistryStateCache::HasFilesOutsideOfContentDirectories({ProjectFile, OutsideFile}, ContentDirectories));
+
+	//Directory sharing the prefix with the content directory is not a part of it
+	const FString SiblingFile = ContentDirectories[0].LeftChop(1) + TEXT("Sibling/Package.uasset");
+	TestTrue(TEXT("Sibling of the content directory"), FAssetRegistryStateCache::HasFilesOutsideOfContentDirectories({SiblingFile}, ContentDirectories));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetRegistryStateCacheSavedPackagesTest, "AssetGenerator.AssetRegistryStateCache.SavedPackagesAreDiscoverable", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssetRegistryStateCacheSavedPackagesTest::RunTest(const FString& Parameters) {
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	const FString PackageName = TEXT("/Game/AssetGeneratorTests/AssetRegistryStateCache/GeneratedCurve");
+	const FString PackageFileName = FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension()));
+
+	//Save the asset the same way generators do, without notifying the asset registry about it
+	UPackage* Package = CreatePackage(
+#if ENGINE_MINOR_VERSION < 26
+	nullptr,
+#endif
+	*PackageName);
+	UCurveFloat* Asset = NewObject<UCurveFloat>(Package, TEXT("GeneratedCurve"), RF_Public | RF_Standalone);
+	if (!UPackage::SavePackage(Package, Asset, RF_Public | RF_Standalone, *PackageFileName)) {
+		AddError(FString::Printf(TEXT("Failed to save test package to %s"), *PackageFileName));
+		return false;
+	}
+
+	//Only the saved file is scanned, since it is located in the project content directory
+	const bool bFullRescan = FAssetRegistryStateCache::ScanSavedPackages(AssetRegistry, {PackageFileName}, false);
+	TestFalse(TEXT("Saved package does not require the full rescan"), bFullRescan);
+
+	TArray<FAssetData> FoundAssets;
+	AssetRegistry.GetAssetsByPackageName(*PackageName, FoundAssets, true);
+	TestEqual(TEXT("Saved asset is found in the registry"), FoundAssets.Num(), 1);
+	if (FoundAssets.Num() == 1) {
+		TestEqual(TEXT("Asset class"), FoundAssets[0].AssetClass, UCurveFloat::StaticClass()->GetFName());
+		TestEqual(TEXT("Asset name"), FoundAssets[0].AssetName, FName(TEXT("GeneratedCurve")));
+	}
+
+	AssetRegistry.AssetDeleted(Asset);
+	Asset->ClearFlags(RF_Public | RF_Standalone);
+	Package->SetFlags(RF_Transient);
+	IFileManager::Get().Delete(*PackageFileName, false, true, true);
+	return true;
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "Toolkit/AssetGeneration/DirtyPackageTracker.h"
+#include "Misc/AutomationTest.h"
+#include "Util/PackageNameMatcher.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static UPackage* CreateCleanTestPackage(const TCHAR* PackageName) {
+	UPackage* Package = CreatePackage(
+#if ENGINE_MINOR_VERSION < 26
+	nullptr,
+#endif
+	PackageName);
+	Package->SetDirtyFlag(false);
+	return Package;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirtyPackageTrackerTest, "AssetGenerator.DirtyPackageTracker.DirtiedPackages", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDirtyPackageTrackerTest::RunTest(const FString& Parameters) {
+	UPackage* LoadedPackage = CreateCleanTestPackage(TEXT("/Temp/AssetGeneratorTests/DirtyPackageTracker/Loaded"));
+	UPackage* CleanedPackage = CreateCleanTestPackage(TEXT("/Temp/AssetGeneratorTests/DirtyPackageTracker/Cleaned"));
+	UPackage* ResavedPackage = CreateCleanTestPackage(TEXT("/Temp/AssetGeneratorTests/DirtyPackageTracker/Resaved"));
+	UPackage* GeneratedPackage = CreateCleanTestPackage(TEXT("/Temp/AssetGeneratorTests/DirtyPackageTracker/Generated"));
+	UPackage* SkippedPackage = CreateCleanTestPackage(TEXT("/Temp/AssetGeneratorTests/DirtyPackageTracker/Skipped/Package"));
+
+	//Tracker is created before anything is loaded, same as the one started by the module
+	const TUniquePtr<FDirtyPackageTracker> DirtyPackageTracker = MakeUnique<FDirtyPackageTracker>();
+
+	//Packages dirtied before the generation starts, for example by the config loading or the asset registry
+	LoadedPackage->SetDirtyFlag(true);
+	CleanedPackage->SetDirtyFlag(true);
+	CleanedPackage->SetDirtyFlag(false);
+	ResavedPackage->SetDirtyFlag(true);
+
+	//Packages dirtied during the generation, including the ones saved in between and then modified again
+	GeneratedPackage->SetDirtyFlag(true);
+	SkippedPackage->SetDirtyFlag(true);
+	ResavedPackage->SetDirtyFlag(false);
+	ResavedPackage->SetDirtyFlag(true);
+
+	FPackageNameMatcher PackagesToSkip;
+	PackagesToSkip.AddRule(TEXT("/Temp/AssetGeneratorTests/DirtyPackageTracker/Skipped/"));
+	TArray<UPackage*> DirtyPackages;
+	DirtyPackageTracker->GetDirtyPackages(PackagesToSkip, DirtyPackages);
+
+	TestTrue(TEXT("Package dirtied before the generation"), DirtyPackages.Contains(LoadedPackage));
+	TestTrue(TEXT("Package dirtied during the generation"), DirtyPackages.Contains(GeneratedPackage));
+	TestTrue(TEXT("Package dirtied again after being saved"), DirtyPackages.Contains(ResavedPackage));
+	TestFalse(TEXT("Package that is no longer dirty"), DirtyPackages.Contains(CleanedPackage));
+	TestFalse(TEXT("Package matched by the skip rules"), DirtyPackages.Contains(SkippedPackage));
+	TestEqual(TEXT("Every dirty package is listed once"), DirtyPackages.Num(), 3);
+
+	//Dirty state changes after the tracker is gone are not recorded anymore
+	CleanedPackage->SetDirtyFlag(false);
+	const TUniquePtr<FDirtyPackageTracker> NewDirtyPackageTracker = MakeUnique<FDirtyPackageTracker>();
+	CleanedPackage->SetDirtyFlag(true);
+	DirtyPackages.Reset();
+	NewDirtyPackageTracker->GetDirtyPackages(PackagesToSkip, DirtyPackages);
+	TestTrue(TEXT("New tracker only sees packages dirtied after it was created"), DirtyPackages.Num() == 1 && DirtyPackages[0] == CleanedPackage);
+
+	for (UPackage* Package : {LoadedPackage, CleanedPackage, ResavedPackage, GeneratedPackage, SkippedPackage}) {
+		Package->SetDirtyFlag(false);
+		Package->SetFlags(RF_Transient);
+	}
+	return true;
+}
+
+#endif
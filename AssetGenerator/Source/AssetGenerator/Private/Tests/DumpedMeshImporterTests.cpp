@@ -0,0 +1,51 @@
+#include "Toolkit/AssetGeneration/DumpedMeshImporter.h"
+#include "Toolkit/AssetTypes/MeshDumpFormat.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Builds skinned mesh with the provided amount of material slots and a single triangle section per slot */
+static FDumpedMeshData MakeMeshDataWithMaterialSlots(const int32 NumMaterialSlots) {
+	FDumpedMeshData MeshData;
+	FDumpedMeshBone& RootBone = MeshData.Bones.AddDefaulted_GetRef();
+	RootBone.Name = TEXT("root");
+
+	FDumpedMeshLOD& LOD = MeshData.LODs.AddDefaulted_GetRef();
+	for (int32 VertexIndex = 0; VertexIndex < 3; VertexIndex++) {
+		LOD.Positions.Add(FVector(VertexIndex, 0.0f, 0.0f));
+		LOD.Normals.Add(FVector::UpVector);
+		LOD.Tangents.Add(FVector4(1.0f, 0.0f, 0.0f, 1.0f));
+		LOD.Indices.Add(VertexIndex);
+	}
+	for (int32 MaterialIndex = 0; MaterialIndex < NumMaterialSlots; MaterialIndex++) {
+		MeshData.MaterialSlotNames.Add(FString::Printf(TEXT("Material_%d"), MaterialIndex));
+		FDumpedMeshSection& Section = LOD.Sections.AddDefaulted_GetRef();
+		Section.MaterialIndex = MaterialIndex;
+		Section.NumTriangles = 1;
+	}
+	return MeshData;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDumpedMeshImporterValidationTest, "AssetGenerator.DumpedMeshImporter.Validation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDumpedMeshImporterValidationTest::RunTest(const FString& Parameters) {
+	FString ErrorMessage;
+
+	//Skeletal mesh import data stores material indices as bytes, so 256 slots is the most a skeletal mesh can have
+	const FDumpedMeshData MaxMaterialsMeshData = MakeMeshDataWithMaterialSlots(MAX_uint8 + 1);
+	TestTrue(TEXT("Skeletal mesh with 256 material slots is accepted"), FDumpedMeshImporter::ValidateMeshData(MaxMaterialsMeshData, true, ErrorMessage));
+
+	const FDumpedMeshData TooManyMaterialsMeshData = MakeMeshDataWithMaterialSlots(MAX_uint8 + 2);
+	TestFalse(TEXT("Skeletal mesh with 257 material slots is rejected"), FDumpedMeshImporter::ValidateMeshData(TooManyMaterialsMeshData, true, ErrorMessage));
+	TestTrue(TEXT("Static mesh with 257 material slots is accepted"), FDumpedMeshImporter::ValidateMeshData(TooManyMaterialsMeshData, false, ErrorMessage));
+
+	FDumpedMeshData StaticMeshData = MakeMeshDataWithMaterialSlots(1);
+	StaticMeshData.Bones.Empty();
+	TestFalse(TEXT("Mesh without reference skeleton is rejected as skeletal mesh"), FDumpedMeshImporter::ValidateMeshData(StaticMeshData, true, ErrorMessage));
+
+	FDumpedMeshData EmptyMeshData;
+	TestFalse(TEXT("Mesh without LODs is rejected"), FDumpedMeshImporter::ValidateMeshData(EmptyMeshData, false, ErrorMessage));
+	return true;
+}
+
+#endif
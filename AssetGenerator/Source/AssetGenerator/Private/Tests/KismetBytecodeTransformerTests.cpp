@@ -0,0 +1,690 @@
+#include "AssetGeneration/KismetBytecodeTransformer.h"
+#include "Dom/JsonObject.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Creates disassembled statement object with the provided instruction, located at the provided bytecode offset */
+static TSharedPtr<FJsonObject> MakeStatementObject(const TCHAR* Instruction, const int32 StatementOffset) {
+	const TSharedPtr<FJsonObject> StatementObject = MakeShareable(new FJsonObject());
+	StatementObject->SetStringField(TEXT("Inst"), Instruction);
+	StatementObject->SetNumberField(TEXT("StatementIndex"), StatementOffset);
+	return StatementObject;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeTransformerJumpResolutionTest, "AssetGenerator.KismetBytecodeTransformer.JumpResolution", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeTransformerJumpResolutionTest::RunTest(const FString& Parameters) {
+	UBlueprint* Blueprint = NewObject<UBlueprint>(GetTransientPackage(), NAME_None, RF_Transient);
+	const int32 NumStatements = 4096;
+
+	//Statements are spaced irregularly, the way real bytecode is, so jump targets cannot be resolved by dividing the offset
+	TArray<int32> StatementOffsets;
+	for (int32 i = 0; i < NumStatements; i++) {
+		StatementOffsets.Add(i * 16 + (i % 3) * (i % 7));
+	}
+
+	//Dense jump table: every statement but the last one jumps, with every fourth jump targeting the final return statement
+	FRandomStream RandomStream(0x4A4D);
+	TArray<int32> ExpectedTargetIndices;
+	TArray<TSharedPtr<FJsonObject>> StatementObjects;
+
+	for (int32 i = 0; i < NumStatements - 1; i++) {
+		const int32 TargetIndex = i % 4 == 0 ? NumStatements - 1 : RandomStream.RandRange(0, NumStatements - 2);
+		ExpectedTargetIndices.Add(TargetIndex);
+
+		TSharedPtr<FJsonObject> StatementObject;
+		if (i % 3 == 0) {
+			StatementObject = MakeStatementObject(TEXT("Jump"), StatementOffsets[i]);
+		}
+		else if (i % 3 == 1) {
+			StatementObject = MakeStatementObject(TEXT("JumpIfNot"), StatementOffsets[i]);
+			const TSharedPtr<FJsonObject> Condition = MakeShareable(new FJsonObject());
+			Condition->SetStringField(TEXT("Inst"), TEXT("True"));
+			StatementObject->SetObjectField(TEXT("Condition"), Condition);
+		}
+		else {
+			StatementObject = MakeStatementObject(TEXT("PushExecutionFlow"), StatementOffsets[i]);
+		}
+		StatementObject->SetNumberField(TEXT("Offset"), StatementOffsets[TargetIndex]);
+		StatementObjects.Add(StatementObject);
+	}
+	StatementObjects.Add(MakeStatementObject(TEXT("Return"), StatementOffsets.Last()));
+
+	FKismetBytecodeTransformer Transformer(Blueprint);
+	Transformer.SetSourceStatements(TEXT("TestFunction"), StatementObjects);
+	const TArray<TSharedPtr<FKismetCompiledStatement>> Statements = Transformer.FinishGeneration();
+
+	if (Statements.Num() != NumStatements) {
+		AddError(FString::Printf(TEXT("Transformer produced %d statements instead of %d"), Statements.Num(), NumStatements));
+		return false;
+	}
+	TestEqual(TEXT("Statement offsets"), Transformer.GetStatementOffsets(), StatementOffsets);
+
+	for (int32 i = 0; i < NumStatements - 1; i++) {
+		const TSharedPtr<FKismetCompiledStatement>& Statement = Statements[i];
+		if (Statement->TargetLabel != Statements[ExpectedTargetIndices[i]]) {
+			AddError(FString::Printf(TEXT("Jump at offset %d was resolved to the wrong statement"), StatementOffsets[i]));
+			return false;
+		}
+
+		//Jumps to the return statement are turned into returns, but pushed execution flow is left as it is
+		const bool bTargetsReturn = ExpectedTargetIndices[i] == NumStatements - 1;
+		ECompiledStatementType ExpectedType = ECompiledStatementType::KCST_PushState;
+		if (i % 3 == 0) {
+			ExpectedType = bTargetsReturn ? ECompiledStatementType::KCST_GotoReturn : ECompiledStatementType::KCST_UnconditionalGoto;
+		}
+		else if (i % 3 == 1) {
+			ExpectedType = bTargetsReturn ? ECompiledStatementType::KCST_GotoReturnIfNot : ECompiledStatementType::KCST_GotoIfNot;
+		}
+		if (Statement->Type != ExpectedType) {
+			AddError(FString::Printf(TEXT("Jump at offset %d has statement type %d instead of %d"), StatementOffsets[i], (int32) Statement->Type, (int32) ExpectedType));
+			return false;
+		}
+	}
+
+	//Finishing generation again should not apply patch-ups twice or change the statements
+	const TArray<TSharedPtr<FKismetCompiledStatement>> StatementsAfterSecondFinish = Transformer.FinishGeneration();
+	TestTrue(TEXT("Finishing generation again returns the same statements"), StatementsAfterSecondFinish == Statements);
+	return true;
+}
+
+/** Creates disassembled jump statement located at the provided offset and targeting another offset */
+static TSharedPtr<FJsonObject> MakeJumpStatementObject(const int32 StatementOffset, const int32 TargetOffset) {
+	const TSharedPtr<FJsonObject> StatementObject = MakeStatementObject(TEXT("Jump"), StatementOffset);
+	StatementObject->SetNumberField(TEXT("Offset"), TargetOffset);
+	return StatementObject;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeTransformerPartitionUberGraphTest, "AssetGenerator.KismetBytecodeTransformer.PartitionUberGraph", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeTransformerPartitionUberGraphTest::RunTest(const FString& Parameters) {
+	UBlueprint* Blueprint = NewObject<UBlueprint>(GetTransientPackage(), NAME_None, RF_Transient);
+	const FString UberGraphFunctionName = UEdGraphSchema_K2::FN_ExecuteUbergraphBase.ToString() + TEXT("_") + Blueprint->GetName();
+
+	//Events at 0 and 20 both end up in the shared statement at 60, event at 70 is independent, and statement at 10 is unreachable
+	TArray<TSharedPtr<FJsonObject>> StatementObjects;
+	StatementObjects.Add(MakeJumpStatementObject(0, 30));
+	StatementObjects.Add(MakeStatementObject(TEXT("PopExecutionFlow"), 10));
+	StatementObjects.Add(MakeJumpStatementObject(20, 50));
+	StatementObjects.Add(MakeStatementObject(TEXT("Nothing"), 30));
+	StatementObjects.Add(MakeJumpStatementObject(40, 60));
+	StatementObjects.Add(MakeJumpStatementObject(50, 60));
+	StatementObjects.Add(MakeStatementObject(TEXT("PopExecutionFlow"), 60));
+	StatementObjects.Add(MakeStatementObject(TEXT("Nothing"), 70));
+	StatementObjects.Add(MakeStatementObject(TEXT("Return"), 80));
+
+	FKismetBytecodeTransformer Transformer(Blueprint);
+	Transformer.SetSourceStatements(UberGraphFunctionName, StatementObjects);
+	const TArray<TSharedPtr<FKismetCompiledStatement>> Statements = Transformer.FinishGeneration();
+
+	//Entry offsets come in the order functions calling into the ubergraph were processed, possibly with duplicates
+	const TArray<FKismetUbergraphRegion> Regions = Transformer.PartitionUberGraph({70, 20, 0, 70});
+	if (Regions.Num() != 3) {
+		AddError(FString::Printf(TEXT("Ubergraph was partitioned into %d regions instead of 3"), Regions.Num()));
+		return false;
+	}
+
+	const TArray<int32> ExpectedFirstEntryOffsets = {0, 20};
+	const TArray<int32> ExpectedSecondEntryOffsets = {70};
+	TestEqual(TEXT("Entry offsets of the merged region"), Regions[0].EntryOffsets, ExpectedFirstEntryOffsets);
+	TestEqual(TEXT("Entry offsets of the independent region"), Regions[1].EntryOffsets, ExpectedSecondEntryOffsets);
+
+	const TArray<TSharedPtr<FKismetCompiledStatement>> ExpectedFirstEntryStatements = {Statements[0], Statements[2]};
+	const TArray<TSharedPtr<FKismetCompiledStatement>> ExpectedSecondEntryStatements = {Statements[7]};
+	TestTrue(TEXT("Entry statements of the merged region"), Regions[0].EntryStatements == ExpectedFirstEntryStatements);
+	TestTrue(TEXT("Entry statements of the independent region"), Regions[1].EntryStatements == ExpectedSecondEntryStatements);
+
+	//Statements stay in the bytecode order, and unreachable ones end up in the last region without entry points
+	const TArray<TSharedPtr<FKismetCompiledStatement>> ExpectedFirstStatements = {Statements[0], Statements[2], Statements[3], Statements[4], Statements[5], Statements[6]};
+	const TArray<TSharedPtr<FKismetCompiledStatement>> ExpectedSecondStatements = {Statements[7], Statements[8]};
+	const TArray<TSharedPtr<FKismetCompiledStatement>> ExpectedUnreachableStatements = {Statements[1]};
+	TestTrue(TEXT("Statements of the merged region"), Regions[0].Statements == ExpectedFirstStatements);
+	TestTrue(TEXT("Statements of the independent region"), Regions[1].Statements == ExpectedSecondStatements);
+	TestTrue(TEXT("Unreachable statements region"), Regions[2].Statements == ExpectedUnreachableStatements);
+	TestTrue(TEXT("Unreachable statements region has no entry points"), Regions[2].EntryOffsets.Num() == 0 && Regions[2].EntryStatements.Num() == 0);
+
+	//Events only called with a non-constant entry offset are not known, but their code should still end up in a region
+	const TArray<FKismetUbergraphRegion> PartialRegions = Transformer.PartitionUberGraph({0});
+	int32 NumPartitionedStatements = 0;
+	for (const FKismetUbergraphRegion& Region : PartialRegions) {
+		NumPartitionedStatements += Region.Statements.Num();
+	}
+	TestEqual(TEXT("Every statement belongs to a region when entry points are missing"), NumPartitionedStatements, Statements.Num());
+	TestEqual(TEXT("Code of unknown events is put into the unreachable statements region"), PartialRegions.Last().Statements.Num(), 5);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeTransformerPartitionUberGraphBenchmark, "AssetGenerator.KismetBytecodeTransformer.PartitionUberGraphBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FKismetBytecodeTransformerPartitionUberGraphBenchmark::RunTest(const FString& Parameters) {
+	UBlueprint* Blueprint = NewObject<UBlueprint>(GetTransientPackage(), NAME_None, RF_Transient);
+	const FString UberGraphFunctionName = UEdGraphSchema_K2::FN_ExecuteUbergraphBase.ToString() + TEXT("_") + Blueprint->GetName();
+	const int32 NumEvents = 2000;
+	const int32 StatementsPerEvent = 50;
+
+	//Every event is a chain of statements ending the thread, and every 10th event pushes execution flow into the code of the previous one, like a shared resume point
+	TArray<TSharedPtr<FJsonObject>> StatementObjects;
+	TArray<int32> EntryOffsets;
+	for (int32 EventIndex = 0; EventIndex < NumEvents; EventIndex++) {
+		const int32 EventOffset = EventIndex * StatementsPerEvent * 10;
+		EntryOffsets.Add(EventOffset);
+
+		if (EventIndex % 10 == 9) {
+			const TSharedPtr<FJsonObject> PushFlowStatement = MakeStatementObject(TEXT("PushExecutionFlow"), EventOffset);
+			PushFlowStatement->SetNumberField(TEXT("Offset"), EventOffset - StatementsPerEvent * 5);
+			StatementObjects.Add(PushFlowStatement);
+		}
+		else {
+			StatementObjects.Add(MakeStatementObject(TEXT("Nothing"), EventOffset));
+		}
+		for (int32 i = 1; i < StatementsPerEvent - 1; i++) {
+			StatementObjects.Add(MakeStatementObject(TEXT("Nothing"), EventOffset + i * 10));
+		}
+		StatementObjects.Add(MakeStatementObject(TEXT("PopExecutionFlow"), EventOffset + (StatementsPerEvent - 1) * 10));
+	}
+
+	FKismetBytecodeTransformer Transformer(Blueprint);
+	const double TransformStartTime = FPlatformTime::Seconds();
+	Transformer.SetSourceStatements(UberGraphFunctionName, StatementObjects);
+	Transformer.FinishGeneration();
+	const double TransformTime = FPlatformTime::Seconds() - TransformStartTime;
+
+	const double PartitionStartTime = FPlatformTime::Seconds();
+	const TArray<FKismetUbergraphRegion> Regions = Transformer.PartitionUberGraph(EntryOffsets);
+	const double PartitionTime = FPlatformTime::Seconds() - PartitionStartTime;
+
+	int32 LargestRegionSize = 0;
+	for (const FKismetUbergraphRegion& Region : Regions) {
+		LargestRegionSize = FMath::Max(LargestRegionSize, Region.Statements.Num());
+	}
+	TestEqual(TEXT("Events sharing code are merged"), Regions.Num(), NumEvents - NumEvents / 10);
+	AddInfo(FString::Printf(TEXT("Partitioned ubergraph of %d statements into %d regions of at most %d statements in %.2f ms, transforming it took %.2f ms"),
+		StatementObjects.Num(), Regions.Num(), LargestRegionSize, PartitionTime * 1000.0, TransformTime * 1000.0));
+	return true;
+}
+
+/** Creates disassembled integer constant expression */
+static TSharedPtr<FJsonObject> MakeIntConstObject(const int32 Value) {
+	const TSharedPtr<FJsonObject> ExpressionObject = MakeShareable(new FJsonObject());
+	ExpressionObject->SetStringField(TEXT("Inst"), TEXT("IntConst"));
+	ExpressionObject->SetNumberField(TEXT("Value"), Value);
+	return ExpressionObject;
+}
+
+/** Creates disassembled object constant expression referencing the provided object */
+static TSharedPtr<FJsonObject> MakeObjectConstObject(const TCHAR* ObjectPath) {
+	const TSharedPtr<FJsonObject> ExpressionObject = MakeShareable(new FJsonObject());
+	ExpressionObject->SetStringField(TEXT("Inst"), TEXT("ObjectConst"));
+	ExpressionObject->SetStringField(TEXT("Object"), ObjectPath);
+	return ExpressionObject;
+}
+
+/** Creates disassembled static function call statement with the provided parameter expressions */
+static TSharedPtr<FJsonObject> MakeCallMathStatementObject(const int32 StatementOffset, const TCHAR* ContextClass, const TCHAR* FunctionName, const TArray<TSharedPtr<FJsonObject>>& Parameters) {
+	const TSharedPtr<FJsonObject> StatementObject = MakeStatementObject(TEXT("CallMath"), StatementOffset);
+	StatementObject->SetStringField(TEXT("ContextClass"), ContextClass);
+	StatementObject->SetStringField(TEXT("Function"), FunctionName);
+
+	TArray<TSharedPtr<FJsonValue>> ParameterValues;
+	for (const TSharedPtr<FJsonObject>& Parameter : Parameters) {
+		ParameterValues.Add(MakeShareable(new FJsonValueObject(Parameter)));
+	}
+	StatementObject->SetArrayField(TEXT("Parameters"), ParameterValues);
+	return StatementObject;
+}
+
+static bool AreTerminalsEquivalent(const TSharedPtr<FKismetTerminal>& First, const TSharedPtr<FKismetTerminal>& Second) {
+	if (!First.IsValid() || !Second.IsValid()) {
+		return First.IsValid() == Second.IsValid();
+	}
+	return *First == *Second;
+}
+
+/** Compares statements at the provided index structurally, with jump targets compared by their position in the statement list */
+static bool AreStatementsEquivalent(const TArray<TSharedPtr<FKismetCompiledStatement>>& FirstStatements, const TArray<TSharedPtr<FKismetCompiledStatement>>& SecondStatements, const int32 StatementIndex) {
+	const TSharedPtr<FKismetCompiledStatement>& First = FirstStatements[StatementIndex];
+	const TSharedPtr<FKismetCompiledStatement>& Second = SecondStatements[StatementIndex];
+
+	if (First->Type != Second->Type ||
+		First->FunctionToCall != Second->FunctionToCall ||
+		First->bIsParentContext != Second->bIsParentContext ||
+		First->bIsInterfaceContext != Second->bIsInterfaceContext ||
+		FirstStatements.IndexOfByKey(First->TargetLabel) != SecondStatements.IndexOfByKey(Second->TargetLabel)) {
+		return false;
+	}
+	if (!AreTerminalsEquivalent(First->FunctionContext, Second->FunctionContext) ||
+		!AreTerminalsEquivalent(First->LHS, Second->LHS) ||
+		First->RHS.Num() != Second->RHS.Num()) {
+		return false;
+	}
+	for (int32 i = 0; i < First->RHS.Num(); i++) {
+		if (!AreTerminalsEquivalent(First->RHS[i], Second->RHS[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeTransformerLiteralInterningTest, "AssetGenerator.KismetBytecodeTransformer.LiteralInterning", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeTransformerLiteralInterningTest::RunTest(const FString& Parameters) {
+	UBlueprint* Blueprint = NewObject<UBlueprint>(GetTransientPackage(), NAME_None, RF_Transient);
+	const TCHAR* SystemLibraryClassPath = TEXT("/Script/Engine.KismetSystemLibrary");
+	const TCHAR* SystemLibraryObjectPath = TEXT("/Script/Engine.Default__KismetSystemLibrary");
+	const TCHAR* MathLibraryClassPath = TEXT("/Script/Engine.KismetMathLibrary");
+
+	//Same object literal is used both as a class context and as a plain parameter, so a shared terminal must not pick up the context type
+	TArray<TSharedPtr<FJsonObject>> StatementObjects;
+	const TSharedPtr<FJsonObject> FunctionCallObject = MakeStatementObject(TEXT("FinalFunction"), 0);
+	FunctionCallObject->SetStringField(TEXT("Function"), TEXT("GetDisplayName"));
+	TArray<TSharedPtr<FJsonValue>> FunctionCallParameters;
+	FunctionCallParameters.Add(MakeShareable(new FJsonValueObject(MakeObjectConstObject(SystemLibraryObjectPath))));
+	FunctionCallObject->SetArrayField(TEXT("Parameters"), FunctionCallParameters);
+
+	const TSharedPtr<FJsonObject> ContextStatementObject = MakeStatementObject(TEXT("ClassContext"), 0);
+	ContextStatementObject->SetObjectField(TEXT("Context"), MakeObjectConstObject(SystemLibraryObjectPath));
+	ContextStatementObject->SetObjectField(TEXT("Expression"), FunctionCallObject);
+	StatementObjects.Add(ContextStatementObject);
+	StatementObjects.Add(MakeCallMathStatementObject(10, SystemLibraryClassPath, TEXT("GetDisplayName"), {MakeObjectConstObject(SystemLibraryObjectPath)}));
+
+	//Repeated integer constants, within a single statement and across statements
+	StatementObjects.Add(MakeCallMathStatementObject(20, MathLibraryClassPath, TEXT("Add_IntInt"), {MakeIntConstObject(5), MakeIntConstObject(5)}));
+	StatementObjects.Add(MakeCallMathStatementObject(30, MathLibraryClassPath, TEXT("Add_IntInt"), {MakeIntConstObject(5), MakeIntConstObject(7)}));
+
+	const TSharedPtr<FJsonObject> ConditionObject = MakeShareable(new FJsonObject());
+	ConditionObject->SetStringField(TEXT("Inst"), TEXT("True"));
+	const TSharedPtr<FJsonObject> JumpObject = MakeStatementObject(TEXT("JumpIfNot"), 40);
+	JumpObject->SetObjectField(TEXT("Condition"), ConditionObject);
+	JumpObject->SetNumberField(TEXT("Offset"), 60);
+	StatementObjects.Add(JumpObject);
+	const TSharedPtr<FJsonObject> PopFlowObject = MakeStatementObject(TEXT("PopExecutionFlowIfNot"), 50);
+	PopFlowObject->SetObjectField(TEXT("Condition"), ConditionObject);
+	StatementObjects.Add(PopFlowObject);
+	StatementObjects.Add(MakeStatementObject(TEXT("Return"), 60));
+
+	FKismetBytecodeTransformer InterningTransformer(Blueprint);
+	InterningTransformer.SetSourceStatements(TEXT("TestFunction"), StatementObjects);
+	const TArray<TSharedPtr<FKismetCompiledStatement>> InternedStatements = InterningTransformer.FinishGeneration();
+
+	FKismetBytecodeTransformer ReferenceTransformer(Blueprint);
+	ReferenceTransformer.SetLiteralInterningEnabled(false);
+	ReferenceTransformer.SetSourceStatements(TEXT("TestFunction"), StatementObjects);
+	const TArray<TSharedPtr<FKismetCompiledStatement>> ReferenceStatements = ReferenceTransformer.FinishGeneration();
+
+	//Interning should only change how literals are shared, never the transformed statements themselves
+	if (InternedStatements.Num() != ReferenceStatements.Num()) {
+		AddError(FString::Printf(TEXT("Interning transformer produced %d statements, reference one produced %d"), InternedStatements.Num(), ReferenceStatements.Num()));
+		return false;
+	}
+	for (int32 i = 0; i < InternedStatements.Num(); i++) {
+		TestTrue(FString::Printf(TEXT("Statement %d is equivalent to the one produced without interning"), i), AreStatementsEquivalent(InternedStatements, ReferenceStatements, i));
+	}
+	TestEqual(TEXT("Statement offsets"), InterningTransformer.GetStatementOffsets(), ReferenceTransformer.GetStatementOffsets());
+
+	TestTrue(TEXT("Context keeps the class context type"), InternedStatements[0]->FunctionContext->ContextType == FKismetTerminal::EContextType_Class);
+	TestTrue(TEXT("Literal used as a context is not shared with the parameter"), InternedStatements[0]->FunctionContext != InternedStatements[0]->RHS[0]);
+	TestTrue(TEXT("Object literals are shared"), InternedStatements[0]->RHS[0] == InternedStatements[1]->RHS[0]);
+	TestTrue(TEXT("Integer literals are shared within a statement"), InternedStatements[2]->RHS[0] == InternedStatements[2]->RHS[1]);
+	TestTrue(TEXT("Integer literals are shared across statements"), InternedStatements[2]->RHS[0] == InternedStatements[3]->RHS[0]);
+	TestTrue(TEXT("Different integer literals are not shared"), InternedStatements[3]->RHS[0] != InternedStatements[3]->RHS[1]);
+	TestTrue(TEXT("Condition literals are shared"), InternedStatements[4]->LHS == InternedStatements[5]->LHS);
+	TestTrue(TEXT("Literals are not shared with interning disabled"), ReferenceStatements[2]->RHS[0] != ReferenceStatements[2]->RHS[1]);
+	return true;
+}
+
+/** Every instruction name written by the bytecode disassembler, in the order of EKismetInstruction entries */
+static const TArray<FString>& GetKismetInstructionNames() {
+	static const TArray<FString> InstructionNames = {
+		TEXT("Nothing"), TEXT("SetSet"), TEXT("SetArray"), TEXT("SetMap"), TEXT("Let"), TEXT("LetObj"), TEXT("LetWeakObjPtr"), TEXT("LetBool"),
+		TEXT("LetMulticastDelegate"), TEXT("LetDelegate"), TEXT("LetValueOnPersistentFrame"), TEXT("CallMulticastDelegate"), TEXT("ComputedJump"),
+		TEXT("Jump"), TEXT("JumpIfNot"), TEXT("PushExecutionFlow"), TEXT("PopExecutionFlowIfNot"), TEXT("PopExecutionFlow"), TEXT("AddMulticastDelegate"),
+		TEXT("RemoveMulticastDelegate"), TEXT("ClearMulticastDelegate"), TEXT("BindDelegate"), TEXT("Return"),
+		TEXT("CallMath"), TEXT("LocalFinalFunction"), TEXT("FinalFunction"), TEXT("LocalVirtualFunction"), TEXT("VirtualFunction"),
+		TEXT("ObjToInterfaceCast"), TEXT("CrossInterfaceCast"), TEXT("InterfaceToObjCast"), TEXT("DynamicCast"), TEXT("MetaCast"), TEXT("PrimitiveCast"),
+		TEXT("Context"), TEXT("Context_FailSilent"), TEXT("ClassContext"), TEXT("InterfaceContext"), TEXT("StructMemberContext"),
+		TEXT("DefaultVariable"), TEXT("InstanceVariable"), TEXT("LocalVariable"), TEXT("LocalOutVariable"), TEXT("ArrayGetByRef"), TEXT("SwitchValue"),
+		TEXT("Self"), TEXT("TextConst"), TEXT("StringConst"), TEXT("UnicodeStringConst"), TEXT("FloatConst"), TEXT("IntConst"), TEXT("Int64Const"),
+		TEXT("UInt64Const"), TEXT("ByteConst"), TEXT("False"), TEXT("True"), TEXT("NameConst"), TEXT("VectorConst"), TEXT("RotationConst"),
+		TEXT("TransformConst"), TEXT("StructConst"), TEXT("InstanceDelegate"), TEXT("SoftObjectConst"), TEXT("NoObject"), TEXT("ObjectConst"),
+		TEXT("NoInterface"), TEXT("ArrayConst"), TEXT("SetConst"), TEXT("MapConst")
+	};
+	return InstructionNames;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeTransformerInstructionLookupTest, "AssetGenerator.KismetBytecodeTransformer.InstructionLookup", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeTransformerInstructionLookupTest::RunTest(const FString& Parameters) {
+	const TArray<FString>& InstructionNames = GetKismetInstructionNames();
+	TestEqual(TEXT("Every instruction has a name"), InstructionNames.Num(), (int32) EKismetInstruction::MapConst);
+
+	for (int32 i = 0; i < InstructionNames.Num(); i++) {
+		const EKismetInstruction ExpectedInstruction = (EKismetInstruction) (i + 1);
+		TestTrue(FString::Printf(TEXT("Instruction %s resolves to its own entry"), *InstructionNames[i]), FKismetBytecodeTransformer::FindInstructionByName(InstructionNames[i]) == ExpectedInstruction);
+
+		//Names used to be compared with FString::operator==, which ignores case, so lookups keep ignoring it too
+		TestTrue(FString::Printf(TEXT("Instruction %s is resolved ignoring case"), *InstructionNames[i]), FKismetBytecodeTransformer::FindInstructionByName(InstructionNames[i].ToUpper()) == ExpectedInstruction);
+	}
+
+	//Names that did not match any of the compared strings before still hit the unsupported instruction checks
+	for (const TCHAR* UnknownName : {TEXT(""), TEXT("Unknown"), TEXT("IntConst "), TEXT("EX_IntConst"), TEXT("Tracepoint"), TEXT("WireTracepoint")}) {
+		TestTrue(FString::Printf(TEXT("Instruction '%s' is unknown"), UnknownName), FKismetBytecodeTransformer::FindInstructionByName(UnknownName) == EKismetInstruction::Unknown);
+	}
+	return true;
+}
+
+/** Creates disassembled expression with the provided instruction and a single value field */
+static TSharedPtr<FJsonObject> MakeValueExpressionObject(const TCHAR* Instruction, const TCHAR* FieldName, const TCHAR* Value) {
+	const TSharedPtr<FJsonObject> ExpressionObject = MakeShareable(new FJsonObject());
+	ExpressionObject->SetStringField(TEXT("Inst"), Instruction);
+	if (FieldName != NULL) {
+		ExpressionObject->SetStringField(FieldName, Value);
+	}
+	return ExpressionObject;
+}
+
+/** Creates disassembled expression with the provided instruction and numeric fields */
+static TSharedPtr<FJsonObject> MakeNumberExpressionObject(const TCHAR* Instruction, const TMap<FString, double>& Fields) {
+	const TSharedPtr<FJsonObject> ExpressionObject = MakeShareable(new FJsonObject());
+	ExpressionObject->SetStringField(TEXT("Inst"), Instruction);
+	for (const TPair<FString, double>& Field : Fields) {
+		ExpressionObject->SetNumberField(Field.Key, Field.Value);
+	}
+	return ExpressionObject;
+}
+
+/** Creates disassembled computed jump statement, which is the simplest statement transforming an arbitrary expression into a terminal */
+static TSharedPtr<FJsonObject> MakeComputedJumpStatementObject(const int32 StatementOffset, const TSharedPtr<FJsonObject>& Expression) {
+	const TSharedPtr<FJsonObject> StatementObject = MakeStatementObject(TEXT("ComputedJump"), StatementOffset);
+	StatementObject->SetObjectField(TEXT("Expression"), Expression);
+	return StatementObject;
+}
+
+/** Renders terminal into the canonical text form used by golden output comparisons, including it's context chain */
+static FString RenderTerminal(const TSharedPtr<FKismetTerminal>& Terminal) {
+	if (!Terminal.IsValid()) {
+		return TEXT("<none>");
+	}
+	const UObject* SubCategoryObject = Terminal->Type.PinSubCategoryObject.Get();
+	FString Result = FString::Printf(TEXT("%s%s|%s|%s|%s|%s"),
+		Terminal->bIsLiteral ? TEXT("Literal:") : TEXT("Term:"),
+		*Terminal->Type.PinCategory.ToString(),
+		*Terminal->Type.PinSubCategory.ToString(),
+		SubCategoryObject ? *SubCategoryObject->GetName() : TEXT(""),
+		*Terminal->StringLiteral,
+		Terminal->ObjectLiteral ? *Terminal->ObjectLiteral->GetPathName() : TEXT(""));
+
+	if (Terminal->Context.IsValid()) {
+		Result += FString::Printf(TEXT(" in %d(%s)"), (int32) Terminal->Context->ContextType, *RenderTerminal(Terminal->Context));
+	}
+	return Result;
+}
+
+/** Renders statement into the canonical text form used by golden output comparisons */
+static FString RenderStatement(const TSharedPtr<FKismetCompiledStatement>& Statement) {
+	FString Result = FString::Printf(TEXT("%d"), (int32) Statement->Type);
+	if (Statement->FunctionToCall != NULL) {
+		Result += FString::Printf(TEXT(" %s"), *Statement->FunctionToCall->GetName());
+	}
+	if (Statement->LHS.IsValid()) {
+		Result += FString::Printf(TEXT(" LHS=%s"), *RenderTerminal(Statement->LHS));
+	}
+	for (const TSharedPtr<FKismetTerminal>& Terminal : Statement->RHS) {
+		Result += FString::Printf(TEXT(" RHS=%s"), *RenderTerminal(Terminal));
+	}
+	return Result;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeTransformerGoldenOutputTest, "AssetGenerator.KismetBytecodeTransformer.GoldenOutput", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeTransformerGoldenOutputTest::RunTest(const FString& Parameters) {
+	UBlueprint* Blueprint = NewObject<UBlueprint>(GetTransientPackage(), NAME_None, RF_Transient);
+	const TCHAR* SystemLibraryObjectPath = TEXT("/Script/Engine.Default__KismetSystemLibrary");
+	const FString ComputedGoto = FString::FromInt((int32) ECompiledStatementType::KCST_ComputedGoto);
+
+	//Pairs of the disassembled statement and it's canonical form, as produced by the transformer comparing instruction names as strings
+	TArray<TPair<TSharedPtr<FJsonObject>, FString>> GoldenStatements;
+	auto AddLiteralStatement = [&](const TSharedPtr<FJsonObject>& Expression, const FString& ExpectedTerminal) {
+		const int32 StatementOffset = GoldenStatements.Num() * 10;
+		GoldenStatements.Emplace(MakeComputedJumpStatementObject(StatementOffset, Expression), ComputedGoto + TEXT(" LHS=") + ExpectedTerminal);
+	};
+
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("Self"), NULL, NULL), TEXT("Literal:object|self|||"));
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("StringConst"), TEXT("Value"), TEXT("Say \"hi\"")), TEXT("Literal:string||||Say \"hi\""));
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("UnicodeStringConst"), TEXT("Value"), TEXT("\u00DCber")), TEXT("Literal:string||||\u00DCber"));
+	AddLiteralStatement(MakeNumberExpressionObject(TEXT("FloatConst"), {{TEXT("Value"), 1.5}}), TEXT("Literal:float||||1.500000"));
+	AddLiteralStatement(MakeNumberExpressionObject(TEXT("IntConst"), {{TEXT("Value"), -7}}), TEXT("Literal:int||||-7"));
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("Int64Const"), TEXT("Value"), TEXT("-9007199254740993")), TEXT("Literal:int64||||-9007199254740993"));
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("UInt64Const"), TEXT("Value"), TEXT("18446744073709551615")), TEXT("Literal:int64||||18446744073709551615"));
+	AddLiteralStatement(MakeNumberExpressionObject(TEXT("ByteConst"), {{TEXT("Value"), 200}}), TEXT("Literal:byte||||200"));
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("False"), NULL, NULL), TEXT("Literal:bool||||0"));
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("True"), NULL, NULL), TEXT("Literal:bool||||1"));
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("NameConst"), TEXT("Value"), TEXT("SomeName")), TEXT("Literal:name||||SomeName"));
+	AddLiteralStatement(MakeNumberExpressionObject(TEXT("VectorConst"), {{TEXT("X"), 1}, {TEXT("Y"), 2}, {TEXT("Z"), 3}}), TEXT("Literal:struct||Vector|(X=1.000000,Y=2.000000,Z=3.000000)|"));
+	AddLiteralStatement(MakeNumberExpressionObject(TEXT("RotationConst"), {{TEXT("Pitch"), 10}, {TEXT("Yaw"), 20}, {TEXT("Roll"), 30}}), TEXT("Literal:struct||Rotator|(Pitch=10.000000,Yaw=20.000000,Roll=30.000000)|"));
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("InstanceDelegate"), TEXT("FunctionName"), TEXT("OnFired")), TEXT("Literal:delegate||||OnFired"));
+	AddLiteralStatement(MakeValueExpressionObject(TEXT("NoObject"), NULL, NULL), TEXT("Literal:object||Object|None|"));
+	AddLiteralStatement(MakeObjectConstObject(SystemLibraryObjectPath), FString::Printf(TEXT("Literal:object||KismetSystemLibrary|KismetSystemLibrary'%s'|%s"), SystemLibraryObjectPath, SystemLibraryObjectPath));
+
+	const TSharedPtr<FJsonObject> SoftObjectExpression = MakeValueExpressionObject(TEXT("SoftObjectConst"), NULL, NULL);
+	SoftObjectExpression->SetObjectField(TEXT("Value"), MakeValueExpressionObject(TEXT("StringConst"), TEXT("Value"), TEXT("")));
+	AddLiteralStatement(SoftObjectExpression, TEXT("Literal:softobject||Object||"));
+
+	//Literals inside of the object and class contexts, the context terminal is copied with it's context type set
+	const TSharedPtr<FJsonObject> ContextExpression = MakeValueExpressionObject(TEXT("Context"), NULL, NULL);
+	ContextExpression->SetObjectField(TEXT("Context"), MakeValueExpressionObject(TEXT("Self"), NULL, NULL));
+	ContextExpression->SetObjectField(TEXT("Expression"), MakeValueExpressionObject(TEXT("NameConst"), TEXT("Value"), TEXT("Inner")));
+	AddLiteralStatement(ContextExpression, FString::Printf(TEXT("Literal:name||||Inner in %d(Literal:object|self|||)"), (int32) FKismetTerminal::EContextType_Object));
+
+	const TSharedPtr<FJsonObject> ClassContextExpression = MakeValueExpressionObject(TEXT("ClassContext"), NULL, NULL);
+	ClassContextExpression->SetObjectField(TEXT("Context"), MakeObjectConstObject(SystemLibraryObjectPath));
+	ClassContextExpression->SetObjectField(TEXT("Expression"), MakeValueExpressionObject(TEXT("True"), NULL, NULL));
+	AddLiteralStatement(ClassContextExpression, FString::Printf(TEXT("Literal:bool||||1 in %d(Literal:object||KismetSystemLibrary|KismetSystemLibrary'%s'|%s)"), (int32) FKismetTerminal::EContextType_Class, SystemLibraryObjectPath, SystemLibraryObjectPath));
+
+	//Statements without expressions, conditional statements and function calls
+	GoldenStatements.Emplace(MakeStatementObject(TEXT("Nothing"), GoldenStatements.Num() * 10), FString::FromInt((int32) ECompiledStatementType::KCST_Nop));
+	const TSharedPtr<FJsonObject> PopFlowObject = MakeStatementObject(TEXT("PopExecutionFlowIfNot"), GoldenStatements.Num() * 10);
+	PopFlowObject->SetObjectField(TEXT("Condition"), MakeValueExpressionObject(TEXT("False"), NULL, NULL));
+	GoldenStatements.Emplace(PopFlowObject, FString::Printf(TEXT("%d LHS=Literal:bool||||0"), (int32) ECompiledStatementType::KCST_EndOfThreadIfNot));
+	GoldenStatements.Emplace(MakeCallMathStatementObject(GoldenStatements.Num() * 10, TEXT("/Script/Engine.KismetMathLibrary"), TEXT("Add_IntInt"), {MakeIntConstObject(2), MakeIntConstObject(3)}),
+		FString::Printf(TEXT("%d Add_IntInt RHS=Literal:int||||2 RHS=Literal:int||||3"), (int32) ECompiledStatementType::KCST_CallFunction));
+	GoldenStatements.Emplace(MakeStatementObject(TEXT("PopExecutionFlow"), GoldenStatements.Num() * 10), FString::FromInt((int32) ECompiledStatementType::KCST_EndOfThread));
+	GoldenStatements.Emplace(MakeStatementObject(TEXT("Return"), GoldenStatements.Num() * 10), FString::FromInt((int32) ECompiledStatementType::KCST_Return));
+
+	TArray<TSharedPtr<FJsonObject>> StatementObjects;
+	for (const TPair<TSharedPtr<FJsonObject>, FString>& GoldenStatement : GoldenStatements) {
+		StatementObjects.Add(GoldenStatement.Key);
+	}
+
+	//Output should not depend on literal interning either, so both transformer configurations are compared against the same golden output
+	for (const bool bInternLiterals : {true, false}) {
+		FKismetBytecodeTransformer Transformer(Blueprint);
+		Transformer.SetLiteralInterningEnabled(bInternLiterals);
+		Transformer.SetSourceStatements(TEXT("TestFunction"), StatementObjects);
+		const TArray<TSharedPtr<FKismetCompiledStatement>> Statements = Transformer.FinishGeneration();
+
+		if (Statements.Num() != GoldenStatements.Num()) {
+			AddError(FString::Printf(TEXT("Transformer produced %d statements instead of %d"), Statements.Num(), GoldenStatements.Num()));
+			return false;
+		}
+		for (int32 i = 0; i < Statements.Num(); i++) {
+			TestEqual(FString::Printf(TEXT("Statement %s (interning %d)"), *GoldenStatements[i].Key->GetStringField(TEXT("Inst")), bInternLiterals), RenderStatement(Statements[i]), GoldenStatements[i].Value);
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeTransformerNoInterfaceLiteralTest, "AssetGenerator.KismetBytecodeTransformer.NoInterfaceLiteral", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeTransformerNoInterfaceLiteralTest::RunTest(const FString& Parameters) {
+	UBlueprint* Blueprint = NewObject<UBlueprint>(GetTransientPackage(), NAME_None, RF_Transient);
+
+	//NoInterface used to fall through into the unsupported literal check, now it produces NULL interface literal like NoObject does for objects
+	TArray<TSharedPtr<FJsonObject>> StatementObjects;
+	StatementObjects.Add(MakeComputedJumpStatementObject(0, MakeValueExpressionObject(TEXT("NoInterface"), NULL, NULL)));
+	StatementObjects.Add(MakeComputedJumpStatementObject(10, MakeValueExpressionObject(TEXT("NoInterface"), NULL, NULL)));
+	StatementObjects.Add(MakeStatementObject(TEXT("Return"), 20));
+
+	FKismetBytecodeTransformer Transformer(Blueprint);
+	Transformer.SetSourceStatements(TEXT("TestFunction"), StatementObjects);
+	const TArray<TSharedPtr<FKismetCompiledStatement>> Statements = Transformer.FinishGeneration();
+
+	if (Statements.Num() != 3 || !Statements[0]->LHS.IsValid()) {
+		AddError(TEXT("NoInterface literal was not transformed into a terminal"));
+		return false;
+	}
+	const TSharedPtr<FKismetTerminal>& InterfaceLiteral = Statements[0]->LHS;
+	TestTrue(TEXT("Terminal is a literal"), InterfaceLiteral->bIsLiteral);
+	TestEqual(TEXT("Pin category"), InterfaceLiteral->Type.PinCategory, UEdGraphSchema_K2::PC_Interface);
+	TestNull(TEXT("Object literal"), InterfaceLiteral->ObjectLiteral);
+	TestEqual(TEXT("String literal"), InterfaceLiteral->StringLiteral, FString(TEXT("None")));
+	TestTrue(TEXT("Repeated NoInterface literals are shared"), Statements[0]->LHS == Statements[1]->LHS);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeTransformerDispatchBenchmark, "AssetGenerator.KismetBytecodeTransformer.InstructionDispatchBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FKismetBytecodeTransformerDispatchBenchmark::RunTest(const FString& Parameters) {
+	const TArray<FString>& InstructionNames = GetKismetInstructionNames();
+	const int32 NumLookups = 1000000;
+
+	//Baseline is the previous dispatch, which compared instruction name against every known name until one matched
+	int32 LinearMatches = 0;
+	const double LinearStartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumLookups; i++) {
+		const FString& InstructionName = InstructionNames[i % InstructionNames.Num()];
+		for (int32 NameIndex = 0; NameIndex < InstructionNames.Num(); NameIndex++) {
+			if (InstructionName == InstructionNames[NameIndex]) {
+				LinearMatches += NameIndex + 1;
+				break;
+			}
+		}
+	}
+	const double LinearTime = FPlatformTime::Seconds() - LinearStartTime;
+
+	int32 TableMatches = 0;
+	const double TableStartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumLookups; i++) {
+		TableMatches += (int32) FKismetBytecodeTransformer::FindInstructionByName(InstructionNames[i % InstructionNames.Num()]);
+	}
+	const double TableTime = FPlatformTime::Seconds() - TableStartTime;
+
+	TestEqual(TEXT("Both dispatches resolve the same instructions"), TableMatches, LinearMatches);
+	AddInfo(FString::Printf(TEXT("%d instruction lookups: string comparison chain %.2fms, lookup table %.2fms"), NumLookups, LinearTime * 1000.0, TableTime * 1000.0));
+
+	//End-to-end transformation of a large function made of calls and conditional jumps with literal operands
+	UBlueprint* Blueprint = NewObject<UBlueprint>(GetTransientPackage(), NAME_None, RF_Transient);
+	const int32 NumStatements = 20000;
+	TArray<TSharedPtr<FJsonObject>> StatementObjects;
+	for (int32 i = 0; i < NumStatements - 1; i++) {
+		if (i % 2 == 0) {
+			StatementObjects.Add(MakeCallMathStatementObject(i * 10, TEXT("/Script/Engine.KismetMathLibrary"), TEXT("Add_IntInt"), {MakeIntConstObject(i % 64), MakeIntConstObject(i)}));
+		}
+		else {
+			const TSharedPtr<FJsonObject> JumpObject = MakeStatementObject(TEXT("JumpIfNot"), i * 10);
+			JumpObject->SetObjectField(TEXT("Condition"), MakeValueExpressionObject(i % 4 == 1 ? TEXT("True") : TEXT("False"), NULL, NULL));
+			JumpObject->SetNumberField(TEXT("Offset"), (NumStatements - 1) * 10);
+			StatementObjects.Add(JumpObject);
+		}
+	}
+	StatementObjects.Add(MakeStatementObject(TEXT("Return"), (NumStatements - 1) * 10));
+
+	const double TransformStartTime = FPlatformTime::Seconds();
+	FKismetBytecodeTransformer Transformer(Blueprint);
+	Transformer.SetSourceStatements(TEXT("TestFunction"), StatementObjects);
+	const TArray<TSharedPtr<FKismetCompiledStatement>> Statements = Transformer.FinishGeneration();
+	const double TransformTime = FPlatformTime::Seconds() - TransformStartTime;
+
+	TestEqual(TEXT("Statements transformed"), Statements.Num(), NumStatements);
+	AddInfo(FString::Printf(TEXT("Transformed %d statements in %.2fms"), NumStatements, TransformTime * 1000.0));
+	return true;
+}
+
+/** Estimates memory held by the distinct literal terminals referenced by the statements, shared terminals are only counted once */
+static SIZE_T CountLiteralTerminalBytes(const TArray<TSharedPtr<FKismetCompiledStatement>>& Statements, int32& OutNumTerminals) {
+	TSet<const FKismetTerminal*> VisitedTerminals;
+	SIZE_T TerminalBytes = 0;
+	auto VisitTerminal = [&](const TSharedPtr<FKismetTerminal>& Terminal) {
+		if (Terminal.IsValid() && Terminal->bIsLiteral && !VisitedTerminals.Contains(Terminal.Get())) {
+			VisitedTerminals.Add(Terminal.Get());
+			TerminalBytes += sizeof(FKismetTerminal) + Terminal->StringLiteral.GetAllocatedSize();
+		}
+	};
+	for (const TSharedPtr<FKismetCompiledStatement>& Statement : Statements) {
+		VisitTerminal(Statement->FunctionContext);
+		VisitTerminal(Statement->LHS);
+		for (const TSharedPtr<FKismetTerminal>& Terminal : Statement->RHS) {
+			VisitTerminal(Terminal);
+		}
+	}
+	OutNumTerminals = VisitedTerminals.Num();
+	return TerminalBytes;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeTransformerLiteralInterningBenchmark, "AssetGenerator.KismetBytecodeTransformer.LiteralInterningBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FKismetBytecodeTransformerLiteralInterningBenchmark::RunTest(const FString& Parameters) {
+	UBlueprint* Blueprint = NewObject<UBlueprint>(GetTransientPackage(), NAME_None, RF_Transient);
+	const int32 NumStatements = 30000;
+
+	//Function made almost entirely of literals: integer math with a small set of operands, string and float constants and a repeated object reference
+	TArray<TSharedPtr<FJsonObject>> StatementObjects;
+	for (int32 i = 0; i < NumStatements - 1; i++) {
+		const int32 StatementOffset = i * 10;
+		const int32 LiteralIndex = i / 4;
+		switch (i % 4) {
+		case 0:
+			StatementObjects.Add(MakeCallMathStatementObject(StatementOffset, TEXT("/Script/Engine.KismetMathLibrary"), TEXT("Add_IntInt"), {MakeIntConstObject(LiteralIndex % 256), MakeIntConstObject(LiteralIndex % 16)}));
+			break;
+		case 1:
+			StatementObjects.Add(MakeComputedJumpStatementObject(StatementOffset, MakeValueExpressionObject(TEXT("StringConst"), TEXT("Value"), *FString::Printf(TEXT("Literal string %d"), LiteralIndex % 128))));
+			break;
+		case 2:
+			StatementObjects.Add(MakeComputedJumpStatementObject(StatementOffset, MakeNumberExpressionObject(TEXT("FloatConst"), {{TEXT("Value"), (LiteralIndex % 64) * 0.5}})));
+			break;
+		default:
+			StatementObjects.Add(MakeComputedJumpStatementObject(StatementOffset, MakeObjectConstObject(TEXT("/Script/Engine.Default__KismetSystemLibrary"))));
+			break;
+		}
+	}
+	StatementObjects.Add(MakeStatementObject(TEXT("Return"), (NumStatements - 1) * 10));
+
+	TArray<TSharedPtr<FKismetCompiledStatement>> ResultStatements[2];
+	for (const bool bInternLiterals : {false, true}) {
+		const double StartTime = FPlatformTime::Seconds();
+		FKismetBytecodeTransformer Transformer(Blueprint);
+		Transformer.SetLiteralInterningEnabled(bInternLiterals);
+		Transformer.SetSourceStatements(TEXT("TestFunction"), StatementObjects);
+		ResultStatements[bInternLiterals] = Transformer.FinishGeneration();
+		const double TransformTime = FPlatformTime::Seconds() - StartTime;
+
+		int32 NumTerminals = 0;
+		const SIZE_T TerminalBytes = CountLiteralTerminalBytes(ResultStatements[bInternLiterals], NumTerminals);
+		AddInfo(FString::Printf(TEXT("Interning %s: transformed %d statements in %.2fms, %d literal terminals taking %.1fKB"),
+			bInternLiterals ? TEXT("enabled") : TEXT("disabled"), NumStatements, TransformTime * 1000.0, NumTerminals, TerminalBytes / 1024.0));
+	}
+
+	const TArray<TSharedPtr<FKismetCompiledStatement>>& ReferenceStatements = ResultStatements[0];
+	const TArray<TSharedPtr<FKismetCompiledStatement>>& InternedStatements = ResultStatements[1];
+	if (InternedStatements.Num() != ReferenceStatements.Num()) {
+		AddError(FString::Printf(TEXT("Interning transformer produced %d statements, reference one produced %d"), InternedStatements.Num(), ReferenceStatements.Num()));
+		return false;
+	}
+	int32 NumMismatchedStatements = 0;
+	for (int32 i = 0; i < InternedStatements.Num(); i++) {
+		if (!AreStatementsEquivalent(InternedStatements, ReferenceStatements, i)) {
+			NumMismatchedStatements++;
+		}
+	}
+	TestEqual(TEXT("Statements different from the ones produced without interning"), NumMismatchedStatements, 0);
+
+	//Second integer operands are a subset of the first ones, so there are 256 distinct integers, 128 strings, 64 floats and a single object
+	int32 NumInternedTerminals = 0;
+	CountLiteralTerminalBytes(InternedStatements, NumInternedTerminals);
+	TestEqual(TEXT("Distinct literal terminals"), NumInternedTerminals, 256 + 128 + 64 + 1);
+	return true;
+}
+
+#endif
@@ -0,0 +1,198 @@
+#include "AssetGeneration/KismetGraphDecompiler.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Creates local variable terminal, terminals with different variable names are structurally different */
+static TSharedPtr<FKismetTerminal> MakeVariableTerminal(const TCHAR* VariableName) {
+	TSharedPtr<FKismetTerminal> Terminal = MakeShareable(new FKismetTerminal());
+	Terminal->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+	Terminal->AssociatedVarProperty = VariableName;
+	Terminal->VarType = FKismetTerminal::EVarType_Local;
+	return Terminal;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetGraphDecompilerPassThroughTest, "AssetGenerator.KismetGraphDecompiler.PassThroughTerminals", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetGraphDecompilerPassThroughTest::RunTest(const FString& Parameters) {
+	const TSharedPtr<FKismetTerminal> First = MakeVariableTerminal(TEXT("First"));
+	const TSharedPtr<FKismetTerminal> Second = MakeVariableTerminal(TEXT("Second"));
+	const TSharedPtr<FKismetTerminal> Third = MakeVariableTerminal(TEXT("Third"));
+	const TSharedPtr<FKismetTerminal> Unrelated = MakeVariableTerminal(TEXT("Unrelated"));
+
+	TMap<FKismetTerminalAsKeyType, TSharedPtr<FKismetTerminal>> PassThroughTerminals;
+	PassThroughTerminals.Add(First, Second);
+	PassThroughTerminals.Add(Second, Third);
+
+	TestTrue(TEXT("Chain is followed to the last terminal"), FKismetGraphDecompiler::ResolvePassThroughTerminal(PassThroughTerminals, First) == Third);
+	TestTrue(TEXT("Structurally equal terminal follows the same chain"), FKismetGraphDecompiler::ResolvePassThroughTerminal(PassThroughTerminals, MakeVariableTerminal(TEXT("Second"))) == Third);
+	TestTrue(TEXT("Terminal without pass-through resolves to itself"), FKismetGraphDecompiler::ResolvePassThroughTerminal(PassThroughTerminals, Unrelated) == Unrelated);
+
+	//Corrupted statements could make terminals pass through to each other, which should not hang the decompiler
+	PassThroughTerminals.Add(Third, First);
+	TestFalse(TEXT("Cycle is detected"), FKismetGraphDecompiler::ResolvePassThroughTerminal(PassThroughTerminals, First).IsValid());
+	TestFalse(TEXT("Cycle is detected when entering it from the middle"), FKismetGraphDecompiler::ResolvePassThroughTerminal(PassThroughTerminals, Second).IsValid());
+
+	TMap<FKismetTerminalAsKeyType, TSharedPtr<FKismetTerminal>> SelfPassThroughTerminals;
+	SelfPassThroughTerminals.Add(First, First);
+	TestFalse(TEXT("Terminal passing through to itself is detected"), FKismetGraphDecompiler::ResolvePassThroughTerminal(SelfPassThroughTerminals, First).IsValid());
+	return true;
+}
+
+/**
+ * Builds statements of a chain of impure casts, every cast taking the result of the previous one and jumping to the return statement on failure
+ * Every cast produces 3 statements, followed by a nop and the return statement, so the chain has both execution and data links
+ */
+static TArray<TSharedPtr<FKismetCompiledStatement>> MakeCastChainStatements(const int32 NumCasts) {
+	const TSharedPtr<FKismetCompiledStatement> ReturnStatement = MakeShareable(new FKismetCompiledStatement());
+	ReturnStatement->Type = ECompiledStatementType::KCST_Return;
+
+	const TSharedPtr<FKismetTerminal> ClassTerminal = MakeShareable(new FKismetTerminal());
+	ClassTerminal->Type.PinCategory = UEdGraphSchema_K2::PC_Class;
+	ClassTerminal->bIsLiteral = true;
+	ClassTerminal->ObjectLiteral = AActor::StaticClass();
+
+	TArray<TSharedPtr<FKismetCompiledStatement>> Statements;
+	TSharedPtr<FKismetTerminal> InputTerminal = MakeVariableTerminal(TEXT("Input"));
+	for (int32 i = 0; i < NumCasts; i++) {
+		const TSharedPtr<FKismetTerminal> CastResultTerminal = MakeVariableTerminal(*FString::Printf(TEXT("K2Node_DynamicCast_AsActor_%d"), i));
+		const TSharedPtr<FKismetTerminal> CastSuccessTerminal = MakeVariableTerminal(*FString::Printf(TEXT("K2Node_DynamicCast_bSuccess_%d"), i));
+
+		const TSharedPtr<FKismetCompiledStatement> CastStatement = MakeShareable(new FKismetCompiledStatement());
+		CastStatement->Type = ECompiledStatementType::KCST_DynamicCast;
+		CastStatement->LHS = CastResultTerminal;
+		CastStatement->RHS = {ClassTerminal, InputTerminal};
+
+		const TSharedPtr<FKismetCompiledStatement> ObjectToBoolStatement = MakeShareable(new FKismetCompiledStatement());
+		ObjectToBoolStatement->Type = ECompiledStatementType::KCST_ObjectToBool;
+		ObjectToBoolStatement->LHS = CastSuccessTerminal;
+		ObjectToBoolStatement->RHS = {CastResultTerminal};
+
+		const TSharedPtr<FKismetCompiledStatement> GotoIfNotStatement = MakeShareable(new FKismetCompiledStatement());
+		GotoIfNotStatement->Type = ECompiledStatementType::KCST_GotoIfNot;
+		GotoIfNotStatement->LHS = CastSuccessTerminal;
+		GotoIfNotStatement->TargetLabel = ReturnStatement;
+
+		Statements.Append({CastStatement, ObjectToBoolStatement, GotoIfNotStatement});
+		InputTerminal = CastResultTerminal;
+	}
+
+	const TSharedPtr<FKismetCompiledStatement> NopStatement = MakeShareable(new FKismetCompiledStatement());
+	NopStatement->Type = ECompiledStatementType::KCST_Nop;
+	Statements.Append({NopStatement, ReturnStatement});
+	return Statements;
+}
+
+static UBlueprint* CreateDecompilerTestBlueprint() {
+	const FName BlueprintName = MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("KismetGraphDecompilerTest"));
+	return FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), GetTransientPackage(), BlueprintName, BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+}
+
+/** Decompiles cast chain into a new graph of the blueprint, either in a batch or through the schema, and returns the graph along with the time it took */
+static UEdGraph* DecompileCastChain(UBlueprint* Blueprint, const int32 NumCasts, const bool bBatchNodeGeneration, double& OutElapsedTime) {
+	const FName GraphName = MakeUniqueObjectName(Blueprint, UEdGraph::StaticClass(), TEXT("CastChain"));
+	UEdGraph* Graph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, GraphName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+	UFunction* Function = NewObject<UFunction>(GetTransientPackage(), NAME_None, RF_Transient);
+	const TArray<TSharedPtr<FKismetCompiledStatement>> Statements = MakeCastChainStatements(NumCasts);
+
+	const double StartTime = FPlatformTime::Seconds();
+	FKismetGraphDecompiler GraphDecompiler(Function, Graph);
+	GraphDecompiler.SetBatchedNodeGenerationEnabled(bBatchNodeGeneration);
+	GraphDecompiler.Initialize(Statements);
+	GraphDecompiler.GenerateNodes();
+	OutElapsedTime = FPlatformTime::Seconds() - StartTime;
+	return Graph;
+}
+
+/** Describes node classes, positions, pins and links between them, so graphs can be compared independently of the node objects */
+static TArray<FString> DescribeGraphTopology(const UEdGraph* Graph) {
+	TArray<FString> Lines;
+	for (int32 NodeIndex = 0; NodeIndex < Graph->Nodes.Num(); NodeIndex++) {
+		const UEdGraphNode* Node = Graph->Nodes[NodeIndex];
+		Lines.Add(FString::Printf(TEXT("%d %s at %d,%d"), NodeIndex, *Node->GetClass()->GetName(), Node->NodePosX, Node->NodePosY));
+
+		for (const UEdGraphPin* Pin : Node->Pins) {
+			TArray<FString> LinkedPins;
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo) {
+				LinkedPins.Add(FString::Printf(TEXT("%d.%s"), Graph->Nodes.IndexOfByKey(LinkedPin->GetOwningNode()), *LinkedPin->PinName.ToString()));
+			}
+			LinkedPins.Sort();
+			Lines.Add(FString::Printf(TEXT("%d.%s %s -> %s"), NodeIndex, *Pin->PinName.ToString(), *Pin->PinType.PinCategory.ToString(), *FString::Join(LinkedPins, TEXT(", "))));
+		}
+	}
+	return Lines;
+}
+
+/** Returns number of pin links in the graph, every link is counted once */
+static int32 CountGraphLinks(const UEdGraph* Graph) {
+	int32 NumLinks = 0;
+	for (const UEdGraphNode* Node : Graph->Nodes) {
+		for (const UEdGraphPin* Pin : Node->Pins) {
+			NumLinks += Pin->Direction == EGPD_Output ? Pin->LinkedTo.Num() : 0;
+		}
+	}
+	return NumLinks;
+}
+
+/** Compares topology of the graphs generated in a batch and through the schema, reporting the first difference */
+static bool TestGraphTopologyEqual(FAutomationTestBase& Test, const UEdGraph* BatchedGraph, const UEdGraph* SchemaGraph) {
+	const TArray<FString> BatchedTopology = DescribeGraphTopology(BatchedGraph);
+	const TArray<FString> SchemaTopology = DescribeGraphTopology(SchemaGraph);
+
+	for (int32 i = 0; i < FMath::Min(BatchedTopology.Num(), SchemaTopology.Num()); i++) {
+		if (!BatchedTopology[i].Equals(SchemaTopology[i], ESearchCase::CaseSensitive)) {
+			Test.AddError(FString::Printf(TEXT("Batched graph differs from the schema one: '%s' instead of '%s'"), *BatchedTopology[i], *SchemaTopology[i]));
+			return false;
+		}
+	}
+	return Test.TestEqual(TEXT("Graph description length"), BatchedTopology.Num(), SchemaTopology.Num());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetGraphDecompilerTopologyTest, "AssetGenerator.KismetGraphDecompiler.BatchedTopology", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetGraphDecompilerTopologyTest::RunTest(const FString& Parameters) {
+	const int32 NumCasts = 64;
+	UBlueprint* Blueprint = CreateDecompilerTestBlueprint();
+
+	double ElapsedTime;
+	const UEdGraph* BatchedGraph = DecompileCastChain(Blueprint, NumCasts, true, ElapsedTime);
+	const UEdGraph* SchemaGraph = DecompileCastChain(Blueprint, NumCasts, false, ElapsedTime);
+
+	//Every cast is linked to the previous one with the execution and the object pin, and nop and return statements do not produce nodes
+	TestEqual(TEXT("Node per cast"), BatchedGraph->Nodes.Num(), NumCasts);
+	TestEqual(TEXT("Execution and data link between every pair of casts"), CountGraphLinks(BatchedGraph), (NumCasts - 1) * 2);
+
+	//Node positions are compared too, since batched generation computes them without GetGoodPlaceForNewNode
+	TestGraphTopologyEqual(*this, BatchedGraph, SchemaGraph);
+
+	Blueprint->ClearFlags(RF_Public | RF_Standalone);
+	Blueprint->SetFlags(RF_Transient);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetGraphDecompilerBenchmark, "AssetGenerator.KismetGraphDecompiler.NodeGenerationBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FKismetGraphDecompilerBenchmark::RunTest(const FString& Parameters) {
+	//Cast chain of 5000 statements, 3 statements for every cast plus the trailing nop and return
+	const int32 NumCasts = (5000 - 2) / 3;
+	UBlueprint* Blueprint = CreateDecompilerTestBlueprint();
+
+	double BatchedTime;
+	double SchemaTime;
+	const UEdGraph* BatchedGraph = DecompileCastChain(Blueprint, NumCasts, true, BatchedTime);
+	const UEdGraph* SchemaGraph = DecompileCastChain(Blueprint, NumCasts, false, SchemaTime);
+
+	TestGraphTopologyEqual(*this, BatchedGraph, SchemaGraph);
+	AddInfo(FString::Printf(TEXT("Decompiled %d statements into %d nodes in %.2f ms batched and %.2f ms through the schema (%.2fx)"),
+		NumCasts * 3 + 2, BatchedGraph->Nodes.Num(), BatchedTime * 1000.0, SchemaTime * 1000.0, SchemaTime / FMath::Max(BatchedTime, SMALL_NUMBER)));
+
+	Blueprint->ClearFlags(RF_Public | RF_Standalone);
+	Blueprint->SetFlags(RF_Transient);
+	return true;
+}
+
+#endif
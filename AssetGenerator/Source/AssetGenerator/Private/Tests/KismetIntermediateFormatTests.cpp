@@ -0,0 +1,219 @@
+#include "AssetGeneration/KismetIntermediateFormat.h"
+#include "EdGraphSchema_K2.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Creates literal terminal of the provided pin category and value */
+static TSharedPtr<FKismetTerminal> MakeLiteralTerminal(const FName PinCategory, const FString& Value) {
+	TSharedPtr<FKismetTerminal> Terminal = MakeShareable(new FKismetTerminal());
+	Terminal->bIsLiteral = true;
+	Terminal->Type.PinCategory = PinCategory;
+	Terminal->StringLiteral = Value;
+	return Terminal;
+}
+
+/** Creates variable terminal referencing the provided property, optionally inside of the context chain */
+static TSharedPtr<FKismetTerminal> MakeVariableTerminal(const FString& PropertyName, const TSharedPtr<FKismetTerminal>& Context) {
+	TSharedPtr<FKismetTerminal> Terminal = MakeShareable(new FKismetTerminal());
+	Terminal->Type.PinCategory = UEdGraphSchema_K2::PC_Object;
+	Terminal->Type.PinSubCategoryObject = UObject::StaticClass();
+	Terminal->AssociatedVarProperty = PropertyName;
+	Terminal->Context = Context;
+	return Terminal;
+}
+
+/** Creates a chain of nested object contexts of the provided depth, with every link being a separately allocated terminal */
+static TSharedPtr<FKismetTerminal> MakeContextChain(const int32 Depth, const FString& RootPropertyName) {
+	TSharedPtr<FKismetTerminal> Context;
+	for (int32 i = 0; i < Depth; i++) {
+		Context = MakeVariableTerminal(i == 0 ? RootPropertyName : FString::Printf(TEXT("Link%d"), i), Context);
+		Context->ContextType = FKismetTerminal::EContextType_Object;
+	}
+	return Context;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetTerminalHashStabilityTest, "AssetGenerator.KismetIntermediateFormat.HashStability", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetTerminalHashStabilityTest::RunTest(const FString& Parameters) {
+	const TSharedPtr<FKismetTerminal> Terminal = MakeVariableTerminal(TEXT("Target"), MakeContextChain(4, TEXT("Root")));
+	const uint32 InitialHash = GetTypeHash(*Terminal);
+
+	TestEqual(TEXT("Hash does not change between calls"), GetTypeHash(*Terminal), InitialHash);
+	TestEqual(TEXT("Copied terminal has the same hash"), GetTypeHash(FKismetTerminal(*Terminal)), InitialHash);
+
+	//Hash only depends on the terminal contents, not on where the terminal and its context chain are allocated
+	TArray<TSharedPtr<FKismetTerminal>> Allocations;
+	for (int32 i = 0; i < 16; i++) {
+		Allocations.Add(MakeVariableTerminal(TEXT("Target"), MakeContextChain(4, TEXT("Root"))));
+		TestEqual(FString::Printf(TEXT("Separately built terminal %d has the same hash"), i), GetTypeHash(*Allocations.Last()), InitialHash);
+	}
+
+	//Text literal is not hashed, so text terminals carrying the same exported form hash the same regardless of the text instance
+	const TSharedPtr<FKismetTerminal> FirstTextTerminal = MakeLiteralTerminal(UEdGraphSchema_K2::PC_Text, TEXT("INVTEXT(\"Hello\")"));
+	FirstTextTerminal->TextLiteral = FText::AsCultureInvariant(TEXT("Hello"));
+	const TSharedPtr<FKismetTerminal> SecondTextTerminal = MakeLiteralTerminal(UEdGraphSchema_K2::PC_Text, TEXT("INVTEXT(\"Hello\")"));
+	SecondTextTerminal->TextLiteral = FText::AsCultureInvariant(TEXT("Hello"));
+	TestTrue(TEXT("Text terminals are equal"), *FirstTextTerminal == *SecondTextTerminal);
+	TestEqual(TEXT("Text terminals have the same hash"), GetTypeHash(*FirstTextTerminal), GetTypeHash(*SecondTextTerminal));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetTerminalHashEqualityConsistencyTest, "AssetGenerator.KismetIntermediateFormat.HashEqualityConsistency", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetTerminalHashEqualityConsistencyTest::RunTest(const FString& Parameters) {
+	//Terminals that differ only somewhere down the context chain
+	TArray<TSharedPtr<FKismetTerminal>> Terminals;
+	for (int32 Depth = 1; Depth <= 6; Depth++) {
+		for (const TCHAR* RootName : {TEXT("Root"), TEXT("root"), TEXT("OtherRoot")}) {
+			Terminals.Add(MakeVariableTerminal(TEXT("Target"), MakeContextChain(Depth, RootName)));
+			Terminals.Add(MakeVariableTerminal(TEXT("Target"), MakeContextChain(Depth, RootName)));
+		}
+	}
+
+	//Same chain where the innermost link is a class context instead of an object one
+	const TSharedPtr<FKismetTerminal> ClassContextChain = MakeContextChain(3, TEXT("Root"));
+	TSharedPtr<FKismetTerminal> InnermostLink = ClassContextChain;
+	while (InnermostLink->Context.IsValid()) {
+		InnermostLink = InnermostLink->Context;
+	}
+	InnermostLink->ContextType = FKismetTerminal::EContextType_Class;
+	Terminals.Add(MakeVariableTerminal(TEXT("Target"), ClassContextChain));
+
+	//Literals differing by the case of the value, by pin category, and by object literal
+	for (const TCHAR* Value : {TEXT("Value"), TEXT("value"), TEXT("VALUE")}) {
+		Terminals.Add(MakeLiteralTerminal(UEdGraphSchema_K2::PC_String, Value));
+		Terminals.Add(MakeLiteralTerminal(UEdGraphSchema_K2::PC_Name, Value));
+	}
+	const TSharedPtr<FKismetTerminal> ObjectLiteral = MakeLiteralTerminal(UEdGraphSchema_K2::PC_Object, TEXT("None"));
+	ObjectLiteral->ObjectLiteral = UKismetSystemLibrary::StaticClass()->GetDefaultObject();
+	Terminals.Add(ObjectLiteral);
+	Terminals.Add(MakeLiteralTerminal(UEdGraphSchema_K2::PC_Object, TEXT("None")));
+
+	//Every pair of equal terminals must have equal hashes, and equality must be symmetric
+	int32 NumEqualPairs = 0;
+	for (int32 i = 0; i < Terminals.Num(); i++) {
+		for (int32 j = 0; j < Terminals.Num(); j++) {
+			const bool bAreEqual = *Terminals[i] == *Terminals[j];
+			if (bAreEqual != (*Terminals[j] == *Terminals[i])) {
+				AddError(FString::Printf(TEXT("Equality of terminals %d and %d is not symmetric"), i, j));
+			}
+			if (bAreEqual && GetTypeHash(*Terminals[i]) != GetTypeHash(*Terminals[j])) {
+				AddError(FString::Printf(TEXT("Equal terminals %d and %d have different hashes"), i, j));
+			}
+			if (bAreEqual && i != j) {
+				NumEqualPairs++;
+			}
+		}
+	}
+	//Only the separately built copies of each context chain are equal, in both orders
+	const int32 NumChainTerminals = 6 * 3 * 2;
+	TestEqual(TEXT("Number of equal terminal pairs"), NumEqualPairs, NumChainTerminals);
+
+	TestTrue(TEXT("Separately built chains are equal"), *Terminals[0] == *Terminals[1]);
+	TestFalse(TEXT("Chains differing only in the case of the root property are not equal"), *Terminals[0] == *Terminals[2]);
+	TestFalse(TEXT("Chains differing in the root property are not equal"), *Terminals[0] == *Terminals[4]);
+	TestFalse(TEXT("Chains differing in the innermost context type are not equal"), *MakeVariableTerminal(TEXT("Target"), MakeContextChain(3, TEXT("Root"))) == *Terminals[NumChainTerminals]);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetTerminalHashCollisionTest, "AssetGenerator.KismetIntermediateFormat.HashCollisions", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKismetTerminalHashCollisionTest::RunTest(const FString& Parameters) {
+	//Populations of distinct terminals shaped like the literals and variables found in real functions
+	TArray<TSharedPtr<FKismetTerminal>> Terminals;
+	for (int32 i = 0; i < 20000; i++) {
+		Terminals.Add(MakeLiteralTerminal(UEdGraphSchema_K2::PC_Int, FString::FromInt(i)));
+		Terminals.Add(MakeLiteralTerminal(UEdGraphSchema_K2::PC_Float, FString::Printf(TEXT("%f"), i * 0.25f)));
+		Terminals.Add(MakeLiteralTerminal(UEdGraphSchema_K2::PC_Name, FString::Printf(TEXT("Name_%d"), i)));
+	}
+	for (int32 i = 0; i < 2000; i++) {
+		Terminals.Add(MakeVariableTerminal(FString::Printf(TEXT("Variable%d"), i), nullptr));
+		Terminals.Add(MakeVariableTerminal(TEXT("Target"), MakeContextChain(i % 8 + 1, FString::Printf(TEXT("Root%d"), i))));
+	}
+
+	//Terminals that only differ in case or in a single field, which would collide if the hash ignored that difference
+	const TArray<TSharedPtr<FKismetTerminal>> NearDuplicates = {
+		MakeLiteralTerminal(UEdGraphSchema_K2::PC_String, TEXT("Hello")),
+		MakeLiteralTerminal(UEdGraphSchema_K2::PC_String, TEXT("hello")),
+		MakeLiteralTerminal(UEdGraphSchema_K2::PC_Name, TEXT("Hello")),
+		MakeVariableTerminal(TEXT("Target"), nullptr),
+		MakeVariableTerminal(TEXT("target"), nullptr),
+		MakeVariableTerminal(TEXT("Target"), MakeContextChain(1, TEXT("Target"))),
+		MakeVariableTerminal(TEXT("Target"), MakeContextChain(2, TEXT("Target")))
+	};
+	TSet<uint32> NearDuplicateHashes;
+	for (const TSharedPtr<FKismetTerminal>& Terminal : NearDuplicates) {
+		NearDuplicateHashes.Add(GetTypeHash(*Terminal));
+	}
+	TestEqual(TEXT("Terminals differing in a single field have distinct hashes"), NearDuplicateHashes.Num(), NearDuplicates.Num());
+
+	TSet<uint32> UniqueHashes;
+	for (const TSharedPtr<FKismetTerminal>& Terminal : Terminals) {
+		UniqueHashes.Add(GetTypeHash(*Terminal));
+	}
+	const int32 NumCollisions = Terminals.Num() - UniqueHashes.Num();
+	AddInfo(FString::Printf(TEXT("%d hash collisions among %d distinct terminals"), NumCollisions, Terminals.Num()));
+
+	//Random 32-bit hashes are expected to have about one collision for this many values, anything much higher points at a weak hash
+	TestTrue(TEXT("Hash collisions stay within the rate of a random hash"), NumCollisions <= 8);
+
+	//Pool must keep colliding terminals apart and must not duplicate equal ones
+	FKismetLiteralTerminalPool TerminalPool;
+	for (const TSharedPtr<FKismetTerminal>& Terminal : Terminals) {
+		if (Terminal->bIsLiteral) {
+			TerminalPool.Intern(Terminal);
+			TerminalPool.Intern(MakeLiteralTerminal(Terminal->Type.PinCategory, Terminal->StringLiteral));
+		}
+	}
+	TestEqual(TEXT("Interned literals"), TerminalPool.Num(), 60000);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetTerminalHashBenchmark, "AssetGenerator.KismetIntermediateFormat.HashBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FKismetTerminalHashBenchmark::RunTest(const FString& Parameters) {
+	//Literal-heavy function: many repeats of a small set of distinct values, plus variables with context chains
+	const int32 NumTerminals = 200000;
+	const int32 NumDistinctLiterals = 499;
+	TArray<TSharedPtr<FKismetTerminal>> Terminals;
+	for (int32 i = 0; i < NumTerminals; i++) {
+		if (i % 4 == 3) {
+			Terminals.Add(MakeVariableTerminal(TEXT("Target"), MakeContextChain(i % 6 + 1, TEXT("Root"))));
+		}
+		else {
+			Terminals.Add(MakeLiteralTerminal(UEdGraphSchema_K2::PC_Int, FString::FromInt(i % NumDistinctLiterals)));
+		}
+	}
+
+	uint32 CombinedHash = 0;
+	const double HashStartTime = FPlatformTime::Seconds();
+	for (const TSharedPtr<FKismetTerminal>& Terminal : Terminals) {
+		CombinedHash ^= GetTypeHash(*Terminal);
+	}
+	const double HashTime = FPlatformTime::Seconds() - HashStartTime;
+
+	int32 NumEqual = 0;
+	const double EqualityStartTime = FPlatformTime::Seconds();
+	for (int32 i = 1; i < Terminals.Num(); i++) {
+		NumEqual += *Terminals[i] == *Terminals[i - 1] ? 1 : 0;
+	}
+	const double EqualityTime = FPlatformTime::Seconds() - EqualityStartTime;
+
+	FKismetLiteralTerminalPool TerminalPool;
+	const double InternStartTime = FPlatformTime::Seconds();
+	for (const TSharedPtr<FKismetTerminal>& Terminal : Terminals) {
+		if (Terminal->bIsLiteral) {
+			TerminalPool.Intern(Terminal);
+		}
+	}
+	const double InternTime = FPlatformTime::Seconds() - InternStartTime;
+
+	TestEqual(TEXT("Interned literals"), TerminalPool.Num(), NumDistinctLiterals);
+	AddInfo(FString::Printf(TEXT("%d terminals: hashing %.2fms, adjacent comparisons %.2fms (%d equal), interning literals %.2fms (hash %08x)"),
+		NumTerminals, HashTime * 1000.0, EqualityTime * 1000.0, NumEqual, InternTime * 1000.0, CombinedHash));
+	return true;
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include "Toolkit/AssetGeneration/MaterialCompilationTracker.h"
+#include "Curves/CurveFloat.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaterialCompilationTrackerTest, "AssetGenerator.MaterialCompilationTracker.NonMaterialPackages", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaterialCompilationTrackerTest::RunTest(const FString& Parameters) {
+	const FName PackageName = TEXT("/Temp/AssetGeneratorTests/MaterialCompilationTracker/Curve");
+	UPackage* Package = CreatePackage(
+#if ENGINE_MINOR_VERSION < 26
+	nullptr,
+#endif
+	*PackageName.ToString());
+	UCurveFloat* Curve = NewObject<UCurveFloat>(Package, FPackageName::GetShortFName(PackageName), RF_Public | RF_Standalone | RF_Transient);
+	Package->SetDirtyFlag(false);
+
+	FMaterialCompilationTracker MaterialCompilationTracker;
+	MaterialCompilationTracker.TrackAsset(PackageName, Curve);
+	TestEqual(TEXT("Non-material assets are not tracked"), MaterialCompilationTracker.GetNumCompilingMaterials(), 0);
+
+	//Packages loaded as dependencies are looked up in memory, packages that are not loaded have nothing to compile
+	TestTrue(TEXT("Loaded package without a material"), MaterialCompilationTracker.IsCompilationFinished(PackageName));
+	TestTrue(TEXT("Package that is not loaded"), MaterialCompilationTracker.IsCompilationFinished(TEXT("/Temp/AssetGeneratorTests/MaterialCompilationTracker/Missing")));
+	TestTrue(TEXT("All dependencies"), MaterialCompilationTracker.AreAllCompilationsFinished({PackageName, TEXT("/Temp/AssetGeneratorTests/MaterialCompilationTracker/Missing")}));
+
+	//Saved packages without pending compilation never need to be saved again
+	MaterialCompilationTracker.RecordPackageSaved(PackageName, Package);
+	TestEqual(TEXT("Nothing to resave"), MaterialCompilationTracker.MarkPackagesSavedBeforeCompilationDirty(), 0);
+	TestFalse(TEXT("Package is left clean"), Package->IsDirty());
+
+	Curve->ClearFlags(RF_Standalone);
+	Package->SetFlags(RF_Transient);
+	return true;
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "Toolkit/AssetGeneration/AssetDumpViewWidget.h"
 #include "PackageTools.h"
 #include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+#include "Toolkit/AssetDumping/AssetDumpIndex.h"
 
 #define LOCTEXT_NAMESPACE "AssetGenerator"
 
@@ -36,6 +37,7 @@ TSharedPtr<FAssetDumpTreeNode> FAssetDumpTreeNode::MakeChildNode() {
 	TSharedRef<FAssetDumpTreeNode> NewNode = MakeShareable(new FAssetDumpTreeNode());
 	NewNode->ParentNode = SharedThis(this);
 	NewNode->RootDirectory = RootDirectory;
+	NewNode->DumpIndex = DumpIndex;
 	NewNode->bIsChecked = bIsChecked;
 	
 	Children.Add(NewNode);
@@ -46,6 +48,14 @@ FString FAssetDumpTreeNode::ComputeAssetClass() {
 	if (!bIsLeafNode) {
 		return TEXT("");
 	}
+
+	//Asset class is listed in the dump index, so we do not need to open the file at all
+	if (DumpIndex.IsValid()) {
+		const FAssetDumpIndexEntry* IndexEntry = DumpIndex->FindEntry(*PackageName);
+		if (IndexEntry != NULL) {
+			return IndexEntry->AssetClass.ToString();
+		}
+	}
 	
 	FString FileContentsString;
 	if (!FFileHelper::LoadFileToString(FileContentsString, *DiskPackagePath)) {
@@ -105,6 +115,10 @@ void FAssetDumpTreeNode::RegenerateChildren() {
 	if (bIsLeafNode) {
 		return;
 	}
+	if (DumpIndex.IsValid()) {
+		RegenerateChildrenFromIndex();
+		return;
+	}
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	TArray<FString> ChildDirectoryNames;
 	TArray<FString> ChildFilenames;
@@ -136,6 +150,32 @@ void FAssetDumpTreeNode::RegenerateChildren() {
 	}
 }
 
+void FAssetDumpTreeNode::RegenerateChildrenFromIndex() {
+	//Index is keyed by package paths, and the root node maps to the / path
+	const FString DirectoryPackagePath = PackageName.Len() > 1 ? PackageName : TEXT("/");
+	
+	for (const FString& ChildDirectoryPath : DumpIndex->GetChildDirectories(DirectoryPackagePath)) {
+		const TSharedPtr<FAssetDumpTreeNode> ChildNode = MakeChildNode();
+		ChildNode->bIsLeafNode = false;
+		ChildNode->DiskPackagePath = FPaths::Combine(RootDirectory, ChildDirectoryPath);
+		ChildNode->PackageName = ChildDirectoryPath;
+		ChildNode->NodeName = FPackageName::GetShortName(ChildDirectoryPath);
+	}
+
+	for (const FName ChildPackageName : DumpIndex->GetDirectoryPackages(DirectoryPackagePath)) {
+		const FAssetDumpIndexEntry* IndexEntry = DumpIndex->FindEntry(ChildPackageName);
+		const FString ChildPackageNameString = ChildPackageName.ToString();
+		
+		const TSharedPtr<FAssetDumpTreeNode> ChildNode = MakeChildNode();
+		ChildNode->bIsLeafNode = true;
+		ChildNode->DiskPackagePath = FPaths::Combine(RootDirectory, ChildPackageNameString) + TEXT(".json");
+		ChildNode->PackageName = ChildPackageNameString;
+		ChildNode->NodeName = FPackageName::GetShortName(ChildPackageNameString);
+		ChildNode->AssetClass = IndexEntry->AssetClass.ToString();
+		ChildNode->bAssetClassComputed = true;
+	}
+}
+
 void FAssetDumpTreeNode::GetChildrenNodes(TArray<TSharedPtr<FAssetDumpTreeNode>>& OutChildrenNodes) {
 	if (!bChildrenNodesInitialized) {
 		this->bChildrenNodesInitialized = true;
@@ -197,11 +237,15 @@ void FAssetDumpTreeNode::PopulateGeneratedPackages(TArray<FName>& OutPackageName
 	}
 }
 
-TSharedPtr<FAssetDumpTreeNode> FAssetDumpTreeNode::CreateRootTreeNode(const FString& DumpDirectory) {
+TSharedPtr<FAssetDumpTreeNode> FAssetDumpTreeNode::CreateRootTreeNode(const FString& DumpDirectory, const bool bUseDumpIndex) {
 	const TSharedPtr<FAssetDumpTreeNode> RootNode = MakeShareable(new FAssetDumpTreeNode);
 	
 	RootNode->bIsLeafNode = false;
 	RootNode->RootDirectory = DumpDirectory;
+	if (bUseDumpIndex) {
+		//Outdated index would hide packages dumped after it has been written, so it is rebuilt in that case
+		RootNode->DumpIndex = FAssetDumpIndex::LoadOrRebuildFromDumpDirectory(DumpDirectory);
+	}
 	RootNode->DiskPackagePath = RootNode->RootDirectory;
 	RootNode->SetupPackageNameFromDiskPath();
 	RootNode->UpdateSelectedState(true, false);
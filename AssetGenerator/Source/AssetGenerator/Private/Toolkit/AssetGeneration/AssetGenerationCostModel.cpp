@@ -0,0 +1,156 @@
+#include "Toolkit/AssetGeneration/AssetGenerationCostModel.h"
+#include "Misc/FileHelper.h"
+
+/** Weight of the newest measurement in the moving average of the stage cost */
+#define STAGE_COST_SMOOTHING_FACTOR 0.2f
+/** Cost of the stage nothing is known about yet, matches the default of UAssetTypeGenerator::GetEstimatedStageCostMs */
+#define DEFAULT_STAGE_COST_MS 10.0f
+
+FAssetGeneratorClassTimings::FAssetGeneratorClassTimings() {
+	this->StagesAdvanced = 0;
+	this->TotalSeconds = 0.0;
+	this->MaxStageSeconds = 0.0;
+	
+	for (int32 i = 0; i < (int32) EAssetGenerationStage::FINISHED; i++) {
+		this->StageCostMs[i] = 0.0f;
+		this->StageSamples[i] = 0;
+	}
+}
+
+FAssetGenerationCostModel::FAssetGenerationCostModel() {
+	this->PerGeneratorOverheadMs = 0.0f;
+	this->OverheadSamples = 0;
+}
+
+float FAssetGenerationCostModel::EstimateStageCostMs(const UAssetTypeGenerator* Generator) const {
+	const EAssetGenerationStage Stage = Generator->GetCurrentStage();
+	if (Stage == EAssetGenerationStage::FINISHED) {
+		return 0.0f;
+	}
+	
+	//Prefer measured cost of the stage if we have advanced it for this class before
+	const FAssetGeneratorClassTimings* Timings = ClassTimings.Find(Generator->GetClass());
+	if (Timings != NULL && Timings->StageSamples[(int32) Stage] > 0) {
+		return Timings->StageCostMs[(int32) Stage];
+	}
+	return Generator->GetEstimatedStageCostMs(Stage);
+}
+
+float FAssetGenerationCostModel::EstimateAverageStageCostMs(const EAssetGenerationStage Stage) const {
+	if (Stage == EAssetGenerationStage::FINISHED) {
+		return 0.0f;
+	}
+	float TotalCostMs = 0.0f;
+	int32 ClassesMeasured = 0;
+	
+	for (const TPair<UClass*, FAssetGeneratorClassTimings>& Pair : ClassTimings) {
+		if (Pair.Value.StageSamples[(int32) Stage] > 0) {
+			TotalCostMs += Pair.Value.StageCostMs[(int32) Stage];
+			ClassesMeasured++;
+		}
+	}
+	return ClassesMeasured ? TotalCostMs / ClassesMeasured : DEFAULT_STAGE_COST_MS;
+}
+
+void FAssetGenerationCostModel::RecordOverheadDuration(const int32 GeneratorsAdvanced, const double Seconds) {
+	if (GeneratorsAdvanced <= 0) {
+		return;
+	}
+	const float OverheadMs = (float) (Seconds * 1000.0 / GeneratorsAdvanced);
+	
+	if (OverheadSamples == 0) {
+		this->PerGeneratorOverheadMs = OverheadMs;
+	} else {
+		this->PerGeneratorOverheadMs = FMath::Lerp(PerGeneratorOverheadMs, OverheadMs, STAGE_COST_SMOOTHING_FACTOR);
+	}
+	this->OverheadSamples++;
+}
+
+void FAssetGenerationCostModel::RecordStageDuration(const UAssetTypeGenerator* Generator, const EAssetGenerationStage Stage, const double Seconds) {
+	if (Stage == EAssetGenerationStage::FINISHED) {
+		return;
+	}
+	FAssetGeneratorClassTimings& Timings = ClassTimings.FindOrAdd(Generator->GetClass());
+	Timings.StagesAdvanced++;
+	Timings.TotalSeconds += Seconds;
+	Timings.MaxStageSeconds = FMath::Max(Timings.MaxStageSeconds, Seconds);
+
+	//First measurement replaces the static estimate, next ones are blended into the moving average
+	const int32 StageIndex = (int32) Stage;
+	const float StageMs = (float) (Seconds * 1000.0);
+	
+	if (Timings.StageSamples[StageIndex] == 0) {
+		Timings.StageCostMs[StageIndex] = StageMs;
+	} else {
+		Timings.StageCostMs[StageIndex] = FMath::Lerp(Timings.StageCostMs[StageIndex], StageMs, STAGE_COST_SMOOTHING_FACTOR);
+	}
+	Timings.StageSamples[StageIndex]++;
+}
+
+static TArray<TPair<UClass*, FAssetGeneratorClassTimings>> GetTimingsSortedByTotalTime(const TMap<UClass*, FAssetGeneratorClassTimings>& ClassTimings) {
+	TArray<TPair<UClass*, FAssetGeneratorClassTimings>> SortedTimings;
+	for (const TPair<UClass*, FAssetGeneratorClassTimings>& Pair : ClassTimings) {
+		SortedTimings.Add(Pair);
+	}
+	SortedTimings.Sort([](const TPair<UClass*, FAssetGeneratorClassTimings>& A, const TPair<UClass*, FAssetGeneratorClassTimings>& B) {
+		return A.Value.TotalSeconds > B.Value.TotalSeconds;
+	});
+	return SortedTimings;
+}
+
+void FAssetGenerationCostModel::PrintTimingsIntoTheLog() const {
+	UE_LOG(LogAssetGenerator, Log, TEXT("------------ ASSET GENERATOR TIMINGS BEGIN ------------"));
+	
+	for (const TPair<UClass*, FAssetGeneratorClassTimings>& Pair : GetTimingsSortedByTotalTime(ClassTimings)) {
+		const FAssetGeneratorClassTimings& Timings = Pair.Value;
+		UE_LOG(LogAssetGenerator, Log, TEXT(" - %s: %d stages, %.2fs total, %.2fms average, %.2fms max"), *Pair.Key->GetName(),
+			Timings.StagesAdvanced, Timings.TotalSeconds, Timings.TotalSeconds * 1000.0 / FMath::Max(Timings.StagesAdvanced, 1), Timings.MaxStageSeconds * 1000.0);
+	}
+	UE_LOG(LogAssetGenerator, Log, TEXT("------------- ASSET GENERATOR TIMINGS END ------------"));
+}
+
+bool FAssetGenerationCostModel::ExportTimingsToFile(const FString& FilePath) const {
+	FString ResultString = TEXT("GeneratorClass,StagesAdvanced,TotalSeconds,AverageStageMs,MaxStageMs");
+	for (int32 i = 0; i < (int32) EAssetGenerationStage::FINISHED; i++) {
+		ResultString.Append(FString::Printf(TEXT(",Stage%dCostMs"), i));
+	}
+	ResultString.Append(LINE_TERMINATOR);
+
+	for (const TPair<UClass*, FAssetGeneratorClassTimings>& Pair : GetTimingsSortedByTotalTime(ClassTimings)) {
+		const FAssetGeneratorClassTimings& Timings = Pair.Value;
+		ResultString.Append(FString::Printf(TEXT("%s,%d,%.4f,%.4f,%.4f"), *Pair.Key->GetName(), Timings.StagesAdvanced, Timings.TotalSeconds,
+			Timings.TotalSeconds * 1000.0 / FMath::Max(Timings.StagesAdvanced, 1), Timings.MaxStageSeconds * 1000.0));
+		
+		for (int32 i = 0; i < (int32) EAssetGenerationStage::FINISHED; i++) {
+			ResultString.Append(FString::Printf(TEXT(",%.4f"), Timings.StageCostMs[i]));
+		}
+		ResultString.Append(LINE_TERMINATOR);
+	}
+
+	if (!FFileHelper::SaveStringToFile(ResultString, *FilePath)) {
+		UE_LOG(LogAssetGenerator, Error, TEXT("Failed to write asset generator timings into %s"), *FilePath);
+		return false;
+	}
+	UE_LOG(LogAssetGenerator, Log, TEXT("Asset generator timings have been written into %s"), *FilePath);
+	return true;
+}
+
+FAssetGenerationTickBudget::FAssetGenerationTickBudget(const float BudgetMs) {
+	this->BudgetMs = BudgetMs;
+	this->OverrunMs = 0.0;
+}
+
+bool FAssetGenerationTickBudget::CanFit(const double ElapsedMs, const double EstimatedCostMs, const int32 GeneratorsAdvanced) const {
+	if (GeneratorsAdvanced == 0) {
+		return true;
+	}
+	return ElapsedMs + EstimatedCostMs <= GetAvailableMs();
+}
+
+void FAssetGenerationTickBudget::FinishTick(const double ElapsedMs) {
+	if (!IsEnabled()) {
+		return;
+	}
+	//Ticks finishing under the budget pay the overrun back, ticks going over it add to the overrun
+	this->OverrunMs = FMath::Max(OverrunMs + ElapsedMs - BudgetMs, 0.0);
+}
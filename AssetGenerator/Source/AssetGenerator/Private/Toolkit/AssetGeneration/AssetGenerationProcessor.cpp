@@ -2,16 +2,55 @@
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "UObject/UObjectBaseUtility.h"
+#include "Async/ParallelFor.h"
 
 #define LOCTEXT_NAMESPACE "AssetGenerator"
 
 TSharedPtr<FAssetGenerationProcessor> FAssetGenerationProcessor::ActiveAssetGenerator = NULL;
 
+void FGeneratorDependencyIndex::AddDependency(UAssetTypeGenerator* Generator, const FName DependencyPackageName, const EAssetGenerationStage DependencyStage) {
+	this->PendingDependents.FindOrAdd(FPackageStageKey(DependencyPackageName, DependencyStage)).Add(Generator);
+	this->OutstandingDependencyCounts.FindOrAdd(Generator)++;
+}
+
+int32 FGeneratorDependencyIndex::FinishPackageStage(const FName PackageName, const EAssetGenerationStage FinishedStage, FGeneratorReadyQueue& ReadyQueue) {
+	TArray<UAssetTypeGenerator*> Dependents;
+	if (!PendingDependents.RemoveAndCopyValue(FPackageStageKey(PackageName, FinishedStage), Dependents)) {
+		return 0;
+	}
+	for (UAssetTypeGenerator* Dependent : Dependents) {
+		int32& RemainingDependencies = OutstandingDependencyCounts.FindChecked(Dependent);
+		check(RemainingDependencies > 0);
+
+		//Dependent can be advanced once all of it's dependencies have been satisfied
+		if (--RemainingDependencies == 0) {
+			this->OutstandingDependencyCounts.Remove(Dependent);
+			ReadyQueue.Enqueue(Dependent);
+		}
+	}
+	return Dependents.Num();
+}
+
+bool FGeneratorDependencyIndex::HasPendingDependents(const FName PackageName) const {
+	for (int32 StageIndex = 0; StageIndex <= (int32) EAssetGenerationStage::FINISHED; StageIndex++) {
+		if (PendingDependents.Contains(FPackageStageKey(PackageName, (EAssetGenerationStage) StageIndex))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void FGeneratorDependencyIndex::RemovePendingDependents(const FName PackageName) {
+	for (int32 StageIndex = 0; StageIndex <= (int32) EAssetGenerationStage::FINISHED; StageIndex++) {
+		this->PendingDependents.Remove(FPackageStageKey(PackageName, (EAssetGenerationStage) StageIndex));
+	}
+}
+
 void FAssetGenerationProcessor::RefreshGeneratorDependencies(UAssetTypeGenerator* Generator) {
 	//Populate package dependencies
 	const FName PackageName = Generator->GetPackageName();
 	TArray<FPackageDependency> GeneratorDependencies;
-	Generator->PopulateStageDependencies(GeneratorDependencies);
+	Generator->CollectStageDependencies(GeneratorDependencies);
 	
 	//Generate a flat list of the asset dependencies, preferring later stage dependency when multiple are present
 	TMap<FName, EAssetGenerationStage> CompactedFlatDependencies;
@@ -27,10 +66,7 @@ void FAssetGenerationProcessor::RefreshGeneratorDependencies(UAssetTypeGenerator
 		}
 	}
 
-	//Create shared dependency list and collect all dependencies
-	TSharedRef<FDependencyList> DependencyList = MakeShareable(new FDependencyList());
-	DependencyList->AssetTypeGenerator = Generator;
-	
+	//Dependencies we are going to wait for are registered in the reverse index by the package and stage
 	for (const TPair<FName, EAssetGenerationStage>& AssetDependency : CompactedFlatDependencies) {
 		const FName DependencyPackageName = AssetDependency.Key;
 
@@ -43,8 +79,7 @@ void FAssetGenerationProcessor::RefreshGeneratorDependencies(UAssetTypeGenerator
 			//We only want to add dependency if required stage index is higher or equal to current stage index,
 			//e.g when we are waiting for the dependency stage advance to happen
 			if (DependencyStageIndex >= CurrentStageIndex) {
-				DependencyList->PackageDependencies.Add(AssetDependency.Key, AssetDependency.Value);
-				PendingDependencies.FindOrAdd(DependencyPackageName).Add(DependencyList);
+				DependencyIndex.AddDependency(Generator, DependencyPackageName, AssetDependency.Value);
 
 				//Log verbose information about the dependency for easier debugging
 				UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Package %s depends on generated package %s (required Stage: %d, Current: %d)"),
@@ -59,8 +94,7 @@ void FAssetGenerationProcessor::RefreshGeneratorDependencies(UAssetTypeGenerator
 
 		//Only add dependency if package is going to be generated. We never wait for external packages.
 		if (AddPackageResult == EAddPackageResult::PACKAGE_WILL_BE_GENERATED) {
-			DependencyList->PackageDependencies.Add(AssetDependency.Key, AssetDependency.Value);
-			PendingDependencies.FindOrAdd(DependencyPackageName).Add(DependencyList);
+			DependencyIndex.AddDependency(Generator, DependencyPackageName, AssetDependency.Value);
 
 			//Log verbose information about the dependency for easier debugging
 			UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Package %s depends on generated package %s (required Stage: %d)"),
@@ -73,11 +107,21 @@ void FAssetGenerationProcessor::RefreshGeneratorDependencies(UAssetTypeGenerator
 		}
 	}
 
+	//Remember which materials the stage needs compiled, the generator will be held back until they are
+	if (Generator->RequiresCompiledShaderMaps(Generator->GetCurrentStage())) {
+		TArray<FName> ShaderMapDependencyPackages;
+		CompactedFlatDependencies.GetKeys(ShaderMapDependencyPackages);
+		ShaderMapDependencyPackages.Add(PackageName);
+		this->ShaderMapDependencies.Add(Generator, ShaderMapDependencyPackages);
+	} else {
+		this->ShaderMapDependencies.Remove(Generator);
+	}
+
 	//If we have no pending asset generator dependencies, add ourselves to the advance list instantly
 	//Otherwise we are waiting on dependencies to advance pretty much, nothing else to do here
-	if (DependencyList->PackageDependencies.Num() == 0) {
+	if (DependencyIndex.GetOutstandingDependencyCount(Generator) == 0) {
 		UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependencies satisfied for package %s (instantly)"), *PackageName.ToString());
-		this->GeneratorsReadyToAdvance.Add(Generator);
+		this->GeneratorsReadyToAdvance.Enqueue(Generator);
 	}
 }
 
@@ -86,33 +130,13 @@ void FAssetGenerationProcessor::OnGeneratorStageAdvanced(UAssetTypeGenerator* Ge
 	const int32 CurrentStageIndex = (int32) Generator->GetCurrentStage();
 	UE_LOG(LogAssetGenerator, Verbose, TEXT("Asset generation advanced to stage %d for asset %s"), CurrentStageIndex, *PackageName.ToString());
 
-	//Notify all dependents that we have advanced by one state
-	TArray<TSharedPtr<FDependencyList>>* Dependents = PendingDependencies.Find(PackageName);
-	if (Dependents) {
-		for (int32 i = Dependents->Num() - 1; i >= 0; i--) {
-			const TSharedPtr<FDependencyList> DependencyList = (*Dependents)[i];
-			const FName DependentPackageName = DependencyList->AssetTypeGenerator->GetPackageName();
-			const int32 DependencyStageIndex = (int32) DependencyList->PackageDependencies.FindChecked(PackageName);
-			
-			if (CurrentStageIndex > DependencyStageIndex) {
-				DependencyList->PackageDependencies.Remove(PackageName);
-				(*Dependents).RemoveAt(i);
-				
-				UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependent package %s has satisfied dependency on %s (dependencies remaining: %d)"),
-					*DependentPackageName.ToString(), *PackageName.ToString(), DependencyList->PackageDependencies.Num());
-
-				//Advance dependent generator state if all dependencies have been satisfied
-				if (DependencyList->PackageDependencies.Num() == 0) {
-					UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependencies satisfied for package %s"), *DependentPackageName.ToString());
-					this->GeneratorsReadyToAdvance.Add(DependencyList->AssetTypeGenerator);
-				}
-			}
-		}
+	//Stages are advanced one by one, so only dependents waiting for the stage we have just finished are satisfied now
+	const int32 ReadyGeneratorsBefore = GeneratorsReadyToAdvance.Num();
+	const int32 DependentsNotified = DependencyIndex.FinishPackageStage(PackageName, (EAssetGenerationStage) (CurrentStageIndex - 1), GeneratorsReadyToAdvance);
 
-		//Remove dependent entries if all dependents are finished now
-		if (Dependents->Num() == 0) {
-			this->PendingDependencies.Remove(PackageName);
-		}
+	UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Package %s has satisfied dependency of %d dependents"), *PackageName.ToString(), DependentsNotified);
+	for (int32 i = ReadyGeneratorsBefore; i < GeneratorsReadyToAdvance.Num(); i++) {
+		UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependencies satisfied for package %s"), *GeneratorsReadyToAdvance[i]->GetPackageName().ToString());
 	}
 
 	//Schedule next stage for the current generator if we're not finished
@@ -127,9 +151,11 @@ void FAssetGenerationProcessor::OnGeneratorStageAdvanced(UAssetTypeGenerator* Ge
 FAssetGeneratorConfiguration::FAssetGeneratorConfiguration() :
 		DumpRootDirectory(FPaths::ProjectDir() + TEXT("AssetDump/")),
 		MaxAssetsToAdvancePerTick(4),
+		TickTimeBudgetMs(0.0f),
 		bRefreshExistingAssets(true),
 		bGeneratePublicProject(false),
-		bTickOnTheSide(false) {
+		bTickOnTheSide(false),
+		bForceSingleThread(false) {
 }
 
 FAssetGenStatistics::FAssetGenStatistics() {
@@ -148,10 +174,24 @@ void FAssetGenerationProcessor::InitializeAssetGeneratorInternal(UAssetTypeGener
 
 	//Associate it with the package in question and refresh dependencies
 	this->AssetGenerators.Add(Generator->GetPackageName(), Generator);
-	if(!this->PackagesToGenerate.Contains(Generator->GetPackageName())) {
+	if(!this->PackagesToGenerateSet.Contains(Generator->GetPackageName())) {
 		this->Statistics.TotalAssetPackages++;
 	}
-	RefreshGeneratorDependencies(Generator);
+	//First stage is prepared together with the other new generators, so it can run on the task graph
+	this->GeneratorsPendingInitialization.Add(Generator);
+}
+
+void FAssetGenerationProcessor::InitializePendingGenerators() {
+	while (GeneratorsPendingInitialization.Num()) {
+		//Gathering dependencies can create more generators, they are prepared as the next batch
+		const TArray<UAssetTypeGenerator*> GeneratorBatch = MoveTemp(GeneratorsPendingInitialization);
+		this->GeneratorsPendingInitialization.Reset();
+
+		PrepareGeneratorStages(GeneratorBatch);
+		for (UAssetTypeGenerator* Generator : GeneratorBatch) {
+			RefreshGeneratorDependencies(Generator);
+		}
+	}
 }
 
 void FAssetGenerationProcessor::MarkExternalPackageDependencySatisfied(FName PackageName) {
@@ -171,20 +211,28 @@ void FAssetGenerationProcessor::MarkPackageSkipped(const FName PackageName, cons
 }
 
 bool FAssetGenerationProcessor::ShouldSkipPackage(UAssetTypeGenerator* PackageGenerator, FString& OutSkipReason) const {
+	const FName PackageName = PackageGenerator->GetPackageName();
+	
+	//Packages requested explicitly take priority over the blacklist, it only applies to the dependencies
+	if (Configuration.PackageBlacklist.IsValid() && !PackagesToGenerateSet.Contains(PackageName) && Configuration.PackageBlacklist->Matches(PackageName)) {
+		OutSkipReason = TEXT("package is blacklisted");
+		return true;
+	}
 	return false;
 }
 
 void FAssetGenerationProcessor::CleanupAssetGenerator(UAssetTypeGenerator* Generator) {
 	//Make sure nobody is waiting for us
-	if (!ensureAlways(this->PendingDependencies.Find(Generator->GetPackageName()) == NULL)) {
+	if (!ensureAlways(!DependencyIndex.HasPendingDependents(Generator->GetPackageName()))) {
 		PrintStateIntoTheLog();
-		this->PendingDependencies.Remove(Generator->GetPackageName());
+		DependencyIndex.RemovePendingDependents(Generator->GetPackageName());
 	}
 	
 	UE_LOG(LogAssetGenerator, Log, TEXT("Finished asset generation: %s"), *Generator->GetPackageName().ToString());
 	
 	//Remove ourselves from the collection of asset generators, mark package as generated
 	this->AssetGenerators.Remove(Generator->GetPackageName());
+	this->ShaderMapDependencies.Remove(Generator);
 	this->AlreadyGeneratedPackages.Add(Generator->GetPackageName());
 
 	//Add asset generator into our statistics
@@ -194,7 +242,31 @@ void FAssetGenerationProcessor::CleanupAssetGenerator(UAssetTypeGenerator* Gener
 	Generator->RemoveFromRoot();
 }
 
-EAddPackageResult FAssetGenerationProcessor::AddPackage(const FName PackageName) {
+void FAssetGenerationProcessor::PrepareGeneratorStages(const TArray<UAssetTypeGenerator*>& Generators) {
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<UAssetTypeGenerator*> GeneratorsToPrepareParallel;
+
+	//Generators that cannot be prepared off the game thread are prepared right away
+	for (UAssetTypeGenerator* Generator : Generators) {
+		if (Generator->GetCurrentStage() == EAssetGenerationStage::FINISHED) {
+			continue;
+		}
+		if (Generator->SupportsParallelPreparation()) {
+			GeneratorsToPrepareParallel.Add(Generator);
+		} else {
+			Generator->PrepareCurrentStage();
+		}
+	}
+
+	if (GeneratorsToPrepareParallel.Num()) {
+		ParallelFor(GeneratorsToPrepareParallel.Num(), [&GeneratorsToPrepareParallel](const int32 GeneratorIndex) {
+			GeneratorsToPrepareParallel[GeneratorIndex]->PrepareCurrentStage();
+		}, Configuration.bForceSingleThread);
+	}
+	this->TimeSpentPreparing += FPlatformTime::Seconds() - StartTime;
+}
+
+EAddPackageResult FAssetGenerationProcessor::AddPackage(const FName PackageName, const TSharedPtr<FJsonObject> PreloadedDumpData) {
 	//Return PACKAGE_EXISTS if we have already processed this package before
 	if (ExternalPackagesResolved.Contains(PackageName) || AlreadyGeneratedPackages.Contains(PackageName)) {
 		return EAddPackageResult::PACKAGE_EXISTS;
@@ -209,8 +281,10 @@ EAddPackageResult FAssetGenerationProcessor::AddPackage(const FName PackageName)
 		return EAddPackageResult::PACKAGE_WILL_BE_GENERATED;
 	}
 	
-	//First, try to extract package from the dump
-	UAssetTypeGenerator* AssetTypeGenerator = UAssetTypeGenerator::InitializeFromFile(Configuration.DumpRootDirectory, PackageName, Configuration.bGeneratePublicProject);
+	//First, try to extract package from the dump, reusing the file contents if they have been already loaded
+	UAssetTypeGenerator* AssetTypeGenerator = PreloadedDumpData.IsValid() ?
+		UAssetTypeGenerator::InitializeFromDumpData(Configuration.DumpRootDirectory, PackageName, PreloadedDumpData, Configuration.bGeneratePublicProject) :
+		UAssetTypeGenerator::InitializeFromFile(Configuration.DumpRootDirectory, PackageName, Configuration.bGeneratePublicProject);
 	if (AssetTypeGenerator != NULL) {
 		FString OutSkipReason;
 		//Skip the package if it's not whitelisted by the configuration
@@ -238,38 +312,105 @@ EAddPackageResult FAssetGenerationProcessor::AddPackage(const FName PackageName)
 	return EAddPackageResult::PACKAGE_NOT_FOUND;
 }
 
+int32 FAssetGenerationProcessor::GetMaxAssetsToGatherThisTick() const {
+	int32 MaxAssetsToAdvance = Configuration.MaxAssetsToAdvancePerTick;
+
+	//With the time budget, estimate how many packages can be constructed in one tick from the measured costs
+	if (TickBudget.IsEnabled()) {
+		const float ConstructionCostMs = CostModel.EstimateAverageStageCostMs(EAssetGenerationStage::CONSTRUCTION) + CostModel.EstimatePerGeneratorOverheadMs();
+		MaxAssetsToAdvance = FMath::Max(1, FMath::FloorToInt(Configuration.TickTimeBudgetMs / FMath::Max(ConstructionCostMs, KINDA_SMALL_NUMBER)));
+	}
+	//Gather twice as many packages as can be advanced, so the ready queue does not run dry while they are waiting on dependencies
+	return MaxAssetsToAdvance * 2;
+}
+
 bool FAssetGenerationProcessor::GatherNewAssetsForGeneration() {
-	const int32 MaxAssetsToGatherThisTick = Configuration.MaxAssetsToAdvancePerTick * 2;
+	const int32 MaxAssetsToGatherThisTick = GetMaxAssetsToGatherThisTick();
 	int32 AssetsAddedThisTick = 0;
 	while (PackagesToGenerate.IsValidIndex(NextPackageToGenerateIndex) && AssetsAddedThisTick < MaxAssetsToGatherThisTick) {
-		const FName PackageToGenerate = PackagesToGenerate[NextPackageToGenerateIndex++];
-
-		//Skip package if it has been generated already before
-		if (AlreadyGeneratedPackages.Contains(PackageToGenerate)) {
-			continue;
+		//Pick the next batch of packages that have not been generated before
+		TArray<FName> PackageBatch;
+		while (PackagesToGenerate.IsValidIndex(NextPackageToGenerateIndex) && PackageBatch.Num() < MaxAssetsToGatherThisTick - AssetsAddedThisTick) {
+			const FName PackageToGenerate = PackagesToGenerate[NextPackageToGenerateIndex++];
+
+			//Skip package if it has been generated already before
+			if (!AlreadyGeneratedPackages.Contains(PackageToGenerate)) {
+				PackageBatch.Add(PackageToGenerate);
+			}
 		}
 
-		const EAddPackageResult Result = AddPackage(PackageToGenerate);
+		//Reading and parsing dump files does not touch any UObjects, so do it for the whole batch on the task graph
+		const double StartTime = FPlatformTime::Seconds();
+		TArray<TSharedPtr<FJsonObject>> PreloadedDumpFiles;
+		PreloadedDumpFiles.SetNum(PackageBatch.Num());
 
-		//If asset is skipped, continue and try to add the other one
-		if (SkippedPackages.Contains(PackageToGenerate)) {
-			continue;
-		}
+		ParallelFor(PackageBatch.Num(), [&](const int32 PackageIndex) {
+			PreloadedDumpFiles[PackageIndex] = UAssetTypeGenerator::LoadAssetDumpFile(Configuration.DumpRootDirectory, PackageBatch[PackageIndex]);
+		}, Configuration.bForceSingleThread);
+		this->TimeSpentPreparing += FPlatformTime::Seconds() - StartTime;
 
-		//Print a warning if package is not actually generated
-		if (Result != EAddPackageResult::PACKAGE_WILL_BE_GENERATED) {
-			const FString AssetFilePath = UAssetTypeGenerator::GetAssetFilePath(Configuration.DumpRootDirectory, PackageToGenerate);
-			
-			UE_LOG(LogAssetGenerator, Warning, TEXT("Failed to queue package %s for generation. Probably asset dump file is missing, make sure it exists at %s"),
-				*PackageToGenerate.ToString(), *AssetFilePath);
-			continue;
+		for (int32 i = 0; i < PackageBatch.Num(); i++) {
+			const FName PackageToGenerate = PackageBatch[i];
+			const EAddPackageResult Result = AddPackage(PackageToGenerate, PreloadedDumpFiles[i]);
+
+			//If asset is skipped, continue and try to add the other one
+			if (SkippedPackages.Contains(PackageToGenerate)) {
+				continue;
+			}
+
+			//Print a warning if package is not actually generated
+			if (Result != EAddPackageResult::PACKAGE_WILL_BE_GENERATED) {
+				const FString AssetFilePath = UAssetTypeGenerator::GetAssetFilePath(Configuration.DumpRootDirectory, PackageToGenerate);
+
+				UE_LOG(LogAssetGenerator, Warning, TEXT("Failed to queue package %s for generation. Probably asset dump file is missing, make sure it exists at %s"),
+					*PackageToGenerate.ToString(), *AssetFilePath);
+				continue;
+			}
+			AssetsAddedThisTick++;
 		}
-		AssetsAddedThisTick++;
 	}
+	InitializePendingGenerators();
 	return AssetsAddedThisTick > 0;
 }
 
+bool FAssetGenerationProcessor::IsWaitingForShaderMaps(UAssetTypeGenerator* Generator) {
+	const TArray<FName>* DependencyPackages = ShaderMapDependencies.Find(Generator);
+	return DependencyPackages != NULL && !MaterialCompilationTracker.AreAllCompilationsFinished(*DependencyPackages);
+}
+
+void FAssetGenerationProcessor::RequeueGeneratorsWithCompiledShaderMaps() {
+	for (int32 i = GeneratorsWaitingForShaderMaps.Num() - 1; i >= 0; i--) {
+		UAssetTypeGenerator* Generator = GeneratorsWaitingForShaderMaps[i];
+		
+		if (!IsWaitingForShaderMaps(Generator)) {
+			UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Shader maps required by package %s have been compiled"), *Generator->GetPackageName().ToString());
+			this->GeneratorsReadyToAdvance.Enqueue(Generator);
+			this->GeneratorsWaitingForShaderMaps.RemoveAtSwap(i);
+		}
+	}
+}
+
+bool FAssetGenerationProcessor::CanAdvanceGeneratorThisTick(UAssetTypeGenerator* Generator, const int32 GeneratorsAdvanced, const int32 MaxGeneratorsToAdvance, const double TickElapsedMs) const {
+	//Without the time budget, just advance fixed amount of generators per tick
+	if (!TickBudget.IsEnabled()) {
+		return GeneratorsAdvanced < MaxGeneratorsToAdvance;
+	}
+	//Advanced generator also has it's next stage prepared and dependencies gathered later in the tick, so account for that too
+	const double EstimatedCostMs = CostModel.EstimateStageCostMs(Generator) + CostModel.EstimatePerGeneratorOverheadMs();
+	return TickBudget.CanFit(TickElapsedMs, EstimatedCostMs, GeneratorsAdvanced);
+}
+
 void FAssetGenerationProcessor::TickAssetGeneration(int32& PackagesGeneratedThisTick) {
+	//Everything done during the tick is charged against the budget, including gathering and loading dump files
+	const double TickStartTime = FPlatformTime::Seconds();
+	
+	//Generators waiting for material compilation are not stuck, they will be advanced once it finishes
+	RequeueGeneratorsWithCompiledShaderMaps();
+	if (IsBlockedOnShaderCompilation()) {
+		PackagesGeneratedThisTick = 0;
+		return;
+	}
+	
 	//If we have nothing to advance, but have asset generators waiting, we are definitely in a cyclic dependencies loop
 	//Log our full state for debugging purposes and crash
 	if (GeneratorsReadyToAdvance.Num() == 0 && AssetGenerators.Num() != 0) {
@@ -287,24 +428,54 @@ void FAssetGenerationProcessor::TickAssetGeneration(int32& PackagesGeneratedThis
 	}
 
 	int32 MaxGeneratorsToAdvance = Configuration.MaxAssetsToAdvancePerTick;
-	int32 GeneratorsActuallyProcessed = 0;
+	TArray<UAssetTypeGenerator*> GeneratorsAdvancedThisTick;
+	int32 GeneratorsConsumed = 0;
 	
-	for (int32 i = 0; i < FMath::Min(GeneratorsReadyToAdvance.Num(), MaxGeneratorsToAdvance); i++) {
-		UAssetTypeGenerator* Generator = GeneratorsReadyToAdvance[i];
-		UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Advancing asset generator %s at index %d"), *Generator->GetPackageName().ToString(), i);
+	for (; GeneratorsConsumed < GeneratorsReadyToAdvance.Num(); GeneratorsConsumed++) {
+		UAssetTypeGenerator* Generator = GeneratorsReadyToAdvance[GeneratorsConsumed];
+		const double TickElapsedMs = (FPlatformTime::Seconds() - TickStartTime) * 1000.0;
+		
+		if (!CanAdvanceGeneratorThisTick(Generator, GeneratorsAdvancedThisTick.Num(), MaxGeneratorsToAdvance, TickElapsedMs)) {
+			break;
+		}
+		//Hold the generator back if materials it depends on are still compiling, and keep advancing the other ones
+		if (IsWaitingForShaderMaps(Generator)) {
+			UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Package %s is waiting for shader compilation to finish"), *Generator->GetPackageName().ToString());
+			this->GeneratorsWaitingForShaderMaps.Add(Generator);
+			continue;
+		}
+		UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Advancing asset generator %s at index %d"), *Generator->GetPackageName().ToString(), GeneratorsConsumed);
 
+		const EAssetGenerationStage StageBeingAdvanced = Generator->GetCurrentStage();
+		const double StageStartTime = FPlatformTime::Seconds();
 		const FGeneratorStateAdvanceResult& AdvanceResult = Generator->AdvanceGenerationState();
-		OnGeneratorStageAdvanced(Generator);
+		
+		CostModel.RecordStageDuration(Generator, StageBeingAdvanced, FPlatformTime::Seconds() - StageStartTime);
+		MaterialCompilationTracker.TrackAsset(Generator->GetPackageName(), Generator->GetAssetObject());
+		MaterialCompilationTracker.RecordPackageSaved(Generator->GetPackageName(), Generator->GetAssetPackage());
+		GeneratorsAdvancedThisTick.Add(Generator);
 
 		//Try to compensate for generation stage not being utilized by advancing more generators this tick
 		if (AdvanceResult.bPreviousStageNotImplemented) {
 			MaxGeneratorsToAdvance++;
 		}
-		GeneratorsActuallyProcessed++;
 	}
-	//Remove generators that we have already advanced
-	GeneratorsReadyToAdvance.RemoveAt(0, GeneratorsActuallyProcessed);
-	PackagesGeneratedThisTick = GeneratorsActuallyProcessed;
+	//Remove generators that we have already advanced or moved to the shader compilation wait list
+	GeneratorsReadyToAdvance.PopFront(GeneratorsConsumed);
+	PackagesGeneratedThisTick = GeneratorsAdvancedThisTick.Num();
+
+	//Prepare next stages of the advanced generators as a batch, then notify dependents and gather new dependencies
+	const double OverheadStartTime = FPlatformTime::Seconds();
+	PrepareGeneratorStages(GeneratorsAdvancedThisTick);
+	for (UAssetTypeGenerator* Generator : GeneratorsAdvancedThisTick) {
+		OnGeneratorStageAdvanced(Generator);
+	}
+	//Dependencies gathered for the next stages might have pulled in new generators
+	InitializePendingGenerators();
+
+	const double TickEndTime = FPlatformTime::Seconds();
+	CostModel.RecordOverheadDuration(GeneratorsAdvancedThisTick.Num(), TickEndTime - OverheadStartTime);
+	TickBudget.FinishTick((TickEndTime - TickStartTime) * 1000.0);
 
 	//Update notification item if it's visible
 	UpdateNotificationItem();
@@ -334,6 +505,13 @@ void FAssetGenerationProcessor::OnAssetGenerationFinished() {
 	this->bGenerationFinished = true;
 	UE_LOG(LogAssetGenerator, Log, TEXT("Asset generation finished successfully, %d packages generated, %d packages refreshed, %d up-to-date"),
 		Statistics.AssetPackagesCreated, Statistics.AssetPackagesRefreshed, Statistics.AssetPackagesUpToDate);
+	UE_LOG(LogAssetGenerator, Log, TEXT("Spent %.2f seconds loading dump files and preparing generator stages (%s)"),
+		TimeSpentPreparing, Configuration.bForceSingleThread ? TEXT("single threaded") : TEXT("multi threaded"));
+
+	CostModel.PrintTimingsIntoTheLog();
+	if (!Configuration.TimingStatsFilePath.IsEmpty()) {
+		CostModel.ExportTimingsToFile(Configuration.TimingStatsFilePath);
+	}
 
 	if (NotificationItem.IsValid()) {
 		FFormatNamedArguments Arguments;
@@ -395,19 +573,27 @@ void FAssetGenerationProcessor::PrintStateIntoTheLog() {
 		}
 	}
 
-	if (PendingDependencies.Num()) {
+	if (DependencyIndex.GetPendingDependents().Num()) {
 		UE_LOG(LogAssetGenerator, Log, TEXT("Pending package dependencies: "));
-		for (const TPair<FName, TArray<TSharedPtr<FDependencyList>>>& Pair : PendingDependencies) {
-			UE_LOG(LogAssetGenerator, Log, TEXT(" - %s Dependents:"), *Pair.Key.ToString());
-			for (const TSharedPtr<FDependencyList>& DependentPtr : Pair.Value) {
-				UE_LOG(LogAssetGenerator, Log, TEXT("    - %s"), *DependentPtr->AssetTypeGenerator->GetPackageName().ToString());
+		for (const TPair<FPackageStageKey, TArray<UAssetTypeGenerator*>>& Pair : DependencyIndex.GetPendingDependents()) {
+			UE_LOG(LogAssetGenerator, Log, TEXT(" - %s (Stage: %d) Dependents:"), *Pair.Key.PackageName.ToString(), Pair.Key.Stage);
+			for (UAssetTypeGenerator* Dependent : Pair.Value) {
+				UE_LOG(LogAssetGenerator, Log, TEXT("    - %s (Dependencies remaining: %d)"), *Dependent->GetPackageName().ToString(),
+					DependencyIndex.GetOutstandingDependencyCount(Dependent));
 			}
 		}
 	}
 
 	if (GeneratorsReadyToAdvance.Num()) {
 		UE_LOG(LogAssetGenerator, Log, TEXT("Generators ready to advance: "));
-		for (UAssetTypeGenerator* Generator : GeneratorsReadyToAdvance) {
+		for (int32 i = 0; i < GeneratorsReadyToAdvance.Num(); i++) {
+			UE_LOG(LogAssetGenerator, Log, TEXT(" - %s"), *GeneratorsReadyToAdvance[i]->GetPackageName().ToString());
+		}
+	}
+
+	if (GeneratorsWaitingForShaderMaps.Num()) {
+		UE_LOG(LogAssetGenerator, Log, TEXT("Generators waiting for shader compilation (%d materials compiling): "), MaterialCompilationTracker.GetNumCompilingMaterials());
+		for (UAssetTypeGenerator* Generator : GeneratorsWaitingForShaderMaps) {
 			UE_LOG(LogAssetGenerator, Log, TEXT(" - %s"), *Generator->GetPackageName().ToString());
 		}
 	}
@@ -440,9 +626,12 @@ FAssetGenerationProcessor::FAssetGenerationProcessor(const FAssetGeneratorConfig
 	const TArray<FName>& PackagesToGenerate) {
 	this->Configuration = Configuration;
 	this->PackagesToGenerate = PackagesToGenerate;
+	this->PackagesToGenerateSet.Append(PackagesToGenerate);
 	this->NextPackageToGenerateIndex = 0;
 	this->bGenerationFinished = false;
 	this->bIsFirstTick = true;
+	this->TimeSpentPreparing = 0.0;
+	this->TickBudget = FAssetGenerationTickBudget(Configuration.TickTimeBudgetMs);
 	this->Statistics.TotalAssetPackages = PackagesToGenerate.Num();
 }
 
@@ -1,7 +1,9 @@
 ﻿#include "Toolkit/AssetGeneration/AssetGenerationUtil.h"
+#include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
 #include "Dom/JsonObject.h"
 #include "Engine/MemberReference.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
+#include "Toolkit/KismetBytecodeCompactFormat.h"
 #include "EdGraphSchema_K2.h"
 #include "CoreUObject.h"
 #include "UserDefinedStructure/UserDefinedStructEditorData.h"
@@ -160,7 +162,7 @@ FDeserializedFunction::FDeserializedFunction(const TSharedPtr<FJsonObject>& Obje
 		this->AllProperties.Add(MoveTemp(DeserializedProperty));
 	}
 
-	const TArray<TSharedPtr<FJsonValue>> Script = Object->GetArrayField(TEXT("Script"));
+	const TArray<TSharedPtr<FJsonValue>> Script = FKismetBytecodeCompactFormat::ReadFunctionScript(Object);
 	const FString UbergraphFunctionName = UEdGraphSchema_K2::FN_ExecuteUbergraphBase.ToString();
 	this->bIsCallingIntoUbergraph = false;
 
@@ -173,6 +175,16 @@ FDeserializedFunction::FDeserializedFunction(const TSharedPtr<FJsonObject>& Obje
 
 			if (FunctionName.StartsWith(UbergraphFunctionName)) {
 				this->bIsCallingIntoUbergraph = true;
+
+				//First parameter of the ubergraph call is the offset of the event entry point, always passed as an integer constant
+				const TArray<TSharedPtr<FJsonValue>>& Parameters = StatementObject->GetArrayField(TEXT("Parameters"));
+				if (Parameters.Num() && Parameters[0]->AsObject()->GetStringField(TEXT("Inst")) == TEXT("IntConst")) {
+					this->UbergraphEntryOffsets.Add(Parameters[0]->AsObject()->GetIntegerField(TEXT("Value")));
+				}
+				else {
+					const FString ParameterInstName = Parameters.Num() ? Parameters[0]->AsObject()->GetStringField(TEXT("Inst")) : TEXT("None");
+					UE_LOG(LogAssetGenerator, Warning, TEXT("Function %s calls into ubergraph with non-constant entry offset (%s), its entry point will not be used to partition the ubergraph"), *FunctionNameString, *ParameterInstName);
+				}
 			}
 		}
 	}
@@ -7,50 +7,45 @@
 #include "AssetRegistry/Private/AssetRegistry.h"
 #include "HAL/PlatformApplicationMisc.h"
 #include "Toolkit/AssetGeneration/AssetGenerationUtil.h"
+#include "Toolkit/AssetGeneration/DirtyPackageTracker.h"
+#include "Toolkit/AssetGeneration/AssetRegistryStateCache.h"
+#include "Toolkit/AssetGeneration/AssetGeneratorGCController.h"
+#include "AssetGeneratorModule.h"
+#include "Toolkit/AssetDumping/AssetDumpIndex.h"
+#include "Util/PackageNameMatcher.h"
 
 DEFINE_LOG_CATEGORY(LogAssetGeneratorCommandlet)
 
-struct FAssetGeneratorGCController {
+/** Records files of the packages saved while generation is running, so only they have to be rescanned by the asset registry */
+struct FSavedPackageTracker {
 private:
-	int32 PackagesCookedSinceLastGC;
-	double LastGCTimestamp;
-
-	float MaxSecondsBetweenGC;
-	int32 MaxPackagesBetweenGC;
+	TSet<FString> SavedPackageFiles;
+	FDelegateHandle PackageSavedHandle;
 public:
-	explicit FAssetGeneratorGCController(float MaxSecondsBetweenGC = 20.0f, int32 MaxPackagesBetweenGC = 32) {
-		this->PackagesCookedSinceLastGC = 0;
-		this->LastGCTimestamp = 0.0f;
-		this->MaxSecondsBetweenGC = MaxSecondsBetweenGC;
-		this->MaxPackagesBetweenGC = MaxPackagesBetweenGC;
+	FSavedPackageTracker() {
+		this->PackageSavedHandle = UPackage::PackageSavedEvent.AddRaw(this, &FSavedPackageTracker::OnPackageSaved);
 	}
 
-	void Update(int32 PackagesGeneratedThisTick) {
-		this->PackagesCookedSinceLastGC += PackagesGeneratedThisTick;
+	~FSavedPackageTracker() {
+		UPackage::PackageSavedEvent.Remove(PackageSavedHandle);
 	}
 
-	void ConditionallyCollectGarbage() {
-		bool bShouldGC = false;
-
-		if (this->PackagesCookedSinceLastGC >= MaxPackagesBetweenGC) {
-			bShouldGC = true;
-		}
-		if (FApp::GetCurrentTime() - LastGCTimestamp >= MaxSecondsBetweenGC) {
-			bShouldGC = true;
-		}
-		if (bShouldGC) {
-			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Collecting garbage"));
-			CollectGarbage(RF_Standalone);
-
-			this->PackagesCookedSinceLastGC = 0;
-			this->LastGCTimestamp = FApp::GetCurrentTime();
-		}
+	void OnPackageSaved(const FString& PackageFileName, UObject* Outer) {
+		this->SavedPackageFiles.Add(FPaths::ConvertRelativePathToFull(PackageFileName));
 	}
+
+	FORCEINLINE TArray<FString> GetSavedPackageFiles() const { return SavedPackageFiles.Array(); }
 };
 
+/** Time the main loop sleeps for when all of the generators are waiting for shader compilation, in seconds */
+#define SHADER_COMPILATION_IDLE_SLEEP_SECONDS 0.01f
+
+/** Amount of dirty packages saved at once during the final save pass */
+#define DIRTY_PACKAGES_SAVE_BATCH_SIZE 32
+
 UAssetGeneratorCommandlet::UAssetGeneratorCommandlet() {
 	HelpDescription = TEXT("Generates assets from the dump located in the provided folder using the provided settings");
-	HelpUsage = TEXT("assetgenerator -DumpDirectory=Path/To/Directory [-ForceGeneratePackageNames=ForceGeneratePackageNames.txt] [-BlacklistPackageNames=BlacklistPackageNames.txt] [-AssetClassWhitelist=Class1,Class2] [-NoRefresh] [-PublicProject]");
+	HelpUsage = TEXT("assetgenerator -DumpDirectory=Path/To/Directory [-ForceGeneratePackageNames=ForceGeneratePackageNames.txt] [-BlacklistPackageNames=BlacklistPackageNames.txt] [-SkipSavePackages=SkipSavePackages.txt] [-AssetClassWhitelist=Class1,Class2] [-NoRefresh] [-PublicProject] [-ForceSingleThread] [-TickTimeBudgetMs=50] [-TimingStatsFile=Path/To/Timings.csv] [-NoDumpIndex] [-RebuildDumpIndex] [-NoAssetRegistryCache] [-FullAssetRegistryRescan] [-GCMemoryCeilingMB=8192]");
 	ShowErrorCount = false;
 }
 
@@ -60,6 +55,13 @@ UAssetRegistryImpl& UAssetGeneratorCommandlet::Get()
 	return static_cast<UAssetRegistryImpl&>(Module.Get());
 }
 
+IAssetRegistry& UAssetGeneratorCommandlet::GetAssetRegistry() {
+#if ENGINE_MINOR_VERSION >= 26
+	return IAssetRegistry::GetChecked();
+#else
+	return Get();
+#endif
+}
 
 int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 	TArray<FString> Tokens, Switches;
@@ -69,6 +71,11 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 
 	const bool bRefreshExistingAssets = !Switches.Contains(TEXT("NoRefresh"));
 	const bool bGeneratePublicProject = Switches.Contains(TEXT("PublicProject"));
+	const bool bForceSingleThread = Switches.Contains(TEXT("ForceSingleThread"));
+	const bool bUseDumpIndex = !Switches.Contains(TEXT("NoDumpIndex"));
+	const bool bRebuildDumpIndex = Switches.Contains(TEXT("RebuildDumpIndex"));
+	const bool bUseAssetRegistryCache = !Switches.Contains(TEXT("NoAssetRegistryCache"));
+	const bool bFullAssetRegistryRescan = Switches.Contains(TEXT("FullAssetRegistryRescan"));
 
 	FString DumpDirectory;
 	{
@@ -83,6 +90,11 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 		}
 	}
 
+	//Rebuild dump index from the dump files if requested, for dumps made without it or modified by hand
+	if (bRebuildDumpIndex) {
+		FAssetDumpIndex::RebuildFromDumpDirectory(DumpDirectory)->SaveToDumpDirectory(DumpDirectory);
+	}
+
 	TSharedPtr<TSet<FName>> WhitelstedAssetClasses;
 	{
 		FString AssetClassWhitelistString;
@@ -114,8 +126,19 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 		}
 	}
 
-	//Build a list of packages to skip saving for in final save pass
-	TArray<FString> InMemoryPackagesToSkip;
+	//Time budget per tick, falls back to the fixed amount of generators per tick if not specified
+	float TickTimeBudgetMs = 0.0f;
+	FParse::Value(*Params, TEXT("TickTimeBudgetMs="), TickTimeBudgetMs);
+
+	FString TimingStatsFilePath;
+	FParse::Value(*Params, TEXT("TimingStatsFile="), TimingStatsFilePath);
+
+	//Memory usage the garbage collection controller tries to stay below, enables adaptive garbage collection if specified
+	int32 GCMemoryCeilingMB = 0;
+	FParse::Value(*Params, TEXT("GCMemoryCeilingMB="), GCMemoryCeilingMB);
+
+	//Build a list of packages to skip saving for in final save pass, same as for the blacklist lines ending with / are matched recursively
+	FPackageNameMatcher InMemoryPackagesToSkip;
 	{
 		FString SkipSavePackagesFile;
 		if (FParse::Value(*Params, TEXT("SkipSavePackages="), SkipSavePackagesFile)) {
@@ -127,12 +150,18 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 
 			FString ResultFileContents;
 			FFileHelper::LoadFileToString(ResultFileContents, *SkipSavePackagesFile);
-			ResultFileContents.ParseIntoArrayLines(InMemoryPackagesToSkip);
+
+			TArray<FString> PackageNamesLines;
+			ResultFileContents.ParseIntoArrayLines(PackageNamesLines);
+
+			for (const FString& PackageNameOrPath : PackageNamesLines) {
+				InMemoryPackagesToSkip.AddRule(PackageNameOrPath);
+			}
 		}
 	}
 
-	//Build a blacklist function
-	TFunction<bool(const FString& PackageName)> PackageNameBlacklistFilter = [](const FString& PackageName) { return true; };
+	//Build a blacklist matcher, wildcard paths ending with / are matched recursively and everything else is an exact package name
+	const TSharedRef<FPackageNameMatcher> PackageNameBlacklist = MakeShareable(new FPackageNameMatcher());
 	{
 		FString BlacklistPackageNamesFile;
 		if (FParse::Value(*Params, TEXT("BlacklistPackageNames="), BlacklistPackageNamesFile)) {
@@ -148,31 +177,11 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 			TArray<FString> PackageNamesLines;
 			ResultFileContents.ParseIntoArrayLines(PackageNamesLines);
 
-			TSet<FString> BlacklistPackageNames;
-			TArray<FString> WildcardBlacklistedPaths;
-
 			for (const FString& PackageNameOrPath : PackageNamesLines) {
-				if (PackageNameOrPath.EndsWith(TEXT("/"))) {
-					//Wildcard path - add to array for fast iteration
-					WildcardBlacklistedPaths.Add(PackageNameOrPath);
-				}
-				else {
-					//Exact package name - add to set for instant lookup
-					BlacklistPackageNames.Add(PackageNameOrPath);
-				}
+				PackageNameBlacklist->AddRule(PackageNameOrPath);
 			}
-
-			PackageNameBlacklistFilter = [=](const FString& PackageName) {
-				if (BlacklistPackageNames.Contains(PackageName)) {
-					return false;
-				}
-				for (const FString& PackagePath : WildcardBlacklistedPaths) {
-					if (PackageName.StartsWith(PackagePath)) {
-						return false;
-					}
-				}
-				return true;
-			};
+			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Loaded package blacklist with %d package names and %d package paths"),
+				PackageNameBlacklist->GetNumPackageNames(), PackageNameBlacklist->GetNumPackagePaths());
 		}
 	}
 
@@ -181,13 +190,23 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 	Configuration.DumpRootDirectory = DumpDirectory;
 	Configuration.bRefreshExistingAssets = bRefreshExistingAssets;
 	Configuration.bGeneratePublicProject = bGeneratePublicProject;
+	Configuration.bForceSingleThread = bForceSingleThread;
+	if (!PackageNameBlacklist->IsEmpty()) {
+		Configuration.PackageBlacklist = PackageNameBlacklist;
+	}
+	Configuration.TickTimeBudgetMs = TickTimeBudgetMs;
+	Configuration.TimingStatsFilePath = TimingStatsFilePath;
 
 	//Populate the initial list of the packages with asset category filters applied
 	TArray<FName> ResultPackagesToGenerate;
 	{
 		TArray<FName> GeneratedPackageNames;
-		const TSharedPtr<FAssetDumpTreeNode> RootNode = FAssetDumpTreeNode::CreateRootTreeNode(DumpDirectory);
+		const double TreePopulationStartTime = FPlatformTime::Seconds();
+		const TSharedPtr<FAssetDumpTreeNode> RootNode = FAssetDumpTreeNode::CreateRootTreeNode(DumpDirectory, bUseDumpIndex);
 		RootNode->PopulateGeneratedPackages(GeneratedPackageNames, WhitelstedAssetClasses.Get());
+		
+		UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Discovered %d dumped packages in %.2f seconds (%s)"), GeneratedPackageNames.Num(),
+			FPlatformTime::Seconds() - TreePopulationStartTime, RootNode->DumpIndex.IsValid() ? TEXT("using dump index") : TEXT("scanning dump directory"));
 
 		if (GeneratedPackageNames.Num() == 0) {
 			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("No assets matching the specified category whitelist found"));
@@ -208,7 +227,7 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 			if (PackagesAlreadyAdded.Contains(GeneratedPackageName)) {
 				continue;
 			}
-			if (!PackageNameBlacklistFilter(GeneratedPackageName.ToString())) {
+			if (PackageNameBlacklist->Matches(GeneratedPackageName)) {
 				continue;
 			}
 			ResultPackagesToGenerate.Add(GeneratedPackageName);
@@ -219,27 +238,51 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 	//Print the amount of assets to be generated and start the generation processor
 	UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Starting generation of %d game assets"), ResultPackagesToGenerate.Num());
 
-	//Synchronize asset registry state with the current assets we have on the disk
+	//Synchronize asset registry state with the current assets we have on the disk,
+	//reusing the state cached by the previous run if the content directory has not changed since then
 	ClearEmptyGamePackagesLoadedDuringDisregardGC();
-#if ENGINE_MINOR_VERSION >= 26
-	IAssetRegistry::GetChecked().SearchAllAssets(true);
-#else
-	Get().SearchAllAssets(true);
-#endif 
+	bool bLoadedCachedAssetRegistryState = false;
+	{
+		const double RegistryScanStartTime = FPlatformTime::Seconds();
+		const FString ContentStateKey = bUseAssetRegistryCache ? FAssetRegistryStateCache::ComputeContentStateKey() : FString();
+		const double ContentStateKeyTime = FPlatformTime::Seconds() - RegistryScanStartTime;
+		
+		bLoadedCachedAssetRegistryState = bUseAssetRegistryCache && FAssetRegistryStateCache::TryLoadCachedState(GetAssetRegistry(), ContentStateKey);
+		if (bLoadedCachedAssetRegistryState) {
+			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Loaded cached asset registry state in %.2f seconds (content directory state computed in %.2f seconds)"),
+				FPlatformTime::Seconds() - RegistryScanStartTime, ContentStateKeyTime);
+		} else {
+			GetAssetRegistry().SearchAllAssets(true);
+			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Pre-generation asset registry scan took %.2f seconds"), FPlatformTime::Seconds() - RegistryScanStartTime);
+		}
+	}
 	ProcessDeferredCommands();
-	FAssetGeneratorGCController AssetGeneratorGCController{};
+	FAssetGeneratorGCController AssetGeneratorGCController{20.0f, 32, (uint64) FMath::Max(GCMemoryCeilingMB, 0)};
+	if (AssetGeneratorGCController.IsAdaptive()) {
+		UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Using adaptive garbage collection with memory ceiling of %dMB"), GCMemoryCeilingMB);
+	}
 	AssetGeneratorGCController.ConditionallyCollectGarbage();
 
+	//Dirty packages are tracked by the module since before the engine has loaded any packages, saved packages only need to be tracked from now on
+	const TSharedPtr<FDirtyPackageTracker> DirtyPackageTracker = FModuleManager::GetModuleChecked<FAssetGeneratorModule>(TEXT("AssetGenerator")).GetDirtyPackageTracker();
+	checkf(DirtyPackageTracker.IsValid(), TEXT("Asset generator module has not been started as a part of the commandlet run"));
+	FSavedPackageTracker SavedPackageTracker;
+
 	//We always want to tick the generator manually, even though without engine ticking game objects will not be processed anyway
 	Configuration.bTickOnTheSide = true;
 	TSharedPtr<FAssetGenerationProcessor> GenerationProcessor = FAssetGenerationProcessor::CreateAssetGenerator(Configuration, ResultPackagesToGenerate);
 
+	const double GenerationLoopStartTime = FPlatformTime::Seconds();
+	double TimeSpentWaitingForShaders = 0.0;
+	
 	while (!GenerationProcessor->HasFinishedAssetGeneration()) {
 		int32 GeneratedPkgCount = 0;
 		GenerationProcessor->TickOnTheSide(GeneratedPkgCount);
 
-		// Flush the asset registry before GC
-		FAssetRegistryModule::TickAssetRegistry(-1.0f);
+		//Flush the asset registry before GC. Cached state has no background scan results to pick up
+		if (!bLoadedCachedAssetRegistryState) {
+			FAssetRegistryModule::TickAssetRegistry(-1.0f);
+		}
 
 		AssetGeneratorGCController.Update(GeneratedPkgCount);
 		AssetGeneratorGCController.ConditionallyCollectGarbage();
@@ -247,44 +290,79 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 		//process deferred commands
 		ProcessDeferredCommands();
 
-		//Tick shader compilation if we have any pending async shader jobs
-		while (GShaderCompilingManager->HasShaderJobs()) {
-
-			// force at least a tick shader compilation even if we are requesting stuff
+		//Pick up finished shader jobs without blocking, generators not depending on the materials being compiled keep advancing meanwhile
+		if (GShaderCompilingManager->HasShaderJobs()) {
 			GShaderCompilingManager->ProcessAsyncResults(true, false);
 
-			ProcessDeferredCommands();
-			AssetGeneratorGCController.ConditionallyCollectGarbage();
+			//Nothing else to do until the shaders are compiled, so sleep instead of spinning
+			if (GenerationProcessor->IsBlockedOnShaderCompilation()) {
+				const double SleepStartTime = FPlatformTime::Seconds();
+				FPlatformProcess::Sleep(SHADER_COMPILATION_IDLE_SLEEP_SECONDS);
+				TimeSpentWaitingForShaders += FPlatformTime::Seconds() - SleepStartTime;
+			}
 		}
 	}
 
-	//Save any packages that are still in memory and have dirty flag
-	TArray<UPackage*> InMemoryDirtyPackages;
-
-	for (TObjectIterator<UPackage> It; It; ++It) {
-		UPackage* Package = *It;
-		if (Package->IsDirty() && !InMemoryPackagesToSkip.Contains(Package->GetName())) {
-			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Scheduling save of dirty package %s"), *Package->GetName());
-			InMemoryDirtyPackages.Add(Package);
+	//Packages are going to be saved once again below, make sure their shader maps are complete by then
+	while (GShaderCompilingManager->HasShaderJobs()) {
+		const double WaitStartTime = FPlatformTime::Seconds();
+		GShaderCompilingManager->ProcessAsyncResults(true, false);
+		ProcessDeferredCommands();
+		AssetGeneratorGCController.ConditionallyCollectGarbage();
+		
+		if (GShaderCompilingManager->HasShaderJobs()) {
+			FPlatformProcess::Sleep(SHADER_COMPILATION_IDLE_SLEEP_SECONDS);
 		}
+		TimeSpentWaitingForShaders += FPlatformTime::Seconds() - WaitStartTime;
 	}
+	UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Asset generation loop took %.2f seconds, %.2f seconds of which were spent idle waiting for shader compilation"),
+		FPlatformTime::Seconds() - GenerationLoopStartTime, TimeSpentWaitingForShaders);
+
+	//Material packages saved while their shaders were still compiling are saved once again by the final save pass, now that compilation is drained
+	const int32 PackagesSavedBeforeCompilation = GenerationProcessor->GetMaterialCompilationTracker().MarkPackagesSavedBeforeCompilationDirty();
+	if (PackagesSavedBeforeCompilation != 0) {
+		UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("%d material packages have been saved before their shaders were compiled, they will be saved again"), PackagesSavedBeforeCompilation);
+	}
+
+	AssetGeneratorGCController.PrintSummaryIntoTheLog();
+
+	//Save any packages that are still in memory and have dirty flag
+	TArray<UPackage*> InMemoryDirtyPackages;
+	DirtyPackageTracker->GetDirtyPackages(InMemoryPackagesToSkip, InMemoryDirtyPackages);
 
 	if (InMemoryDirtyPackages.Num()) {
-		UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saving %d in-memory dirty packages after the asset generation is done"), InMemoryDirtyPackages.Num());
+		UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saving %d in-memory dirty packages after the asset generation is done (%d packages tracked)"),
+			InMemoryDirtyPackages.Num(), DirtyPackageTracker->GetNumTrackedPackages());
+		const double SavePassStartTime = FPlatformTime::Seconds();
+
+		for (int32 BatchStartIndex = 0; BatchStartIndex < InMemoryDirtyPackages.Num(); BatchStartIndex += DIRTY_PACKAGES_SAVE_BATCH_SIZE) {
+			const int32 BatchSize = FMath::Min(DIRTY_PACKAGES_SAVE_BATCH_SIZE, InMemoryDirtyPackages.Num() - BatchStartIndex);
+			const TArray<UPackage*> PackageBatch(InMemoryDirtyPackages.GetData() + BatchStartIndex, BatchSize);
 
-		for (UPackage* Package : InMemoryDirtyPackages) {
-			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saving dirty package %s"), *Package->GetName());
-			UEditorLoadingAndSavingUtils::SavePackages({ Package }, true);
+			for (UPackage* Package : PackageBatch) {
+				UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saving dirty package %s"), *Package->GetName());
+			}
+			const double BatchStartTime = FPlatformTime::Seconds();
+			UEditorLoadingAndSavingUtils::SavePackages(PackageBatch, true);
+			
+			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saved batch of %d dirty packages in %.2f seconds"), BatchSize, FPlatformTime::Seconds() - BatchStartTime);
 		}
+		UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saved in-memory dirty packages in %.2f seconds"), FPlatformTime::Seconds() - SavePassStartTime);
 		AssetGeneratorGCController.ConditionallyCollectGarbage();
 	}
 
-	//Synchronize asset registry state with all of the new packages we created
-#if ENGINE_MINOR_VERSION >= 26
-	IAssetRegistry::GetChecked().SearchAllAssets(true);
-#else
-	Get().SearchAllAssets(true);
-#endif 
+	//Synchronize asset registry state with all of the new packages we created. Every package written
+	//during generation has been recorded by the tracker, so scanning just these files is enough,
+	//unless some of them have been written outside of the content directories the registry state covers
+	{
+		FAssetRegistryStateCache::ScanSavedPackages(GetAssetRegistry(), SavedPackageTracker.GetSavedPackageFiles(), bFullAssetRegistryRescan);
+
+		if (bUseAssetRegistryCache) {
+			const double CacheSaveStartTime = FPlatformTime::Seconds();
+			FAssetRegistryStateCache::SaveCachedState(GetAssetRegistry(), FAssetRegistryStateCache::ComputeContentStateKey());
+			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saved asset registry state cache in %.2f seconds"), FPlatformTime::Seconds() - CacheSaveStartTime);
+		}
+	}
 	UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Asset generation finished successfully"));
 	return 0;
 }
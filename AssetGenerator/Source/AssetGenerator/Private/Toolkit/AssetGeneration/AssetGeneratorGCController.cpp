@@ -0,0 +1,104 @@
+#include "Toolkit/AssetGeneration/AssetGeneratorGCController.h"
+#include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+#include "Misc/App.h"
+#include "UObject/UObjectArray.h"
+
+/** Garbage collection is forced once memory usage reaches this fraction of the memory ceiling */
+#define GC_MEMORY_PRESSURE_THRESHOLD 0.85f
+/** Collections freeing less than this amount of objects are considered low yield */
+#define GC_LOW_YIELD_OBJECT_COUNT 2000
+/** Maximum multiplier applied to the collection interval when collections keep yielding little */
+#define GC_MAX_INTERVAL_MULTIPLIER 8
+
+FAssetGeneratorGCSample FAssetGeneratorGCSample::Capture() {
+	return FAssetGeneratorGCSample(FPlatformMemory::GetStats().UsedPhysical / (1024 * 1024), GUObjectArray.GetObjectArrayNumMinusAvailable());
+}
+
+FAssetGeneratorGCController::FAssetGeneratorGCController(const float MaxSecondsBetweenGC, const int32 MaxPackagesBetweenGC, const uint64 MemoryCeilingMB) {
+	this->PackagesCookedSinceLastGC = 0;
+	this->LastGCTimestamp = 0.0f;
+	this->MaxSecondsBetweenGC = MaxSecondsBetweenGC;
+	this->MaxPackagesBetweenGC = MaxPackagesBetweenGC;
+	this->MemoryCeilingMB = MemoryCeilingMB;
+	this->IntervalMultiplier = 1;
+	this->LastGCObjectsFreed = 0;
+	this->NumCollections = 0;
+	this->TotalObjectsFreed = 0;
+}
+
+void FAssetGeneratorGCController::Update(const int32 PackagesGeneratedThisTick) {
+	this->PackagesCookedSinceLastGC += PackagesGeneratedThisTick;
+}
+
+bool FAssetGeneratorGCController::ShouldCollectGarbage(const FAssetGeneratorGCSample& Sample, const double CurrentTime, FString& OutReason) const {
+	if (IsAdaptive()) {
+		const uint64 PressureThresholdMB = (uint64) (MemoryCeilingMB * GC_MEMORY_PRESSURE_THRESHOLD);
+		if (Sample.UsedPhysicalMB >= PressureThresholdMB) {
+			//Collecting right after a low yield collection with no new packages generated will not free anything
+			if (LastGCObjectsFreed < GC_LOW_YIELD_OBJECT_COUNT && PackagesCookedSinceLastGC == 0 && NumCollections != 0) {
+				return false;
+			}
+			OutReason = FString::Printf(TEXT("memory usage %lluMB is above %lluMB (ceiling %lluMB)"), Sample.UsedPhysicalMB, PressureThresholdMB, MemoryCeilingMB);
+			return true;
+		}
+	}
+	const int32 PackagesBetweenGC = MaxPackagesBetweenGC * IntervalMultiplier;
+	const double SecondsBetweenGC = MaxSecondsBetweenGC * IntervalMultiplier;
+	
+	if (PackagesCookedSinceLastGC >= PackagesBetweenGC) {
+		OutReason = FString::Printf(TEXT("%d packages generated since the last collection"), PackagesCookedSinceLastGC);
+		return true;
+	}
+	if (CurrentTime - LastGCTimestamp >= SecondsBetweenGC) {
+		OutReason = FString::Printf(TEXT("%.1f seconds passed since the last collection"), CurrentTime - LastGCTimestamp);
+		return true;
+	}
+	return false;
+}
+
+void FAssetGeneratorGCController::RecordCollection(const FAssetGeneratorGCSample& SampleBefore, const FAssetGeneratorGCSample& SampleAfter, const double CurrentTime) {
+	this->LastGCObjectsFreed = FMath::Max(SampleBefore.NumObjects - SampleAfter.NumObjects, 0);
+	this->NumCollections++;
+	this->TotalObjectsFreed += LastGCObjectsFreed;
+	this->PackagesCookedSinceLastGC = 0;
+	this->LastGCTimestamp = CurrentTime;
+
+	if (!IsAdaptive()) {
+		return;
+	}
+	const int32 OldIntervalMultiplier = IntervalMultiplier;
+	if (LastGCObjectsFreed < GC_LOW_YIELD_OBJECT_COUNT) {
+		this->IntervalMultiplier = FMath::Min(IntervalMultiplier * 2, GC_MAX_INTERVAL_MULTIPLIER);
+	} else {
+		this->IntervalMultiplier = FMath::Max(IntervalMultiplier / 2, 1);
+	}
+	if (OldIntervalMultiplier != IntervalMultiplier) {
+		UE_LOG(LogAssetGenerator, Display, TEXT("Garbage collection interval changed from x%d to x%d after collection freed %d objects"),
+			OldIntervalMultiplier, IntervalMultiplier, LastGCObjectsFreed);
+	}
+	if (SampleAfter.UsedPhysicalMB >= MemoryCeilingMB) {
+		UE_LOG(LogAssetGenerator, Warning, TEXT("Memory usage %lluMB is still above the ceiling of %lluMB after garbage collection"),
+			SampleAfter.UsedPhysicalMB, MemoryCeilingMB);
+	}
+}
+
+void FAssetGeneratorGCController::ConditionallyCollectGarbage() {
+	const FAssetGeneratorGCSample SampleBefore = FAssetGeneratorGCSample::Capture();
+	FString CollectionReason;
+
+	if (ShouldCollectGarbage(SampleBefore, FApp::GetCurrentTime(), CollectionReason)) {
+		UE_LOG(LogAssetGenerator, Display, TEXT("Collecting garbage: %s"), *CollectionReason);
+		const double CollectionStartTime = FPlatformTime::Seconds();
+		CollectGarbage(RF_Standalone);
+
+		const FAssetGeneratorGCSample SampleAfter = FAssetGeneratorGCSample::Capture();
+		RecordCollection(SampleBefore, SampleAfter, FApp::GetCurrentTime());
+		
+		UE_LOG(LogAssetGenerator, Display, TEXT("Garbage collection took %.2f seconds, freed %d objects, memory usage %lluMB -> %lluMB"),
+			FPlatformTime::Seconds() - CollectionStartTime, LastGCObjectsFreed, SampleBefore.UsedPhysicalMB, SampleAfter.UsedPhysicalMB);
+	}
+}
+
+void FAssetGeneratorGCController::PrintSummaryIntoTheLog() const {
+	UE_LOG(LogAssetGenerator, Display, TEXT("Garbage was collected %d times, freeing %lld objects in total"), NumCollections, TotalObjectsFreed);
+}
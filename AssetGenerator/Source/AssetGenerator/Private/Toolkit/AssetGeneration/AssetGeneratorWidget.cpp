@@ -64,6 +64,7 @@ FReply SAssetGeneratorWidget::OnGenerateAssetsButtonPressed() {
 	Configuration.DumpRootDirectory = GetAssetDumpFolderPath();
 	Configuration.bRefreshExistingAssets = LocalSettings->bRefreshExistingAssets;
 	Configuration.MaxAssetsToAdvancePerTick = LocalSettings->MaxAssetsToAdvancePerTick;
+	Configuration.TickTimeBudgetMs = LocalSettings->TickTimeBudgetMs;
 	Configuration.bGeneratePublicProject = LocalSettings->bGeneratePublicProject;
 	
 	FAssetGenerationProcessor::CreateAssetGenerator(Configuration, SelectedAssetPackages);
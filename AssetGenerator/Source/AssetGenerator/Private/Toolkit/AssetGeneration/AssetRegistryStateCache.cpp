@@ -0,0 +1,140 @@
+#include "Toolkit/AssetGeneration/AssetRegistryStateCache.h"
+#include "AssetRegistryModule.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+
+static FString GetAssetRegistryCacheFilePath() {
+	return FPaths::ProjectIntermediateDir() / TEXT("AssetGenerator") / TEXT("CachedAssetRegistry.bin");
+}
+
+static FString GetAssetRegistryCacheKeyFilePath() {
+	return FPaths::ProjectIntermediateDir() / TEXT("AssetGenerator") / TEXT("CachedAssetRegistry.key");
+}
+
+/** Appends path, size and modification time of the provided file to the state entries, if the file exists */
+static void AddFileState(IPlatformFile& PlatformFile, const FString& FilePath, TArray<FString>& OutFileStates) {
+	const FFileStatData StatData = PlatformFile.GetStatData(*FilePath);
+	if (StatData.bIsValid && !StatData.bIsDirectory) {
+		OutFileStates.Add(FString::Printf(TEXT("%s|%lld|%s"), *FilePath, StatData.FileSize, *StatData.ModificationTime.ToString()));
+	}
+}
+
+/** Appends path, size and modification time of every file in the provided directory to the state entries */
+static void AddDirectoryFileStates(IPlatformFile& PlatformFile, const FString& Directory, TArray<FString>& OutFileStates) {
+	PlatformFile.IterateDirectoryStatRecursively(*Directory, [&](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData) {
+		if (!StatData.bIsDirectory) {
+			OutFileStates.Add(FString::Printf(TEXT("%s|%lld|%s"), FilenameOrDirectory, StatData.FileSize, *StatData.ModificationTime.ToString()));
+		}
+		return true;
+	});
+}
+
+TArray<FString> FAssetRegistryStateCache::GetContentDirectories() {
+	TArray<FString> ContentDirectories;
+	ContentDirectories.Add(FPaths::ProjectContentDir());
+	ContentDirectories.Add(FPaths::EngineContentDir());
+
+	//Enabled plugins, including the engine ones, mount their content directories too
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPlugins()) {
+		if (Plugin->CanContainContent()) {
+			ContentDirectories.Add(Plugin->GetContentDir());
+		}
+	}
+
+	//Normalize paths so they can be compared against the saved package file paths
+	for (FString& ContentDirectory : ContentDirectories) {
+		ContentDirectory = FPaths::ConvertRelativePathToFull(ContentDirectory);
+		FPaths::NormalizeDirectoryName(ContentDirectory);
+		ContentDirectory.AppendChar(TEXT('/'));
+	}
+	return ContentDirectories;
+}
+
+FString FAssetRegistryStateCache::ComputeContentStateKey() {
+	//Stat every file in the content directories, which is much cheaper than the registry scan reading package headers
+	TArray<FString> ContentFileStates;
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	for (const FString& ContentDirectory : GetContentDirectories()) {
+		AddDirectoryFileStates(PlatformFile, ContentDirectory, ContentFileStates);
+	}
+	AddDirectoryFileStates(PlatformFile, FPaths::ProjectConfigDir(), ContentFileStates);
+	AddFileState(PlatformFile, FPaths::GetProjectFilePath(), ContentFileStates);
+
+	//Enabling or updating a plugin changes its descriptor, even if it has no content
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPlugins()) {
+		AddFileState(PlatformFile, Plugin->GetDescriptorFileName(), ContentFileStates);
+	}
+	
+	//Iteration order is not guaranteed, so sort the entries to get a stable key
+	ContentFileStates.Sort();
+	ContentFileStates.Add(FEngineVersion::Current().ToString());
+
+	FMD5 ContentStateHash;
+	for (const FString& ContentFileState : ContentFileStates) {
+		const FTCHARToUTF8 ContentFileStateUTF8(*ContentFileState);
+		ContentStateHash.Update((const uint8*) ContentFileStateUTF8.Get(), ContentFileStateUTF8.Length());
+	}
+	uint8 Digest[16];
+	ContentStateHash.Final(Digest);
+	return BytesToHex(Digest, 16);
+}
+
+bool FAssetRegistryStateCache::TryLoadCachedState(IAssetRegistry& AssetRegistry, const FString& ContentStateKey) {
+	FString CachedContentStateKey;
+	if (!FFileHelper::LoadFileToString(CachedContentStateKey, *GetAssetRegistryCacheKeyFilePath()) || CachedContentStateKey != ContentStateKey) {
+		return false;
+	}
+	
+	const TUniquePtr<FArchive> CacheFileReader(IFileManager::Get().CreateFileReader(*GetAssetRegistryCacheFilePath()));
+	if (!CacheFileReader.IsValid()) {
+		return false;
+	}
+	AssetRegistry.Serialize(*CacheFileReader);
+	return !CacheFileReader->IsError();
+}
+
+void FAssetRegistryStateCache::SaveCachedState(IAssetRegistry& AssetRegistry, const FString& ContentStateKey) {
+	const TUniquePtr<FArchive> CacheFileWriter(IFileManager::Get().CreateFileWriter(*GetAssetRegistryCacheFilePath()));
+	if (!CacheFileWriter.IsValid()) {
+		UE_LOG(LogAssetGenerator, Warning, TEXT("Failed to write asset registry cache file %s"), *GetAssetRegistryCacheFilePath());
+		return;
+	}
+	AssetRegistry.Serialize(*CacheFileWriter);
+	
+	//Only write the key once the state has been written successfully, so a broken cache file is never picked up
+	if (CacheFileWriter->Close()) {
+		FFileHelper::SaveStringToFile(ContentStateKey, *GetAssetRegistryCacheKeyFilePath());
+	}
+}
+
+bool FAssetRegistryStateCache::HasFilesOutsideOfContentDirectories(const TArray<FString>& PackageFiles, const TArray<FString>& ContentDirectories) {
+	for (const FString& PackageFile : PackageFiles) {
+		const bool bInsideContentDirectory = ContentDirectories.ContainsByPredicate([&](const FString& ContentDirectory) {
+			return PackageFile.StartsWith(ContentDirectory);
+		});
+		if (!bInsideContentDirectory) {
+			UE_LOG(LogAssetGenerator, Display, TEXT("Package file %s is located outside of the cached content directories"), *PackageFile);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FAssetRegistryStateCache::ScanSavedPackages(IAssetRegistry& AssetRegistry, const TArray<FString>& SavedPackageFiles, const bool bForceFullRescan) {
+	const double RegistryScanStartTime = FPlatformTime::Seconds();
+
+	//Files outside of the known content directories belong to content roots the cached state knows nothing about, so it cannot be updated incrementally
+	if (bForceFullRescan || HasFilesOutsideOfContentDirectories(SavedPackageFiles, GetContentDirectories())) {
+		AssetRegistry.SearchAllAssets(true);
+		UE_LOG(LogAssetGenerator, Display, TEXT("Post-generation full asset registry scan took %.2f seconds"), FPlatformTime::Seconds() - RegistryScanStartTime);
+		return true;
+	}
+	AssetRegistry.ScanFilesSynchronous(SavedPackageFiles, true);
+	UE_LOG(LogAssetGenerator, Display, TEXT("Post-generation asset registry scan of %d saved packages took %.2f seconds"),
+		SavedPackageFiles.Num(), FPlatformTime::Seconds() - RegistryScanStartTime);
+	return false;
+}
@@ -51,6 +51,7 @@ UAssetTypeGenerator::UAssetTypeGenerator() {
 	this->bHasAssetEverBeenChanged = false;
 	this->bIsGeneratingPublicProject = false;
 	this->bSkipAnim = true;
+	this->bCurrentStagePrepared = false;
 }
 
 void UAssetTypeGenerator::InitializeInternal(const FString& DumpRootDirectory, const FString& InPackageBaseDirectory, const FName InPackageName, const TSharedPtr<FJsonObject> RootFileObject, bool bGeneratePublicProject) {
@@ -155,6 +156,20 @@ void UAssetTypeGenerator::PreFinishAssetGeneration() {
 	this->bIsStageNotOverriden = true;
 }
 
+void UAssetTypeGenerator::PrepareCurrentStage() {
+	if (!bCurrentStagePrepared) {
+		this->PreparedStageDependencies.Reset();
+		PrepareStage(CurrentStage, PreparedStageDependencies);
+		this->bCurrentStagePrepared = true;
+	}
+}
+
+void UAssetTypeGenerator::CollectStageDependencies(TArray<FPackageDependency>& OutDependencies) {
+	PrepareCurrentStage();
+	OutDependencies.Append(PreparedStageDependencies);
+	PopulateStageDependencies(OutDependencies);
+}
+
 FGeneratorStateAdvanceResult UAssetTypeGenerator::AdvanceGenerationState() {
 	if (this->PackageName == "/Game/PostProcess/MaxComponent") {
 		UE_LOG(LogTemp, Warning, TEXT("Amogus!"));
@@ -167,6 +182,9 @@ FGeneratorStateAdvanceResult UAssetTypeGenerator::AdvanceGenerationState() {
 		return FGeneratorStateAdvanceResult{ CurrentStage, false };
 	}
 
+	//Make sure stage has been prepared, normally it is already done by the processor before gathering dependencies
+	PrepareCurrentStage();
+
 	//Dispatch current stage call to the appropriate method
 	if (CurrentStage == EAssetGenerationStage::CONSTRUCTION) {
 		this->ConstructAssetAndPackage();
@@ -181,8 +199,10 @@ FGeneratorStateAdvanceResult UAssetTypeGenerator::AdvanceGenerationState() {
 		if (AssetObject != NULL) this->PreFinishAssetGeneration();
 	}
 
-	//Increment current generation stage
+	//Increment current generation stage, new stage will need to be prepared again
 	this->CurrentStage = (EAssetGenerationStage)((int32)CurrentStage + 1);
+	this->bCurrentStagePrepared = false;
+	this->PreparedStageDependencies.Reset();
 
 	//Force package to be saved to disk if it has been marked as changed, which should have also marked it as dirty
 	if (bAssetChanged) {
@@ -210,9 +230,8 @@ FString UAssetTypeGenerator::GetAssetFilePath(const FString& RootDirectory, FNam
 	return FPaths::Combine(PackageBaseDirectory, AssetDumpFilename);
 }
 
-UAssetTypeGenerator* UAssetTypeGenerator::InitializeFromFile(const FString& RootDirectory, const FName PackageName, bool bGeneratePublicProject) {
+TSharedPtr<FJsonObject> UAssetTypeGenerator::LoadAssetDumpFile(const FString& RootDirectory, const FName PackageName) {
 	const FString AssetDumpFilePath = GetAssetFilePath(RootDirectory, PackageName);
-	const FString PackageBaseDirectory = FPaths::GetPath(AssetDumpFilePath);
 
 	//Return early if dump file is not found for this asset
 	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*AssetDumpFilePath)) {
@@ -231,6 +250,16 @@ UAssetTypeGenerator* UAssetTypeGenerator::InitializeFromFile(const FString& Root
 		UE_LOG(LogAssetGenerator, Error, TEXT("Failed to parse asset dump file %s: invalid json"), *AssetDumpFilePath);
 		return NULL;
 	}
+	return RootFileObject;
+}
+
+UAssetTypeGenerator* UAssetTypeGenerator::InitializeFromDumpData(const FString& RootDirectory, const FName PackageName, const TSharedPtr<FJsonObject> RootFileObject, bool bGeneratePublicProject) {
+	check(IsInGameThread());
+	if (!RootFileObject.IsValid()) {
+		return NULL;
+	}
+	const FString AssetDumpFilePath = GetAssetFilePath(RootDirectory, PackageName);
+	const FString PackageBaseDirectory = FPaths::GetPath(AssetDumpFilePath);
 
 	const FName AssetClass = FName(*RootFileObject->GetStringField(TEXT("AssetClass")));
 	UClass* AssetTypeGenerator = FindGeneratorForClass(AssetClass);
@@ -244,6 +273,11 @@ UAssetTypeGenerator* UAssetTypeGenerator::InitializeFromFile(const FString& Root
 	return NewGenerator;
 }
 
+UAssetTypeGenerator* UAssetTypeGenerator::InitializeFromFile(const FString& RootDirectory, const FName PackageName, bool bGeneratePublicProject) {
+	const TSharedPtr<FJsonObject> RootFileObject = LoadAssetDumpFile(RootDirectory, PackageName);
+	return InitializeFromDumpData(RootDirectory, PackageName, RootFileObject, bGeneratePublicProject);
+}
+
 //Static class used to lazily populate serializer registry
 class FAssetTypeGeneratorRegistry {
 public:
@@ -0,0 +1,26 @@
+#include "Toolkit/AssetGeneration/DirtyPackageTracker.h"
+#include "Util/PackageNameMatcher.h"
+
+FDirtyPackageTracker::FDirtyPackageTracker() {
+	this->DirtyStateChangedHandle = UPackage::PackageDirtyStateChangedEvent.AddRaw(this, &FDirtyPackageTracker::OnPackageDirtyStateChanged);
+}
+
+FDirtyPackageTracker::~FDirtyPackageTracker() {
+	UPackage::PackageDirtyStateChangedEvent.Remove(DirtyStateChangedHandle);
+}
+
+void FDirtyPackageTracker::OnPackageDirtyStateChanged(UPackage* Package) {
+	//Packages cleaned afterwards are kept too, GetDirtyPackages checks the dirty flag again anyway
+	if (Package->IsDirty()) {
+		this->TrackedPackages.Add(Package);
+	}
+}
+
+void FDirtyPackageTracker::GetDirtyPackages(const FPackageNameMatcher& PackagesToSkip, TArray<UPackage*>& OutDirtyPackages) const {
+	for (const TWeakObjectPtr<UPackage>& PackagePtr : TrackedPackages) {
+		UPackage* Package = PackagePtr.Get();
+		if (Package != NULL && Package->IsDirty() && !PackagesToSkip.Matches(Package->GetFName())) {
+			OutDirtyPackages.Add(Package);
+		}
+	}
+}
@@ -0,0 +1,315 @@
+#include "Toolkit/AssetGeneration/DumpedMeshImporter.h"
+#include "Toolkit/AssetTypes/MeshDumpFormat.h"
+#include "Animation/Skeleton.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "IMeshBuilderModule.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "Modules/ModuleManager.h"
+#include "Rendering/SkeletalMeshLODImporterData.h"
+#include "Rendering/SkeletalMeshLODModel.h"
+#include "Rendering/SkeletalMeshModel.h"
+
+void FDumpedMeshImporter::PopulateMeshDescription(const FDumpedMeshLOD& LOD, const TArray<FString>& MaterialSlotNames, FMeshDescription& OutMeshDescription) {
+	FStaticMeshAttributes Attributes(OutMeshDescription);
+	Attributes.Register();
+
+	TVertexAttributesRef<FVector> VertexPositions = Attributes.GetVertexPositions();
+	TVertexInstanceAttributesRef<FVector> VertexInstanceNormals = Attributes.GetVertexInstanceNormals();
+	TVertexInstanceAttributesRef<FVector> VertexInstanceTangents = Attributes.GetVertexInstanceTangents();
+	TVertexInstanceAttributesRef<float> VertexInstanceBinormalSigns = Attributes.GetVertexInstanceBinormalSigns();
+	TVertexInstanceAttributesRef<FVector4> VertexInstanceColors = Attributes.GetVertexInstanceColors();
+	TVertexInstanceAttributesRef<FVector2D> VertexInstanceUVs = Attributes.GetVertexInstanceUVs();
+	TPolygonGroupAttributesRef<FName> PolygonGroupMaterialSlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+
+	const int32 NumVertices = LOD.GetNumVertices();
+	const int32 NumTexCoords = FMath::Clamp(LOD.GetNumTexCoords(), 1, (int32) MAX_STATIC_TEXCOORDS);
+	VertexInstanceUVs.SetNumIndices(NumTexCoords);
+
+	OutMeshDescription.ReserveNewVertices(NumVertices);
+	OutMeshDescription.ReserveNewVertexInstances(NumVertices);
+	OutMeshDescription.ReserveNewPolygons(LOD.Indices.Num() / 3);
+
+	//Render data duplicates vertices along the UV and normal seams, weld them back so mesh keeps it's topology
+	TMap<FVector, FVertexID> WeldedVertices;
+	TArray<FVertexID> RenderVertexIDs;
+	TArray<FVertexInstanceID> RenderVertexInstanceIDs;
+	RenderVertexIDs.SetNumUninitialized(NumVertices);
+	RenderVertexInstanceIDs.SetNumUninitialized(NumVertices);
+
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++) {
+		const FVector& Position = LOD.Positions[VertexIndex];
+		const FVertexID* ExistingVertexID = WeldedVertices.Find(Position);
+		FVertexID VertexID;
+
+		if (ExistingVertexID != NULL) {
+			VertexID = *ExistingVertexID;
+		} else {
+			VertexID = OutMeshDescription.CreateVertex();
+			VertexPositions[VertexID] = Position;
+			WeldedVertices.Add(Position, VertexID);
+		}
+
+		const FVertexInstanceID VertexInstanceID = OutMeshDescription.CreateVertexInstance(VertexID);
+		VertexInstanceNormals[VertexInstanceID] = LOD.Normals[VertexIndex];
+		VertexInstanceTangents[VertexInstanceID] = FVector(LOD.Tangents[VertexIndex]);
+		VertexInstanceBinormalSigns[VertexInstanceID] = LOD.Tangents[VertexIndex].W;
+		VertexInstanceColors[VertexInstanceID] = LOD.HasVertexColors() ? FVector4(FLinearColor(LOD.Colors[VertexIndex])) : FVector4(1.0f, 1.0f, 1.0f, 1.0f);
+
+		for (int32 TexCoordIndex = 0; TexCoordIndex < FMath::Min(NumTexCoords, LOD.GetNumTexCoords()); TexCoordIndex++) {
+			VertexInstanceUVs.Set(VertexInstanceID, TexCoordIndex, LOD.TexCoords[TexCoordIndex][VertexIndex]);
+		}
+		RenderVertexIDs[VertexIndex] = VertexID;
+		RenderVertexInstanceIDs[VertexIndex] = VertexInstanceID;
+	}
+
+	//Sections sharing the material slot end up in the same polygon group
+	TMap<int32, FPolygonGroupID> MaterialPolygonGroups;
+	TArray<FVertexInstanceID> TriangleVertexInstanceIDs;
+	TriangleVertexInstanceIDs.SetNum(3);
+
+	for (const FDumpedMeshSection& Section : LOD.Sections) {
+		const FPolygonGroupID* ExistingPolygonGroupID = MaterialPolygonGroups.Find(Section.MaterialIndex);
+		FPolygonGroupID PolygonGroupID;
+
+		if (ExistingPolygonGroupID != NULL) {
+			PolygonGroupID = *ExistingPolygonGroupID;
+		} else {
+			PolygonGroupID = OutMeshDescription.CreatePolygonGroup();
+			PolygonGroupMaterialSlotNames[PolygonGroupID] = FName(*MaterialSlotNames[Section.MaterialIndex]);
+			MaterialPolygonGroups.Add(Section.MaterialIndex, PolygonGroupID);
+		}
+
+		for (int32 TriangleIndex = 0; TriangleIndex < Section.NumTriangles; TriangleIndex++) {
+			const int32 FirstIndex = Section.FirstIndex + TriangleIndex * 3;
+			const uint32 Index0 = LOD.Indices[FirstIndex];
+			const uint32 Index1 = LOD.Indices[FirstIndex + 1];
+			const uint32 Index2 = LOD.Indices[FirstIndex + 2];
+
+			//Welding can collapse triangles with zero area, and mesh description does not allow them
+			if (RenderVertexIDs[Index0] == RenderVertexIDs[Index1] ||
+				RenderVertexIDs[Index1] == RenderVertexIDs[Index2] ||
+				RenderVertexIDs[Index0] == RenderVertexIDs[Index2]) {
+				continue;
+			}
+			TriangleVertexInstanceIDs[0] = RenderVertexInstanceIDs[Index0];
+			TriangleVertexInstanceIDs[1] = RenderVertexInstanceIDs[Index1];
+			TriangleVertexInstanceIDs[2] = RenderVertexInstanceIDs[Index2];
+			OutMeshDescription.CreatePolygon(PolygonGroupID, TriangleVertexInstanceIDs);
+		}
+	}
+}
+
+bool FDumpedMeshImporter::ValidateMeshData(const FDumpedMeshData& MeshData, bool bSkeletalMesh, FString& OutErrorMessage) {
+	if (MeshData.LODs.Num() == 0) {
+		OutErrorMessage = TEXT("Mesh data has no LODs");
+		return false;
+	}
+	if (bSkeletalMesh && !MeshData.IsSkeletalMesh()) {
+		OutErrorMessage = TEXT("Mesh data has no reference skeleton");
+		return false;
+	}
+	//Skeletal mesh import data stores material indices as bytes, so meshes with more slots cannot be represented
+	const int32 MaxMaterialIndex = bSkeletalMesh ? MAX_uint8 : MAX_int32;
+	
+	for (int32 LODIndex = 0; LODIndex < MeshData.LODs.Num(); LODIndex++) {
+		for (const FDumpedMeshSection& Section : MeshData.LODs[LODIndex].Sections) {
+			if (Section.MaterialIndex < 0 || Section.MaterialIndex >= MeshData.MaterialSlotNames.Num()) {
+				OutErrorMessage = FString::Printf(TEXT("Section of LOD %d references material slot %d, but mesh only has %d material slots"),
+					LODIndex, Section.MaterialIndex, MeshData.MaterialSlotNames.Num());
+				return false;
+			}
+			if (Section.MaterialIndex > MaxMaterialIndex) {
+				OutErrorMessage = FString::Printf(TEXT("Section of LOD %d references material slot %d, but at most %d material slots are supported"),
+					LODIndex, Section.MaterialIndex, MaxMaterialIndex + 1);
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool FDumpedMeshImporter::BuildStaticMesh(UStaticMesh* StaticMesh, const FDumpedMeshData& MeshData, FString& OutErrorMessage) {
+	if (!ValidateMeshData(MeshData, false, OutErrorMessage)) {
+		return false;
+	}
+	StaticMesh->PreEditChange(NULL);
+
+	//Material interfaces are assigned later from the asset data, only slot names are needed to map sections to them
+	StaticMesh->StaticMaterials.Empty();
+	for (const FString& MaterialSlotName : MeshData.MaterialSlotNames) {
+		StaticMesh->StaticMaterials.Add(FStaticMaterial(NULL, *MaterialSlotName, *MaterialSlotName));
+	}
+
+	StaticMesh->SetNumSourceModels(MeshData.LODs.Num());
+	StaticMesh->bAutoComputeLODScreenSize = false;
+
+	for (int32 LODIndex = 0; LODIndex < MeshData.LODs.Num(); LODIndex++) {
+		const FDumpedMeshLOD& LOD = MeshData.LODs[LODIndex];
+		FStaticMeshSourceModel& SourceModel = StaticMesh->GetSourceModel(LODIndex);
+
+		//Render data already contains final normals, tangents and lightmap UVs, so they should be kept intact
+		SourceModel.BuildSettings.bRecomputeNormals = false;
+		SourceModel.BuildSettings.bRecomputeTangents = false;
+		SourceModel.BuildSettings.bGenerateLightmapUVs = false;
+		SourceModel.BuildSettings.bRemoveDegenerates = false;
+		SourceModel.ScreenSize.Default = LOD.ScreenSize;
+
+		FMeshDescription* MeshDescription = StaticMesh->CreateMeshDescription(LODIndex);
+		PopulateMeshDescription(LOD, MeshData.MaterialSlotNames, *MeshDescription);
+		StaticMesh->CommitMeshDescription(LODIndex);
+	}
+
+	StaticMesh->ImportVersion = EImportStaticMeshVersion::LastVersion;
+	StaticMesh->Build(true);
+	StaticMesh->PostEditChange();
+	return true;
+}
+
+/** Converts single dumped mesh LOD into the data consumed by the skeletal mesh builder */
+static void PopulateSkeletalMeshImportData(const FDumpedMeshLOD& LOD, const FDumpedMeshData& MeshData, FSkeletalMeshImportData& OutImportData) {
+	const int32 NumVertices = LOD.GetNumVertices();
+	const int32 NumTexCoords = FMath::Min(LOD.GetNumTexCoords(), (int32) MAX_TEXCOORDS);
+
+	OutImportData.NumTexCoords = FMath::Max(NumTexCoords, 1);
+	OutImportData.bHasNormals = true;
+	OutImportData.bHasTangents = true;
+	OutImportData.bHasVertexColors = LOD.HasVertexColors();
+
+	for (const FString& MaterialSlotName : MeshData.MaterialSlotNames) {
+		SkeletalMeshImportData::FMaterial& Material = OutImportData.Materials.AddDefaulted_GetRef();
+		Material.MaterialImportName = MaterialSlotName;
+	}
+
+	for (const FDumpedMeshBone& DumpedBone : MeshData.Bones) {
+		SkeletalMeshImportData::FBone& Bone = OutImportData.RefBonesBinary.AddDefaulted_GetRef();
+		Bone.Name = DumpedBone.Name;
+		Bone.Flags = 0;
+		Bone.NumChildren = 0;
+		Bone.ParentIndex = DumpedBone.ParentIndex;
+		Bone.BonePos.Transform = DumpedBone.Pose;
+		Bone.BonePos.Length = 1.0f;
+		Bone.BonePos.XSize = Bone.BonePos.YSize = Bone.BonePos.ZSize = 100.0f;
+
+		if (DumpedBone.ParentIndex != INDEX_NONE) {
+			OutImportData.RefBonesBinary[DumpedBone.ParentIndex].NumChildren++;
+		}
+	}
+
+	//Every render vertex becomes both a point and a wedge, welding is left to the skeletal mesh builder
+	OutImportData.Points = LOD.Positions;
+	OutImportData.PointToRawMap.SetNumUninitialized(NumVertices);
+	OutImportData.Wedges.SetNum(NumVertices);
+
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++) {
+		SkeletalMeshImportData::FVertex& Wedge = OutImportData.Wedges[VertexIndex];
+		Wedge.VertexIndex = VertexIndex;
+		Wedge.Color = LOD.HasVertexColors() ? LOD.Colors[VertexIndex] : FColor::White;
+
+		for (int32 TexCoordIndex = 0; TexCoordIndex < NumTexCoords; TexCoordIndex++) {
+			Wedge.UVs[TexCoordIndex] = LOD.TexCoords[TexCoordIndex][VertexIndex];
+		}
+		OutImportData.PointToRawMap[VertexIndex] = VertexIndex;
+
+		for (int32 InfluenceIndex = 0; InfluenceIndex < LOD.NumInfluencesPerVertex; InfluenceIndex++) {
+			const int32 InfluenceOffset = VertexIndex * LOD.NumInfluencesPerVertex + InfluenceIndex;
+			if (LOD.InfluenceWeights[InfluenceOffset] != 0) {
+				SkeletalMeshImportData::FRawBoneInfluence& Influence = OutImportData.Influences.AddDefaulted_GetRef();
+				Influence.VertexIndex = VertexIndex;
+				Influence.BoneIndex = LOD.InfluenceBones[InfluenceOffset];
+				Influence.Weight = LOD.InfluenceWeights[InfluenceOffset] / 255.0f;
+			}
+		}
+	}
+
+	for (const FDumpedMeshSection& Section : LOD.Sections) {
+		for (int32 TriangleIndex = 0; TriangleIndex < Section.NumTriangles; TriangleIndex++) {
+			SkeletalMeshImportData::FTriangle& Face = OutImportData.Faces.AddDefaulted_GetRef();
+			Face.MatIndex = (uint8) Section.MaterialIndex;
+			Face.AuxMatIndex = 0;
+			Face.SmoothingGroups = 1;
+
+			for (int32 CornerIndex = 0; CornerIndex < 3; CornerIndex++) {
+				const uint32 VertexIndex = LOD.Indices[Section.FirstIndex + TriangleIndex * 3 + CornerIndex];
+				const FVector4& Tangent = LOD.Tangents[VertexIndex];
+				const FVector TangentX = FVector(Tangent);
+				const FVector& TangentZ = LOD.Normals[VertexIndex];
+
+				Face.WedgeIndex[CornerIndex] = VertexIndex;
+				Face.TangentX[CornerIndex] = TangentX;
+				Face.TangentY[CornerIndex] = (TangentZ ^ TangentX) * Tangent.W;
+				Face.TangentZ[CornerIndex] = TangentZ;
+				OutImportData.Wedges[VertexIndex].MatIndex = (uint8) Section.MaterialIndex;
+			}
+		}
+	}
+}
+
+bool FDumpedMeshImporter::BuildSkeletalMesh(USkeletalMesh* SkeletalMesh, USkeleton* Skeleton, const FDumpedMeshData& MeshData, FString& OutErrorMessage) {
+	if (!ValidateMeshData(MeshData, true, OutErrorMessage)) {
+		return false;
+	}
+	SkeletalMesh->PreEditChange(NULL);
+
+	FReferenceSkeleton ReferenceSkeleton;
+	{
+		//Modifier rebuilds the reference skeleton once it goes out of scope
+		FReferenceSkeletonModifier ReferenceSkeletonModifier(ReferenceSkeleton, Skeleton);
+		for (const FDumpedMeshBone& Bone : MeshData.Bones) {
+			ReferenceSkeletonModifier.Add(FMeshBoneInfo(FName(*Bone.Name), Bone.Name, Bone.ParentIndex), Bone.Pose);
+		}
+	}
+	SkeletalMesh->RefSkeleton = ReferenceSkeleton;
+	SkeletalMesh->Skeleton = Skeleton;
+
+	//Material interfaces are assigned later from the asset data, only slot names are needed to map sections to them
+	SkeletalMesh->Materials.Empty();
+	for (const FString& MaterialSlotName : MeshData.MaterialSlotNames) {
+		SkeletalMesh->Materials.Add(FSkeletalMaterial(NULL, true, false, *MaterialSlotName, *MaterialSlotName));
+	}
+
+	FSkeletalMeshModel* ImportedModel = SkeletalMesh->GetImportedModel();
+	ImportedModel->LODModels.Empty();
+	SkeletalMesh->ResetLODInfo();
+	SkeletalMesh->bHasVertexColors = false;
+
+	IMeshBuilderModule& MeshBuilderModule = FModuleManager::LoadModuleChecked<IMeshBuilderModule>(TEXT("MeshBuilder"));
+	bool bMeshBuilt = true;
+
+	for (int32 LODIndex = 0; LODIndex < MeshData.LODs.Num(); LODIndex++) {
+		const FDumpedMeshLOD& LOD = MeshData.LODs[LODIndex];
+		ImportedModel->LODModels.Add(new FSkeletalMeshLODModel());
+
+		//Render data already contains final normals and tangents, so they should be kept intact
+		FSkeletalMeshLODInfo& LODInfo = SkeletalMesh->AddLODInfo();
+		LODInfo.ScreenSize = LOD.ScreenSize;
+		LODInfo.BuildSettings.bRecomputeNormals = false;
+		LODInfo.BuildSettings.bRecomputeTangents = false;
+		LODInfo.BuildSettings.bRemoveDegenerates = false;
+
+		FSkeletalMeshImportData ImportData;
+		PopulateSkeletalMeshImportData(LOD, MeshData, ImportData);
+		SkeletalMesh->SaveLODImportedData(LODIndex, ImportData);
+
+		if (!MeshBuilderModule.BuildSkeletalMesh(SkeletalMesh, LODIndex, false)) {
+			OutErrorMessage = FString::Printf(TEXT("Skeletal mesh builder failed to build LOD %d"), LODIndex);
+			bMeshBuilt = false;
+			break;
+		}
+		SkeletalMesh->bHasVertexColors |= LOD.HasVertexColors();
+	}
+
+	if (bMeshBuilt) {
+		SkeletalMesh->CalculateInvRefMatrices();
+		SkeletalMesh->SetImportedBounds(FBoxSphereBounds(FBox(MeshData.LODs[0].Positions)));
+
+		if (!Skeleton->MergeAllBonesToBoneTree(SkeletalMesh)) {
+			OutErrorMessage = FString::Printf(TEXT("Reference skeleton is not compatible with skeleton %s"), *Skeleton->GetPathName());
+			bMeshBuilt = false;
+		}
+	}
+	//PreEditChange has to be balanced even if the build failed, otherwise the mesh is left without a render state
+	SkeletalMesh->PostEditChange();
+	return bMeshBuilt;
+}
@@ -0,0 +1,72 @@
+#include "Toolkit/AssetGeneration/MaterialCompilationTracker.h"
+#include "Materials/MaterialInterface.h"
+#include "MaterialShared.h"
+#include "RHI.h"
+
+bool FMaterialCompilationTracker::IsMaterialCompilationFinished(const TWeakObjectPtr<UMaterialInterface>& Material) {
+	//Material that has been garbage collected cannot be compiling anymore
+	if (Material.IsValid()) {
+		const FMaterialResource* MaterialResource = Material->GetMaterialResource(GMaxRHIFeatureLevel);
+		if (MaterialResource != NULL && !MaterialResource->IsCompilationFinished()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void FMaterialCompilationTracker::TrackAsset(const FName PackageName, UObject* AssetObject) {
+	UMaterialInterface* Material = Cast<UMaterialInterface>(AssetObject);
+	if (Material != NULL) {
+		this->CompilingMaterials.Add(PackageName, Material);
+	}
+}
+
+bool FMaterialCompilationTracker::IsCompilationFinished(const FName PackageName) {
+	const TWeakObjectPtr<UMaterialInterface>* Material = CompilingMaterials.Find(PackageName);
+	if (Material == NULL) {
+		//Package has not been produced by the generator, but it can still be a material loaded as a dependency and compiling after the load
+		UPackage* LoadedPackage = FindObjectFast<UPackage>(NULL, PackageName);
+		UMaterialInterface* LoadedMaterial = LoadedPackage ? FindObjectFast<UMaterialInterface>(LoadedPackage, FPackageName::GetShortFName(PackageName)) : NULL;
+
+		if (LoadedMaterial == NULL || IsMaterialCompilationFinished(LoadedMaterial)) {
+			return true;
+		}
+		this->CompilingMaterials.Add(PackageName, LoadedMaterial);
+		return false;
+	}
+	if (!IsMaterialCompilationFinished(*Material)) {
+		return false;
+	}
+	//Stop tracking the material once it's done, it will be tracked again if it is modified by another generator
+	this->CompilingMaterials.Remove(PackageName);
+	return true;
+}
+
+bool FMaterialCompilationTracker::AreAllCompilationsFinished(const TArray<FName>& PackageNames) {
+	for (const FName& PackageName : PackageNames) {
+		if (!IsCompilationFinished(PackageName)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void FMaterialCompilationTracker::RecordPackageSaved(const FName PackageName, UPackage* Package) {
+	//Package that is not dirty anymore right after it's material has been modified has just been saved
+	if (Package != NULL && !Package->IsDirty() && !IsCompilationFinished(PackageName)) {
+		this->PackagesSavedBeforeCompilation.Add(Package);
+	}
+}
+
+int32 FMaterialCompilationTracker::MarkPackagesSavedBeforeCompilationDirty() {
+	int32 PackagesMarkedDirty = 0;
+	for (const TWeakObjectPtr<UPackage>& PackagePtr : PackagesSavedBeforeCompilation) {
+		UPackage* Package = PackagePtr.Get();
+		if (Package != NULL && !Package->IsDirty()) {
+			Package->SetDirtyFlag(true);
+			PackagesMarkedDirty++;
+		}
+	}
+	this->PackagesSavedBeforeCompilation.Empty();
+	return PackagesMarkedDirty;
+}
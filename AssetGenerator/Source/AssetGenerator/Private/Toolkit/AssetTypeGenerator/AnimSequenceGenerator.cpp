@@ -1,11 +1,9 @@
 #include "Toolkit/AssetTypeGenerator/AnimSequenceGenerator.h"
-#include "AutomatedAssetImportData.h"
 #include "Dom/JsonObject.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
 #include "EditorFramework/AssetImportData.h"
-#include "Factories/FbxAnimSequenceImportData.h"
-#include "Factories/FbxImportUI.h"
-#include "Factories/ReimportFbxAnimSequenceFactory.h"
+#include "Animation/Skeleton.h"
+#include "Toolkit/AssetTypes/AnimationDumpFormat.h"
 
 void UAnimSequenceGenerator::CreateAssetPackage() {
 	UPackage* NewPackage = CreatePackage(
@@ -33,63 +31,82 @@ void UAnimSequenceGenerator::OnExistingPackageLoaded() {
 }
 
 UAnimSequence* UAnimSequenceGenerator::ImportAnimation(UPackage* Package, const FName& AssetName, const EObjectFlags ObjectFlags) {
-	UFbxFactory* AnimationFactory = NewObject<UFbxFactory>(GetTransientPackage(), NAME_None);
-	
-	AnimationFactory->SetAutomatedAssetImportData(NewObject<UAutomatedAssetImportData>(AnimationFactory));
-	AnimationFactory->SetDetectImportTypeOnImport(false);
-	SetupFbxImportSettings(AnimationFactory->ImportUI);
-
-	const FString AssetFbxFilePath = GetAdditionalDumpFilePath(TEXT(""), TEXT("fbx"));
-	
-	bool bOperationCancelled = false;
-	UObject* ResultAnimation = AnimationFactory->ImportObject(UAnimSequence::StaticClass(), Package, AssetName, ObjectFlags, AssetFbxFilePath, TEXT(""), bOperationCancelled);
-	
-	checkf(ResultAnimation, TEXT("Failed to import AnimSequence %s from FBX file %s. See log for errors"), *GetPackageName().ToString(), *AssetFbxFilePath);
-	checkf(ResultAnimation->GetOuter() == Package, TEXT("Expected Outer to be package %s, found %s"), *Package->GetName(), *ResultAnimation->GetOuter()->GetPathName());
-	checkf(ResultAnimation->GetFName() == AssetName, TEXT("Expected Name to be %s, but found %s"), *AssetName.ToString(), *ResultAnimation->GetName());
-	
-	return CastChecked<UAnimSequence>(ResultAnimation);
+	UAnimSequence* NewAnimSequence = NewObject<UAnimSequence>(Package, AssetName, ObjectFlags);
+	BuildAnimationFromDumpedData(NewAnimSequence);
+	return NewAnimSequence;
 }
 
 void UAnimSequenceGenerator::ReimportAnimationFromSource(UAnimSequence* Asset) {
-	UClass* ReimportFbxAnimSequenceFactoryClass = FindObjectChecked<UClass>(NULL, TEXT("/Script/UnrealEd.ReimportFbxAnimSequenceFactory"));
-	UReimportFbxAnimSequenceFactory* AnimationFactory = static_cast<UReimportFbxAnimSequenceFactory*>(NewObject<UObject>(GetTransientPackage(), ReimportFbxAnimSequenceFactoryClass));
-	
-	AnimationFactory->SetAutomatedAssetImportData(NewObject<UAutomatedAssetImportData>(AnimationFactory));
-	AnimationFactory->SetDetectImportTypeOnImport(false);
-	SetupFbxImportSettings(AnimationFactory->ImportUI);
-	
-	const FString AssetFbxFilePath = GetAdditionalDumpFilePath(TEXT(""), TEXT("fbx"));
-	
-	AnimationFactory->SetReimportPaths(Asset, {AssetFbxFilePath});
-	AnimationFactory->Reimport(Asset);
+	BuildAnimationFromDumpedData(Asset);
 	MarkAssetChanged();
 }
 
-void UAnimSequenceGenerator::SetupFbxImportSettings(UFbxImportUI* ImportUI) const {
-	ImportUI->MeshTypeToImport = FBXIT_Animation;
-	ImportUI->bOverrideFullName = true;
-	ImportUI->bImportMaterials = false;
-	ImportUI->bImportTextures = false;
-	ImportUI->bImportAnimations = true;
-	ImportUI->OverrideAnimationName = GetAssetName().ToString();
+void UAnimSequenceGenerator::BuildAnimationFromDumpedData(UAnimSequence* Asset) {
+	const FString AnimationFilePath = GetAdditionalDumpFilePath(TEXT(""), FDumpedAnimationData::FileExtension);
+	FDumpedAnimationData AnimationData;
+	FString ErrorMessage;
+
+	//Import data is left untouched, so the animation is built again once the animation file becomes readable
+	if (!AnimationData.LoadFromFile(AnimationFilePath, ErrorMessage)) {
+		UE_LOG(LogAssetGenerator, Error, TEXT("Failed to read AnimSequence %s from animation file %s, leaving it without keys: %s"),
+			*GetPackageName().ToString(), *AnimationFilePath, *ErrorMessage);
+		return;
+	}
 
 	const int32 SkeletonObjectIndex = GetAssetData()->GetObjectField(TEXT("AssetObjectData"))->GetIntegerField(TEXT("Skeleton"));
 	USkeleton* Skeleton = CastChecked<USkeleton>(GetObjectSerializer()->DeserializeObject(SkeletonObjectIndex));
-	ImportUI->Skeleton = Skeleton;
+	const FReferenceSkeleton& ReferenceSkeleton = Skeleton->GetReferenceSkeleton();
 
-	ImportUI->AnimSequenceImportData = NewObject<UFbxAnimSequenceImportData>(ImportUI, NAME_None, RF_NoFlags);
-	ImportUI->AnimSequenceImportData->bRemoveRedundantKeys = true;
-	
-	const int32 NumFrames = GetAssetData()->GetIntegerField(TEXT("NumFrames"));
-	ImportUI->AnimSequenceImportData->AnimationLength = EFBXAnimationLengthImportType::FBXALIT_SetRange;
-	ImportUI->AnimSequenceImportData->FrameImportRange = FInt32Interval(0, NumFrames - 1);
-	
-	const int32 SequenceLength = GetAssetData()->GetIntegerField(TEXT("SequenceLength"));
-	int32 RateScale = GetAssetData()->GetIntegerField(TEXT("RateScale"));
-	if (RateScale == 0) RateScale = 1;
-	ImportUI->AnimSequenceImportData->bUseDefaultSampleRate = true;
-	ImportUI->AnimSequenceImportData->CustomSampleRate = FMath::CeilToInt((float)NumFrames / (float)SequenceLength);
+	Asset->SetSkeleton(Skeleton);
+	Asset->CleanAnimSequenceForImport();
+	Asset->SequenceLength = AnimationData.SequenceLength;
+	Asset->SetRawNumberOfFrame(AnimationData.NumFrames);
+
+	for (const FDumpedAnimationTrack& Track : AnimationData.Tracks) {
+		const FName BoneName = FName(*Track.BoneName);
+		if (ReferenceSkeleton.FindBoneIndex(BoneName) == INDEX_NONE) {
+			UE_LOG(LogAssetGenerator, Warning, TEXT("Skipping track of bone %s missing in the skeleton %s of AnimSequence %s"), *Track.BoneName, *Skeleton->GetPathName(), *GetPackageName().ToString());
+			continue;
+		}
+		FRawAnimSequenceTrack RawTrack;
+		RawTrack.PosKeys = Track.PositionKeys;
+		RawTrack.RotKeys = Track.RotationKeys;
+		RawTrack.ScaleKeys = Track.ScaleKeys;
+		Asset->AddNewRawTrack(BoneName, &RawTrack);
+	}
+
+	Asset->RawCurveData.FloatCurves.Empty();
+	for (const FDumpedAnimationCurve& Curve : AnimationData.Curves) {
+		//Curve names are registered in the skeleton, which assigns them the UIDs
+		FSmartName CurveName;
+		CurveName.DisplayName = FName(*Curve.CurveName);
+		Skeleton->VerifySmartName(USkeleton::AnimCurveMappingName, CurveName);
+
+		if (!Asset->RawCurveData.AddCurveData(CurveName, Curve.CurveTypeFlags)) {
+			continue;
+		}
+		FFloatCurve* FloatCurve = static_cast<FFloatCurve*>(Asset->RawCurveData.GetCurveData(CurveName.UID, ERawCurveTrackTypes::RCT_Float));
+		TArray<FRichCurveKey> RichCurveKeys;
+		RichCurveKeys.Reserve(Curve.Keys.Num());
+
+		for (const FDumpedCurveKey& Key : Curve.Keys) {
+			FRichCurveKey& RichCurveKey = RichCurveKeys.Emplace_GetRef(Key.Time, Key.Value, Key.ArriveTangent, Key.LeaveTangent, (ERichCurveInterpMode) Key.InterpMode);
+			RichCurveKey.TangentMode = (ERichCurveTangentMode) Key.TangentMode;
+			RichCurveKey.TangentWeightMode = (ERichCurveTangentWeightMode) Key.TangentWeightMode;
+			RichCurveKey.ArriveTangentWeight = Key.ArriveTangentWeight;
+			RichCurveKey.LeaveTangentWeight = Key.LeaveTangentWeight;
+		}
+		FloatCurve->FloatCurve.SetKeys(RichCurveKeys);
+	}
+
+	Asset->MarkRawDataAsModified();
+	Asset->PostProcessSequence();
+
+	//Record source file hash the same way FBX import does, so the animation is only rebuilt when the animation file changes
+	if (Asset->AssetImportData == NULL) {
+		Asset->AssetImportData = NewObject<UAssetImportData>(Asset, TEXT("AssetImportData"));
+	}
+	Asset->AssetImportData->Update(AnimationFilePath);
 }
 
 void UAnimSequenceGenerator::PopulateAnimationProperties(UAnimSequence* Asset) {
@@ -113,6 +130,9 @@ bool UAnimSequenceGenerator::IsAnimationSourceUpToDate(UAnimSequence* Asset) con
 		return true;
 	}
 	
+	if (Asset->AssetImportData == NULL || Asset->AssetImportData->SourceData.SourceFiles.Num() == 0) {
+		return false;
+	}
 	const FAssetImportInfo& AssetImportInfo = Asset->AssetImportData->SourceData;
 	const FMD5Hash& ExistingFileHash = AssetImportInfo.SourceFiles[0].FileHash;
 	
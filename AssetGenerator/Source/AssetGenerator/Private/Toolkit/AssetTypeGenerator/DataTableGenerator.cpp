@@ -100,8 +100,8 @@ bool UDataTableGenerator::IsDataTableUpToDate(UDataTable* DataTable, const FTabl
 	return true;
 }
 
-void UDataTableGenerator::PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const {
-	if (GetCurrentStage() == EAssetGenerationStage::CONSTRUCTION) {
+void UDataTableGenerator::PrepareStage(const EAssetGenerationStage Stage, TArray<FPackageDependency>& OutDependencies) {
+	if (Stage == EAssetGenerationStage::CONSTRUCTION) {
 		TArray<FString> OutReferencedPackages;
 		const int32 RowStructObjectIndex = GetAssetData()->GetIntegerField(TEXT("RowStruct"));
 		GetObjectSerializer()->CollectObjectPackages(RowStructObjectIndex, OutReferencedPackages);
@@ -110,7 +110,7 @@ void UDataTableGenerator::PopulateStageDependencies(TArray<FPackageDependency>&
 			OutDependencies.Add(FPackageDependency{*DependencyPackageName, EAssetGenerationStage::CDO_FINALIZATION});
 		}
 	}
-	if (GetCurrentStage() == EAssetGenerationStage::DATA_POPULATION) {
+	if (Stage == EAssetGenerationStage::DATA_POPULATION) {
 		const TArray<TSharedPtr<FJsonValue>> ReferencedObjects = GetAssetData()->GetArrayField(TEXT("ReferencedObjects"));
 		
 		TArray<FString> OutReferencedPackages;
@@ -16,6 +16,9 @@
 #include "Toolkit/AssetGeneration/PublicProjectStubHelper.h"
 #include "Materials/MaterialInterface.h"
 #include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsAssetUtils.h"
+#include "Toolkit/AssetGeneration/DumpedMeshImporter.h"
+#include "Toolkit/AssetTypes/MeshDumpFormat.h"
 
 void USkeletalMeshGenerator::CreateAssetPackage() {
 	UPackage* NewPackage = CreatePackage(
@@ -44,6 +47,19 @@ void USkeletalMeshGenerator::OnExistingPackageLoaded() {
 }
 
 USkeletalMesh* USkeletalMeshGenerator::ImportSkeletalMesh(UPackage* Package, const FName& AssetName, const EObjectFlags ObjectFlags) {
+	//Dumped meshes are built natively from the mesh file, only stubs still go through the FBX import
+	if (!IsGeneratingPublicProject()) {
+		FDumpedMeshData MeshData;
+		if (LoadDumpedMeshData(MeshData)) {
+			USkeletalMesh* NewSkeletalMesh = NewObject<USkeletalMesh>(Package, AssetName, ObjectFlags);
+			BuildSkeletalMeshFromDumpedData(NewSkeletalMesh, MeshData);
+		
+			//TODO here only until we implement physics asset generation
+			CreatePhysicsAsset(NewSkeletalMesh);
+			return NewSkeletalMesh;
+		}
+	}
+	
 	UFbxFactory* SkeletalMeshFactory = NewObject<UFbxFactory>(GetTransientPackage(), NAME_None);
 	UObject* ResultMesh;
 
@@ -52,14 +68,7 @@ USkeletalMesh* USkeletalMeshGenerator::ImportSkeletalMesh(UPackage* Package, con
 
 	SetupFbxImportSettings(SkeletalMeshFactory->ImportUI, AssetName, Package);
 
-	FString AssetFbxFilePath;
-	if (!IsGeneratingPublicProject()) {
-		AssetFbxFilePath = GetAdditionalDumpFilePath(TEXT(""), TEXT("fbx"));;
-	}
-	else {
-		AssetFbxFilePath = FPublicProjectStubHelper::DefaultSkeletalMesh.GetFullFilePath();
-	}
-
+	const FString AssetFbxFilePath = FPublicProjectStubHelper::DefaultSkeletalMesh.GetFullFilePath();
 	bool bOperationCancelled = false;
 	ResultMesh = SkeletalMeshFactory->ImportObject(USkeletalMesh::StaticClass(), Package, AssetName, ObjectFlags, AssetFbxFilePath, TEXT(""), bOperationCancelled);
 
@@ -70,7 +79,63 @@ USkeletalMesh* USkeletalMeshGenerator::ImportSkeletalMesh(UPackage* Package, con
 	return CastChecked<USkeletalMesh>(ResultMesh);
 }
 
+bool USkeletalMeshGenerator::LoadDumpedMeshData(FDumpedMeshData& OutMeshData) const {
+	const FString MeshFilePath = GetAdditionalDumpFilePath(TEXT(""), FDumpedMeshData::FileExtension);
+	FString ErrorMessage;
+
+	if (!OutMeshData.LoadFromFile(MeshFilePath, ErrorMessage) || !FDumpedMeshImporter::ValidateMeshData(OutMeshData, true, ErrorMessage)) {
+		UE_LOG(LogAssetGenerator, Warning, TEXT("Failed to read SkeletalMesh %s from mesh file %s, falling back to the stub mesh: %s"),
+			*GetPackageName().ToString(), *MeshFilePath, *ErrorMessage);
+		return false;
+	}
+	return true;
+}
+
+void USkeletalMeshGenerator::BuildSkeletalMeshFromDumpedData(USkeletalMesh* Asset, const FDumpedMeshData& MeshData) {
+	const FString MeshFilePath = GetAdditionalDumpFilePath(TEXT(""), FDumpedMeshData::FileExtension);
+	FString ErrorMessage;
+
+	const int32 SkeletonObjectIndex = GetAssetData()->GetObjectField(TEXT("AssetObjectData"))->GetIntegerField(TEXT("Skeleton"));
+	USkeleton* Skeleton = CastChecked<USkeleton>(GetObjectSerializer()->DeserializeObject(SkeletonObjectIndex));
+
+	const bool bMeshBuilt = FDumpedMeshImporter::BuildSkeletalMesh(Asset, Skeleton, MeshData, ErrorMessage);
+	checkf(bMeshBuilt, TEXT("Failed to build SkeletalMesh %s from mesh file %s: %s"), *GetPackageName().ToString(), *MeshFilePath, *ErrorMessage);
+
+	//Record source file hash the same way FBX import does, so the mesh is only rebuilt when the mesh file changes
+	if (Asset->AssetImportData == NULL) {
+		Asset->AssetImportData = NewObject<UAssetImportData>(Asset, TEXT("AssetImportData"));
+	}
+	Asset->AssetImportData->Update(MeshFilePath);
+}
+
+void USkeletalMeshGenerator::CreatePhysicsAsset(USkeletalMesh* Asset) {
+	//Physics asset is placed next to the mesh, with the same name FBX import would have given it
+	const FString PhysicsAssetPackageName = GetPackageName().ToString() + TEXT("_PhysicsAsset");
+	UPackage* PhysicsAssetPackage = CreatePackage(
+#if ENGINE_MINOR_VERSION < 26
+		nullptr,
+#endif
+		*PhysicsAssetPackageName);
+	
+	UPhysicsAsset* PhysicsAsset = NewObject<UPhysicsAsset>(PhysicsAssetPackage, *FPackageName::GetShortName(PhysicsAssetPackageName), RF_Public | RF_Standalone);
+	FPhysAssetCreateParams CreateParams;
+	FText ErrorMessage;
+	
+	if (!FPhysicsAssetUtils::CreateFromSkeletalMesh(PhysicsAsset, Asset, CreateParams, ErrorMessage, true, false)) {
+		UE_LOG(LogAssetGenerator, Warning, TEXT("Failed to create PhysicsAsset for SkeletalMesh %s: %s"), *GetPackageName().ToString(), *ErrorMessage.ToString());
+	}
+}
+
 void USkeletalMeshGenerator::ReimportSkeletalMeshSource(USkeletalMesh* Asset) {
+	if (!IsGeneratingPublicProject()) {
+		FDumpedMeshData MeshData;
+		if (LoadDumpedMeshData(MeshData)) {
+			BuildSkeletalMeshFromDumpedData(Asset, MeshData);
+			MarkAssetChanged();
+			return;
+		}
+	}
+	
 	UReimportFbxSkeletalMeshFactory* SkeletalMeshFactory = NewObject<UReimportFbxSkeletalMeshFactory>(GetTransientPackage(), NAME_None);
 
 	SkeletalMeshFactory->SetAutomatedAssetImportData(NewObject<UAutomatedAssetImportData>(SkeletalMeshFactory));
@@ -83,14 +148,7 @@ void USkeletalMeshGenerator::ReimportSkeletalMeshSource(USkeletalMesh* Asset) {
 #endif
 	);
 
-	FString AssetFbxFilePath;
-	if (!IsGeneratingPublicProject()) {
-		AssetFbxFilePath = GetAdditionalDumpFilePath(TEXT(""), TEXT("fbx"));
-	}
-	else {
-		AssetFbxFilePath = FPublicProjectStubHelper::DefaultSkeletalMesh.GetFullFilePath();
-	}
-
+	const FString AssetFbxFilePath = FPublicProjectStubHelper::DefaultSkeletalMesh.GetFullFilePath();
 	SkeletalMeshFactory->SetReimportPaths(Asset, { AssetFbxFilePath });
 	SkeletalMeshFactory->Reimport(Asset);
 	MarkAssetChanged();
@@ -103,22 +161,8 @@ void USkeletalMeshGenerator::SetupFbxImportSettings(UFbxImportUI* ImportUI, cons
 	ImportUI->bImportTextures = false;
 	ImportUI->bImportAsSkeletal = true;
 
-	if (!IsGeneratingPublicProject()) {
-		const int32 SkeletonObjectIndex = GetAssetData()->GetObjectField(TEXT("AssetObjectData"))->GetIntegerField(TEXT("Skeleton"));
-		/*if (SkeletonObjectIndex == 0) {
-			FString SkeletonName = AssetName.ToString() + TEXT("_Skeleton");
-			FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
-			FString PackagePath = Package->GetPathName().LeftChop(AssetName.ToString().Len() + 1);
-			UObject* NewSkeleton = AssetToolsModule.Get().CreateAsset(SkeletonName, PackagePath, USkeleton::StaticClass(), NewObject<USkeletonFactory>());
-			ImportUI->Skeleton = CastChecked<USkeleton>(NewSkeleton);
-		} else {*/
-		USkeleton* Skeleton = CastChecked<USkeleton>(GetObjectSerializer()->DeserializeObject(SkeletonObjectIndex));
-		ImportUI->Skeleton = Skeleton;
-		//}
-	}
-	else {
-		ImportUI->Skeleton = FPublicProjectStubHelper::DefaultSkeletalMeshSkeleton.GetObject();
-	}
+	//Only the stub mesh is imported from FBX, and it's bones only match the stub skeleton
+	ImportUI->Skeleton = FPublicProjectStubHelper::DefaultSkeletalMeshSkeleton.GetObject();
 
 	ImportUI->SkeletalMeshImportData = NewObject<UFbxSkeletalMeshImportData>(ImportUI, NAME_None, RF_NoFlags);
 	ImportUI->SkeletalMeshImportData->ImportContentType = FBXICT_All;
@@ -205,13 +249,19 @@ bool USkeletalMeshGenerator::IsSkeletalMeshPropertiesUpToDate(USkeletalMesh* Ass
 }
 
 bool USkeletalMeshGenerator::IsSkeletalMeshSourceFileUpToDate(USkeletalMesh* Asset) const {
+	if (Asset->AssetImportData == NULL || Asset->AssetImportData->SourceData.SourceFiles.Num() == 0) {
+		return false;
+	}
 	const FAssetImportInfo& AssetImportInfo = Asset->AssetImportData->SourceData;
 	const FMD5Hash& ExistingFileHash = AssetImportInfo.SourceFiles[0].FileHash;
 
 	const FString ExistingFileHashString = LexToString(ExistingFileHash);
 
+	//Meshes which mesh file is missing are generated from the stub, so compare against it to avoid rebuilding them every run
+	const FString MeshFilePath = GetAdditionalDumpFilePath(TEXT(""), FDumpedMeshData::FileExtension);
+	
 	FString ModelFileHash;
-	if (!IsGeneratingPublicProject()) {
+	if (!IsGeneratingPublicProject() && FPlatformFileManager::Get().GetPlatformFile().FileExists(*MeshFilePath)) {
 		ModelFileHash = GetAssetData()->GetStringField(TEXT("ModelFileHash"));;
 	}
 	else {
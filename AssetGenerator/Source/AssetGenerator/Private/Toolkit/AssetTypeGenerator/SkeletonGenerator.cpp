@@ -1,28 +1,46 @@
 #include "Toolkit/AssetTypeGenerator/SkeletonGenerator.h"
 #include "Dom/JsonObject.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
+#include "Toolkit/AssetTypes/AssetHelper.h"
 
 FSkeletonCompareData::FSkeletonCompareData(const TSharedPtr<FJsonObject>& AssetData) {
 	const TSharedPtr<FJsonObject> ReferenceSkeleton = AssetData->GetObjectField(TEXT("ReferenceSkeleton"));
 	const TArray<TSharedPtr<FJsonValue>>& Bones = ReferenceSkeleton->GetArrayField(TEXT("Bones"));
 
 	FReferenceSkeletonModifier ReferenceSkeletonModifier(this->ReferenceSkeleton, NULL);
+
+	//Bones with malformed poses are skipped along with their children, so dumped bone indices are remapped to the added ones
+	TArray<int32> DumpedToAddedBoneIndex;
+	DumpedToAddedBoneIndex.Init(INDEX_NONE, Bones.Num());
 	
 	for (int32 i = 0; i < Bones.Num(); i++) {
 		const TSharedPtr<FJsonObject> BoneElement = Bones[i]->AsObject();
 
 		const FString BoneName = BoneElement->GetStringField(TEXT("Name"));
 		const int32 ParentBoneIndex = BoneElement->GetIntegerField(TEXT("ParentIndex"));
+		const int32 AddedParentBoneIndex = DumpedToAddedBoneIndex.IsValidIndex(ParentBoneIndex) ? DumpedToAddedBoneIndex[ParentBoneIndex] : INDEX_NONE;
+
+		if (ParentBoneIndex != INDEX_NONE && AddedParentBoneIndex == INDEX_NONE) {
+			UE_LOG(LogAssetGenerator, Error, TEXT("Skipping skeleton bone %s because it's parent bone has been skipped"), *BoneName);
+			continue;
+		}
 
 		FTransform BonePose;
-		BonePose.InitFromString(BoneElement->GetStringField(TEXT("Pose")));
+		if (!FAssetHelper::DeserializeTransform(BoneElement->TryGetField(TEXT("Pose")), BonePose)) {
+			UE_LOG(LogAssetGenerator, Error, TEXT("Skipping skeleton bone %s because it's reference pose is malformed"), *BoneName);
+			continue;
+		}
 		
-		ReferenceSkeletonModifier.Add(FMeshBoneInfo(*BoneName, BoneName, ParentBoneIndex), BonePose);
+		DumpedToAddedBoneIndex[i] = this->ReferenceSkeleton.GetRawBoneNum();
+		ReferenceSkeletonModifier.Add(FMeshBoneInfo(*BoneName, BoneName, AddedParentBoneIndex), BonePose);
 	}
 
 	const TArray<TSharedPtr<FJsonValue>>& BoneTree = AssetData->GetArrayField(TEXT("BoneTree"));
 	
 	for (int32 i = 0; i < BoneTree.Num(); i++) {
+		if (!DumpedToAddedBoneIndex.IsValidIndex(i) || DumpedToAddedBoneIndex[i] == INDEX_NONE) {
+			continue;
+		}
 		const int32 RetargetingModeValue = BoneTree[i]->AsNumber();
 		this->BoneTree.Add((EBoneTranslationRetargetingMode::Type) RetargetingModeValue);
 	}
@@ -48,8 +66,15 @@ FSkeletonCompareData::FSkeletonCompareData(const TSharedPtr<FJsonObject>& AssetD
 		ReferencePose.PoseName = FName(*ReferencePoseObject->GetStringField(TEXT("PoseName")));
 		
 		for (int32 j = 0; j < ReferencePoseArray.Num(); j++) {
+			if (!DumpedToAddedBoneIndex.IsValidIndex(j) || DumpedToAddedBoneIndex[j] == INDEX_NONE) {
+				continue;
+			}
 			FTransform Transform;
-			Transform.InitFromString(ReferencePoseArray[j]->AsString());
+			if (!FAssetHelper::DeserializeTransform(ReferencePoseArray[j], Transform)) {
+				UE_LOG(LogAssetGenerator, Error, TEXT("Retarget source %s has malformed transform of the bone %s, using reference pose of the bone instead"),
+					*ReferencePose.PoseName.ToString(), *this->ReferenceSkeleton.GetRawRefBoneInfo()[DumpedToAddedBoneIndex[j]].Name.ToString());
+				Transform = this->ReferenceSkeleton.GetRawRefBonePose()[DumpedToAddedBoneIndex[j]];
+			}
 			ReferencePose.ReferencePose.Add(Transform);
 		}
 		this->AnimRetargetSources.Add(ReferencePose.PoseName, ReferencePose);
@@ -10,6 +10,8 @@
 #include "Factories/ReimportFbxStaticMeshFactory.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "Toolkit/AssetGeneration/PublicProjectStubHelper.h"
+#include "Toolkit/AssetGeneration/DumpedMeshImporter.h"
+#include "Toolkit/AssetTypes/MeshDumpFormat.h"
 
 void UStaticMeshGenerator::CreateAssetPackage() {
 	UPackage* NewPackage = CreatePackage(
@@ -37,19 +39,23 @@ void UStaticMeshGenerator::OnExistingPackageLoaded() {
 }
 
 UStaticMesh* UStaticMeshGenerator::ImportStaticMesh(UPackage* Package, const FName& AssetName, const EObjectFlags ObjectFlags) {
+	//Dumped meshes are built natively from the mesh file, only stubs still go through the FBX import
+	if (!IsGeneratingPublicProject()) {
+		FDumpedMeshData MeshData;
+		if (LoadDumpedMeshData(MeshData)) {
+			UStaticMesh* NewStaticMesh = NewObject<UStaticMesh>(Package, AssetName, ObjectFlags);
+			BuildStaticMeshFromDumpedData(NewStaticMesh, MeshData);
+			return NewStaticMesh;
+		}
+	}
+	
 	UFbxFactory* StaticMeshFactory = NewObject<UFbxFactory>(GetTransientPackage(), NAME_None);
 	
 	StaticMeshFactory->SetAutomatedAssetImportData(NewObject<UAutomatedAssetImportData>(StaticMeshFactory));
 	StaticMeshFactory->SetDetectImportTypeOnImport(false);
 	SetupFbxImportSettings(StaticMeshFactory->ImportUI);
 
-	FString AssetFbxFilePath;
-	if (!IsGeneratingPublicProject()) {
-		AssetFbxFilePath = GetAdditionalDumpFilePath(TEXT(""), TEXT("fbx"));
-	} else {
-		AssetFbxFilePath = FPublicProjectStubHelper::EditorCube.GetFullFilePath();
-	}
-	
+	const FString AssetFbxFilePath = FPublicProjectStubHelper::EditorCube.GetFullFilePath();
 	bool bOperationCancelled = false;
 	UObject* ResultMesh = StaticMeshFactory->ImportObject(UStaticMesh::StaticClass(), Package, AssetName, ObjectFlags, AssetFbxFilePath, TEXT(""), bOperationCancelled);
 	
@@ -60,20 +66,49 @@ UStaticMesh* UStaticMeshGenerator::ImportStaticMesh(UPackage* Package, const FNa
 	return CastChecked<UStaticMesh>(ResultMesh);
 }
 
+bool UStaticMeshGenerator::LoadDumpedMeshData(FDumpedMeshData& OutMeshData) const {
+	const FString MeshFilePath = GetAdditionalDumpFilePath(TEXT(""), FDumpedMeshData::FileExtension);
+	FString ErrorMessage;
+
+	if (!OutMeshData.LoadFromFile(MeshFilePath, ErrorMessage) || !FDumpedMeshImporter::ValidateMeshData(OutMeshData, false, ErrorMessage)) {
+		UE_LOG(LogAssetGenerator, Warning, TEXT("Failed to read StaticMesh %s from mesh file %s, falling back to the stub mesh: %s"),
+			*GetPackageName().ToString(), *MeshFilePath, *ErrorMessage);
+		return false;
+	}
+	return true;
+}
+
+void UStaticMeshGenerator::BuildStaticMeshFromDumpedData(UStaticMesh* Asset, const FDumpedMeshData& MeshData) {
+	const FString MeshFilePath = GetAdditionalDumpFilePath(TEXT(""), FDumpedMeshData::FileExtension);
+	FString ErrorMessage;
+
+	const bool bMeshBuilt = FDumpedMeshImporter::BuildStaticMesh(Asset, MeshData, ErrorMessage);
+	checkf(bMeshBuilt, TEXT("Failed to build StaticMesh %s from mesh file %s: %s"), *GetPackageName().ToString(), *MeshFilePath, *ErrorMessage);
+
+	//Record source file hash the same way FBX import does, so the mesh is only rebuilt when the mesh file changes
+	if (Asset->AssetImportData == NULL) {
+		Asset->AssetImportData = NewObject<UAssetImportData>(Asset, TEXT("AssetImportData"));
+	}
+	Asset->AssetImportData->Update(MeshFilePath);
+}
+
 void UStaticMeshGenerator::ReimportStaticMeshSource(UStaticMesh* Asset) {
+	if (!IsGeneratingPublicProject()) {
+		FDumpedMeshData MeshData;
+		if (LoadDumpedMeshData(MeshData)) {
+			BuildStaticMeshFromDumpedData(Asset, MeshData);
+			MarkAssetChanged();
+			return;
+		}
+	}
+	
 	UReimportFbxStaticMeshFactory* StaticMeshFactory = NewObject<UReimportFbxStaticMeshFactory>(GetTransientPackage(), NAME_None);
 	
 	StaticMeshFactory->SetAutomatedAssetImportData(NewObject<UAutomatedAssetImportData>(StaticMeshFactory));
 	StaticMeshFactory->SetDetectImportTypeOnImport(false);
 	SetupFbxImportSettings(StaticMeshFactory->ImportUI);
 	
-	FString AssetFbxFilePath;
-	if (!IsGeneratingPublicProject()) {
-		AssetFbxFilePath = GetAdditionalDumpFilePath(TEXT(""), TEXT("fbx"));
-	} else {
-		AssetFbxFilePath = FPublicProjectStubHelper::EditorCube.GetFullFilePath();
-	}
-	
+	const FString AssetFbxFilePath = FPublicProjectStubHelper::EditorCube.GetFullFilePath();
 	StaticMeshFactory->SetReimportPaths(Asset, {AssetFbxFilePath});
 	StaticMeshFactory->Reimport(Asset);
 	MarkAssetChanged();
@@ -183,6 +218,9 @@ bool UStaticMeshGenerator::IsStaticMeshDataUpToDate(UStaticMesh* Asset) const {
 }
 
 bool UStaticMeshGenerator::IsStaticMeshSourceFileUpToDate(UStaticMesh* Asset) const {
+	if (Asset->AssetImportData == NULL) {
+		return false;
+	}
 	const FAssetImportInfo& AssetImportInfo = Asset->AssetImportData->SourceData;
 	
 	if (AssetImportInfo.SourceFiles.Num() == 0) {
@@ -192,8 +230,11 @@ bool UStaticMeshGenerator::IsStaticMeshSourceFileUpToDate(UStaticMesh* Asset) co
 	const FMD5Hash& ExistingFileHash = AssetImportInfo.SourceFiles[0].FileHash;
 	const FString ExistingFileHashString = LexToString(ExistingFileHash);
 
+	//Meshes which mesh file is missing are generated from the stub, so compare against it to avoid rebuilding them every run
+	const FString MeshFilePath = GetAdditionalDumpFilePath(TEXT(""), FDumpedMeshData::FileExtension);
+	
 	FString ModelFileHash;
-	if (!IsGeneratingPublicProject()) {
+	if (!IsGeneratingPublicProject() && FPlatformFileManager::Get().GetPlatformFile().FileExists(*MeshFilePath)) {
 		ModelFileHash = GetAssetData()->GetStringField(TEXT("ModelFileHash"));;
 	} else {
 		ModelFileHash = FPublicProjectStubHelper::EditorCube.GetFileHash();
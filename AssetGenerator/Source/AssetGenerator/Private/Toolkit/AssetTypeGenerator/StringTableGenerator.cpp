@@ -27,35 +27,39 @@ void UStringTableGenerator::OnExistingPackageLoaded() {
 	}
 }
 
-void UStringTableGenerator::PopulateStringTableWithData(UStringTable* StringTable) {
+void UStringTableGenerator::PrepareStage(const EAssetGenerationStage Stage, TArray<FPackageDependency>& OutDependencies) {
+	if (Stage != EAssetGenerationStage::CONSTRUCTION) {
+		return;
+	}
 	const TSharedPtr<FJsonObject> InAssetData = GetAssetData();
-	const FStringTableRef MutableStringTable = StringTable->GetMutableStringTable();
-	
-	const FString TableNamespace = InAssetData->GetStringField(TEXT("TableNamespace"));
-	MutableStringTable->SetNamespace(TableNamespace);
+	this->TableNamespace = InAssetData->GetStringField(TEXT("TableNamespace"));
 
-	
-	const TSharedPtr<FJsonObject> SourceStrings = InAssetData->GetObjectField(TEXT("SourceStrings"));
-	
-	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : SourceStrings->Values) {
-		const FString TableKey = Pair.Key;
-		const FString DisplayString = Pair.Value->AsString();
-
-		MutableStringTable->SetSourceString(TableKey, DisplayString);
+	const TSharedPtr<FJsonObject> SourceStringsObject = InAssetData->GetObjectField(TEXT("SourceStrings"));
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : SourceStringsObject->Values) {
+		this->SourceStrings.Add(Pair.Key, Pair.Value->AsString());
 	}
-	
 
 	const TSharedPtr<FJsonObject> TableMetadataObjects = InAssetData->GetObjectField(TEXT("MetaData"));
-	
 	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : TableMetadataObjects->Values) {
-		const FString TableKey = Pair.Key;
-		const TSharedPtr<FJsonObject> MetadataObject = Pair.Value->AsObject();
-
-		for (const TPair<FString, TSharedPtr<FJsonValue>>& MetadataPair : MetadataObject->Values) {
-			const FName MetadataKey = *MetadataPair.Key;
-			const FString MetadataValue = MetadataPair.Value->AsString();
-			
-			MutableStringTable->SetMetaData(TableKey, MetadataKey, MetadataValue);
+		TMap<FName, FString>& KeyMetaData = this->TableMetaData.Add(Pair.Key);
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& MetadataPair : Pair.Value->AsObject()->Values) {
+			KeyMetaData.Add(*MetadataPair.Key, MetadataPair.Value->AsString());
+		}
+	}
+}
+
+void UStringTableGenerator::PopulateStringTableWithData(UStringTable* StringTable) {
+	const FStringTableRef MutableStringTable = StringTable->GetMutableStringTable();
+	MutableStringTable->SetNamespace(TableNamespace);
+
+	for (const TPair<FString, FString>& Pair : SourceStrings) {
+		MutableStringTable->SetSourceString(Pair.Key, Pair.Value);
+	}
+
+	for (const TPair<FString, TMap<FName, FString>>& Pair : TableMetaData) {
+		for (const TPair<FName, FString>& MetadataPair : Pair.Value) {
+			MutableStringTable->SetMetaData(Pair.Key, MetadataPair.Key, MetadataPair.Value);
 		}
 	}
 	
@@ -64,9 +68,7 @@ void UStringTableGenerator::PopulateStringTableWithData(UStringTable* StringTabl
 
 bool UStringTableGenerator::IsStringTableUpToDate(UStringTable* StringTable) const {
 	const FStringTableConstRef StringTableRef = StringTable->GetStringTable();
-	const TSharedPtr<FJsonObject> InAssetData = GetAssetData();
 
-	const FString TableNamespace = InAssetData->GetStringField(TEXT("TableNamespace"));
 	if (StringTableRef->GetNamespace() != TableNamespace) {
 		return false;
 	}
@@ -77,43 +79,35 @@ bool UStringTableGenerator::IsStringTableUpToDate(UStringTable* StringTable) con
 		return true;
 	});
 
-	const TSharedPtr<FJsonObject> SourceStrings = InAssetData->GetObjectField(TEXT("SourceStrings"));
-	if (TableSourceStrings.Num() != SourceStrings->Values.Num()) {
+	if (TableSourceStrings.Num() != SourceStrings.Num()) {
 		return false;
 	}
 
 	for (const TPair<FString, FString>& TablePair : TableSourceStrings) {
-		FString JsonDisplayString;
-		if (!SourceStrings->TryGetStringField(TablePair.Key, JsonDisplayString) ||
-			TablePair.Value != JsonDisplayString) {
+		const FString* DumpDisplayString = SourceStrings.Find(TablePair.Key);
+		if (DumpDisplayString == NULL || TablePair.Value != *DumpDisplayString) {
 			return false;
 		}
 	}
 
-	const TSharedPtr<FJsonObject> TableMetadataObjects = InAssetData->GetObjectField(TEXT("MetaData"));
-	TArray<FString> InStringTableKeys;
-	TableSourceStrings.GetKeys(InStringTableKeys);
-	
-	for (const FString& InKey : InStringTableKeys) {
-		TMap<FString, FString> TableMetadataMap;
-		StringTableRef->EnumerateMetaData(InKey, [&](FName MetaDataKey, const FString& Value){
-			TableMetadataMap.Add(MetaDataKey.ToString(), Value);
+	for (const TPair<FString, FString>& TablePair : TableSourceStrings) {
+		TMap<FName, FString> TableMetadataMap;
+		StringTableRef->EnumerateMetaData(TablePair.Key, [&](FName MetaDataKey, const FString& Value){
+			TableMetadataMap.Add(MetaDataKey, Value);
 			return true;
 		});
 
-		if (!TableMetadataObjects->HasField(InKey) && InStringTableKeys.Num()) {
+		const TMap<FName, FString>* DumpMetaData = TableMetaData.Find(TablePair.Key);
+		if (DumpMetaData == NULL) {
 			return false;
 		}
-		
-		const TSharedPtr<FJsonObject> MetaDataObject = TableMetadataObjects->GetObjectField(InKey);
-		if (TableMetadataMap.Num() != MetaDataObject->Values.Num()) {
+		if (TableMetadataMap.Num() != DumpMetaData->Num()) {
 			return false;
 		}
 
-		for (const TPair<FString, FString>& MetadataPair : TableMetadataMap) {
-			FString MetadataValueString;
-			if (!MetaDataObject->TryGetStringField(MetadataPair.Key, MetadataValueString) ||
-				MetadataPair.Value != MetadataValueString) {
+		for (const TPair<FName, FString>& MetadataPair : TableMetadataMap) {
+			const FString* DumpMetadataValue = DumpMetaData->Find(MetadataPair.Key);
+			if (DumpMetadataValue == NULL || MetadataPair.Value != *DumpMetadataValue) {
 				return false;
 			}
 		}
@@ -160,8 +160,8 @@ void UUserDefinedStructGenerator::FinalizeAssetCDO() {
 	}
 }
 
-void UUserDefinedStructGenerator::PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const {
-	if (GetCurrentStage() == EAssetGenerationStage::CONSTRUCTION) {
+void UUserDefinedStructGenerator::PrepareStage(const EAssetGenerationStage Stage, TArray<FPackageDependency>& OutDependencies) {
+	if (Stage == EAssetGenerationStage::CONSTRUCTION) {
 		const TArray<TSharedPtr<FJsonValue>>& ChildProperties = GetAssetData()->GetArrayField(TEXT("ChildProperties"));
 
 		TArray<FString> AllDependencyNames;
@@ -174,7 +174,7 @@ void UUserDefinedStructGenerator::PopulateStageDependencies(TArray<FPackageDepen
 			OutDependencies.Add(FPackageDependency{FName(*DependencyName), EAssetGenerationStage::CONSTRUCTION});
 		}
 
-	} else if (GetCurrentStage() == EAssetGenerationStage::CDO_FINALIZATION) {
+	} else if (Stage == EAssetGenerationStage::CDO_FINALIZATION) {
 		const TArray<TSharedPtr<FJsonValue>> ReferencedObjects = GetAssetData()->GetArrayField(TEXT("ReferencedObjects"));
 		
 		TArray<FString> OutReferencedPackages;
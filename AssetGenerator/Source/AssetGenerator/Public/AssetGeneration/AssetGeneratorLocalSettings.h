@@ -13,6 +13,7 @@ public:
 public:
 	UAssetGeneratorLocalSettings() :
 		MaxAssetsToAdvancePerTick(4),
+		TickTimeBudgetMs(0.0f),
 		bRefreshExistingAssets(true),
 		bGeneratePublicProject(false) {
 	}
@@ -28,6 +29,10 @@ public:
 	/** Maximum amount of asset generators to advance in one tick */
 	UPROPERTY(EditAnywhere, Config, Category = "Asset Generator")
 	int32 MaxAssetsToAdvancePerTick;
+
+	/** Target duration of one tick in milliseconds, overrides MaxAssetsToAdvancePerTick when above zero */
+	UPROPERTY(EditAnywhere, Config, Category = "Asset Generator", meta = (ClampMin = "0"))
+	float TickTimeBudgetMs;
 	
 	/** Whenever existing assets need to be refreshed */
 	UPROPERTY(EditAnywhere, Config, Category = "Asset Generator")
@@ -3,6 +3,104 @@
 #include "AssetGeneration/KismetIntermediateFormat.h"
 #include "Json.h"
 
+/**
+ * Instructions of the disassembled bytecode understood by the transformer, named after "Inst" field values
+ * Instruction names are resolved into this enum once per node through the static lookup table, so dispatch
+ * does not need to compare strings against every known instruction name
+ */
+enum class EKismetInstruction : uint8 {
+    Unknown,
+    //Statements
+    Nothing,
+    SetSet,
+    SetArray,
+    SetMap,
+    Let,
+    LetObj,
+    LetWeakObjPtr,
+    LetBool,
+    LetMulticastDelegate,
+    LetDelegate,
+    LetValueOnPersistentFrame,
+    CallMulticastDelegate,
+    ComputedJump,
+    Jump,
+    JumpIfNot,
+    PushExecutionFlow,
+    PopExecutionFlowIfNot,
+    PopExecutionFlow,
+    AddMulticastDelegate,
+    RemoveMulticastDelegate,
+    ClearMulticastDelegate,
+    BindDelegate,
+    Return,
+    //Function calls
+    CallMath,
+    LocalFinalFunction,
+    FinalFunction,
+    LocalVirtualFunction,
+    VirtualFunction,
+    //Casts
+    ObjToInterfaceCast,
+    CrossInterfaceCast,
+    InterfaceToObjCast,
+    DynamicCast,
+    MetaCast,
+    PrimitiveCast,
+    //Contexts and variables
+    Context,
+    Context_FailSilent,
+    ClassContext,
+    InterfaceContext,
+    StructMemberContext,
+    DefaultVariable,
+    InstanceVariable,
+    LocalVariable,
+    LocalOutVariable,
+    //Inline generated parameters
+    ArrayGetByRef,
+    SwitchValue,
+    //Literals
+    Self,
+    TextConst,
+    StringConst,
+    UnicodeStringConst,
+    FloatConst,
+    IntConst,
+    Int64Const,
+    UInt64Const,
+    ByteConst,
+    False,
+    True,
+    NameConst,
+    VectorConst,
+    RotationConst,
+    TransformConst,
+    StructConst,
+    InstanceDelegate,
+    SoftObjectConst,
+    NoObject,
+    ObjectConst,
+    NoInterface,
+    ArrayConst,
+    SetConst,
+    MapConst
+};
+
+/**
+ * Independent region of the ubergraph, consisting of all statements reachable from a set of event entry points
+ * Regions do not share any statements, so they can be decompiled separately from each other
+ * Region without any entry points holds statements not reachable from any of the known entry points
+ */
+struct ASSETGENERATOR_API FKismetUbergraphRegion {
+    /** Bytecode offsets of the event entry points starting execution in this region, sorted */
+    TArray<int32> EntryOffsets;
+    /** Statements located at the matching entry offsets, where execution of each event starts */
+    TArray<TSharedPtr<FKismetCompiledStatement>> EntryStatements;
+    /** Statements belonging to this region, in the bytecode order */
+    TArray<TSharedPtr<FKismetCompiledStatement>> Statements;
+};
+
 /**
  * Handles transformation of kismet bytecode into the intermediate format
  * To aid with decompilation and represent bytecode in a format closer to the source text
@@ -21,8 +119,25 @@ public:
     /** Finishes generation and returns result statements */
     TArray<TSharedPtr<FKismetCompiledStatement>> FinishGeneration();
 
+    /** Returns bytecode offsets of the result statements, in the same order as the statements themselves */
+    FORCEINLINE const TArray<int32>& GetStatementOffsets() const { return StatementOffsets; }
+
+    /** Enables or disables interning of the literal terminals, should be set before source statements are provided. Enabled by default */
+    FORCEINLINE void SetLiteralInterningEnabled(bool bEnabled) { this->bInternLiteralTerminals = bEnabled; }
+
+    /**
+     * Partitions transformed ubergraph statements into independent regions reachable from the provided event entry offsets
+     * Entry points reaching the same statements, for example shared latent action resume points, end up in the same region
+     * Statements not reachable from any of the entry points, like code of the events called with a non-constant entry offset,
+     * are put into the last region, which has no entry points, so every statement ends up in exactly one region
+     */
+    TArray<FKismetUbergraphRegion> PartitionUberGraph(const TArray<int32>& EntryOffsets) const;
+
     /** Returns true if we are currently processing ubergraph function */
     FORCEINLINE bool IsUberGraphFunction() const { return CurrentFunctionName == ExecuteUbergraphFunctionName; } 
+
+    /** Resolves instruction name into the instruction enum, returns Unknown for instructions transformer does not support */
+    static EKismetInstruction FindInstructionByName(const FString& InstructionName);
 private:
     /** Class path of the class this bytecode belongs to. Should exist and be populated with function stubs */
     UBlueprint* OwnerBlueprint;
@@ -33,23 +148,53 @@ private:
     /** Name of the function we are currently transforming */
     FString CurrentFunctionName;
 
-    static bool IsContextInstruction(const FString& InstructionName);
-    static bool IsCallFunctionInstruction(const FString& InstructionName);
-    static bool IsVariableInstruction(const FString& InstructionName);
+    /** Reads "Inst" field of the disassembled node and resolves it into the instruction enum */
+    static EKismetInstruction GetInstruction(const TSharedPtr<FJsonObject>& Node);
+
+    /** Returns true if execution can continue to the next statement in the list after executing the provided statement */
+    static bool CanFallThroughStatement(const TSharedPtr<FKismetCompiledStatement>& Statement);
+
+    static bool IsContextInstruction(EKismetInstruction Instruction);
+    static bool IsCallFunctionInstruction(EKismetInstruction Instruction);
     
     TSharedPtr<FKismetCompiledStatement> ProcessStatement(TSharedPtr<FJsonObject> Statement);
     TSharedPtr<FKismetTerminal> ProcessExpression(TSharedPtr<FJsonObject> Expression);
-    TSharedPtr<FKismetTerminal> ProcessLiteralExpression(TSharedPtr<FJsonObject> Expression, bool bIsDelimited);
-    TSharedPtr<FKismetCompiledStatement> ProcessFunctionCallStatement(TSharedPtr<FJsonObject> Statement);
+    /** Overloads below take the instruction already resolved by the caller, so every node is only looked up once */
+    TSharedPtr<FKismetTerminal> ProcessExpression(TSharedPtr<FJsonObject> Expression, EKismetInstruction Instruction);
+    TSharedPtr<FKismetTerminal> ProcessLiteralExpression(TSharedPtr<FJsonObject> Expression, EKismetInstruction Instruction, bool bIsDelimited);
+    /** Builds a new literal terminal without interning it, used for nested constants only consumed while building the outer literal */
+    TSharedPtr<FKismetTerminal> CreateLiteralTerminal(TSharedPtr<FJsonObject> Expression, EKismetInstruction Instruction, bool bIsDelimited);
+    /** Builds a key identifying the literal by it's instruction and source value, returns false for literals that cannot be identified without building them */
+    static bool GetLiteralSourceKey(const TSharedPtr<FJsonObject>& Expression, EKismetInstruction Instruction, bool bIsDelimited, FString& OutSourceKey);
+    TSharedPtr<FKismetCompiledStatement> ProcessFunctionCallStatement(TSharedPtr<FJsonObject> Statement, EKismetInstruction Instruction);
     TSharedPtr<FKismetTerminal> ProcessFunctionParameter(TSharedPtr<FJsonObject> Expression);
 
-    TMap<int32, TSharedPtr<FKismetCompiledStatement>> StatementsByOffset;
+    /** Appends statement starting at the provided bytecode offset to the result statements. Offsets should be strictly increasing */
+    void AddResultStatement(int32 StatementOffset, TSharedPtr<FKismetCompiledStatement> Statement);
+
+    /** Returns result statement starting at the provided bytecode offset, or NULL if there is no such statement */
+    TSharedPtr<FKismetCompiledStatement> FindStatementByOffset(int32 StatementOffset) const;
+
+    /** Returns terminal safe to modify, copying literals since they can be shared through the literal pool */
+    static TSharedPtr<FKismetTerminal> MakeMutableTerminal(const TSharedPtr<FKismetTerminal>& Terminal);
+
+    //Bytecode offsets of the result statements, one per statement in ResultStatements
+    //Statements are produced in the bytecode order, so offsets are sorted and looked up using binary search
+    TArray<int32> StatementOffsets;
     TArray<TSharedPtr<FKismetCompiledStatement>> ResultStatements;
 
-    //Map of patch-ups to apply to target labels after all expressions have been parsed
-    //It will convert int32 offsets in bytecode to absolute statement references
+    //List of patch-ups to apply to target labels after all expressions have been parsed
+    //It will convert int32 offsets in bytecode to absolute statement references in a single pass
     //It might also end up converting statement type if referenced statement is happens to be Return
     //then jump is converted to KCST_GotoReturn
-    TMap<TSharedPtr<FKismetCompiledStatement>, int32> JumpPatchUpTable;
+    TArray<TPair<TSharedPtr<FKismetCompiledStatement>, int32>> JumpPatchUpTable;
+
+    //Literal terminals of the current function, structurally equal literals are interned into a single shared terminal
+    //Sharing them also lets the graph decompiler match repeated literals by pointer before falling back to structural comparison
+    FKismetLiteralTerminalPool LiteralTerminalPool;
+    //Interned literal terminals by the source key of the simple literals, so repeated simple literals are not built again just to be looked up in the pool
+    TMap<FString, TSharedPtr<FKismetTerminal>> LiteralTerminalsBySource;
+    //When disabled, every literal gets its own terminal, which is how literals were produced before interning was introduced
+    bool bInternLiteralTerminals;
 
 };
@@ -1,11 +1,17 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "AssetGeneration/KismetIntermediateFormat.h"
+#include "AssetGeneration/KismetBytecodeTransformer.h"
 #include "EdGraphSchema_K2.h"
+#include "EdGraphSchema_K2_Actions.h"
 
 class UK2Node_CreateDelegate;
 class UK2Node_BaseMCDelegate;
 
+/**
+ * Wraps shared terminal pointer to make maps keyed by it use structural terminal equality and hashing
+ * instead of pointer identity, so different terminal objects referencing the same variable map to the same entry
+ */
 struct ASSETGENERATOR_API FKismetTerminalAsKeyType {
 public:
     TSharedPtr<FKismetTerminal> Terminal;
@@ -25,9 +31,66 @@ public:
     /** Constructs decompiler object for provided function and graph */
     FKismetGraphDecompiler(UFunction* Function, UEdGraph* Graph);
 
+    /** Asserts that nodes generated by the decompiler have been linked by FinishNodeGeneration */
+    ~FKismetGraphDecompiler();
+
     /** Initializes decompiler with the compiled kismet statement list */
     void Initialize(const TArray<TSharedPtr<FKismetCompiledStatement>>& Statements);
+
+    /**
+     * Initializes decompiler with the statements of the single ubergraph region produced by FKismetBytecodeTransformer::PartitionUberGraph
+     * Code of every event entry point of the region is laid out in its own column of the graph
+     */
+    void InitializeFromUbergraphRegion(const FKismetUbergraphRegion& Region);
+
+    /** Returns bytecode offset of the ubergraph event entry point starting at the provided statement, or NULL if it is not an entry point */
+    FORCEINLINE const int32* FindUbergraphEntryOffset(const TSharedPtr<FKismetCompiledStatement>& Statement) const {
+        return UbergraphEntryOffsets.Find(Statement);
+    }
+
+    /**
+     * Generates nodes for all of the statements decompiler has been initialized with and links them by calling FinishNodeGeneration
+     * Statements no node generator has been implemented for yet are skipped
+     */
+    void GenerateNodes();
+
+    /**
+     * Links pins of the generated nodes in a single batch and broadcasts graph change notifications,
+     * which are suppressed while nodes are generated. Should be called once all statements have been processed
+     */
+    void FinishNodeGeneration();
+
+    /**
+     * Enables or disables batched node generation, should be set before the decompiler is initialized. Enabled by default
+     * When disabled, nodes are spawned through FEdGraphSchemaAction_K2NewNode and linked through the schema one connection at a time
+     */
+    FORCEINLINE void SetBatchedNodeGenerationEnabled(bool bEnabled) { this->bBatchNodeGeneration = bEnabled; }
+
+    /** Follows the chain of pass-through terminals starting at the provided terminal to the terminal it ends with. Returns NULL if the chain forms a cycle */
+    static TSharedPtr<FKismetTerminal> ResolvePassThroughTerminal(const TMap<FKismetTerminalAsKeyType, TSharedPtr<FKismetTerminal>>& PassThroughTerminals, TSharedPtr<FKismetTerminal> Terminal);
 private:
+    /**
+     * Spawns node of the provided class into the graph below the previously generated node, calling initializer before pins are allocated
+     * Unlike FEdGraphSchemaAction_K2NewNode::SpawnNode, it does not modify the graph, notify about the change or mark blueprint as modified
+     * for every node, which is done once for the whole graph instead
+     */
+    UEdGraphNode* SpawnGraphNode(UClass* NodeClass, TFunctionRef<void(UEdGraphNode*)> InitializerFn);
+
+    template<typename T>
+    FORCEINLINE T* SpawnGraphNode(TFunctionRef<void(T*)> InitializerFn) {
+        //Spawning through the schema action places every node at the free spot of the graph and modifies the graph per node
+        if (!bBatchNodeGeneration) {
+            this->bHasUnlinkedNodes = true;
+            return FEdGraphSchemaAction_K2NewNode::SpawnNode<T>(EditorGraph, EditorGraph->GetGoodPlaceForNewNode(), EK2NewNodeFlags::None, InitializerFn);
+        }
+        return CastChecked<T>(SpawnGraphNode(T::StaticClass(), [&InitializerFn](UEdGraphNode* NewNode) { InitializerFn(CastChecked<T>(NewNode)); }));
+    }
+
+    template<typename T>
+    FORCEINLINE T* SpawnGraphNode() {
+        return CastChecked<T>(SpawnGraphNode(T::StaticClass(), [](UEdGraphNode* NewNode) {}));
+    }
+
     void ConnectMakeStructNodePinsWithTerminals(UK2Node* MakeStructNode, TSharedPtr<FKismetTerminal> StructTerminal);
     
     UEdGraphNode* CreateMakeMapNode();
@@ -84,11 +147,22 @@ private:
     UBlueprint* OwnerBlueprint;
     /** Graph containing source code for edited function */
     UEdGraph* EditorGraph;
+    /** Position of the next generated node, every generated node is placed below the previous one */
+    FVector2D NextNodePosition;
+    /** Position of the first node generated for the current ubergraph event, next event starts a new column to the right of it */
+    FVector2D EventColumnPosition;
+    /** Whenever nodes are spawned and linked in a batch, or one by one through the schema */
+    bool bBatchNodeGeneration;
+    /** Set once a node is spawned, and reset once FinishNodeGeneration links the generated nodes */
+    bool bHasUnlinkedNodes;
     
     /** Collection of statements we are decompiling */
     TArray<TSharedPtr<FKismetCompiledStatement>> CompiledStatements;
     int32 CurrentStatementIndex;
 
+    /** Statements execution of the ubergraph events starts at, mapped to their bytecode offsets. Empty for normal functions */
+    TMap<TSharedPtr<FKismetCompiledStatement>, int32> UbergraphEntryOffsets;
+
     /** Map of intermediate variable terminals to node outputs which caused their generation */
     TMap<FKismetTerminalAsKeyType, UEdGraphPin*> IntermediateVariableHandles;
 
@@ -160,13 +160,47 @@ struct FKismetTerminal {
 	// If this term is also a context, this indicates which type of context it is
 	EContextType ContextType;
 
-	FORCEINLINE bool operator==(const FKismetTerminal& Terminal) const {
-		checkf(0, TEXT("Should implement it later"));
-		return true;
+	/**
+	 * Structural comparison of the terminals: types, literal values, referenced properties and objects must match,
+	 * and context chains must be structurally equal too. Inline generated parameters are compared by identity,
+	 * since every one of them is a separate statement evaluated at the point of use
+	 */
+	ASSETGENERATOR_API bool operator==(const FKismetTerminal& Terminal) const;
+
+	FORCEINLINE bool operator!=(const FKismetTerminal& Terminal) const {
+		return !operator==(Terminal);
+	}
+};
+
+/** Hash consistent with the structural equality of the terminals, includes hashes of the entire context chain */
+ASSETGENERATOR_API uint32 GetTypeHash(const FKismetTerminal& Terminal);
+
+/** Set key functions comparing and hashing shared terminals structurally instead of by pointer */
+struct FKismetTerminalStructuralKeyFuncs : BaseKeyFuncs<TSharedPtr<FKismetTerminal>, TSharedPtr<FKismetTerminal>> {
+	static FORCEINLINE const TSharedPtr<FKismetTerminal>& GetSetKey(const TSharedPtr<FKismetTerminal>& Element) {
+		return Element;
+	}
+	static FORCEINLINE bool Matches(const TSharedPtr<FKismetTerminal>& A, const TSharedPtr<FKismetTerminal>& B) {
+		return *A == *B;
+	}
+	static FORCEINLINE uint32 GetKeyHash(const TSharedPtr<FKismetTerminal>& Key) {
+		return GetTypeHash(*Key);
 	}
 };
 
-FORCEINLINE uint32 GetTypeHash(const FKismetTerminal& Terminal) {
-	checkf(0, TEXT("Should implement it later"));
-	return 0;
-}
\ No newline at end of file
+/**
+ * Pool of the literal terminals, handing out a single shared terminal for all structurally equal literals of the function
+ * Interned terminals are referenced by multiple statements at once, so they should never be modified after being interned
+ */
+class ASSETGENERATOR_API FKismetLiteralTerminalPool {
+public:
+	/** Returns previously interned terminal equal to the provided one, or interns the provided terminal if there is none */
+	TSharedPtr<FKismetTerminal> Intern(const TSharedPtr<FKismetTerminal>& Terminal);
+
+	/** Releases all interned terminals */
+	void Reset();
+
+	FORCEINLINE int32 Num() const { return InternedTerminals.Num(); }
+private:
+	TSet<TSharedPtr<FKismetTerminal>, FKismetTerminalStructuralKeyFuncs> InternedTerminals;
+};
\ No newline at end of file
@@ -1,10 +1,18 @@
 ﻿#pragma once
 #include "Modules/ModuleManager.h"
 
+class FDirtyPackageTracker;
+
 class ASSETGENERATOR_API FAssetGeneratorModule : public FDefaultGameModuleImpl {
+private:
+	/** Tracks packages dirtied since the module has been started, only created when running as a commandlet */
+	TSharedPtr<FDirtyPackageTracker> DirtyPackageTracker;
 public:
 	static const FName AssetGeneratorTabName;
 	
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
+
+	/** Returns tracker of the packages dirtied since the module has been started, or NULL when not running as a commandlet */
+	FORCEINLINE TSharedPtr<FDirtyPackageTracker> GetDirtyPackageTracker() const { return DirtyPackageTracker; }
 };
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
 #include "Slate.h"
 
+class FAssetDumpIndex;
+
 struct ASSETGENERATOR_API FAssetDumpTreeNode : TSharedFromThis<FAssetDumpTreeNode> {
 public:
 	/** Root directory path */
 	FString RootDirectory;
+	/** Index of the dump directory, shared between all nodes of the tree. Directory is scanned when it is not available */
+	TSharedPtr<const FAssetDumpIndex> DumpIndex;
 	/** Whenever this node represents a complete asset path, or just a directory */
 	bool bIsLeafNode;
 	/** Full Path to the represented asset dump file or directory */
@@ -31,6 +35,7 @@ private:
 	TArray<TSharedPtr<FAssetDumpTreeNode>> Children;
 	
     void RegenerateChildren();
+	void RegenerateChildrenFromIndex();
 	TSharedPtr<FAssetDumpTreeNode> MakeChildNode();
 	FString ComputeAssetClass();
 public:
@@ -49,8 +54,8 @@ public:
 	/** Appends selected package names to the package list */
 	void PopulateGeneratedPackages(TArray<FName>& OutPackageNames, const TSet<FName>* WhitelistedAssetClasses = NULL);
 
-	/** Creates a root node for the asset tree */
-	static TSharedPtr<FAssetDumpTreeNode> CreateRootTreeNode(const FString& DumpDirectory);
+	/** Creates a root node for the asset tree, using the dump index to populate it when it's available and allowed */
+	static TSharedPtr<FAssetDumpTreeNode> CreateRootTreeNode(const FString& DumpDirectory, bool bUseDumpIndex = true);
 };
 
 class ASSETGENERATOR_API SAssetDumpViewWidget : public SCompoundWidget {
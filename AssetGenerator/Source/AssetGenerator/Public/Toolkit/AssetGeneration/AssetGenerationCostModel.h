@@ -0,0 +1,89 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+
+/** Stage timings accumulated for a single asset generator class */
+struct ASSETGENERATOR_API FAssetGeneratorClassTimings {
+public:
+	/** Amount of stages advanced by generators of this class */
+	int32 StagesAdvanced;
+	/** Total time spent advancing stages, in seconds */
+	double TotalSeconds;
+	/** Duration of the slowest stage advanced, in seconds */
+	double MaxStageSeconds;
+	/** Moving average of the measured duration of each stage, in milliseconds */
+	float StageCostMs[(int32) EAssetGenerationStage::FINISHED];
+	/** Amount of measurements taken for each stage */
+	int32 StageSamples[(int32) EAssetGenerationStage::FINISHED];
+
+	FAssetGeneratorClassTimings();
+};
+
+/**
+ * Estimates how long advancing a generator stage is going to take
+ * Starts with the static estimates provided by the generator classes and refines them
+ * with the stage durations measured during the generation, so the processor can fit as many
+ * generators into a tick as the time budget allows regardless of how expensive each asset type is
+ */
+class ASSETGENERATOR_API FAssetGenerationCostModel {
+private:
+	/** Generator classes are native and never unloaded, so raw pointers are safe here */
+	TMap<UClass*, FAssetGeneratorClassTimings> ClassTimings;
+	/** Moving average of the work done for each advanced generator after the stage itself, like preparing the next stage and gathering dependencies, in milliseconds */
+	float PerGeneratorOverheadMs;
+	/** Amount of ticks overhead has been measured for */
+	int32 OverheadSamples;
+public:
+	FAssetGenerationCostModel();
+
+	/** Returns estimated duration of advancing the current stage of the provided generator, in milliseconds */
+	float EstimateStageCostMs(const UAssetTypeGenerator* Generator) const;
+
+	/** Returns average measured cost of the given stage across all generator classes, or the default estimate if it has not been measured yet */
+	float EstimateAverageStageCostMs(EAssetGenerationStage Stage) const;
+
+	/** Returns estimated cost of the work done for each advanced generator after the stage itself, in milliseconds */
+	FORCEINLINE float EstimatePerGeneratorOverheadMs() const { return PerGeneratorOverheadMs; }
+
+	/** Records measured duration of advancing the given stage of the provided generator */
+	void RecordStageDuration(const UAssetTypeGenerator* Generator, EAssetGenerationStage Stage, double Seconds);
+
+	/** Records time spent after advancing the provided amount of generators in one tick, preparing their next stages and gathering dependencies */
+	void RecordOverheadDuration(int32 GeneratorsAdvanced, double Seconds);
+
+	/** Prints per-class timings into the log, slowest classes first */
+	void PrintTimingsIntoTheLog() const;
+
+	/** Writes per-class timings into the CSV file at the provided path */
+	bool ExportTimingsToFile(const FString& FilePath) const;
+};
+
+/**
+ * Time budget of the generator ticks. All of the work done during the tick is charged against it,
+ * and when a tick still overruns the budget, the overrun is subtracted from the budget of the next ticks
+ * Time is passed in by the caller instead of being read from the clock, so scheduling can be simulated
+ */
+class ASSETGENERATOR_API FAssetGenerationTickBudget {
+private:
+	/** Target duration of one tick in milliseconds, zero or less when the budget is disabled */
+	float BudgetMs;
+	/** Time the previous ticks have spent over their budget and that is still to be paid back, in milliseconds */
+	double OverrunMs;
+public:
+	explicit FAssetGenerationTickBudget(float BudgetMs = 0.0f);
+
+	FORCEINLINE bool IsEnabled() const { return BudgetMs > 0.0f; }
+	FORCEINLINE double GetOverrunMs() const { return OverrunMs; }
+
+	/** Returns time available to the current tick, with the overrun of the previous ticks subtracted */
+	FORCEINLINE double GetAvailableMs() const { return FMath::Max(BudgetMs - OverrunMs, 0.0); }
+
+	/**
+	 * Determines whenever work with the provided estimated cost still fits into the current tick after ElapsedMs have been spent on it
+	 * At least one generator is always allowed per tick, otherwise generators more expensive than the budget would never be advanced
+	 */
+	bool CanFit(double ElapsedMs, double EstimatedCostMs, int32 GeneratorsAdvanced) const;
+
+	/** Finishes the tick that took ElapsedMs in total, carrying the overrun over to the next tick */
+	void FinishTick(double ElapsedMs);
+};
@@ -1,12 +1,91 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+#include "Toolkit/AssetGeneration/AssetGenerationCostModel.h"
+#include "Toolkit/AssetGeneration/MaterialCompilationTracker.h"
+#include "Util/PackageNameMatcher.h"
 
 class SNotificationItem;
 
-struct FDependencyList {
-	UAssetTypeGenerator* AssetTypeGenerator;
-	TMap<FName, EAssetGenerationStage> PackageDependencies;
+/** Identifies generation stage of a specific package that dependents are waiting to be finished */
+struct FPackageStageKey {
+	FName PackageName;
+	EAssetGenerationStage Stage;
+
+	FORCEINLINE FPackageStageKey(FName PackageName, EAssetGenerationStage Stage) : PackageName(PackageName), Stage(Stage) {}
+
+	FORCEINLINE bool operator==(const FPackageStageKey& Other) const {
+		return PackageName == Other.PackageName && Stage == Other.Stage;
+	}
+
+	FORCEINLINE friend uint32 GetTypeHash(const FPackageStageKey& Key) {
+		return HashCombine(GetTypeHash(Key.PackageName), (uint32) Key.Stage);
+	}
+};
+
+/**
+ * FIFO queue of the generators ready to be advanced
+ * Elements are consumed by moving the head index, and the consumed part of the storage
+ * is only reclaimed once it outgrows the live part, so both operations are amortized O(1)
+ */
+class FGeneratorReadyQueue {
+	TArray<UAssetTypeGenerator*> Generators;
+	int32 HeadIndex;
+public:
+	FORCEINLINE FGeneratorReadyQueue() : HeadIndex(0) {}
+
+	FORCEINLINE int32 Num() const { return Generators.Num() - HeadIndex; }
+
+	FORCEINLINE UAssetTypeGenerator* operator[](int32 Index) const { return Generators[HeadIndex + Index]; }
+
+	FORCEINLINE void Enqueue(UAssetTypeGenerator* Generator) { Generators.Add(Generator); }
+
+	/** Removes provided amount of generators from the head of the queue */
+	FORCEINLINE void PopFront(int32 Count) {
+		check(Count <= Num());
+		HeadIndex += Count;
+
+		if (HeadIndex == Generators.Num()) {
+			Generators.Reset();
+			HeadIndex = 0;
+		} else if (HeadIndex > Generators.Num() / 2) {
+			Generators.RemoveAt(0, HeadIndex, false);
+			HeadIndex = 0;
+		}
+	}
+};
+
+/**
+ * Reverse index from the package stage to the generators waiting for it to be finished,
+ * along with the amount of dependencies every waiting generator still has outstanding
+ * Finishing a stage only touches generators that are waiting for it, instead of rescanning all of the dependency lists
+ */
+class FGeneratorDependencyIndex {
+	/** Maps package name and stage to the generators waiting for that package to finish the stage */
+	TMap<FPackageStageKey, TArray<UAssetTypeGenerator*>> PendingDependents;
+	/** Amount of package dependencies each waiting generator still has outstanding for it's current stage */
+	TMap<UAssetTypeGenerator*, int32> OutstandingDependencyCounts;
+public:
+	/** Registers generator as waiting for the provided package to finish the stage */
+	void AddDependency(UAssetTypeGenerator* Generator, FName DependencyPackageName, EAssetGenerationStage DependencyStage);
+
+	/**
+	 * Marks stage of the provided package as finished, decrementing outstanding dependency counts of the generators waiting for it
+	 * Generators which have no dependencies left are appended to the ready queue in the order they started waiting for the stage
+	 * Returns amount of generators that have been waiting for the stage
+	 */
+	int32 FinishPackageStage(FName PackageName, EAssetGenerationStage FinishedStage, FGeneratorReadyQueue& ReadyQueue);
+
+	/** Returns true if any generators are still waiting on any stage of the provided package */
+	bool HasPendingDependents(FName PackageName) const;
+
+	/** Drops all of the generators waiting on the provided package, used to recover from inconsistent state */
+	void RemovePendingDependents(FName PackageName);
+
+	/** Returns amount of dependencies the generator is still waiting for */
+	FORCEINLINE int32 GetOutstandingDependencyCount(UAssetTypeGenerator* Generator) const { return OutstandingDependencyCounts.FindRef(Generator); }
+
+	FORCEINLINE const TMap<FPackageStageKey, TArray<UAssetTypeGenerator*>>& GetPendingDependents() const { return PendingDependents; }
 };
 
 enum class EAddPackageResult {
@@ -20,14 +99,22 @@ struct ASSETGENERATOR_API FAssetGeneratorConfiguration {
 public:
 	/** Root directory for the source asset dump */
 	FString DumpRootDirectory;
-	/** Maximum amount of asset generators to advance in one tick */
+	/** Maximum amount of asset generators to advance in one tick. Only used when TickTimeBudgetMs is not set */
 	int32 MaxAssetsToAdvancePerTick;
+	/** Target duration of one tick in milliseconds. When above zero, generators are advanced until their estimated cost no longer fits into the budget */
+	float TickTimeBudgetMs;
+	/** When not empty, per-generator class timings are written into the CSV file at this path once generation is finished */
+	FString TimingStatsFilePath;
+	/** Packages matching this blacklist are skipped when they are pulled in as dependencies. Packages explicitly requested for generation are never skipped */
+	TSharedPtr<const FPackageNameMatcher> PackageBlacklist;
 	/** True to refresh existing assets, false to completely ignore assets already present */
 	bool bRefreshExistingAssets;
 	/** True to generate public project, with all of the non-redistributable asset files replaced with stubs */
 	bool bGeneratePublicProject;
 	/** If true, ticking will be performed manually by the external code like commandlet, and tickable game object logic will be fully ignored */
 	bool bTickOnTheSide;
+	/** True to read dump files and prepare generator stages on the game thread instead of the task graph workers */
+	bool bForceSingleThread;
 
 	FAssetGeneratorConfiguration();
 };
@@ -71,10 +158,18 @@ private:
 	FAssetGeneratorConfiguration Configuration;
 	/** Package name mapping to it's active asset generator */
 	TMap<FName, UAssetTypeGenerator*> AssetGenerators;
-	/** Maps package name to the list of dependencies waiting for it's generation */
-	TMap<FName, TArray<TSharedPtr<FDependencyList>>> PendingDependencies;
+	/** Newly created generators which first stage has not been prepared yet, they are prepared together as a batch */
+	TArray<UAssetTypeGenerator*> GeneratorsPendingInitialization;
+	/** Generators waiting for the other packages to finish their stages */
+	FGeneratorDependencyIndex DependencyIndex;
 	/** Generators which dependencies have been fully satisfied are added here, they will be advanced next tick */
-	TArray<UAssetTypeGenerator*> GeneratorsReadyToAdvance;
+	FGeneratorReadyQueue GeneratorsReadyToAdvance;
+	/** Dependency packages of the generators which current stage needs compiled shader maps */
+	TMap<UAssetTypeGenerator*, TArray<FName>> ShaderMapDependencies;
+	/** Generators ready to advance, but held back until the materials they depend on finish compiling */
+	TArray<UAssetTypeGenerator*> GeneratorsWaitingForShaderMaps;
+	/** Tracks compilation of the materials touched by the generators */
+	FMaterialCompilationTracker MaterialCompilationTracker;
 	/** External packages checked to exist are added here and checked quickly */
 	TSet<FName> ExternalPackagesResolved;
 	/** Packages that have been generated before are listed here */
@@ -85,6 +180,8 @@ private:
 	TSet<FName> SkippedPackages;
 	/** List of packages to generate */
 	TArray<FName> PackagesToGenerate;
+	/** Same packages as PackagesToGenerate, for quick lookups */
+	TSet<FName> PackagesToGenerateSet;
 	/** Index of the next package to generate */
 	int32 NextPackageToGenerateIndex;
 	/** True when generation has been finished */
@@ -95,9 +192,17 @@ private:
 	FAssetGenStatistics Statistics;
 	/** Notification shown to indicate asset generation progress */
 	TSharedPtr<SNotificationItem> NotificationItem;
+	/** Total time spent loading dump files and preparing generator stages, in seconds */
+	double TimeSpentPreparing;
+	/** Estimates stage costs of the generators and accumulates their timings */
+	FAssetGenerationCostModel CostModel;
+	/** Time budget all of the work done in a tick is charged against, when TickTimeBudgetMs is set */
+	FAssetGenerationTickBudget TickBudget;
 
-	/** Initializes generator for the provided asset */
+	/** Initializes generator for the provided asset. Dependencies are gathered later by InitializePendingGenerators */
 	void InitializeAssetGeneratorInternal(UAssetTypeGenerator* Generator);
+	/** Prepares first stages of the newly created generators as a batch and gathers their dependencies */
+	void InitializePendingGenerators();
 	/** Marks external package as resolved */
 	void MarkExternalPackageDependencySatisfied(FName PackageName);
 	/** Marks package as unresolved and prints warning */
@@ -113,14 +218,24 @@ private:
 	void OnGeneratorStageAdvanced(UAssetTypeGenerator* Generator);
 	/** Cleans up asset generator for the provided asset and then removes it */
 	void CleanupAssetGenerator(UAssetTypeGenerator* Generator);
-	/** Adds new package to asset generator */
-	EAddPackageResult AddPackage(FName PackageName);
+	/** Adds new package to asset generator, optionally using the dump file contents loaded in advance */
+	EAddPackageResult AddPackage(FName PackageName, TSharedPtr<FJsonObject> PreloadedDumpData = NULL);
+	/** Prepares current stages of the provided generators, running the ones supporting it on the task graph */
+	void PrepareGeneratorStages(const TArray<UAssetTypeGenerator*>& Generators);
 	/** Called to find new packages for asset generation */
 	bool GatherNewAssetsForGeneration();
+	/** Returns amount of new packages to gather at once, derived from the tick time budget when it is set */
+	int32 GetMaxAssetsToGatherThisTick() const;
 	/** Called when asset generation is finished */
 	void OnAssetGenerationFinished();
 	/** Prints current state of the asset generator into the log */
 	void PrintStateIntoTheLog();
+	/** Returns true if the generator's current stage is waiting for materials it depends on to finish compiling */
+	bool IsWaitingForShaderMaps(UAssetTypeGenerator* Generator);
+	/** Moves generators which materials have finished compiling back into the ready queue */
+	void RequeueGeneratorsWithCompiledShaderMaps();
+	/** Determines whenever one more generator can be advanced this tick within the configured limits */
+	bool CanAdvanceGeneratorThisTick(UAssetTypeGenerator* Generator, int32 GeneratorsAdvanced, int32 MaxGeneratorsToAdvance, double TickElapsedMs) const;
 	/** Ticks asset generation and optionally terminates it when finished */
 	void TickAssetGeneration(int32& PackagesGeneratedThisTick);
 	/** Called at the first tick of asset generation, before any work is done */
@@ -135,6 +250,12 @@ private:
 public:
 	FORCEINLINE bool HasFinishedAssetGeneration() const { return bGenerationFinished; }
 	FORCEINLINE const FAssetGenStatistics& GetStatistics() const { return Statistics; } 
+
+	/** Returns tracker of the materials compiling during the generation */
+	FORCEINLINE FMaterialCompilationTracker& GetMaterialCompilationTracker() { return MaterialCompilationTracker; }
+
+	/** Returns true if all of the generators that can be advanced are waiting for shader compilation to finish */
+	FORCEINLINE bool IsBlockedOnShaderCompilation() const { return GeneratorsReadyToAdvance.Num() == 0 && GeneratorsWaitingForShaderMaps.Num() != 0; }
 	
 	/** Returns currently active instance of the asset generator */
 	FORCEINLINE static TSharedPtr<FAssetGenerationProcessor> GetActiveAssetGenerator() {
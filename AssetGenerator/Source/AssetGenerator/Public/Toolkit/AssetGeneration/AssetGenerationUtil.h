@@ -43,6 +43,8 @@ public:
 	bool bIsUberGraphFunction;
 	bool bIsDelegateSignatureFunction;
 	bool bIsCallingIntoUbergraph;
+	/** Offsets of the ubergraph entry points this function calls into, used to partition ubergraph into per-event regions */
+	TArray<int32> UbergraphEntryOffsets;
 	
 	FORCEINLINE FDeserializedFunction() : FunctionFlags(FUNC_None), bIsUberGraphFunction(false), bIsDelegateSignatureFunction(false), bIsCallingIntoUbergraph(false) {}
 
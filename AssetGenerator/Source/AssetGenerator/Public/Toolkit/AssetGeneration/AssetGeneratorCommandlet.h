@@ -17,5 +17,8 @@ private:
 	void ProcessDeferredCommands();
 	void ClearEmptyGamePackagesLoadedDuringDisregardGC();
 
+	/** Returns asset registry for the current engine version */
+	IAssetRegistry& GetAssetRegistry();
+
 	virtual UAssetRegistryImpl& Get();
 };
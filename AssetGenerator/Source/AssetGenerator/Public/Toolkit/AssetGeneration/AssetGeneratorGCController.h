@@ -0,0 +1,62 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/** Snapshot of the process memory state used by the garbage collection controller */
+struct ASSETGENERATOR_API FAssetGeneratorGCSample {
+	/** Physical memory used by the process, in megabytes */
+	uint64 UsedPhysicalMB;
+	/** Amount of live UObjects */
+	int32 NumObjects;
+
+	FAssetGeneratorGCSample() : UsedPhysicalMB(0), NumObjects(0) {}
+	FAssetGeneratorGCSample(uint64 UsedPhysicalMB, int32 NumObjects) : UsedPhysicalMB(UsedPhysicalMB), NumObjects(NumObjects) {}
+
+	/** Captures memory state of the current process */
+	static FAssetGeneratorGCSample Capture();
+};
+
+/**
+ * Decides when garbage should be collected during generation
+ * Without the memory ceiling, collects garbage every N seconds or N packages, like the cooker does
+ * With the memory ceiling, collects garbage whenever memory usage gets close to the ceiling, and otherwise
+ * stretches the regular interval while collections free little objects, shrinking it back once they become useful again
+ */
+class ASSETGENERATOR_API FAssetGeneratorGCController {
+private:
+	int32 PackagesCookedSinceLastGC;
+	double LastGCTimestamp;
+
+	float MaxSecondsBetweenGC;
+	int32 MaxPackagesBetweenGC;
+
+	/** Memory usage we try to stay below, in megabytes. 0 disables adaptive mode */
+	uint64 MemoryCeilingMB;
+	/** Current multiplier applied to the regular collection interval */
+	int32 IntervalMultiplier;
+	/** Amount of objects freed by the last collection */
+	int32 LastGCObjectsFreed;
+	/** Total amount of collections and objects freed by them, for the summary */
+	int32 NumCollections;
+	int64 TotalObjectsFreed;
+public:
+	explicit FAssetGeneratorGCController(float MaxSecondsBetweenGC = 20.0f, int32 MaxPackagesBetweenGC = 32, uint64 MemoryCeilingMB = 0);
+
+	/** Records the amount of packages generated since the last update */
+	void Update(int32 PackagesGeneratedThisTick);
+
+	FORCEINLINE bool IsAdaptive() const { return MemoryCeilingMB != 0; }
+	FORCEINLINE int32 GetIntervalMultiplier() const { return IntervalMultiplier; }
+	FORCEINLINE int32 GetNumCollections() const { return NumCollections; }
+	FORCEINLINE int32 GetLastGCObjectsFreed() const { return LastGCObjectsFreed; }
+
+	/** Decides whenever garbage should be collected given the memory sample and the current time. Does not touch the engine state */
+	bool ShouldCollectGarbage(const FAssetGeneratorGCSample& Sample, double CurrentTime, FString& OutReason) const;
+
+	/** Records results of the garbage collection and adjusts the collection interval based on it's yield */
+	void RecordCollection(const FAssetGeneratorGCSample& SampleBefore, const FAssetGeneratorGCSample& SampleAfter, double CurrentTime);
+
+	/** Samples the current memory state and collects garbage if ShouldCollectGarbage decides so */
+	void ConditionallyCollectGarbage();
+
+	void PrintSummaryIntoTheLog() const;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class IAssetRegistry;
+
+/**
+ * Caches asset registry state between the commandlet runs, so the full registry scan is only done when content has changed
+ * State is keyed on the size and modification time of every file in the content directories the registry scans,
+ * which is much cheaper to compute than the scan itself
+ */
+class ASSETGENERATOR_API FAssetRegistryStateCache {
+public:
+	/** Returns full paths of the content directories covered by the state key, which are project, engine and enabled plugins content directories */
+	static TArray<FString> GetContentDirectories();
+
+	/** Computes key describing the current state of the content directories, project config and plugin descriptors */
+	static FString ComputeContentStateKey();
+
+	/** Loads asset registry state saved by the previous run if it was saved for the same content state */
+	static bool TryLoadCachedState(IAssetRegistry& AssetRegistry, const FString& ContentStateKey);
+
+	/** Saves current asset registry state along with the content state key */
+	static void SaveCachedState(IAssetRegistry& AssetRegistry, const FString& ContentStateKey);
+
+	/** Returns true if any of the package files is located outside of the content directories, and thus will not be scanned by the incremental scan */
+	static bool HasFilesOutsideOfContentDirectories(const TArray<FString>& PackageFiles, const TArray<FString>& ContentDirectories);
+
+	/**
+	 * Makes packages saved during generation visible through the asset registry
+	 * Scans just the saved files, unless some of them are located outside of the content directories or a full rescan is forced
+	 * Returns true if the full rescan has been done
+	 */
+	static bool ScanSavedPackages(IAssetRegistry& AssetRegistry, const TArray<FString>& SavedPackageFiles, bool bForceFullRescan);
+};
@@ -45,6 +45,10 @@ private:
 	bool bIsGeneratingPublicProject;
 	bool bIsStageNotOverriden;
 	bool bSkipAnim;
+	bool bCurrentStagePrepared;
+
+	/** Dependencies gathered by PrepareStage for the current stage, merged into the stage dependencies by CollectStageDependencies */
+	TArray<FPackageDependency> PreparedStageDependencies;
 	
 	UPROPERTY()
     UObjectHierarchySerializer* ObjectSerializer;
@@ -92,6 +96,13 @@ protected:
 	/** Called right after asset generator is initialized with asset data */
 	virtual void PostInitializeAssetGenerator() {}
 
+	/**
+	 * Prepares the provided stage before it's dependencies are gathered and the stage itself is applied
+	 * When SupportsParallelPreparation returns true this is called on a worker thread, so it should only read
+	 * the dump data and write into the generator's own members. Dependencies appended here are merged with PopulateStageDependencies
+	 */
+	virtual void PrepareStage(EAssetGenerationStage Stage, TArray<FPackageDependency>& OutDependencies) {}
+
 	/** Allocates new package object and asset object inside of it */
 	virtual void CreateAssetPackage() PURE_VIRTUAL(ConstructAsset, );
 	virtual void PopulateAssetWithData();
@@ -132,9 +143,27 @@ public:
 	template<typename T>
 	FORCEINLINE T* GetAsset() const { return CastChecked<T>(AssetObject); }
 
+	/** Returns asset object being generated, can be NULL before the construction stage */
+	FORCEINLINE UObject* GetAssetObject() const { return AssetObject; }
+
 	/** Populates array with the dependencies required to perform current asset generation stage */
 	virtual void PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const {}
 
+	/** Determines whenever PrepareStage can be run in parallel in worker threads. Override and return true if your PrepareStage never touches UObjects */
+	virtual bool SupportsParallelPreparation() const { return false; }
+
+	/** Static estimate of how long advancing the given stage takes, in milliseconds. Refined by the measured durations during the generation */
+	virtual float GetEstimatedStageCostMs(EAssetGenerationStage Stage) const { return 10.0f; }
+
+	/** Determines whenever the given stage needs shader maps of the materials it depends on to be fully compiled before it can be advanced */
+	virtual bool RequiresCompiledShaderMaps(EAssetGenerationStage Stage) const { return false; }
+
+	/** Runs PrepareStage for the current stage if it has not been prepared yet. Safe to call from worker threads if SupportsParallelPreparation is true */
+	void PrepareCurrentStage();
+
+	/** Collects both prepared and populated dependencies of the current stage, preparing it first if needed */
+	void CollectStageDependencies(TArray<FPackageDependency>& OutDependencies);
+
 	/** Attempts to advance asset generation stage. Returns new stage, or finished if generation is finished */
 	FGeneratorStateAdvanceResult AdvanceGenerationState();
 
@@ -147,6 +176,12 @@ public:
 	/** Returns file path corresponding to the provided package in the root directory */
 	static FString GetAssetFilePath(const FString& RootDirectory, FName PackageName);
 
+	/** Reads and parses asset dump file for the provided package. Does not touch any UObjects, so it can be called from any thread */
+	static TSharedPtr<FJsonObject> LoadAssetDumpFile(const FString& RootDirectory, FName PackageName);
+
+	/** Creates asset generator from the dump file contents previously returned by LoadAssetDumpFile */
+	static UAssetTypeGenerator* InitializeFromDumpData(const FString& RootDirectory, FName PackageName, TSharedPtr<FJsonObject> RootFileObject, bool bGeneratePublicProject);
+
 	/** Tries to load asset generator state from the asset dump located under the provided root directory and having given package name */
 	static UAssetTypeGenerator* InitializeFromFile(const FString& RootDirectory, FName PackageName, bool bGeneratePublicProject);
 
@@ -0,0 +1,27 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class FPackageNameMatcher;
+
+/**
+ * Records packages which dirty state changes while it is alive, so the final save pass of the commandlet
+ * only needs to look at these instead of iterating every package loaded in memory
+ * Packages dirtied before the tracker is created are not seen, so the commandlet uses the one started by the module
+ * before the engine loads any packages
+ */
+class ASSETGENERATOR_API FDirtyPackageTracker : public FNoncopyable {
+private:
+	TSet<TWeakObjectPtr<UPackage>> TrackedPackages;
+	FDelegateHandle DirtyStateChangedHandle;
+
+	void OnPackageDirtyStateChanged(UPackage* Package);
+public:
+	FDirtyPackageTracker();
+	~FDirtyPackageTracker();
+
+	/** Returns packages that are still alive and dirty, skipping the ones matched by the provided matcher */
+	void GetDirtyPackages(const FPackageNameMatcher& PackagesToSkip, TArray<UPackage*>& OutDirtyPackages) const;
+
+	/** Returns amount of packages that have been dirtied at least once since the tracker was created */
+	FORCEINLINE int32 GetNumTrackedPackages() const { return TrackedPackages.Num(); }
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include "CoreMinimal.h"
+
+struct FDumpedMeshData;
+struct FDumpedMeshLOD;
+struct FMeshDescription;
+class USkeletalMesh;
+class USkeleton;
+class UStaticMesh;
+
+/**
+ * Builds mesh source data out of the mesh files written by the asset dumper
+ * Replaces FBX import for the dumped meshes: static meshes are built from FMeshDescription, and skeletal meshes
+ * from the imported skeletal mesh data, which is what the skeletal mesh builder consumes in this engine version
+ */
+class ASSETGENERATOR_API FDumpedMeshImporter {
+public:
+	/** Fills mesh description with the geometry of the provided LOD. Vertices with identical positions are welded together */
+	static void PopulateMeshDescription(const FDumpedMeshLOD& LOD, const TArray<FString>& MaterialSlotNames, FMeshDescription& OutMeshDescription);
+
+	/** Checks that the dumped mesh data can be built into the static or skeletal mesh without modifying any of them */
+	static bool ValidateMeshData(const FDumpedMeshData& MeshData, bool bSkeletalMesh, FString& OutErrorMessage);
+
+	/** Replaces source models and material slots of the static mesh with the dumped mesh data and rebuilds it */
+	static bool BuildStaticMesh(UStaticMesh* StaticMesh, const FDumpedMeshData& MeshData, FString& OutErrorMessage);
+
+	/** Replaces reference skeleton, LOD models and material slots of the skeletal mesh with the dumped mesh data and rebuilds it */
+	static bool BuildSkeletalMesh(USkeletalMesh* SkeletalMesh, USkeleton* Skeleton, const FDumpedMeshData& MeshData, FString& OutErrorMessage);
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class UMaterialInterface;
+
+/**
+ * Tracks shader compilation of the materials created, modified or loaded as dependencies during the asset generation
+ * Generator stages that need finished shader maps of their material dependencies are held back
+ * only until the materials they depend on are compiled, instead of waiting for every single shader job to finish
+ * Material packages saved while their shaders were still compiling are remembered, so they can be saved again once compilation is drained
+ */
+class ASSETGENERATOR_API FMaterialCompilationTracker {
+private:
+	/** Materials with shader compilation possibly still in flight, mapped by their package name */
+	TMap<FName, TWeakObjectPtr<UMaterialInterface>> CompilingMaterials;
+	/** Material packages that have been saved while their shaders were still compiling */
+	TSet<TWeakObjectPtr<UPackage>> PackagesSavedBeforeCompilation;
+
+	/** Returns true if shader compilation of the provided material has finished, or the material is no longer alive */
+	static bool IsMaterialCompilationFinished(const TWeakObjectPtr<UMaterialInterface>& Material);
+public:
+	/** Starts tracking compilation of the provided asset if it is a material */
+	void TrackAsset(FName PackageName, UObject* AssetObject);
+
+	/**
+	 * Returns true if the material in the provided package has finished compiling or there is no material in it
+	 * Packages which have not been generated in this run are looked up in memory, so materials loaded as dependencies are covered too
+	 */
+	bool IsCompilationFinished(FName PackageName);
+
+	/** Returns true if materials in all of the provided packages have finished compiling */
+	bool AreAllCompilationsFinished(const TArray<FName>& PackageNames);
+
+	/** Records the material package if it has just been saved while the material is still compiling */
+	void RecordPackageSaved(FName PackageName, UPackage* Package);
+
+	/** Marks packages saved before their material finished compiling as dirty, so they are saved again. Should be called once compilation has been drained */
+	int32 MarkPackagesSavedBeforeCompilationDirty();
+
+	/** Returns amount of materials that might still be compiling */
+	FORCEINLINE int32 GetNumCompilingMaterials() const { return CompilingMaterials.Num(); }
+};
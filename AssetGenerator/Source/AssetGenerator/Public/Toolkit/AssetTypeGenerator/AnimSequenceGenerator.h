@@ -17,9 +17,10 @@ protected:
 	UAnimSequence* ImportAnimation(UPackage* Package, const FName& AssetName, const EObjectFlags ObjectFlags);
 	void ReimportAnimationFromSource(UAnimSequence* Asset);
 	bool IsAnimationSourceUpToDate(UAnimSequence* Asset) const;
-
-	void SetupFbxImportSettings(class UFbxImportUI* ImportUI) const;
+	void BuildAnimationFromDumpedData(UAnimSequence* Asset);
 public:
+	/** Animation is built from the dumped animation file on construction */
+	virtual float GetEstimatedStageCostMs(EAssetGenerationStage Stage) const override { return Stage == EAssetGenerationStage::CONSTRUCTION ? 500.0f : 1.0f; }
 	virtual void PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const override;
 	virtual FName GetAssetClass() override;
 };
\ No newline at end of file
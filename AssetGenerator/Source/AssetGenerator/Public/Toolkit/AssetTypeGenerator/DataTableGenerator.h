@@ -14,7 +14,8 @@ protected:
 	virtual void PopulateAssetWithData() override;
 	void PopulateDataTableWithData(class UDataTable* DataTable, const FTableRowMap& TableRowMap);
 	bool IsDataTableUpToDate(class UDataTable* DataTable, const FTableRowMap& TableRowMap) const;
+	virtual void PrepareStage(EAssetGenerationStage Stage, TArray<FPackageDependency>& OutDependencies) override;
 public:
-	virtual void PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const override;
+	virtual bool SupportsParallelPreparation() const override { return true; }
 	virtual FName GetAssetClass() override;
 };
\ No newline at end of file
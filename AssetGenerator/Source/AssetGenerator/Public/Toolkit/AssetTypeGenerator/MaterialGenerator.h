@@ -142,6 +142,8 @@ protected:
 	static void RemoveMaterialComment(UMaterial* Material, UMaterialExpressionComment* Comment);
 	static bool IsMaterialQualityNodeUsed(const FMaterialCachedExpressionData& Data);
 public:
+	/** Material compilation is forced on construction */
+	virtual float GetEstimatedStageCostMs(EAssetGenerationStage Stage) const override { return Stage == EAssetGenerationStage::CONSTRUCTION ? 250.0f : 1.0f; }
 	virtual void PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const override;
 	virtual FName GetAssetClass() override;
 	static FVector2D GetGoodPlaceForNewMaterialExpression(UMaterial* Material);
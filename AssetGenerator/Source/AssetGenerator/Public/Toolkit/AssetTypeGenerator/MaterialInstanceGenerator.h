@@ -16,6 +16,8 @@ protected:
 	FStaticParameterSet GetStaticParameterOverrides() const;
 public:
 	virtual void PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const override;
+	/** Data population modifies and recompiles the parent material, so it waits for the previous compilation of the parent to finish */
+	virtual bool RequiresCompiledShaderMaps(EAssetGenerationStage Stage) const override { return Stage == EAssetGenerationStage::DATA_POPULATION; }
 protected:
 	virtual void PreFinishAssetGeneration() override;
 public:
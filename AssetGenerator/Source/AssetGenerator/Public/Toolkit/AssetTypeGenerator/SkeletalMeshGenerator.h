@@ -3,6 +3,8 @@
 #include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
 #include "SkeletalMeshGenerator.generated.h"
 
+struct FDumpedMeshData;
+
 UCLASS(MinimalAPI)
 class USkeletalMeshGenerator : public UAssetTypeGenerator {
 	GENERATED_BODY()
@@ -16,11 +18,17 @@ protected:
 	USkeletalMesh* ImportSkeletalMesh(UPackage* Package, const FName& AssetName, const EObjectFlags ObjectFlags);
 	
 	void ReimportSkeletalMeshSource(USkeletalMesh* Asset);
+	/** Loads the dumped mesh file, logging a warning and returning false if it is missing or cannot be built */
+	bool LoadDumpedMeshData(FDumpedMeshData& OutMeshData) const;
+	void BuildSkeletalMeshFromDumpedData(USkeletalMesh* Asset, const FDumpedMeshData& MeshData);
+	void CreatePhysicsAsset(USkeletalMesh* Asset);
 	bool IsSkeletalMeshSourceFileUpToDate(USkeletalMesh* Asset) const;
 
 	void SetupFbxImportSettings(class UFbxImportUI* ImportUI, const FName& AssetName, UPackage* Package);
 	virtual void GetAdditionalPackagesToSave(TArray<UPackage*>& OutPackages) override;
 public:
+	/** Skeletal mesh is built from the dumped mesh file on construction */
+	virtual float GetEstimatedStageCostMs(EAssetGenerationStage Stage) const override { return Stage == EAssetGenerationStage::CONSTRUCTION ? 1000.0f : 1.0f; }
 	virtual void PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const override;
 	virtual FName GetAssetClass() override;
 };
\ No newline at end of file
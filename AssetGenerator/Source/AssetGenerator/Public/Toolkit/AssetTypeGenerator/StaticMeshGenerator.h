@@ -3,6 +3,8 @@
 #include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
 #include "StaticMeshGenerator.generated.h"
 
+struct FDumpedMeshData;
+
 UCLASS(MinimalAPI)
 class UStaticMeshGenerator : public UAssetTypeGenerator {
 	GENERATED_BODY()
@@ -13,11 +15,16 @@ protected:
 	void PopulateStaticMeshWithData(UStaticMesh* Asset);
 	UStaticMesh* ImportStaticMesh(UPackage* Package, const FName& AssetName, const EObjectFlags ObjectFlags);
 	void ReimportStaticMeshSource(UStaticMesh* Asset);
+	/** Loads the dumped mesh file, logging a warning and returning false if it is missing or cannot be built */
+	bool LoadDumpedMeshData(FDumpedMeshData& OutMeshData) const;
+	void BuildStaticMeshFromDumpedData(UStaticMesh* Asset, const FDumpedMeshData& MeshData);
 	void SetupFbxImportSettings(class UFbxImportUI* ImportUI) const;
 	
 	bool IsStaticMeshDataUpToDate(UStaticMesh* Asset) const;
 	bool IsStaticMeshSourceFileUpToDate(UStaticMesh* Asset) const;
 public:
+	/** Static mesh is built from the dumped mesh file on construction */
+	virtual float GetEstimatedStageCostMs(EAssetGenerationStage Stage) const override { return Stage == EAssetGenerationStage::CONSTRUCTION ? 500.0f : 1.0f; }
 	virtual void PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const override;
 	virtual FName GetAssetClass() override;
 };
\ No newline at end of file
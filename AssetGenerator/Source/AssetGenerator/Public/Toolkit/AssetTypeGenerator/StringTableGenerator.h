@@ -7,10 +7,18 @@ UCLASS(MinimalAPI)
 class UStringTableGenerator : public UAssetTypeGenerator {
 	GENERATED_BODY()
 protected:
+	/** String table contents read from the dump during CONSTRUCTION stage preparation */
+	FString TableNamespace;
+	TMap<FString, FString> SourceStrings;
+	TMap<FString, TMap<FName, FString>> TableMetaData;
+
+	virtual void PrepareStage(EAssetGenerationStage Stage, TArray<FPackageDependency>& OutDependencies) override;
 	virtual void CreateAssetPackage() override;
 	virtual void OnExistingPackageLoaded() override;
 	void PopulateStringTableWithData(class UStringTable* StringTable);
 	bool IsStringTableUpToDate(class UStringTable* StringTable) const;
 public:
+	virtual bool SupportsParallelPreparation() const override { return true; }
+	virtual float GetEstimatedStageCostMs(EAssetGenerationStage Stage) const override { return 1.0f; }
 	virtual FName GetAssetClass() override;
-};
\ No newline at end of file
+};
@@ -11,7 +11,8 @@ protected:
 	void PopulateStructWithData(class UUserDefinedStruct* Struct);
 	bool IsStructUpToDate(class UUserDefinedStruct* Struct) const;
 	virtual void FinalizeAssetCDO() override;
+	virtual void PrepareStage(EAssetGenerationStage Stage, TArray<FPackageDependency>& OutDependencies) override;
 public:
-	virtual void PopulateStageDependencies(TArray<FPackageDependency>& OutDependencies) const override;
+	virtual bool SupportsParallelPreparation() const override { return true; }
 	virtual FName GetAssetClass() override;
 };
\ No newline at end of file